@@ -0,0 +1,364 @@
+/**
+ * Daniel Sebastian Iliescu, http://dansil.net
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ *
+ * List and queue microbenchmarks.
+ *
+ * The sequential benchmarks compare doubly_linked_list (with the standard allocator and with
+ * node_pool), the other lists of the collection and the standard library containers on FIFO
+ * push/pop throughput, steady-state churn, iteration, copy and move. The handoff benchmarks pass
+ * items from producer threads to consumer threads through the concurrent queues and through
+ * sequential containers behind a mutex.
+ *
+ * Usage: DataStructuresAlgorithmsBenchmarks [filter], e.g. "handoff" or "node_pool".
+ */
+
+#include "utilities/benchmark.hpp"
+
+#include "lists/bounded_concurrent_queue.hpp"
+#include "lists/concurrent_queue.hpp"
+#include "lists/doubly_linked_list.hpp"
+#include "lists/segmented_deque.hpp"
+#include "lists/spsc_ring.hpp"
+#include "lists/unrolled_list.hpp"
+#include "memory/node_pool.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace
+{
+	using value_type = std::uint64_t;
+
+	constexpr std::size_t ITEMS = std::size_t( 1 ) << 20;
+	constexpr std::size_t MOVES = std::size_t( 1 ) << 20;
+
+	// Length of the queue kept by the churn benchmark, and capacity of the bounded queues.
+	constexpr std::size_t QUEUE_LENGTH = 1024;
+
+	template < typename Container >
+	void
+	sequential_benchmarks(
+		benchmarks::benchmark_suite& suite,
+		const std::string& subject )
+	{
+		suite.run( "push_back_pop_front", subject, 2 * ITEMS, []( benchmarks::stopwatch& watch )
+		{
+			Container container;
+			value_type sum = 0;
+
+			watch.start();
+
+			for ( value_type item = 0; item < ITEMS; ++item )
+			{
+				container.push_back( item );
+			}
+
+			for ( std::size_t item = 0; item < ITEMS; ++item )
+			{
+				sum += container.front();
+				container.pop_front();
+			}
+
+			watch.stop();
+
+			benchmarks::do_not_optimize( sum );
+		} );
+
+		suite.run( "queue_churn", subject, ITEMS, []( benchmarks::stopwatch& watch )
+		{
+			Container container;
+			value_type sum = 0;
+
+			for ( value_type item = 0; item < QUEUE_LENGTH; ++item )
+			{
+				container.push_back( item );
+			}
+
+			watch.start();
+
+			for ( value_type item = 0; item < ITEMS; ++item )
+			{
+				container.push_back( item );
+				sum += container.front();
+				container.pop_front();
+			}
+
+			watch.stop();
+
+			benchmarks::do_not_optimize( sum );
+		} );
+
+		Container source;
+
+		for ( value_type item = 0; item < ITEMS; ++item )
+		{
+			source.push_back( item );
+		}
+
+		suite.run( "iterate", subject, ITEMS, [&source]( benchmarks::stopwatch& watch )
+		{
+			value_type sum = 0;
+
+			watch.start();
+
+			for ( const auto item : source )
+			{
+				sum += item;
+			}
+
+			watch.stop();
+
+			benchmarks::do_not_optimize( sum );
+		} );
+
+		suite.run( "copy", subject, ITEMS, [&source]( benchmarks::stopwatch& watch )
+		{
+			// Destroyed after the stopwatch is stopped.
+			Container copy;
+
+			watch.start();
+			copy = source;
+			benchmarks::do_not_optimize( copy );
+			watch.stop();
+		} );
+
+		suite.run( "move", subject, 2 * MOVES, [&source]( benchmarks::stopwatch& watch )
+		{
+			auto first = source;
+			Container second;
+
+			watch.start();
+
+			for ( std::size_t move = 0; move < MOVES; ++move )
+			{
+				second = std::move( first );
+				first = std::move( second );
+
+				benchmarks::do_not_optimize( first );
+			}
+
+			watch.stop();
+		} );
+	}
+
+	// A sequential container behind a mutex, with the interface of the concurrent queues.
+	template < typename Container >
+	class locked_queue
+	{
+	public:
+		bool
+		push_back( const value_type item )
+		{
+			std::lock_guard< std::mutex > lock( this->mutex );
+			this->items.push_back( item );
+
+			return true;
+		}
+
+		bool
+		pop_front( value_type& item )
+		{
+			std::lock_guard< std::mutex > lock( this->mutex );
+
+			if ( this->items.empty() )
+			{
+				return false;
+			}
+
+			item = this->items.front();
+			this->items.pop_front();
+
+			return true;
+		}
+
+	private:
+		std::mutex mutex;
+		Container items;
+	};
+
+	// Pushes an item, reporting false if the queue is full (the unbounded queues never are).
+	template < typename Queue >
+	bool
+	try_push(
+		Queue& queue,
+		const value_type item )
+	{
+		if constexpr ( std::is_void< decltype( queue.push_back( item ) ) >::value )
+		{
+			queue.push_back( item );
+
+			return true;
+		}
+		else
+		{
+			return queue.push_back( item );
+		}
+	}
+
+	template <
+		typename Queue,
+		typename Factory >
+	void
+	handoff_benchmark(
+		benchmarks::benchmark_suite& suite,
+		const std::string& subject,
+		const std::size_t producers,
+		const std::size_t consumers,
+		Factory&& make_queue )
+	{
+		const auto benchmark = "handoff_" + std::to_string( producers ) + "x" + std::to_string( consumers );
+
+		suite.run( benchmark, subject, ITEMS, [&]( benchmarks::stopwatch& watch )
+		{
+			std::unique_ptr< Queue > queue = make_queue();
+
+			std::atomic< bool > started { false };
+			std::atomic< std::size_t > consumed { 0 };
+
+			std::vector< std::thread > threads;
+
+			for ( std::size_t producer = 0; producer < producers; ++producer )
+			{
+				threads.emplace_back( [&, producer]
+				{
+					while ( !started.load() )
+					{
+						std::this_thread::yield();
+					}
+
+					for ( auto item = static_cast< value_type >( producer ); item < ITEMS; item += producers )
+					{
+						while ( !try_push( *queue, item ) )
+						{
+							std::this_thread::yield();
+						}
+					}
+				} );
+			}
+
+			for ( std::size_t consumer = 0; consumer < consumers; ++consumer )
+			{
+				threads.emplace_back( [&]
+				{
+					value_type sum = 0;
+					value_type item = 0;
+
+					while ( consumed.load( std::memory_order_relaxed ) < ITEMS )
+					{
+						if ( queue->pop_front( item ) )
+						{
+							sum += item;
+							consumed.fetch_add( 1, std::memory_order_relaxed );
+						}
+						else
+						{
+							std::this_thread::yield();
+						}
+					}
+
+					benchmarks::do_not_optimize( sum );
+				} );
+			}
+
+			watch.start();
+			started = true;
+
+			for ( auto& thread : threads )
+			{
+				thread.join();
+			}
+
+			watch.stop();
+		} );
+	}
+
+	template <
+		typename Queue,
+		typename Factory >
+	void
+	mpmc_handoff_benchmarks(
+		benchmarks::benchmark_suite& suite,
+		const std::string& subject,
+		Factory&& make_queue )
+	{
+		handoff_benchmark< Queue >( suite, subject, 1, 1, make_queue );
+		handoff_benchmark< Queue >( suite, subject, 2, 2, make_queue );
+	}
+
+	template < typename Queue >
+	std::unique_ptr< Queue >
+	make_default()
+	{
+		return std::make_unique< Queue >();
+	}
+}
+
+int
+main(
+	const int argc,
+	char* argv[] )
+{
+	using pool = dsa::node_pool< value_type >;
+
+	benchmarks::benchmark_suite suite( ( argc > 1 ) ? argv[ 1 ] : "" );
+
+	sequential_benchmarks< dsa::doubly_linked_list< value_type > >( suite, "doubly_linked_list" );
+	sequential_benchmarks< dsa::doubly_linked_list< value_type, pool > >( suite, "doubly_linked_list<node_pool>" );
+	sequential_benchmarks< dsa::unrolled_list< value_type > >( suite, "unrolled_list" );
+	sequential_benchmarks< dsa::segmented_deque< value_type > >( suite, "segmented_deque" );
+	sequential_benchmarks< std::list< value_type > >( suite, "std::list" );
+	sequential_benchmarks< std::deque< value_type > >( suite, "std::deque" );
+
+	mpmc_handoff_benchmarks< dsa::concurrent_queue< value_type > >(
+		suite,
+		"concurrent_queue",
+		make_default< dsa::concurrent_queue< value_type > > );
+
+	mpmc_handoff_benchmarks< dsa::bounded_concurrent_queue< value_type > >(
+		suite,
+		"bounded_concurrent_queue",
+		[]
+		{
+			return std::make_unique< dsa::bounded_concurrent_queue< value_type > >( QUEUE_LENGTH );
+		} );
+
+	handoff_benchmark< dsa::spsc_ring< value_type, QUEUE_LENGTH > >(
+		suite,
+		"spsc_ring",
+		1,
+		1,
+		make_default< dsa::spsc_ring< value_type, QUEUE_LENGTH > > );
+
+	mpmc_handoff_benchmarks< locked_queue< dsa::doubly_linked_list< value_type > > >(
+		suite,
+		"mutex+doubly_linked_list",
+		make_default< locked_queue< dsa::doubly_linked_list< value_type > > > );
+
+	mpmc_handoff_benchmarks< locked_queue< dsa::doubly_linked_list< value_type, pool > > >(
+		suite,
+		"mutex+doubly_linked_list<node_pool>",
+		make_default< locked_queue< dsa::doubly_linked_list< value_type, pool > > > );
+
+	mpmc_handoff_benchmarks< locked_queue< std::list< value_type > > >(
+		suite,
+		"mutex+std::list",
+		make_default< locked_queue< std::list< value_type > > > );
+
+	mpmc_handoff_benchmarks< locked_queue< std::deque< value_type > > >(
+		suite,
+		"mutex+std::deque",
+		make_default< locked_queue< std::deque< value_type > > > );
+
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,119 @@
+/**
+ * Daniel Sebastian Iliescu, http://dansil.net
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ *
+ * Replacements of the global allocation functions which count every allocation.
+ *
+ * The array, nothrow and sized forms of the standard library forward to the replaced ones.
+ */
+
+#include "benchmark.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#if defined( _MSC_VER )
+#include <malloc.h>
+#endif
+
+namespace
+{
+	std::atomic< std::size_t > allocations { 0 };
+
+	void*
+	allocate(
+		const std::size_t size,
+		const std::size_t alignment )
+	{
+		allocations.fetch_add( 1, std::memory_order_relaxed );
+
+		const auto bytes = ( size == 0 ) ? 1 : size;
+
+#if defined( _MSC_VER )
+		const auto memory = ( alignment > alignof( std::max_align_t ) ) ? _aligned_malloc( bytes, alignment ) : std::malloc( bytes );
+#else
+		// aligned_alloc requires the size to be a multiple of the alignment.
+		const auto memory = ( alignment > alignof( std::max_align_t ) ) ? std::aligned_alloc( alignment, ( bytes + alignment - 1 ) / alignment * alignment ) : std::malloc( bytes );
+#endif
+
+		if ( !memory )
+		{
+			throw std::bad_alloc();
+		}
+
+		return memory;
+	}
+
+	void
+	deallocate(
+		void* const memory,
+		[[maybe_unused]] const std::size_t alignment ) noexcept
+	{
+#if defined( _MSC_VER )
+		if ( alignment > alignof( std::max_align_t ) )
+		{
+			_aligned_free( memory );
+
+			return;
+		}
+#endif
+
+		std::free( memory );
+	}
+}
+
+namespace benchmarks
+{
+	std::size_t
+	allocation_count() noexcept
+	{
+		return allocations.load( std::memory_order_relaxed );
+	}
+}
+
+void*
+operator new( const std::size_t size )
+{
+	return allocate( size, alignof( std::max_align_t ) );
+}
+
+void*
+operator new(
+	const std::size_t size,
+	const std::align_val_t alignment )
+{
+	return allocate( size, static_cast< std::size_t >( alignment ) );
+}
+
+void
+operator delete( void* const memory ) noexcept
+{
+	deallocate( memory, alignof( std::max_align_t ) );
+}
+
+void
+operator delete(
+	void* const memory,
+	std::size_t ) noexcept
+{
+	deallocate( memory, alignof( std::max_align_t ) );
+}
+
+void
+operator delete(
+	void* const memory,
+	const std::align_val_t alignment ) noexcept
+{
+	deallocate( memory, static_cast< std::size_t >( alignment ) );
+}
+
+void
+operator delete(
+	void* const memory,
+	std::size_t,
+	const std::align_val_t alignment ) noexcept
+{
+	deallocate( memory, static_cast< std::size_t >( alignment ) );
+}
\ No newline at end of file
@@ -0,0 +1,144 @@
+/**
+ * Daniel Sebastian Iliescu, http://dansil.net
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ *
+ * A minimal harness for microbenchmarks.
+ *
+ * Every benchmark runs a number of trials and reports its fastest one, as operations per second,
+ * nanoseconds per operation and heap allocations per operation. The body of a benchmark starts and
+ * stops the stopwatch it is given around the measured region, so that setup and teardown are left
+ * out. Allocations are counted by the replaced global operator new (see allocation_counter.cpp),
+ * across every thread.
+ *
+ * Benchmarks are named "<benchmark>/<subject>", and only those containing the filter given on the
+ * command line are run. Timings are only meaningful for optimized builds.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <limits>
+#include <string>
+#include <utility>
+
+namespace benchmarks
+{
+	// Number of heap allocations made since the start of the program.
+	std::size_t
+	allocation_count() noexcept;
+
+	// Makes the compiler assume that the value is read and modified, so that computing it is not optimized away.
+	template < typename T >
+	void
+	do_not_optimize( T& value ) noexcept
+	{
+#if defined( __GNUC__ ) || defined( __clang__ )
+		asm volatile( "" : : "g"( &value ) : "memory" );
+#else
+		static volatile const void* escaped;
+		escaped = &value;
+#endif
+	}
+
+	class stopwatch
+	{
+	public:
+		void
+		start() noexcept
+		{
+			this->allocations = allocation_count();
+			this->begin = std::chrono::steady_clock::now();
+		}
+
+		void
+		stop() noexcept
+		{
+			this->end = std::chrono::steady_clock::now();
+			this->allocations = allocation_count() - this->allocations;
+		}
+
+		double
+		seconds() const noexcept
+		{
+			return std::chrono::duration< double >( this->end - this->begin ).count();
+		}
+
+		std::size_t
+		allocated() const noexcept
+		{
+			return this->allocations;
+		}
+
+	private:
+		std::chrono::steady_clock::time_point begin;
+		std::chrono::steady_clock::time_point end;
+
+		std::size_t allocations = 0;
+	};
+
+	class benchmark_suite
+	{
+	public:
+		static constexpr std::size_t DEFAULT_TRIALS = 5;
+
+		explicit benchmark_suite(
+			std::string input_filter = std::string(),
+			const std::size_t input_trials = DEFAULT_TRIALS ) :
+			filter( std::move( input_filter ) ),
+			trials( input_trials )
+		{
+			std::printf( "%-48s %14s %12s %14s\n", "benchmark", "Mops/s", "ns/op", "allocs/op" );
+		}
+
+		/**
+		 * Runs the body, which performs the given number of operations between the start and the stop
+		 * of the stopwatch it is passed, and prints the fastest trial.
+		 */
+		template < typename Body >
+		void
+		run(
+			const std::string& benchmark,
+			const std::string& subject,
+			const std::size_t operations,
+			Body&& body )
+		{
+			const auto name = benchmark + "/" + subject;
+
+			if ( name.find( this->filter ) == std::string::npos )
+			{
+				return;
+			}
+
+			auto best_seconds = std::numeric_limits< double >::infinity();
+			std::size_t best_allocations = 0;
+
+			for ( std::size_t trial = 0; trial < this->trials; ++trial )
+			{
+				stopwatch watch;
+				body( watch );
+
+				if ( watch.seconds() < best_seconds )
+				{
+					best_seconds = watch.seconds();
+					best_allocations = watch.allocated();
+				}
+			}
+
+			const auto seconds = std::max( best_seconds, std::numeric_limits< double >::min() );
+
+			std::printf(
+				"%-48s %14.2f %12.2f %14.3f\n",
+				name.c_str(),
+				operations / seconds / 1e6,
+				seconds * 1e9 / operations,
+				static_cast< double >( best_allocations ) / operations );
+		}
+
+	private:
+		std::string filter;
+		std::size_t trials;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,59 @@
+/**
+ * Daniel Sebastian Iliescu, http://dansil.net
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ *
+ * Definitions shared by the caches.
+ *
+ * A cache is bounded by the total weight of its entries. The weight of an entry is given by
+ * a weigher, a function object called with its key and value: the default weigher gives each
+ * entry a weight of one, which bounds the number of entries, while a weigher returning sizes
+ * in bytes bounds the memory used.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+namespace dsa
+{
+	// Weighs every entry as one, so that the capacity is a number of entries.
+	struct entry_count_weigher
+	{
+		template <
+			typename Key,
+			typename Value >
+		constexpr std::size_t
+		operator()(
+			const Key&,
+			const Value& ) const noexcept
+		{
+			return 1;
+		}
+	};
+
+	struct cache_statistics
+	{
+		cache_statistics&
+		operator+=( const cache_statistics& rhs ) noexcept
+		{
+			this->hits += rhs.hits;
+			this->misses += rhs.misses;
+			this->evictions += rhs.evictions;
+
+			return *this;
+		}
+
+		// Fraction of the lookups which were hits, or zero if there were none.
+		double
+		hit_ratio() const noexcept
+		{
+			const auto lookups = this->hits + this->misses;
+
+			return ( lookups == 0 ) ? 0.0 : static_cast< double >( this->hits ) / static_cast< double >( lookups );
+		}
+
+		std::size_t hits = 0;
+		std::size_t misses = 0;
+		std::size_t evictions = 0;
+	};
+}
\ No newline at end of file
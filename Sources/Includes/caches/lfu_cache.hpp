@@ -0,0 +1,458 @@
+/**
+ * Daniel Sebastian Iliescu, http://dansil.net
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ *
+ * A cache evicting the least frequently used entries once its capacity is exceeded, the least
+ * recently used first among entries used equally often.
+ *
+ * The entries are grouped in buckets of equal use count, linked in increasing order of count,
+ * each bucket linking its entries in order of recency (Shah, Mitra and Matani, 2010). A hit
+ * moves an entry to the front of the bucket for the next count, which is either the following
+ * bucket or a new one, so get, put and erase run in constant time. A HashTable maps each key
+ * to its entry. The buckets and the entries are linked through intrusive lists and allocated
+ * from (rebound copies of) the given allocator, node pools by default, so moving an entry
+ * between buckets neither allocates nor copies.
+ *
+ * The cache is not thread-safe; see sharded_cache for a concurrent cache.
+ */
+
+#pragma once
+
+#include "cache.hpp"
+#include "hashing/hash_table.hpp"
+#include "lists/intrusive_list.hpp"
+#include "memory/node_pool.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <utility>
+
+namespace dsa
+{
+	template <
+		typename Key,
+		typename Value,
+		typename Weigher = entry_count_weigher,
+		typename Hash = std::hash< Key >,
+		typename KeyEqual = std::equal_to< Key >,
+		typename Allocator = node_pool< std::pair< const Key, Value > > >
+	class lfu_cache
+	{
+		struct frequency_bucket;
+
+		struct cache_entry
+		{
+			template < typename V >
+			cache_entry(
+				const Key& input_key,
+				V&& input_value ) :
+				key( input_key ),
+				value( std::forward< V >( input_value ) )
+			{
+			}
+
+			Key key;
+			Value value;
+			std::size_t weight = 0;
+
+			frequency_bucket* bucket = nullptr;
+			intrusive_list_hook hook;
+		};
+
+		struct frequency_bucket
+		{
+			explicit frequency_bucket( const std::size_t input_frequency ) noexcept :
+				frequency( input_frequency )
+			{
+			}
+
+			std::size_t frequency;
+
+			// Entries used this many times, most recently used first.
+			intrusive_list< cache_entry, &cache_entry::hook > entries;
+			intrusive_list_hook hook;
+		};
+
+		using frequency_list = intrusive_list< frequency_bucket, &frequency_bucket::hook >;
+
+		template < typename T >
+		using rebind_alloc = typename std::allocator_traits< Allocator >::template rebind_alloc< T >;
+
+		using entry_allocator = rebind_alloc< cache_entry >;
+		using bucket_allocator = rebind_alloc< frequency_bucket >;
+		using entry_index = HashTable< Key, cache_entry*, Hash, KeyEqual, rebind_alloc< std::pair< const Key, cache_entry* > > >;
+
+	public:
+		using key_type = Key;
+		using mapped_type = Value;
+		using size_type = std::size_t;
+		using hasher = Hash;
+		using key_equal = KeyEqual;
+		using weigher_type = Weigher;
+		using allocator_type = Allocator;
+
+		explicit lfu_cache(
+			const size_type input_capacity,
+			Weigher input_weigher = Weigher(),
+			const Allocator& input_allocator = Allocator() ) :
+			weigher( std::move( input_weigher ) ),
+			entry_pool( input_allocator ),
+			bucket_pool( input_allocator ),
+			index( typename entry_index::allocator_type( input_allocator ) ),
+			maximum_weight( input_capacity )
+		{
+		}
+
+		~lfu_cache() noexcept
+		{
+			this->clear();
+		}
+
+		lfu_cache( const lfu_cache& ) = delete;
+		lfu_cache( lfu_cache&& ) = delete;
+
+		lfu_cache& operator=( const lfu_cache& ) = delete;
+		lfu_cache& operator=( lfu_cache&& ) = delete;
+
+		/**
+		 * Lookup
+		 */
+
+		/**
+		 * Returns a pointer to the value of the key, or a null pointer on a miss. A hit counts as
+		 * a use of the entry. The pointer remains valid until the entry is evicted or erased.
+		 */
+		Value*
+		get( const Key& key )
+		{
+			const auto entry = this->index.find( key );
+
+			if ( !entry )
+			{
+				++( this->counters.misses );
+
+				return nullptr;
+			}
+
+			++( this->counters.hits );
+
+			this->touch( **entry );
+
+			return &( *entry )->value;
+		}
+
+		// Tells whether the key is cached, without counting a use or affecting the statistics.
+		bool
+		contains( const Key& key ) const noexcept
+		{
+			return this->index.contains( key );
+		}
+
+		// Number of uses of the key (its insertion and hits), or zero if it is not cached.
+		size_type
+		frequency( const Key& key ) const noexcept
+		{
+			const auto entry = this->index.find( key );
+
+			return entry ? ( *entry )->bucket->frequency : 0;
+		}
+
+		/**
+		 * Modifiers
+		 */
+
+		/**
+		 * Caches the value for the key, replacing any previous value, which counts as a use of
+		 * the entry. Then evicts the least frequently used entries until the capacity is respected,
+		 * a new entry only being evicted if it exceeds the capacity on its own.
+		 */
+		template < typename V >
+		void
+		put(
+			const Key& key,
+			V&& value )
+		{
+			if ( const auto entry = this->index.find( key ) )
+			{
+				( *entry )->value = std::forward< V >( value );
+
+				this->reweigh( **entry );
+				this->touch( **entry );
+			}
+			else
+			{
+				const auto new_entry = this->create_entry( key, std::forward< V >( value ) );
+
+				// New entries are used once, which is the lowest count, so their bucket is at the front.
+				const auto has_bucket = !this->frequencies.empty() && ( this->frequencies.front().frequency == 1 );
+				frequency_bucket* new_bucket = nullptr;
+
+				try
+				{
+					if ( !has_bucket )
+					{
+						new_bucket = this->create_bucket( 1 );
+					}
+
+					this->index.try_emplace( key, new_entry );
+				}
+				catch ( ... )
+				{
+					if ( new_bucket )
+					{
+						this->destroy_bucket( new_bucket );
+					}
+
+					this->destroy_entry( new_entry );
+					throw;
+				}
+
+				if ( new_bucket )
+				{
+					this->frequencies.push_front( *new_bucket );
+				}
+
+				this->link( *new_entry, this->frequencies.front() );
+				this->reweigh( *new_entry );
+
+				this->evict( new_entry );
+
+				return;
+			}
+
+			this->evict();
+		}
+
+		// Removes the key; returns whether it was cached.
+		bool
+		erase( const Key& key )
+		{
+			const auto entry = this->index.find( key );
+
+			if ( !entry )
+			{
+				return false;
+			}
+
+			const auto removed = *entry;
+
+			this->index.erase( key );
+			this->remove( removed );
+
+			return true;
+		}
+
+		void
+		clear() noexcept
+		{
+			while ( !this->frequencies.empty() )
+			{
+				const auto bucket = this->frequencies.pop_front();
+
+				while ( const auto entry = bucket->entries.pop_front() )
+				{
+					this->destroy_entry( entry );
+				}
+
+				this->destroy_bucket( bucket );
+			}
+
+			this->index.clear();
+
+			this->entries = 0;
+			this->total_weight = 0;
+		}
+
+		/**
+		 * Capacity
+		 */
+
+		bool
+		empty() const noexcept
+		{
+			return ( this->entries == 0 );
+		}
+
+		size_type
+		size() const noexcept
+		{
+			return this->entries;
+		}
+
+		// Total weight of the entries.
+		size_type
+		weight() const noexcept
+		{
+			return this->total_weight;
+		}
+
+		// Maximum total weight of the entries.
+		size_type
+		capacity() const noexcept
+		{
+			return this->maximum_weight;
+		}
+
+		/**
+		 * Statistics
+		 */
+
+		const cache_statistics&
+		statistics() const noexcept
+		{
+			return this->counters;
+		}
+
+		void
+		reset_statistics() noexcept
+		{
+			this->counters = cache_statistics();
+		}
+
+	private:
+		// Moves the entry to the front of the bucket for one more use.
+		void
+		touch( cache_entry& entry )
+		{
+			const auto bucket = entry.bucket;
+			const auto next = std::next( frequency_list::iterator_to( *bucket ) );
+
+			auto target = ( ( next != this->frequencies.end() ) && ( next->frequency == bucket->frequency + 1 ) ) ?
+				&*next :
+				&*this->frequencies.insert( next, *this->create_bucket( bucket->frequency + 1 ) );
+
+			this->unlink( entry );
+			this->link( entry, *target );
+		}
+
+		void
+		link(
+			cache_entry& entry,
+			frequency_bucket& bucket ) noexcept
+		{
+			bucket.entries.push_front( entry );
+			entry.bucket = &bucket;
+
+			++( this->entries );
+		}
+
+		// Unlinks the entry from its bucket, removing the bucket if it becomes empty.
+		void
+		unlink( cache_entry& entry ) noexcept
+		{
+			const auto bucket = entry.bucket;
+
+			bucket->entries.erase( entry );
+			entry.bucket = nullptr;
+
+			if ( bucket->entries.empty() )
+			{
+				this->frequencies.erase( *bucket );
+				this->destroy_bucket( bucket );
+			}
+
+			--( this->entries );
+		}
+
+		// Unlinks and destroys an entry which is no longer indexed.
+		void
+		remove( cache_entry* const entry ) noexcept
+		{
+			this->total_weight -= entry->weight;
+
+			this->unlink( *entry );
+			this->destroy_entry( entry );
+		}
+
+		void
+		reweigh( cache_entry& entry )
+		{
+			const auto weight = this->weigher( static_cast< const Key& >( entry.key ), static_cast< const Value& >( entry.value ) );
+
+			this->total_weight = this->total_weight - entry.weight + weight;
+			entry.weight = weight;
+		}
+
+		// Evicts the least frequently used entries, sparing the incoming entry while any other remains.
+		void
+		evict( const cache_entry* const incoming = nullptr )
+		{
+			while ( this->total_weight > this->maximum_weight )
+			{
+				auto victim = &this->frequencies.front().entries.back();
+
+				// The incoming entry is at the front of its bucket, so it is only the candidate when alone in it.
+				if ( ( victim == incoming ) && ( this->entries > 1 ) )
+				{
+					victim = &std::next( this->frequencies.begin() )->entries.back();
+				}
+
+				this->index.erase( victim->key );
+				this->remove( victim );
+
+				++( this->counters.evictions );
+			}
+		}
+
+		template < typename V >
+		cache_entry*
+		create_entry(
+			const Key& key,
+			V&& value )
+		{
+			const auto entry = std::allocator_traits< entry_allocator >::allocate( this->entry_pool, 1 );
+
+			try
+			{
+				std::allocator_traits< entry_allocator >::construct( this->entry_pool, entry, key, std::forward< V >( value ) );
+			}
+			catch ( ... )
+			{
+				std::allocator_traits< entry_allocator >::deallocate( this->entry_pool, entry, 1 );
+				throw;
+			}
+
+			return entry;
+		}
+
+		void
+		destroy_entry( cache_entry* const entry ) noexcept
+		{
+			std::allocator_traits< entry_allocator >::destroy( this->entry_pool, entry );
+			std::allocator_traits< entry_allocator >::deallocate( this->entry_pool, entry, 1 );
+		}
+
+		frequency_bucket*
+		create_bucket( const size_type frequency )
+		{
+			const auto bucket = std::allocator_traits< bucket_allocator >::allocate( this->bucket_pool, 1 );
+			std::allocator_traits< bucket_allocator >::construct( this->bucket_pool, bucket, frequency );
+
+			return bucket;
+		}
+
+		void
+		destroy_bucket( frequency_bucket* const bucket ) noexcept
+		{
+			std::allocator_traits< bucket_allocator >::destroy( this->bucket_pool, bucket );
+			std::allocator_traits< bucket_allocator >::deallocate( this->bucket_pool, bucket, 1 );
+		}
+
+		Weigher weigher;
+
+		entry_allocator entry_pool;
+		bucket_allocator bucket_pool;
+
+		// Buckets in increasing order of use count; the front one holds the eviction candidates.
+		frequency_list frequencies;
+		entry_index index;
+
+		size_type maximum_weight;
+		size_type total_weight = 0;
+		size_type entries = 0;
+
+		cache_statistics counters;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,283 @@
+/**
+ * Daniel Sebastian Iliescu, http://dansil.net
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ *
+ * A cache evicting the least recently used entries once its capacity is exceeded.
+ *
+ * The entries are kept in a doubly_linked_list in order of recency, and a HashTable maps each
+ * key to the position of its entry. A hit splices the entry to the front of the list, and
+ * evictions pop the back of the list, so get, put and erase run in constant time. Both are
+ * allocated through (rebound copies of) the given allocator.
+ *
+ * The cache is not thread-safe; see sharded_cache for a concurrent cache.
+ */
+
+#pragma once
+
+#include "cache.hpp"
+#include "hashing/hash_table.hpp"
+#include "lists/doubly_linked_list.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <utility>
+
+namespace dsa
+{
+	template <
+		typename Key,
+		typename Value,
+		typename Weigher = entry_count_weigher,
+		typename Hash = std::hash< Key >,
+		typename KeyEqual = std::equal_to< Key >,
+		typename Allocator = std::allocator< std::pair< const Key, Value > > >
+	class lru_cache
+	{
+		struct cache_entry
+		{
+			cache_entry() = default;
+
+			template < typename V >
+			cache_entry(
+				const Key& input_key,
+				V&& input_value ) :
+				key( input_key ),
+				value( std::forward< V >( input_value ) )
+			{
+			}
+
+			Key key = Key();
+			Value value = Value();
+			std::size_t weight = 0;
+		};
+
+		template < typename T >
+		using rebind_alloc = typename std::allocator_traits< Allocator >::template rebind_alloc< T >;
+
+		using recency_list = doubly_linked_list< cache_entry, rebind_alloc< cache_entry > >;
+		using recency_index = HashTable<
+			Key,
+			typename recency_list::iterator,
+			Hash,
+			KeyEqual,
+			rebind_alloc< std::pair< const Key, typename recency_list::iterator > > >;
+
+	public:
+		using key_type = Key;
+		using mapped_type = Value;
+		using size_type = std::size_t;
+		using hasher = Hash;
+		using key_equal = KeyEqual;
+		using weigher_type = Weigher;
+		using allocator_type = Allocator;
+
+		explicit lru_cache(
+			const size_type input_capacity,
+			Weigher input_weigher = Weigher(),
+			const Allocator& input_allocator = Allocator() ) :
+			weigher( std::move( input_weigher ) ),
+			recency( typename recency_list::allocator_type( input_allocator ) ),
+			index( typename recency_index::allocator_type( input_allocator ) ),
+			maximum_weight( input_capacity )
+		{
+		}
+
+		~lru_cache() noexcept = default;
+
+		lru_cache( const lru_cache& ) = delete;
+		lru_cache( lru_cache&& ) = delete;
+
+		lru_cache& operator=( const lru_cache& ) = delete;
+		lru_cache& operator=( lru_cache&& ) = delete;
+
+		/**
+		 * Lookup
+		 */
+
+		/**
+		 * Returns a pointer to the value of the key, or a null pointer on a miss. A hit makes the
+		 * entry the most recently used. The pointer remains valid until the entry is evicted or erased.
+		 */
+		Value*
+		get( const Key& key )
+		{
+			const auto position = this->index.find( key );
+
+			if ( !position )
+			{
+				++( this->counters.misses );
+
+				return nullptr;
+			}
+
+			++( this->counters.hits );
+
+			this->recency.splice( this->recency.cbegin(), this->recency, *position );
+
+			return &( *position )->value;
+		}
+
+		// Tells whether the key is cached, without affecting its recency or the statistics.
+		bool
+		contains( const Key& key ) const noexcept
+		{
+			return this->index.contains( key );
+		}
+
+		/**
+		 * Modifiers
+		 */
+
+		/**
+		 * Caches the value for the key as the most recently used entry, replacing any previous
+		 * value, then evicts the least recently used entries until the capacity is respected.
+		 */
+		template < typename V >
+		void
+		put(
+			const Key& key,
+			V&& value )
+		{
+			if ( const auto position = this->index.find( key ) )
+			{
+				auto& entry = **position;
+
+				entry.value = std::forward< V >( value );
+
+				this->reweigh( entry );
+				this->recency.splice( this->recency.cbegin(), this->recency, *position );
+			}
+			else
+			{
+				this->recency.emplace_front( key, std::forward< V >( value ) );
+
+				try
+				{
+					this->index.try_emplace( key, this->recency.begin() );
+				}
+				catch ( ... )
+				{
+					this->recency.erase( this->recency.cbegin() );
+					throw;
+				}
+
+				this->reweigh( this->recency.front() );
+			}
+
+			this->evict();
+		}
+
+		// Removes the key; returns whether it was cached.
+		bool
+		erase( const Key& key )
+		{
+			const auto position = this->index.find( key );
+
+			if ( !position )
+			{
+				return false;
+			}
+
+			this->total_weight -= ( *position )->weight;
+
+			this->recency.erase( *position );
+			this->index.erase( key );
+
+			return true;
+		}
+
+		void
+		clear() noexcept
+		{
+			this->recency.clear();
+			this->index.clear();
+
+			this->total_weight = 0;
+		}
+
+		/**
+		 * Capacity
+		 */
+
+		bool
+		empty() const noexcept
+		{
+			return this->recency.empty();
+		}
+
+		size_type
+		size() const noexcept
+		{
+			return this->recency.size();
+		}
+
+		// Total weight of the entries.
+		size_type
+		weight() const noexcept
+		{
+			return this->total_weight;
+		}
+
+		// Maximum total weight of the entries.
+		size_type
+		capacity() const noexcept
+		{
+			return this->maximum_weight;
+		}
+
+		/**
+		 * Statistics
+		 */
+
+		const cache_statistics&
+		statistics() const noexcept
+		{
+			return this->counters;
+		}
+
+		void
+		reset_statistics() noexcept
+		{
+			this->counters = cache_statistics();
+		}
+
+	private:
+		// Updates the weight of an entry whose value was stored.
+		void
+		reweigh( cache_entry& entry )
+		{
+			const auto weight = this->weigher( static_cast< const Key& >( entry.key ), static_cast< const Value& >( entry.value ) );
+
+			this->total_weight = this->total_weight - entry.weight + weight;
+			entry.weight = weight;
+		}
+
+		void
+		evict()
+		{
+			while ( this->total_weight > this->maximum_weight )
+			{
+				const auto& victim = this->recency.back();
+
+				this->total_weight -= victim.weight;
+				this->index.erase( victim.key );
+
+				this->recency.erase( std::prev( this->recency.cend() ) );
+
+				++( this->counters.evictions );
+			}
+		}
+
+		Weigher weigher;
+
+		recency_list recency;
+		recency_index index;
+
+		size_type maximum_weight;
+		size_type total_weight = 0;
+
+		cache_statistics counters;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,233 @@
+/**
+ * Daniel Sebastian Iliescu, http://dansil.net
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ *
+ * A thread-safe cache, partitioned into shards which each hold a cache behind their own lock.
+ *
+ * A key always maps to the same shard, chosen from its hash, so threads using different keys
+ * rarely contend. Each shard is bounded by an equal part of the capacity and evicts on its own,
+ * so the eviction order is only approximately global (for instance approximately LRU for
+ * sharded_cache< lru_cache< Key, Value > >). Each shard sits on its own cache lines.
+ *
+ * Since another thread may evict an entry at any time, get returns a copy of the value.
+ */
+
+#pragma once
+
+#include "cache.hpp"
+#include "memory/cache_line.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace dsa
+{
+	template < typename Cache >
+	class sharded_cache
+	{
+		struct alignas( cache_line_size ) cache_shard
+		{
+			cache_shard(
+				const std::size_t capacity,
+				const typename Cache::weigher_type& weigher ) :
+				cache( capacity, weigher )
+			{
+			}
+
+			std::mutex mutex;
+			Cache cache;
+		};
+
+	public:
+		using key_type = typename Cache::key_type;
+		using mapped_type = typename Cache::mapped_type;
+		using size_type = std::size_t;
+		using hasher = typename Cache::hasher;
+		using weigher_type = typename Cache::weigher_type;
+
+		static constexpr size_type DEFAULT_SHARDS = 16;
+
+		// The capacity is divided evenly between the shards.
+		explicit sharded_cache(
+			const size_type capacity,
+			const size_type shard_count = DEFAULT_SHARDS,
+			const weigher_type& weigher = weigher_type(),
+			hasher input_hash = hasher() ) :
+			hash( std::move( input_hash ) )
+		{
+			const auto shards_used = std::max< size_type >( 1, shard_count );
+
+			this->shards.reserve( shards_used );
+
+			for ( size_type shard = 0; shard < shards_used; ++shard )
+			{
+				// Spread the remainder over the first shards.
+				const auto shard_capacity = capacity / shards_used + ( ( shard < capacity % shards_used ) ? 1 : 0 );
+
+				this->shards.push_back( std::make_unique< cache_shard >( shard_capacity, weigher ) );
+			}
+		}
+
+		~sharded_cache() noexcept = default;
+
+		sharded_cache( const sharded_cache& ) = delete;
+		sharded_cache( sharded_cache&& ) = delete;
+
+		sharded_cache& operator=( const sharded_cache& ) = delete;
+		sharded_cache& operator=( sharded_cache&& ) = delete;
+
+		/**
+		 * Lookup
+		 */
+
+		// Returns a copy of the value of the key, or nothing on a miss.
+		std::optional< mapped_type >
+		get( const key_type& key )
+		{
+			auto& shard = this->shard_for( key );
+			const std::lock_guard< std::mutex > lock( shard.mutex );
+
+			if ( const auto value = shard.cache.get( key ) )
+			{
+				return *value;
+			}
+
+			return std::nullopt;
+		}
+
+		bool
+		contains( const key_type& key )
+		{
+			auto& shard = this->shard_for( key );
+			const std::lock_guard< std::mutex > lock( shard.mutex );
+
+			return shard.cache.contains( key );
+		}
+
+		/**
+		 * Modifiers
+		 */
+
+		template < typename V >
+		void
+		put(
+			const key_type& key,
+			V&& value )
+		{
+			auto& shard = this->shard_for( key );
+			const std::lock_guard< std::mutex > lock( shard.mutex );
+
+			shard.cache.put( key, std::forward< V >( value ) );
+		}
+
+		bool
+		erase( const key_type& key )
+		{
+			auto& shard = this->shard_for( key );
+			const std::lock_guard< std::mutex > lock( shard.mutex );
+
+			return shard.cache.erase( key );
+		}
+
+		void
+		clear()
+		{
+			for ( auto& shard : this->shards )
+			{
+				const std::lock_guard< std::mutex > lock( shard->mutex );
+
+				shard->cache.clear();
+			}
+		}
+
+		/**
+		 * Capacity and statistics, as snapshots taken one shard at a time.
+		 */
+
+		size_type
+		size()
+		{
+			return this->accumulate( []( const Cache& cache ) { return cache.size(); } );
+		}
+
+		size_type
+		weight()
+		{
+			return this->accumulate( []( const Cache& cache ) { return cache.weight(); } );
+		}
+
+		size_type
+		capacity()
+		{
+			return this->accumulate( []( const Cache& cache ) { return cache.capacity(); } );
+		}
+
+		size_type
+		shard_count() const noexcept
+		{
+			return this->shards.size();
+		}
+
+		cache_statistics
+		statistics()
+		{
+			cache_statistics total;
+
+			for ( auto& shard : this->shards )
+			{
+				const std::lock_guard< std::mutex > lock( shard->mutex );
+
+				total += shard->cache.statistics();
+			}
+
+			return total;
+		}
+
+		void
+		reset_statistics()
+		{
+			for ( auto& shard : this->shards )
+			{
+				const std::lock_guard< std::mutex > lock( shard->mutex );
+
+				shard->cache.reset_statistics();
+			}
+		}
+
+	private:
+		// Scrambled with another multiplier than HashTable, so that the shard and the slot of a key are unrelated.
+		cache_shard&
+		shard_for( const key_type& key )
+		{
+			const auto scrambled = static_cast< std::uint64_t >( this->hash( key ) ) * 0xC2B2AE3D27D4EB4FULL;
+
+			return *this->shards[ static_cast< size_type >( ( scrambled >> 32 ) % this->shards.size() ) ];
+		}
+
+		template < typename Function >
+		size_type
+		accumulate( Function function )
+		{
+			size_type total = 0;
+
+			for ( auto& shard : this->shards )
+			{
+				const std::lock_guard< std::mutex > lock( shard->mutex );
+
+				total += function( shard->cache );
+			}
+
+			return total;
+		}
+
+		hasher hash;
+
+		std::vector< std::unique_ptr< cache_shard > > shards;
+	};
+}
\ No newline at end of file
@@ -9,6 +9,7 @@
 
 #include <sstream>
 #include <iostream>
+#include <new>
 
 namespace dsa
 {
@@ -17,8 +18,10 @@ namespace dsa
     const int EDGE_INDENT = 2;      // indentation of edge info
 
     // ---------------------------------------------------------------------------
-    // Default constructor for class GraphL
-    GraphL::GraphL()
+    // Constructor for class GraphL
+    // The edges are allocated from the given memory resource.
+    GraphL::GraphL(std::pmr::memory_resource* resource)
+        : edgeAllocator(resource)
     {
         initGraph();
     }
@@ -57,7 +60,7 @@ namespace dsa
             while (edge != nullptr)
             {
                 EdgeNode* temp = edge->nextEdge;
-                delete edge;
+                edgeAllocator.deallocate(edge, 1);
                 edge = temp;
             }
             node[i].edgeHead = nullptr;
@@ -100,7 +103,7 @@ namespace dsa
                 current = current->nextEdge;
             }
 
-            EdgeNode* edge = new EdgeNode;
+            EdgeNode* edge = new (edgeAllocator.allocate(1)) EdgeNode;
             edge->adjGraphNode = end;
             edge->nextEdge = current;
 
@@ -149,7 +152,7 @@ namespace dsa
                     {
                         prev->nextEdge = current->nextEdge;
                     }
-                    delete current;
+                    edgeAllocator.deallocate(current, 1);
                     return true;
                 }
                 else if (current->adjGraphNode > end)
@@ -6,6 +6,8 @@
 
 #include "node_data.hpp"
 
+#include <memory_resource>
+
 namespace dsa
 {
     //---------------------------------------------------------------------------
@@ -33,13 +35,16 @@ namespace dsa
     //  --  allows building the Graph with a stream of data
     //  --  allows displaying the Graph info (including nodes data and edges)
     //  --  allows performing the depth-first traversal of the Graph
+    //  --  allocates the edges from a memory resource (e.g. a monotonic_arena)
     // Note: the public interface assumes a 1-based indexing of nodes while
     // the internal implementation uses a 0-based indexing scheme.
     //---------------------------------------------------------------------------
     class GraphL
     {
     public:
-        GraphL();                           // constructor
+        explicit GraphL(                    // constructor
+            std::pmr::memory_resource* resource =
+                std::pmr::get_default_resource());
         ~GraphL();                          // destructor 
 
         // Accessors
@@ -67,6 +72,7 @@ namespace dsa
         static void padString( std::string &info, int length);
 
         // Data members
+        std::pmr::polymorphic_allocator<EdgeNode> edgeAllocator; // edges
         static const int MAXNODES = 100;    // max. number of graph nodes
         GraphNode node[MAXNODES];           // Graph nodes
         int dfsPath[MAXNODES];              // Depth-First Search path
@@ -6,6 +6,7 @@
  */
 
 #include "graphm.hpp"
+#include "../heaps/d_ary_heap.hpp"
 
 #include <limits.h>
 #include <sstream>
@@ -206,22 +207,37 @@ namespace dsa
     // findShortestPath
     // Calculates the shortest path between any two vertices within the Graph
     // by implementing Dijkstra's shortest path algorithm. 
+    // The vertices yet to be visited are kept in a 4-ary heap keyed by their
+    // distance (then by their index, so that ties are broken towards the lowest
+    // index), whose priorities are lowered in place as shorter paths are found.
     void GraphM::findShortestPath()
     {
         clearShortestPath();        // Clear previous data (if any)
 
+        d_ary_heap<std::pair<int, int>> frontier(size);
+
         // For each node in the graph, assess shortest path to all other vertices
         for (int fromNode = 0; fromNode < size; fromNode++)
         {
+            frontier.clear();
+            for (int toNode = 0; toNode < size; toNode++)
+            {
+                if (toNode != fromNode)
+                {
+                    frontier.push(toNode,
+                        std::make_pair(T[fromNode][toNode].dist, toNode));
+                }
+            }
+
             // As all paths are un-optimized, we visit the other nodes one by one
             // and we mark them as "visited". The nodes are visited in increasing
             // order of their distance to current node (i.e. "fromNode").
-            for (int pass = size - 1; pass >= 0; pass--)
+            while (!frontier.empty())
             {
                 // Find vertex within the smallest distance from current node
-                int toNode = findNode(fromNode);
+                int toNode = static_cast<int>(frontier.pop().handle);
 
-                if ((toNode < 0) || (T[fromNode][toNode].dist >= MAX_COST_PATH))
+                if (T[fromNode][toNode].dist >= MAX_COST_PATH)
                 {
                     // All remaining vertices are inaccessible from current node
                     break;
@@ -252,6 +268,8 @@ namespace dsa
                             T[fromNode][nextNode].dist = dist;
                             T[fromNode][nextNode].path =
                                 (path >= 0) ? path : toNode;
+                            frontier.decrease_key(nextNode,
+                                std::make_pair(dist, nextNode));
                         }
                     }
                 }
@@ -375,32 +393,6 @@ namespace dsa
         }
     }
 
-    //---------------------------------------------------------------------------
-    // findNode
-    // Helper method that locates and returns the node within the shortest
-    // distance from a reference node and not marked as "visited".
-    int GraphM::findNode(int fromNode) const
-    {
-        int nextNode = -1;
-
-        if ((fromNode >= 0) && (fromNode < size))
-        {
-            for (int toNode = 0; toNode < size; toNode++)
-            {
-                if ((toNode != fromNode) && !T[fromNode][toNode].visited)
-                {
-                    if ((nextNode < 0) ||
-                        (T[fromNode][toNode].dist < T[fromNode][nextNode].dist))
-                    {
-                        nextNode = toNode;
-                    }
-                }
-            }
-        }
-
-        return nextNode;
-    }
-
     //---------------------------------------------------------------------------
     // displayPath
     // Helper method for displaying the shortest path between two vertices
@@ -43,7 +43,6 @@ namespace dsa
         // Helper methods
         void initGraph();
         void clearShortestPath();
-        int findNode(int fromNode) const;
         void displayPath(int fromNode, int toNode) const;
         void displayPathDistance(int fromNode, int toNode) const;
 
@@ -1,21 +1,369 @@
 /**
- * Daniel Sebastian Iliescu
+ * Daniel Sebastian Iliescu, http://dansil.net
+ * MIT License (MIT), http://opensource.org/licenses/MIT
  *
- * An implementation of the Queue (FIFO) data structure.
+ * A hash table mapping keys to values, using open addressing with linear probing.
+ *
+ * The slots are kept in a single array, so a lookup is usually one or two cache misses. The
+ * hash of each key is stored next to it, which avoids most key comparisons and rehashing when
+ * the table grows. The hash is scrambled by a multiplicative (Fibonacci) step, so weak hashes
+ * such as the identity hash of integers do not cluster. Erasure shifts the following entries
+ * back instead of leaving tombstones, so probe sequences never degrade.
+ *
+ * The table grows by doubling once it is 7/8 full. Pointers to values remain valid until the
+ * table grows or the entry (or an entry before it in its probe sequence) is erased. The slot
+ * array is allocated through the given allocator, which is propagated as by std::vector.
  */
 
 #pragma once
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
 namespace dsa
 {
-    template < typename T >
-    class HashTable
-    {
-    public:
-        HashTable();
-        ~HashTable();
-
-    private:
-        void hashFunction();
-    };
+	template <
+		typename Key,
+		typename Value,
+		typename Hash = std::hash< Key >,
+		typename KeyEqual = std::equal_to< Key >,
+		typename Allocator = std::allocator< std::pair< const Key, Value > > >
+	class HashTable
+	{
+		struct table_entry
+		{
+			template < typename... Args >
+			table_entry(
+				const std::size_t input_hash,
+				Key input_key,
+				Args&&... args ) :
+				hash( input_hash ),
+				key( std::move( input_key ) ),
+				value( std::forward< Args >( args )... )
+			{
+			}
+
+			std::size_t hash;
+			Key key;
+			Value value;
+		};
+
+		using table_slot = std::optional< table_entry >;
+
+	public:
+		using key_type = Key;
+		using mapped_type = Value;
+		using size_type = std::size_t;
+		using hasher = Hash;
+		using key_equal = KeyEqual;
+		using allocator_type = typename std::allocator_traits< Allocator >::template rebind_alloc< table_slot >;
+
+		HashTable() = default;
+
+		explicit HashTable( const allocator_type& input_allocator ) :
+			slots( input_allocator )
+		{
+		}
+
+		explicit HashTable(
+			const size_type minimum_capacity,
+			Hash input_hash = Hash(),
+			KeyEqual input_equal = KeyEqual(),
+			const allocator_type& input_allocator = allocator_type() ) :
+			hash( std::move( input_hash ) ),
+			equal( std::move( input_equal ) ),
+			slots( input_allocator )
+		{
+			this->reserve( minimum_capacity );
+		}
+
+		~HashTable() noexcept = default;
+
+		HashTable( const HashTable& ) = default;
+		HashTable( HashTable&& ) noexcept = default;
+
+		// Move assignment only throws if the allocators neither propagate nor compare equal.
+		HashTable& operator=( const HashTable& ) = default;
+		HashTable& operator=( HashTable&& ) = default;
+
+		allocator_type
+		get_allocator() const
+		{
+			return this->slots.get_allocator();
+		}
+
+		/**
+		 * Lookup
+		 */
+
+		// Returns a pointer to the value of the key, or a null pointer if it is absent.
+		Value*
+		find( const Key& key ) noexcept
+		{
+			const auto slot = this->locate( key );
+
+			return ( slot == NOT_FOUND ) ? nullptr : &this->slots[ slot ]->value;
+		}
+
+		const Value*
+		find( const Key& key ) const noexcept
+		{
+			const auto slot = this->locate( key );
+
+			return ( slot == NOT_FOUND ) ? nullptr : &this->slots[ slot ]->value;
+		}
+
+		bool
+		contains( const Key& key ) const noexcept
+		{
+			return ( this->locate( key ) != NOT_FOUND );
+		}
+
+		/**
+		 * Modifiers
+		 */
+
+		/**
+		 * Inserts the key with a value constructed from the arguments, unless the key is already
+		 * present. Returns a pointer to the value of the key and whether it was inserted.
+		 */
+		template < typename... Args >
+		std::pair< Value*, bool >
+		try_emplace(
+			const Key& key,
+			Args&&... args )
+		{
+			if ( ( this->entries + 1 ) * LOAD_DENOMINATOR > this->slots.size() * LOAD_NUMERATOR )
+			{
+				this->rehash( std::max< size_type >( MINIMUM_CAPACITY, 2 * this->slots.size() ) );
+			}
+
+			const auto key_hash = this->hash( key );
+			auto slot = this->home( key_hash );
+
+			while ( this->slots[ slot ] )
+			{
+				if ( ( this->slots[ slot ]->hash == key_hash ) && this->equal( this->slots[ slot ]->key, key ) )
+				{
+					return { &this->slots[ slot ]->value, false };
+				}
+
+				slot = ( slot + 1 ) & this->mask();
+			}
+
+			this->slots[ slot ].emplace( key_hash, key, std::forward< Args >( args )... );
+			++( this->entries );
+
+			return { &this->slots[ slot ]->value, true };
+		}
+
+		template < typename V >
+		std::pair< Value*, bool >
+		insert_or_assign(
+			const Key& key,
+			V&& value )
+		{
+			auto result = this->try_emplace( key, std::forward< V >( value ) );
+
+			if ( !result.second )
+			{
+				*result.first = std::forward< V >( value );
+			}
+
+			return result;
+		}
+
+		Value&
+		operator[]( const Key& key )
+		{
+			return *this->try_emplace( key ).first;
+		}
+
+		// Removes the key; returns whether it was present.
+		bool
+		erase( const Key& key )
+		{
+			auto hole = this->locate( key );
+
+			if ( hole == NOT_FOUND )
+			{
+				return false;
+			}
+
+			this->slots[ hole ].reset();
+			--( this->entries );
+
+			// Shift back the following entries which may no longer be reachable through the hole.
+			for ( auto slot = ( hole + 1 ) & this->mask(); this->slots[ slot ]; slot = ( slot + 1 ) & this->mask() )
+			{
+				const auto distance = ( slot - this->home( this->slots[ slot ]->hash ) ) & this->mask();
+
+				if ( distance >= ( ( slot - hole ) & this->mask() ) )
+				{
+					this->slots[ hole ].emplace( std::move( *this->slots[ slot ] ) );
+					this->slots[ slot ].reset();
+
+					hole = slot;
+				}
+			}
+
+			return true;
+		}
+
+		void
+		clear() noexcept
+		{
+			for ( auto& slot : this->slots )
+			{
+				slot.reset();
+			}
+
+			this->entries = 0;
+		}
+
+		// Grows the table so that it holds at least the given number of entries without growing.
+		void
+		reserve( const size_type count )
+		{
+			auto capacity = std::max( MINIMUM_CAPACITY, this->slots.size() );
+
+			while ( count * LOAD_DENOMINATOR > capacity * LOAD_NUMERATOR )
+			{
+				capacity <<= 1;
+			}
+
+			if ( capacity != this->slots.size() )
+			{
+				this->rehash( capacity );
+			}
+		}
+
+		/**
+		 * Capacity
+		 */
+
+		bool
+		empty() const noexcept
+		{
+			return ( this->entries == 0 );
+		}
+
+		size_type
+		size() const noexcept
+		{
+			return this->entries;
+		}
+
+		// Number of slots, which is a power of two.
+		size_type
+		capacity() const noexcept
+		{
+			return this->slots.size();
+		}
+
+		/**
+		 * Iteration
+		 */
+
+		// Calls the function with the key and value of every entry, in no particular order.
+		template < typename Function >
+		void
+		for_each( Function function )
+		{
+			for ( auto& slot : this->slots )
+			{
+				if ( slot )
+				{
+					function( static_cast< const Key& >( slot->key ), slot->value );
+				}
+			}
+		}
+
+	private:
+		static constexpr size_type NOT_FOUND = static_cast< size_type >( -1 );
+		static constexpr size_type MINIMUM_CAPACITY = 8;
+		static constexpr size_type LOAD_NUMERATOR = 7;
+		static constexpr size_type LOAD_DENOMINATOR = 8;
+
+		size_type
+		mask() const noexcept
+		{
+			return this->slots.size() - 1;
+		}
+
+		// First slot of the probe sequence of the given hash, taken from the high bits of its product.
+		size_type
+		home( const std::size_t key_hash ) const noexcept
+		{
+			const auto scrambled = static_cast< std::uint64_t >( key_hash ) * 0x9E3779B97F4A7C15ULL;
+
+			return static_cast< size_type >( scrambled >> this->shift );
+		}
+
+		size_type
+		locate( const Key& key ) const noexcept
+		{
+			if ( this->entries == 0 )
+			{
+				return NOT_FOUND;
+			}
+
+			const auto key_hash = this->hash( key );
+
+			for ( auto slot = this->home( key_hash ); this->slots[ slot ]; slot = ( slot + 1 ) & this->mask() )
+			{
+				if ( ( this->slots[ slot ]->hash == key_hash ) && this->equal( this->slots[ slot ]->key, key ) )
+				{
+					return slot;
+				}
+			}
+
+			return NOT_FOUND;
+		}
+
+		void
+		rehash( const size_type capacity )
+		{
+			std::vector< table_slot, allocator_type > old_slots( capacity, this->slots.get_allocator() );
+			old_slots.swap( this->slots );
+
+			this->shift = 64;
+
+			for ( auto size = capacity; size > 1; size >>= 1 )
+			{
+				--( this->shift );
+			}
+
+			for ( auto& old_slot : old_slots )
+			{
+				if ( old_slot )
+				{
+					auto slot = this->home( old_slot->hash );
+
+					while ( this->slots[ slot ] )
+					{
+						slot = ( slot + 1 ) & this->mask();
+					}
+
+					this->slots[ slot ].emplace( std::move( *old_slot ) );
+				}
+			}
+		}
+
+		Hash hash;
+		KeyEqual equal;
+
+		std::vector< table_slot, allocator_type > slots;
+
+		// Number of bits dropped from the scrambled hash, so that the rest index the slots.
+		unsigned shift = 64;
+
+		size_type entries = 0;
+	};
 }
\ No newline at end of file
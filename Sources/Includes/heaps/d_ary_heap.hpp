@@ -0,0 +1,369 @@
+/**
+ * Daniel Sebastian Iliescu, http://dansil.net
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ *
+ * An implicit d-ary min-heap of (priority, handle) entries supporting decrease_key.
+ *
+ * Handles are small integers naming the elements (e.g. vertex indices), and a position index
+ * maps every handle to its entry, so the priority of an element already in the heap can be
+ * lowered in O(log n) without searching for it. The heap is a min-heap with respect to Compare:
+ * top() is an entry whose priority no other entry compares less than.
+ *
+ * With the default arity of 4 the heap is half as deep as a binary heap, and a sift down compares
+ * the four children of a node, which are adjacent. The array is cache line aligned and offset by
+ * Arity - 1 entries, so that every group of siblings starts at a multiple of Arity entries and does
+ * not straddle two lines when Arity entries fit in one. The padding entries are default constructed.
+ * The array and the position index are allocated through (rebound copies of) the given allocator;
+ * the alignment only holds for allocators providing it, as the default aligned_allocator does.
+ */
+
+#pragma once
+
+#include "memory/aligned_allocator.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace dsa
+{
+	template <
+		typename Priority,
+		std::size_t Arity = 4,
+		typename Compare = std::less< Priority >,
+		typename Allocator = aligned_allocator< Priority > >
+	class d_ary_heap
+	{
+		static_assert( Arity >= 2, "A node must have at least two children." );
+
+	public:
+		using handle_type = std::uint32_t;
+
+		struct heap_entry
+		{
+			Priority priority;
+			handle_type handle;
+		};
+
+		using value_type = heap_entry;
+		using size_type = std::size_t;
+		using reference = value_type&;
+		using const_reference = const value_type&;
+		using allocator_type = typename std::allocator_traits< Allocator >::template rebind_alloc< heap_entry >;
+
+		d_ary_heap() :
+			d_ary_heap( 0 )
+		{
+		}
+
+		explicit d_ary_heap( const allocator_type& input_allocator ) :
+			d_ary_heap( 0, Compare(), input_allocator )
+		{
+		}
+
+		// Sizes the position index for the handles [0, handles); larger handles grow it on demand.
+		explicit d_ary_heap(
+			const size_type handles,
+			Compare input_compare = Compare(),
+			const allocator_type& input_allocator = allocator_type() ) :
+			entries( PADDING, input_allocator ),
+			positions( handles, ABSENT, position_allocator( input_allocator ) ),
+			compare( std::move( input_compare ) )
+		{
+		}
+
+		~d_ary_heap() noexcept = default;
+
+		d_ary_heap( const d_ary_heap& ) = default;
+
+		// The source keeps its padding entries, so it is left as an empty heap.
+		d_ary_heap( d_ary_heap&& other ) :
+			entries( std::exchange( other.entries, entry_vector( PADDING, other.entries.get_allocator() ) ) ),
+			positions( std::move( other.positions ) ),
+			compare( std::move( other.compare ) )
+		{
+			other.positions.clear();
+		}
+
+		d_ary_heap& operator=( const d_ary_heap& ) = default;
+
+		/**
+		 * The source takes the entries of this heap, which it then clears, unless the allocators can
+		 * neither be swapped nor compare equal, in which case the entries are moved one by one.
+		 */
+		d_ary_heap&
+		operator=( d_ary_heap&& rhs ) noexcept( SWAPS_STORAGE )
+		{
+			if constexpr ( !SWAPS_STORAGE )
+			{
+				if ( this->entries.get_allocator() != rhs.entries.get_allocator() )
+				{
+					this->entries = std::move( rhs.entries );
+					this->positions = std::move( rhs.positions );
+					this->compare = std::move( rhs.compare );
+
+					rhs.entries.assign( PADDING, heap_entry() );
+					rhs.positions.clear();
+
+					return *this;
+				}
+			}
+
+			using std::swap;
+
+			swap( this->entries, rhs.entries );
+			swap( this->positions, rhs.positions );
+			swap( this->compare, rhs.compare );
+
+			rhs.clear();
+
+			return *this;
+		}
+
+		allocator_type
+		get_allocator() const
+		{
+			return this->entries.get_allocator();
+		}
+
+		/**
+		 * Element access
+		 */
+
+		const_reference
+		top() const noexcept
+		{
+			return this->entries[ PADDING ];
+		}
+
+		bool
+		contains( const handle_type handle ) const noexcept
+		{
+			return ( handle < this->positions.size() ) && ( this->positions[ handle ] != ABSENT );
+		}
+
+		// Priority of a handle in the heap.
+		const Priority&
+		priority( const handle_type handle ) const noexcept
+		{
+			return this->at( this->positions[ handle ] ).priority;
+		}
+
+		/**
+		 * Modifiers
+		 */
+
+		// Adds the handle with the given priority; returns false (leaving the heap unchanged) if it is already in the heap.
+		bool
+		push(
+			const handle_type handle,
+			Priority priority )
+		{
+			if ( this->contains( handle ) )
+			{
+				return false;
+			}
+
+			if ( handle >= this->positions.size() )
+			{
+				this->positions.resize( static_cast< size_type >( handle ) + 1, ABSENT );
+			}
+
+			this->entries.push_back( heap_entry { std::move( priority ), handle } );
+			this->sift_up( static_cast< handle_type >( this->size() - 1 ) );
+
+			return true;
+		}
+
+		// Lowers the priority of a handle in the heap; the new priority must not compare greater than the current one.
+		void
+		decrease_key(
+			const handle_type handle,
+			Priority priority )
+		{
+			const auto position = this->positions[ handle ];
+
+			this->at( position ).priority = std::move( priority );
+			this->sift_up( position );
+		}
+
+		/**
+		 * Adds the handle, or lowers its priority if it is in the heap with a greater one, which is the
+		 * relaxation step of Dijkstra's algorithm. Returns whether the heap was changed.
+		 */
+		bool
+		push_or_decrease(
+			const handle_type handle,
+			Priority priority )
+		{
+			if ( !this->contains( handle ) )
+			{
+				return this->push( handle, std::move( priority ) );
+			}
+
+			if ( !this->compare( priority, this->priority( handle ) ) )
+			{
+				return false;
+			}
+
+			this->decrease_key( handle, std::move( priority ) );
+
+			return true;
+		}
+
+		// Removes and returns the top entry; the heap must not be empty.
+		value_type
+		pop()
+		{
+			auto entry = std::move( this->at( 0 ) );
+			this->positions[ entry.handle ] = ABSENT;
+
+			if ( this->size() > 1 )
+			{
+				this->at( 0 ) = std::move( this->entries.back() );
+				this->entries.pop_back();
+				this->sift_down( 0 );
+			}
+			else
+			{
+				this->entries.pop_back();
+			}
+
+			return entry;
+		}
+
+		void
+		clear() noexcept
+		{
+			for ( auto entry = this->entries.cbegin() + PADDING; entry != this->entries.cend(); ++entry )
+			{
+				this->positions[ entry->handle ] = ABSENT;
+			}
+
+			this->entries.erase( this->entries.cbegin() + PADDING, this->entries.cend() );
+		}
+
+		void
+		reserve( const size_type capacity )
+		{
+			this->entries.reserve( capacity + PADDING );
+		}
+
+		bool
+		empty() const noexcept
+		{
+			return ( this->size() == 0 );
+		}
+
+		size_type
+		size() const noexcept
+		{
+			return this->entries.size() - PADDING;
+		}
+
+	private:
+		using entry_vector = std::vector< heap_entry, allocator_type >;
+		using position_allocator = typename std::allocator_traits< Allocator >::template rebind_alloc< handle_type >;
+
+		// Whether the vectors can always be swapped, i.e. their allocators are swapped along or interchangeable.
+		static constexpr bool SWAPS_STORAGE =
+			std::allocator_traits< allocator_type >::propagate_on_container_swap::value ||
+			std::allocator_traits< allocator_type >::is_always_equal::value;
+
+		static constexpr size_type PADDING = Arity - 1;
+		static constexpr handle_type ABSENT = std::numeric_limits< handle_type >::max();
+
+		heap_entry&
+		at( const size_type position ) noexcept
+		{
+			return this->entries[ PADDING + position ];
+		}
+
+		const heap_entry&
+		at( const size_type position ) const noexcept
+		{
+			return this->entries[ PADDING + position ];
+		}
+
+		// Moves the entry at the given position up to its place, shifting the parents passed over down.
+		void
+		sift_up( handle_type position )
+		{
+			auto entry = std::move( this->at( position ) );
+
+			while ( position > 0 )
+			{
+				const auto parent = static_cast< handle_type >( ( position - 1 ) / Arity );
+
+				if ( !this->compare( entry.priority, this->at( parent ).priority ) )
+				{
+					break;
+				}
+
+				this->place( position, std::move( this->at( parent ) ) );
+				position = parent;
+			}
+
+			this->place( position, std::move( entry ) );
+		}
+
+		void
+		sift_down( handle_type position )
+		{
+			const auto count = this->size();
+			auto entry = std::move( this->at( position ) );
+
+			while ( true )
+			{
+				const auto first_child = Arity * position + 1;
+
+				if ( first_child >= count )
+				{
+					break;
+				}
+
+				const auto last_child = std::min( first_child + Arity, count );
+				auto best_child = first_child;
+
+				for ( auto child = first_child + 1; child < last_child; ++child )
+				{
+					if ( this->compare( this->at( child ).priority, this->at( best_child ).priority ) )
+					{
+						best_child = child;
+					}
+				}
+
+				if ( !this->compare( this->at( best_child ).priority, entry.priority ) )
+				{
+					break;
+				}
+
+				this->place( position, std::move( this->at( best_child ) ) );
+				position = static_cast< handle_type >( best_child );
+			}
+
+			this->place( position, std::move( entry ) );
+		}
+
+		void
+		place(
+			const handle_type position,
+			heap_entry&& entry )
+		{
+			this->positions[ entry.handle ] = position;
+			this->at( position ) = std::move( entry );
+		}
+
+		entry_vector entries;
+
+		// Position in the heap of every handle, or ABSENT.
+		std::vector< handle_type, position_allocator > positions;
+
+		Compare compare;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,254 @@
+/**
+ * Daniel Sebastian Iliescu, http://dansil.net
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ *
+ * A concurrent relaxed min-priority queue (MultiQueue, Rihani, Sanders and Dementiev, 2015).
+ *
+ * The elements are spread over c·P sequential binary heaps, P being the number of threads, each
+ * behind its own lock and on its own cache lines. push adds to a random heap. pop samples two random
+ * heaps and removes the better of their tops, so it returns one of the smallest elements rather than
+ * the smallest one: the rank error is O(c·P) in expectation. Locks are only ever tried, and another
+ * pair of heaps is drawn when one is held, so threads neither wait for each other nor serialize on a
+ * common lock.
+ *
+ * pop reports whether an element was removed, since another thread may empty the queue at any time,
+ * and only returns false once every heap was observed empty. size() and empty() are snapshots.
+ */
+
+#pragma once
+
+#include "memory/cache_line.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace dsa
+{
+	template <
+		typename T,
+		typename Compare = std::less< T > >
+	class multiqueue
+	{
+		struct alignas( cache_line_size ) queue_shard
+		{
+			std::mutex mutex;
+
+			// Binary heap ordered by the reversed comparison, so that its front is the smallest element.
+			std::vector< T > heap;
+
+			// Number of elements, readable without the lock.
+			std::atomic< std::size_t > count { 0 };
+		};
+
+	public:
+		using value_type = T;
+		using size_type = std::size_t;
+		using reference = value_type&;
+		using const_reference = const value_type&;
+
+		static constexpr size_type DEFAULT_QUEUES_PER_THREAD = 2;
+
+		explicit multiqueue(
+			const size_type threads = std::thread::hardware_concurrency(),
+			const size_type queues_per_thread = DEFAULT_QUEUES_PER_THREAD,
+			Compare input_compare = Compare() ) :
+			compare( std::move( input_compare ) )
+		{
+			// Two queues at least, so that pop always has a choice.
+			const auto queue_count = std::max< size_type >( 2, threads * queues_per_thread );
+
+			this->queues.reserve( queue_count );
+
+			for ( size_type queue = 0; queue < queue_count; ++queue )
+			{
+				this->queues.push_back( std::make_unique< queue_shard >() );
+			}
+		}
+
+		~multiqueue() noexcept = default;
+
+		multiqueue( const multiqueue& ) = delete;
+		multiqueue( multiqueue&& ) = delete;
+
+		multiqueue& operator=( const multiqueue& ) = delete;
+		multiqueue& operator=( multiqueue&& ) = delete;
+
+		/**
+		 * Modifiers
+		 */
+
+		void
+		push( const T& item )
+		{
+			this->emplace( item );
+		}
+
+		void
+		push( T&& item )
+		{
+			this->emplace( std::move( item ) );
+		}
+
+		template < typename... Args >
+		void
+		emplace( Args&&... args )
+		{
+			while ( true )
+			{
+				auto& queue = *this->queues[ this->random_index( this->queues.size() ) ];
+				std::unique_lock< std::mutex > lock( queue.mutex, std::try_to_lock );
+
+				if ( lock.owns_lock() )
+				{
+					queue.heap.emplace_back( std::forward< Args >( args )... );
+					std::push_heap( std::begin( queue.heap ), std::end( queue.heap ), this->heap_order() );
+
+					queue.count.store( queue.heap.size(), std::memory_order_relaxed );
+
+					return;
+				}
+			}
+		}
+
+		// Moves one of the smallest elements into the argument; returns false if the queue was empty.
+		bool
+		pop( T& item )
+		{
+			size_type empty_samples = 0;
+
+			while ( true )
+			{
+				// Two distinct heaps.
+				const auto first_index = this->random_index( this->queues.size() );
+				const auto second_index = ( first_index + 1 + this->random_index( this->queues.size() - 1 ) ) % this->queues.size();
+
+				auto first = this->queues[ first_index ].get();
+				auto second = this->queues[ second_index ].get();
+
+				if ( ( first->count.load( std::memory_order_relaxed ) == 0 ) &&
+					 ( second->count.load( std::memory_order_relaxed ) == 0 ) )
+				{
+					// Only scan every heap once the samples keep coming up empty.
+					if ( ++empty_samples >= this->queues.size() )
+					{
+						if ( this->empty() )
+						{
+							return false;
+						}
+
+						empty_samples = 0;
+					}
+
+					continue;
+				}
+
+				std::unique_lock< std::mutex > first_lock( first->mutex, std::try_to_lock );
+
+				if ( !first_lock.owns_lock() )
+				{
+					continue;
+				}
+
+				std::unique_lock< std::mutex > second_lock( second->mutex, std::try_to_lock );
+
+				if ( !second_lock.owns_lock() )
+				{
+					continue;
+				}
+
+				// Pop from the heap with the better top.
+				if ( first->heap.empty() ||
+					 ( !second->heap.empty() && this->compare( second->heap.front(), first->heap.front() ) ) )
+				{
+					std::swap( first, second );
+					std::swap( first_lock, second_lock );
+				}
+
+				if ( first->heap.empty() )
+				{
+					continue;
+				}
+
+				// The heap which is not popped from is released right away.
+				second_lock.unlock();
+
+				std::pop_heap( std::begin( first->heap ), std::end( first->heap ), this->heap_order() );
+				item = std::move( first->heap.back() );
+				first->heap.pop_back();
+
+				first->count.store( first->heap.size(), std::memory_order_relaxed );
+
+				return true;
+			}
+		}
+
+		bool
+		empty() const noexcept
+		{
+			return std::all_of(
+				std::cbegin( this->queues ),
+				std::cend( this->queues ),
+				[]( const std::unique_ptr< queue_shard >& queue )
+				{
+					return ( queue->count.load( std::memory_order_relaxed ) == 0 );
+				} );
+		}
+
+		size_type
+		size() const noexcept
+		{
+			size_type items = 0;
+
+			for ( const auto& queue : this->queues )
+			{
+				items += queue->count.load( std::memory_order_relaxed );
+			}
+
+			return items;
+		}
+
+		size_type
+		queue_count() const noexcept
+		{
+			return this->queues.size();
+		}
+
+	private:
+		auto
+		heap_order() const
+		{
+			return [this]( const T& first, const T& second )
+			{
+				return this->compare( second, first );
+			};
+		}
+
+		// Draws an index below the bound with a per-thread SplitMix64 generator, so that threads share no random state.
+		static size_type
+		random_index( const size_type bound ) noexcept
+		{
+			thread_local std::uint64_t state = std::hash< std::thread::id >()( std::this_thread::get_id() );
+
+			state += 0x9E3779B97F4A7C15ULL;
+
+			auto z = state;
+			z = ( z ^ ( z >> 30 ) ) * 0xBF58476D1CE4E5B9ULL;
+			z = ( z ^ ( z >> 27 ) ) * 0x94D049BB133111EBULL;
+			z ^= z >> 31;
+
+			return static_cast< size_type >( z % bound );
+		}
+
+		std::vector< std::unique_ptr< queue_shard > > queues;
+
+		Compare compare;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,448 @@
+/**
+ * Daniel Sebastian Iliescu, http://dansil.net
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ *
+ * A pairing min-heap (Fredman, Sedgewick, Sleator and Tarjan, 1986).
+ *
+ * The heap is a multiway tree whose root is the top element. Every node links to its leftmost
+ * child and to its next sibling, and back to its previous sibling (or to its parent when it is
+ * the leftmost child), which is enough to cut a subtree out in constant time.
+ *
+ * Pushing and melding two heaps link two roots and operate in constant time. Popping combines
+ * the children of the root in two passes (pairing them left to right, then linking the pairs right
+ * to left) in O(log n) amortized time. decrease_key cuts the subtree of the element and links it
+ * to the root. push returns a handle to the element, which stays valid until it is popped.
+ *
+ * The heap is a min-heap with respect to Compare: top() is an element no other element compares
+ * less than. top() and pop() require a non-empty heap.
+ */
+
+#pragma once
+
+#include "memory/allocator_propagation.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <utility>
+
+namespace dsa
+{
+	template <
+		typename T,
+		typename Compare = std::less< T >,
+		typename Allocator = std::allocator< T > >
+	class pairing_heap
+	{
+		struct pairing_node
+		{
+			template < typename... Args >
+			explicit pairing_node(
+				std::in_place_t,
+				Args&&... args ) :
+				item( std::forward< Args >( args )... )
+			{
+			}
+
+			T item;
+
+			pairing_node* child = nullptr;
+			pairing_node* next = nullptr;
+
+			// Previous sibling, or the parent of the leftmost child.
+			pairing_node* previous = nullptr;
+		};
+
+	public:
+		// Refers to an element of the heap until it is popped.
+		class handle
+		{
+		public:
+			handle() noexcept = default;
+
+			const T&
+			operator*() const noexcept
+			{
+				return this->node->item;
+			}
+
+			const T*
+			operator->() const noexcept
+			{
+				return &this->node->item;
+			}
+
+			bool
+			operator==( const handle& rhs ) const noexcept
+			{
+				return ( this->node == rhs.node );
+			}
+
+			bool
+			operator!=( const handle& rhs ) const noexcept
+			{
+				return !( *this == rhs );
+			}
+
+		private:
+			friend class pairing_heap;
+
+			explicit handle( pairing_node* const input_node ) noexcept :
+				node( input_node )
+			{
+			}
+
+			pairing_node* node = nullptr;
+		};
+
+		using value_type = T;
+		using allocator_type = typename std::allocator_traits< Allocator >::template rebind_alloc< pairing_node >;
+		using size_type = std::size_t;
+		using reference = value_type&;
+		using const_reference = const value_type&;
+
+		pairing_heap() noexcept = default;
+
+		explicit pairing_heap( Compare input_compare ) :
+			compare( std::move( input_compare ) )
+		{
+		}
+
+		explicit pairing_heap( const allocator_type& input_allocator ) noexcept :
+			allocator( input_allocator )
+		{
+		}
+
+		pairing_heap(
+			Compare input_compare,
+			const allocator_type& input_allocator ) :
+			allocator( input_allocator ),
+			compare( std::move( input_compare ) )
+		{
+		}
+
+		~pairing_heap() noexcept
+		{
+			this->clear();
+		}
+
+		// Handles would not carry over to a copy.
+		pairing_heap( const pairing_heap& ) = delete;
+
+		pairing_heap( pairing_heap&& other ) noexcept :
+			allocator( std::move( other.allocator ) ),
+			compare( other.compare )
+		{
+			this->swap_nodes( other );
+		}
+
+		pairing_heap& operator=( const pairing_heap& ) = delete;
+
+		/**
+		 * Takes over the nodes of the source, unless its allocator neither propagates nor compares equal, in which
+		 * case its elements are moved into nodes of this heap instead, and the handles to them are invalidated.
+		 */
+		pairing_heap&
+		operator=( pairing_heap&& rhs ) noexcept( allocator_moves_storage_v< allocator_type > )
+		{
+			if constexpr ( !allocator_moves_storage_v< allocator_type > )
+			{
+				if ( this->allocator != rhs.allocator )
+				{
+					this->clear();
+
+					pairing_heap moved( rhs.compare, this->allocator );
+
+					while ( !rhs.empty() )
+					{
+						moved.push( rhs.pop() );
+					}
+
+					this->swap_nodes( moved );
+
+					return *this;
+				}
+			}
+
+			propagate_on_move_assignment( this->allocator, rhs.allocator );
+			this->swap_nodes( rhs );
+
+			return *this;
+		}
+
+		// The allocators of both heaps must compare equal, unless they propagate on swap.
+		friend void
+		swap( pairing_heap& first, pairing_heap& second ) noexcept
+		{
+			propagate_on_swap( first.allocator, second.allocator );
+			first.swap_nodes( second );
+		}
+
+		allocator_type
+		get_allocator() const
+		{
+			return this->allocator;
+		}
+
+		/**
+		 * Element access
+		 */
+
+		const_reference
+		top() const noexcept
+		{
+			return this->root->item;
+		}
+
+		/**
+		 * Modifiers
+		 */
+
+		handle
+		push( const T& item )
+		{
+			return this->emplace( item );
+		}
+
+		handle
+		push( T&& item )
+		{
+			return this->emplace( std::move( item ) );
+		}
+
+		template < typename... Args >
+		handle
+		emplace( Args&&... args )
+		{
+			auto node = std::allocator_traits< allocator_type >::allocate( this->allocator, 1 );
+
+			try
+			{
+				std::allocator_traits< allocator_type >::construct( this->allocator, node, std::in_place, std::forward< Args >( args )... );
+			}
+			catch ( ... )
+			{
+				std::allocator_traits< allocator_type >::deallocate( this->allocator, node, 1 );
+				throw;
+			}
+
+			this->root = this->root ? this->link( this->root, node ) : node;
+			++( this->nodes );
+
+			return handle( node );
+		}
+
+		T
+		pop()
+		{
+			const auto node = this->root;
+
+			this->root = node->child ? this->merge_pairs( node->child ) : nullptr;
+			--( this->nodes );
+
+			auto item = std::move( node->item );
+
+			this->destroy_node( node );
+
+			return item;
+		}
+
+		// Replaces the element of the handle by one which must not compare greater than it.
+		void
+		decrease_key(
+			const handle position,
+			T item )
+		{
+			const auto node = position.node;
+
+			node->item = std::move( item );
+
+			if ( node != this->root )
+			{
+				this->cut( node );
+				this->root = this->link( this->root, node );
+			}
+		}
+
+		/**
+		 * Moves every element of the other heap into this one, leaving it empty. Handles to the elements
+		 * of the other heap remain valid. The allocators of both heaps must compare equal.
+		 */
+		void
+		meld( pairing_heap& other ) noexcept
+		{
+			if ( ( &other == this ) || !other.root )
+			{
+				return;
+			}
+
+			this->root = this->root ? this->link( this->root, other.root ) : other.root;
+			this->nodes += other.nodes;
+
+			other.root = nullptr;
+			other.nodes = 0;
+		}
+
+		void
+		clear() noexcept
+		{
+			// Nodes waiting to be destroyed are chained through their next links, the children of a node joining the chain.
+			auto pending = this->root;
+
+			while ( pending )
+			{
+				const auto node = pending;
+				pending = node->next;
+
+				if ( auto child = node->child )
+				{
+					while ( child->next )
+					{
+						child = child->next;
+					}
+
+					child->next = pending;
+					pending = node->child;
+				}
+
+				this->destroy_node( node );
+			}
+
+			this->root = nullptr;
+			this->nodes = 0;
+		}
+
+		bool
+		empty() const noexcept
+		{
+			return ( this->nodes == 0 );
+		}
+
+		size_type
+		size() const noexcept
+		{
+			return this->nodes;
+		}
+
+	private:
+		void
+		destroy_node( pairing_node* const node ) noexcept
+		{
+			std::allocator_traits< allocator_type >::destroy( this->allocator, node );
+			std::allocator_traits< allocator_type >::deallocate( this->allocator, node, 1 );
+		}
+
+		// Makes the root with the greater element the leftmost child of the other, which is returned.
+		pairing_node*
+		link(
+			pairing_node* first,
+			pairing_node* second ) noexcept
+		{
+			if ( this->compare( second->item, first->item ) )
+			{
+				std::swap( first, second );
+			}
+
+			second->previous = first;
+			second->next = first->child;
+
+			if ( first->child )
+			{
+				first->child->previous = second;
+			}
+
+			first->child = second;
+
+			return first;
+		}
+
+		// Detaches the subtree of a node which is not the root from its parent and siblings.
+		static void
+		cut( pairing_node* const node ) noexcept
+		{
+			if ( node->previous->child == node )
+			{
+				node->previous->child = node->next;
+			}
+			else
+			{
+				node->previous->next = node->next;
+			}
+
+			if ( node->next )
+			{
+				node->next->previous = node->previous;
+			}
+
+			node->previous = nullptr;
+			node->next = nullptr;
+		}
+
+		// Combines a chain of siblings into a single tree and returns its root.
+		pairing_node*
+		merge_pairs( pairing_node* first ) noexcept
+		{
+			// Left to right, link the siblings two by two, stacking the results through their next links.
+			pairing_node* pairs = nullptr;
+
+			while ( first )
+			{
+				const auto left = first;
+				const auto right = left->next;
+
+				if ( !right )
+				{
+					left->next = pairs;
+					pairs = left;
+
+					break;
+				}
+
+				first = right->next;
+
+				left->previous = left->next = nullptr;
+				right->previous = right->next = nullptr;
+
+				const auto pair = this->link( left, right );
+				pair->next = pairs;
+				pairs = pair;
+			}
+
+			// Right to left, link every pair into the accumulated tree.
+			auto result = pairs;
+			pairs = pairs->next;
+
+			while ( pairs )
+			{
+				const auto pair = pairs;
+				pairs = pairs->next;
+
+				pair->next = nullptr;
+				result->next = nullptr;
+				result = this->link( result, pair );
+			}
+
+			result->previous = nullptr;
+			result->next = nullptr;
+
+			return result;
+		}
+
+		// Exchanges the elements and the comparison of both heaps.
+		void
+		swap_nodes( pairing_heap& other ) noexcept
+		{
+			using std::swap;
+
+			swap( this->compare, other.compare );
+			swap( this->root, other.root );
+			swap( this->nodes, other.nodes );
+		}
+
+		allocator_type allocator;
+		Compare compare;
+
+		pairing_node* root = nullptr;
+		size_type nodes = 0;
+	};
+}
\ No newline at end of file
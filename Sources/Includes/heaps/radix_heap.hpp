@@ -0,0 +1,270 @@
+/**
+ * Daniel Sebastian Iliescu, http://dansil.net
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ *
+ * A monotone radix heap (Ahuja, Mehlhorn, Orlin and Tarjan, 1990) for unsigned integer keys.
+ *
+ * The heap is monotone: every pushed key must not be less than the last popped key, which holds for
+ * the tentative distances of Dijkstra's algorithm and for event times in a simulation. An entry is kept
+ * in the bucket given by the highest bit in which its key differs from the last popped key, so bucket 0
+ * holds the entries whose key equals it. When bucket 0 runs out, the first non-empty bucket is emptied
+ * into the lower buckets relative to its minimum key. Since an entry only ever moves to a lower bucket,
+ * a pop costs O(log C) amortized for keys spanning a range of C, with no comparisons between values.
+ *
+ * The buckets are allocated through (copies of) the given allocator.
+ *
+ * top() and pop() require a non-empty heap.
+ */
+
+#pragma once
+
+#include "memory/allocator_propagation.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace dsa
+{
+	template <
+		typename Key,
+		typename Value,
+		typename Allocator = std::allocator< std::pair< Key, Value > > >
+	class radix_heap
+	{
+		static_assert( std::is_unsigned< Key >::value, "The keys must be unsigned integers." );
+
+		static constexpr std::size_t BUCKETS = std::numeric_limits< Key >::digits + 1;
+
+	public:
+		using key_type = Key;
+		using mapped_type = Value;
+		using value_type = std::pair< Key, Value >;
+		using size_type = std::size_t;
+		using reference = value_type&;
+		using const_reference = const value_type&;
+		using allocator_type = typename std::allocator_traits< Allocator >::template rebind_alloc< value_type >;
+
+		radix_heap() = default;
+
+		explicit radix_heap( const allocator_type& input_allocator ) :
+			buckets( make_buckets( input_allocator, std::make_index_sequence< BUCKETS >() ) )
+		{
+		}
+
+		~radix_heap() noexcept = default;
+
+		radix_heap( const radix_heap& ) = default;
+
+		// The source is left as an empty heap.
+		radix_heap( radix_heap&& other ) noexcept :
+			buckets( std::move( other.buckets ) ),
+			last( std::exchange( other.last, 0 ) ),
+			entries( std::exchange( other.entries, 0 ) )
+		{
+			other.clear();
+		}
+
+		radix_heap& operator=( const radix_heap& ) = default;
+
+		// Only throws if the allocators neither propagate nor compare equal; the source is then left empty as well.
+		radix_heap&
+		operator=( radix_heap&& rhs ) noexcept( allocator_moves_storage_v< allocator_type > )
+		{
+			if ( this != &rhs )
+			{
+				this->buckets = std::move( rhs.buckets );
+				this->last = std::exchange( rhs.last, 0 );
+				this->entries = std::exchange( rhs.entries, 0 );
+
+				rhs.clear();
+			}
+
+			return *this;
+		}
+
+		allocator_type
+		get_allocator() const
+		{
+			return this->buckets[ 0 ].get_allocator();
+		}
+
+		/**
+		 * Element access
+		 */
+
+		// Found in bucket 0, or else by a scan of the first non-empty bucket (which the next pop empties).
+		const_reference
+		top() const noexcept
+		{
+			if ( !this->buckets[ 0 ].empty() )
+			{
+				return this->buckets[ 0 ].back();
+			}
+
+			return *minimum( this->buckets[ this->first_bucket() ] );
+		}
+
+		// Last popped key, which pushed keys must not be less than.
+		key_type
+		last_key() const noexcept
+		{
+			return this->last;
+		}
+
+		/**
+		 * Modifiers
+		 */
+
+		void
+		push(
+			const Key key,
+			Value value )
+		{
+			this->emplace( key, std::move( value ) );
+		}
+
+		template < typename... Args >
+		void
+		emplace(
+			const Key key,
+			Args&&... args )
+		{
+			this->buckets[ this->bucket( key ) ].emplace_back(
+				std::piecewise_construct,
+				std::forward_as_tuple( key ),
+				std::forward_as_tuple( std::forward< Args >( args )... ) );
+
+			++( this->entries );
+		}
+
+		value_type
+		pop()
+		{
+			if ( this->buckets[ 0 ].empty() )
+			{
+				this->redistribute();
+			}
+
+			auto entry = std::move( this->buckets[ 0 ].back() );
+
+			this->buckets[ 0 ].pop_back();
+			--( this->entries );
+
+			return entry;
+		}
+
+		void
+		clear() noexcept
+		{
+			for ( auto& bucket : this->buckets )
+			{
+				bucket.clear();
+			}
+
+			this->last = 0;
+			this->entries = 0;
+		}
+
+		bool
+		empty() const noexcept
+		{
+			return ( this->entries == 0 );
+		}
+
+		size_type
+		size() const noexcept
+		{
+			return this->entries;
+		}
+
+	private:
+		using bucket_vector = std::vector< value_type, allocator_type >;
+
+		template < std::size_t... Indices >
+		static std::array< bucket_vector, BUCKETS >
+		make_buckets(
+			const allocator_type& input_allocator,
+			std::index_sequence< Indices... > )
+		{
+			return { { ( static_cast< void >( Indices ), bucket_vector( input_allocator ) )... } };
+		}
+
+		// Number of significant bits of the value.
+		static std::size_t
+		bit_width( const Key value ) noexcept
+		{
+#if defined( __GNUC__ ) || defined( __clang__ )
+			return value ? ( std::numeric_limits< unsigned long long >::digits - __builtin_clzll( value ) ) : 0;
+#else
+			std::size_t width = 0;
+
+			for ( auto remaining = value; remaining; remaining >>= 1 )
+			{
+				++width;
+			}
+
+			return width;
+#endif
+		}
+
+		std::size_t
+		bucket( const Key key ) const noexcept
+		{
+			return bit_width( static_cast< Key >( key ^ this->last ) );
+		}
+
+		static typename bucket_vector::const_iterator
+		minimum( const bucket_vector& bucket ) noexcept
+		{
+			return std::min_element(
+				std::cbegin( bucket ),
+				std::cend( bucket ),
+				[]( const value_type& first, const value_type& second )
+				{
+					return ( first.first < second.first );
+				} );
+		}
+
+		// First non-empty bucket after bucket 0, which must be empty.
+		std::size_t
+		first_bucket() const noexcept
+		{
+			std::size_t bucket = 1;
+
+			while ( this->buckets[ bucket ].empty() )
+			{
+				++bucket;
+			}
+
+			return bucket;
+		}
+
+		// Refills bucket 0 from the first non-empty bucket, whose minimum key becomes the last key.
+		void
+		redistribute()
+		{
+			auto& source = this->buckets[ this->first_bucket() ];
+
+			this->last = minimum( source )->first;
+
+			for ( auto& entry : source )
+			{
+				this->buckets[ this->bucket( entry.first ) ].push_back( std::move( entry ) );
+			}
+
+			source.clear();
+		}
+
+		std::array< bucket_vector, BUCKETS > buckets;
+
+		Key last = 0;
+		size_type entries = 0;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,222 @@
+/**
+ * Daniel Sebastian Iliescu, http://dansil.net
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ *
+ * A bounded multi-producer multi-consumer FIFO queue over a ring buffer (Vyukov).
+ *
+ * Every cell carries a sequence number which tells producers and consumers whether it is free
+ * for the current lap of the ring, so a push or pop is one CAS on the shared position followed
+ * by uncontended accesses to the cell. Nothing is allocated after construction.
+ *
+ * The modifiers keep the push_back/pop_front naming of doubly_linked_list and report failure
+ * when the queue is full or empty instead of blocking. size() and empty() are snapshots.
+ *
+ * A claimed cell has to be published, so items must be nothrow movable. Items whose
+ * construction may throw are built before a cell is claimed, then moved into it.
+ */
+
+#pragma once
+
+#include "memory/cache_line.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace dsa
+{
+	template < typename T >
+	class bounded_concurrent_queue
+	{
+		static_assert(
+			std::is_nothrow_move_constructible< T >::value && std::is_nothrow_move_assignable< T >::value,
+			"A claimed cell would never be published if moving an item threw." );
+
+		struct cell
+		{
+			T*
+			item() noexcept
+			{
+				return std::launder( reinterpret_cast< T* >( this->storage ) );
+			}
+
+			std::atomic< std::size_t > sequence;
+
+			alignas( T ) unsigned char storage[ sizeof( T ) ];
+		};
+
+	public:
+		using value_type = T;
+		using size_type = std::size_t;
+		using reference = value_type&;
+		using const_reference = const value_type&;
+
+		// The capacity is rounded up to a power of two.
+		explicit bounded_concurrent_queue( const size_type minimum_capacity ) :
+			mask( round_up( minimum_capacity ) - 1 ),
+			cells( new cell[ this->mask + 1 ] )
+		{
+			for ( size_type position = 0; position <= this->mask; ++position )
+			{
+				this->cells[ position ].sequence.store( position, std::memory_order_relaxed );
+			}
+		}
+
+		~bounded_concurrent_queue() noexcept
+		{
+			const auto back = this->back_position.load();
+
+			for ( auto position = this->front_position.load(); position != back; ++position )
+			{
+				this->cells[ position & this->mask ].item()->~T();
+			}
+		}
+
+		bounded_concurrent_queue( const bounded_concurrent_queue& ) = delete;
+		bounded_concurrent_queue( bounded_concurrent_queue&& ) = delete;
+
+		bounded_concurrent_queue& operator=( const bounded_concurrent_queue& ) = delete;
+		bounded_concurrent_queue& operator=( bounded_concurrent_queue&& ) = delete;
+
+		/**
+		 * Modifiers
+		 */
+
+		// Returns false (leaving the item untouched) if the queue is full.
+		bool
+		push_back( const T& item )
+		{
+			return this->emplace_back( item );
+		}
+
+		bool
+		push_back( T&& item )
+		{
+			return this->emplace_back( std::move( item ) );
+		}
+
+		template < typename... Args >
+		bool
+		emplace_back( Args&&... args )
+		{
+			if constexpr ( !std::is_nothrow_constructible< T, Args&&... >::value )
+			{
+				return this->emplace_back( T( std::forward< Args >( args )... ) );
+			}
+			else
+			{
+				auto position = this->back_position.load( std::memory_order_relaxed );
+
+				while ( true )
+				{
+					auto& target = this->cells[ position & this->mask ];
+
+					const auto sequence = target.sequence.load( std::memory_order_acquire );
+					const auto difference = static_cast< std::ptrdiff_t >( sequence - position );
+
+					if ( difference == 0 )
+					{
+						if ( this->back_position.compare_exchange_weak( position, position + 1, std::memory_order_relaxed ) )
+						{
+							::new ( static_cast< void* >( target.storage ) ) T( std::forward< Args >( args )... );
+							target.sequence.store( position + 1, std::memory_order_release );
+
+							return true;
+						}
+					}
+					else if ( difference < 0 )
+					{
+						// The cell still holds the item from the previous lap.
+						return false;
+					}
+					else
+					{
+						position = this->back_position.load( std::memory_order_relaxed );
+					}
+				}
+			}
+		}
+
+		// Moves the front item into the argument; returns false if the queue was empty.
+		bool
+		pop_front( T& item )
+		{
+			auto position = this->front_position.load( std::memory_order_relaxed );
+
+			while ( true )
+			{
+				auto& target = this->cells[ position & this->mask ];
+
+				const auto sequence = target.sequence.load( std::memory_order_acquire );
+				const auto difference = static_cast< std::ptrdiff_t >( sequence - ( position + 1 ) );
+
+				if ( difference == 0 )
+				{
+					if ( this->front_position.compare_exchange_weak( position, position + 1, std::memory_order_relaxed ) )
+					{
+						item = std::move( *target.item() );
+						target.item()->~T();
+
+						// Free the cell for the producer of the next lap.
+						target.sequence.store( position + this->mask + 1, std::memory_order_release );
+
+						return true;
+					}
+				}
+				else if ( difference < 0 )
+				{
+					return false;
+				}
+				else
+				{
+					position = this->front_position.load( std::memory_order_relaxed );
+				}
+			}
+		}
+
+		bool
+		empty() const noexcept
+		{
+			return ( this->size() == 0 );
+		}
+
+		size_type
+		size() const noexcept
+		{
+			const auto front = this->front_position.load( std::memory_order_acquire );
+			const auto back = this->back_position.load( std::memory_order_acquire );
+
+			return ( back > front ) ? std::min( back - front, this->capacity() ) : 0;
+		}
+
+		size_type
+		capacity() const noexcept
+		{
+			return this->mask + 1;
+		}
+
+	private:
+		static size_type
+		round_up( const size_type minimum_capacity ) noexcept
+		{
+			size_type capacity = 2;
+
+			while ( capacity < minimum_capacity )
+			{
+				capacity <<= 1;
+			}
+
+			return capacity;
+		}
+
+		const size_type mask;
+		const std::unique_ptr< cell[] > cells;
+
+		alignas( cache_line_size ) std::atomic< size_type > back_position { 0 };
+		alignas( cache_line_size ) std::atomic< size_type > front_position { 0 };
+	};
+}
@@ -0,0 +1,215 @@
+/**
+ * Daniel Sebastian Iliescu, http://dansil.net
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ *
+ * An unbounded lock-free multi-producer multi-consumer FIFO queue (Michael and Scott, 1996).
+ *
+ * The queue is a singly-linked list with a dummy front node. Producers append with a CAS on
+ * the last node's link and consumers advance the front with a CAS; a lagging back pointer is
+ * helped forward by whichever thread notices it. Unlinked nodes are reclaimed through hazard
+ * pointers, so a node is never freed while another thread may still read it.
+ *
+ * The modifiers keep the push_back/pop_front naming of doubly_linked_list. Since another thread
+ * may empty the queue at any time, pop_front reports whether an item was dequeued instead of
+ * returning a default constructed value, which it moves out after unlinking it, so moving an
+ * item must not throw. size() and empty() are snapshots.
+ */
+
+#pragma once
+
+#include "memory/cache_line.hpp"
+#include "memory/hazard_pointer.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace dsa
+{
+	template < typename T >
+	class concurrent_queue
+	{
+		static_assert(
+			std::is_nothrow_move_assignable< T >::value,
+			"A dequeued item would be lost, and its node leaked, if moving it out threw." );
+
+		struct queue_node
+		{
+			queue_node() noexcept = default;
+
+			// The item is constructed by push_back and destroyed by the pop_front which dequeues it.
+			T*
+			item() noexcept
+			{
+				return std::launder( reinterpret_cast< T* >( this->storage ) );
+			}
+
+			std::atomic< queue_node* > next { nullptr };
+
+			alignas( T ) unsigned char storage[ sizeof( T ) ];
+		};
+
+	public:
+		using value_type = T;
+		using size_type = std::size_t;
+		using reference = value_type&;
+		using const_reference = const value_type&;
+
+		concurrent_queue() :
+			front_node( new queue_node() ),
+			back_node( this->front_node.load() )
+		{
+		}
+
+		~concurrent_queue() noexcept
+		{
+			auto node = this->front_node.load();
+
+			// Every node after the dummy still holds an item.
+			for ( auto next_node = node->next.load(); next_node; next_node = node->next.load() )
+			{
+				next_node->item()->~T();
+
+				delete node;
+				node = next_node;
+			}
+
+			delete node;
+		}
+
+		concurrent_queue( const concurrent_queue& ) = delete;
+		concurrent_queue( concurrent_queue&& ) = delete;
+
+		concurrent_queue& operator=( const concurrent_queue& ) = delete;
+		concurrent_queue& operator=( concurrent_queue&& ) = delete;
+
+		/**
+		 * Modifiers
+		 */
+
+		void
+		push_back( const T& item )
+		{
+			this->emplace_back( item );
+		}
+
+		void
+		push_back( T&& item )
+		{
+			this->emplace_back( std::move( item ) );
+		}
+
+		template < typename... Args >
+		void
+		emplace_back( Args&&... args )
+		{
+			auto new_node = new queue_node();
+
+			try
+			{
+				::new ( static_cast< void* >( new_node->storage ) ) T( std::forward< Args >( args )... );
+			}
+			catch ( ... )
+			{
+				delete new_node;
+				throw;
+			}
+
+			typename hazard_domain< queue_node >::hazard_guard guard( this->hazards );
+
+			while ( true )
+			{
+				auto back = guard.protect( 0, this->back_node );
+				auto next = back->next.load();
+
+				if ( back != this->back_node.load() )
+				{
+					continue;
+				}
+
+				if ( next )
+				{
+					// Another producer linked a node but has not swung the back pointer yet.
+					this->back_node.compare_exchange_weak( back, next );
+				}
+				else if ( back->next.compare_exchange_weak( next, new_node ) )
+				{
+					this->back_node.compare_exchange_strong( back, new_node );
+
+					break;
+				}
+			}
+
+			this->items.fetch_add( 1, std::memory_order_relaxed );
+		}
+
+		// Moves the front item into the argument; returns false if the queue was empty.
+		bool
+		pop_front( T& item )
+		{
+			typename hazard_domain< queue_node >::hazard_guard guard( this->hazards );
+
+			while ( true )
+			{
+				auto front = guard.protect( 0, this->front_node );
+				auto back = this->back_node.load();
+				const auto next = guard.protect( 1, front->next );
+
+				if ( front != this->front_node.load() )
+				{
+					continue;
+				}
+
+				if ( !next )
+				{
+					return false;
+				}
+
+				if ( front == back )
+				{
+					this->back_node.compare_exchange_weak( back, next );
+				}
+				else if ( this->front_node.compare_exchange_weak( front, next ) )
+				{
+					// The dequeued node becomes the new dummy; only this thread owns its item.
+					item = std::move( *next->item() );
+					next->item()->~T();
+
+					this->items.fetch_sub( 1, std::memory_order_relaxed );
+
+					guard.clear( 1 );
+					guard.clear( 0 );
+					guard.retire( front );
+
+					return true;
+				}
+			}
+		}
+
+		bool
+		empty() const
+		{
+			typename hazard_domain< queue_node >::hazard_guard guard( this->hazards );
+
+			return ( guard.protect( 0, this->front_node )->next.load() == nullptr );
+		}
+
+		size_type
+		size() const noexcept
+		{
+			const auto count = this->items.load( std::memory_order_relaxed );
+
+			// Producers and consumers update the count after the fact, so it can transiently underflow.
+			return ( count < 0 ) ? 0 : static_cast< size_type >( count );
+		}
+
+	private:
+		alignas( cache_line_size ) std::atomic< queue_node* > front_node;
+		alignas( cache_line_size ) std::atomic< queue_node* > back_node;
+		alignas( cache_line_size ) std::atomic< std::ptrdiff_t > items { 0 };
+
+		mutable hazard_domain< queue_node > hazards;
+	};
+}
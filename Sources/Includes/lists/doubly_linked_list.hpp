@@ -4,14 +4,29 @@
  *
  * A doubly-linked implementation of a list combining both LIFO and FIFO operations.
  *
- * C++ Standard Library compliant iterators for the list are provided. Custom allocators are also supported.
+ * C++ Standard Library compliant iterators for the list are provided. Custom allocators are also supported, including
+ * std::pmr::polymorphic_allocator and arena_allocator.
+ *
+ * Items are moved or constructed in place into their node, and moved out when popped, so they are only
+ * copied when pushed by const reference. Move-only types are supported.
  * 
- * All modifier functions operate in constant time (amortized for custom allocators) since no traversal occurs.
+ * All modifier functions operate in constant time (amortized for custom allocators) since no traversal occurs,
+ * except for the range insertion and erasure, merging, and splicing a range out of another list, which are linear
+ * in the number of elements involved. Splicing only relinks nodes, so elements are never copied or moved.
+ *
+ * The nodes form a circle through a sentinel owned by the list, which acts as the past-the-end node.
  */
 
 #pragma once
 
+#include "list_iterator.hpp"
+#include "memory/allocator_propagation.hpp"
+
+#include <functional>
+#include <iterator>
 #include <memory>
+#include <type_traits>
+#include <utility>
 
 namespace dsa
 {
@@ -24,10 +39,23 @@ namespace dsa
 		struct doubly_linked_node
 		{
 			doubly_linked_node() noexcept = default;
-			doubly_linked_node( T input_item ) noexcept :
+			explicit doubly_linked_node( const T& input_item ) :
 				item( input_item )
 			{
 			}
+
+			explicit doubly_linked_node( T&& input_item ) noexcept( std::is_nothrow_move_constructible< T >::value ) :
+				item( std::move( input_item ) )
+			{
+			}
+
+			template < typename... Args >
+			explicit doubly_linked_node(
+				std::in_place_t,
+				Args&&... args ) :
+				item( std::forward< Args >( args )... )
+			{
+			}
 			~doubly_linked_node() noexcept = default;
 
 			doubly_linked_node( doubly_linked_node const & ) = default;
@@ -54,116 +82,35 @@ namespace dsa
 			doubly_linked_node* next = nullptr;
 		};
 
-		// Iterator class for both mutable and const iterators.
-		template< bool IsConstIterator >
-		class iterator_impl
+		// Traversal of the nodes by the iterators.
+		struct node_traits
 		{
-		public:
-			using iterator_category = std::bidirectional_iterator_tag;
+			using owner_type = doubly_linked_list;
 			using value_type = T;
-			using difference_type = std::ptrdiff_t;
-			using pointer =
-				typename std::conditional<
-					IsConstIterator,
-					const T* const,
-					T* >::type;
-			using reference =
-				typename std::conditional<
-					IsConstIterator,
-					const T&,
-					T& >::type;
-
-			iterator_impl( doubly_linked_node* const input_node ) noexcept :
-				node( input_node )
-			{
-			}
+			using node_pointer = doubly_linked_node*;
 
-			iterator_impl( const iterator_impl< false >& it ) noexcept :
-				node( it.node )
+			static node_pointer
+			next( const node_pointer node ) noexcept
 			{
+				return node->next;
 			}
 
-			 // Copy construction for const iterators is handled by the default
-			 // generated implementation. The copy constructor specialization for
-			 // mutable iterators allows for the conversion from mutable to const.
-			iterator_impl& operator=( const iterator_impl< false >& it ) noexcept
+			static node_pointer
+			previous( const node_pointer node ) noexcept
 			{
-				this->node = it.node;
-
-				return *this;
+				return node->previous;
 			}
 
-			void
-			swap( iterator_impl& it ) noexcept
+			static T&
+			item( const node_pointer node ) noexcept
 			{
-				std::swap( this->node, it.node );
+				return node->item;
 			}
-
-			iterator_impl&
-			operator++() noexcept
-			{
-				this->node = this->node->next;
-
-				return *this;
-			}
-
-			iterator_impl
-			operator++( int ) noexcept
-			{
-				const iterator_impl iterator( *this );
-				++( *this );
-
-				return iterator;
-			}
-
-			iterator_impl&
-			operator--() noexcept
-			{
-				this->node = this->node->previous;
-
-				return *this;
-			}
-
-			iterator_impl
-			operator--( int ) noexcept
-			{
-				const iterator_impl iterator ( *this );
-				--( *this );
-
-				return iterator;
-			}
-
-			reference
-			operator*() const noexcept
-			{
-				return this->node->item;
-			}
-
-			pointer
-			operator->() const noexcept
-			{
-				return this->node;
-			}
-
-			bool
-			operator==( const iterator_impl& it ) const noexcept
-			{
-				return
-					( this->node == it.node ) ||
-					( ( this->node && it.node ) &&
-						( *this->node == *it.node ) );
-			}
-
-			bool
-			operator!=( const iterator_impl& it ) const noexcept
-			{
-				return !( *this == it );
-			}
-
-		private:
-			doubly_linked_node* node;
 		};
 
+		template< bool IsConstIterator >
+		using iterator_impl = list_iterator< node_traits, IsConstIterator >;
+
 		using iterator = iterator_impl< false >;
 		using const_iterator = iterator_impl< true >;
 		using reverse_iterator = std::reverse_iterator< iterator >;
@@ -178,56 +125,106 @@ namespace dsa
 		using pointer = typename std::allocator_traits< allocator_type >::pointer;
 		using const_pointer = typename std::allocator_traits< allocator_type >::const_pointer;
 
-		doubly_linked_list() noexcept = default;
+		doubly_linked_list() noexcept( std::is_nothrow_default_constructible< allocator_type >::value )
+		{
+			this->reset();
+		}
+
+		explicit doubly_linked_list( const allocator_type& input_allocator ) noexcept :
+			allocator( input_allocator )
+		{
+			this->reset();
+		}
 
 		~doubly_linked_list() noexcept
 		{
 			this->clear();
 		}
 
-		doubly_linked_list( const doubly_linked_list& other )
+		template < typename InputIterator >
+		doubly_linked_list(
+			InputIterator first,
+			InputIterator last,
+			const allocator_type& input_allocator = allocator_type() ) :
+			doubly_linked_list( input_allocator )
 		{
-			auto node = other.front_node;
+			this->insert( this->cend(), first, last );
+		}
 
-			while ( other.valid_node( node ) )
-			{
-				this->push_back( node->item );
-				node = node->next;
-			}
+		doubly_linked_list( const doubly_linked_list& other ) :
+			doubly_linked_list(
+				other.cbegin(),
+				other.cend(),
+				std::allocator_traits< allocator_type >::select_on_container_copy_construction( other.allocator ) )
+		{
 		}
 
+		// The nodes now belong to the allocator moved out of the source.
 		doubly_linked_list( doubly_linked_list&& other ) noexcept :
-			allocator( other.allocator ),
-			front_node( other.front_node ),
-			back_node( other.back_node ),
-			sentinel( std::move( other.sentinel ) ),
-			nodes( other.nodes )
-		{
-			other.front_node = nullptr;
-			other.back_node = nullptr;
-			other.nodes = 0;
+			allocator( std::move( other.allocator ) )
+		{
+			this->reset();
+			this->swap_nodes( other );
 		}
 
+		// Copies the elements into the nodes of this list, which only takes the allocator of the source if it propagates.
 		doubly_linked_list&
 		operator=( const doubly_linked_list& rhs )
 		{
-			this->swap( *this, doubly_linked_list( rhs ) );
+			if ( &rhs != this )
+			{
+				this->clear();
+
+				propagate_on_copy_assignment( this->allocator, rhs.allocator );
+				this->insert( this->cend(), rhs.cbegin(), rhs.cend() );
+			}
 
 			return *this;
 		}
 
+		/**
+		 * Takes over the nodes of the source, unless its allocator neither propagates nor compares equal,
+		 * in which case the elements are moved into nodes of this list instead.
+		 */
 		doubly_linked_list&
-		operator=( doubly_linked_list&& rhs ) noexcept
+		operator=( doubly_linked_list&& rhs ) noexcept( allocator_moves_storage_v< allocator_type > )
 		{
-			this->swap( *this, rhs );
+			if constexpr ( !allocator_moves_storage_v< allocator_type > )
+			{
+				if ( this->allocator != rhs.allocator )
+				{
+					this->clear();
+					this->insert( this->cend(), std::make_move_iterator( rhs.begin() ), std::make_move_iterator( rhs.end() ) );
+					rhs.clear();
+
+					return *this;
+				}
+			}
+
+			propagate_on_move_assignment( this->allocator, rhs.allocator );
+			this->swap_nodes( rhs );
 
 			return *this;
 		}
 
+		// Lists of different sizes are told apart without traversal; otherwise the nodes are compared in a single pass.
 		bool
 		operator==( const doubly_linked_list& rhs ) const noexcept
 		{
-			return equals( this->front_node, rhs.front_node );
+			if ( this->nodes != rhs.nodes )
+			{
+				return false;
+			}
+
+			for ( auto node1 = this->first(), node2 = rhs.first(); node1 != this->last(); node1 = node1->next, node2 = node2->next )
+			{
+				if ( !( node1->item == node2->item ) )
+				{
+					return false;
+				}
+			}
+
+			return true;
 		}
 
 		bool
@@ -236,15 +233,12 @@ namespace dsa
 			return !( *this == rhs );
 		}
 
+		// The allocators of both lists must compare equal, unless they propagate on swap.
 		friend void
 		swap( doubly_linked_list& first, doubly_linked_list& second ) noexcept
 		{
-			using std::swap;
-
-			swap( first.front_node, second.front_node );
-			swap( first.back_node, second.back_node );
-			swap( first.sentinel, second.sentinel );
-			swap( first.nodes, second.nodes );
+			propagate_on_swap( first.allocator, second.allocator );
+			first.swap_nodes( second );
 		}
 
 		allocator_type
@@ -255,18 +249,33 @@ namespace dsa
 
 		/**
 		 * Element access
+		 *
+		 * On an empty list these refer to the default constructed item of the sentinel,
+		 * which must not be modified.
 		 */
 
-		T
+		reference
+		front() noexcept
+		{
+			return this->sentinel.next->item;
+		}
+
+		const_reference
 		front() const noexcept
 		{
-			return this->empty() ? T() : this->front_node->item;
+			return this->sentinel.next->item;
 		}
 
-		T
+		reference
+		back() noexcept
+		{
+			return this->sentinel.previous->item;
+		}
+
+		const_reference
 		back() const noexcept
 		{
-			return this->empty() ? T() : this->back_node->item;
+			return this->sentinel.previous->item;
 		}
 
 		/**
@@ -350,109 +359,308 @@ namespace dsa
 		 */
 
 		void
-		push_front( T item )
+		push_front( const T& item )
 		{
-			auto new_node = this->create_node( item );
+			this->emplace_front( item );
+		}
 
-			if ( this->empty() )
-			{
-				this->front_node = new_node;
-				this->back_node = new_node;
+		void
+		push_front( T&& item )
+		{
+			this->emplace_front( std::move( item ) );
+		}
 
-				this->update_sentinel();
-			}
-			else
-			{
-				new_node->next = this->front_node;
+		void
+		push_back( const T& item )
+		{
+			this->emplace_back( item );
+		}
 
-				this->front_node->previous = new_node;
-				this->front_node = new_node;
-			}
+		void
+		push_back( T&& item )
+		{
+			this->emplace_back( std::move( item ) );
+		}
 
-			++( this->nodes );
+		template < typename... Args >
+		reference
+		emplace_front( Args&&... args )
+		{
+			return *this->emplace( this->cbegin(), std::forward< Args >( args )... );
 		}
 
-		void
-		push_back( T item )
+		template < typename... Args >
+		reference
+		emplace_back( Args&&... args )
 		{
-			auto new_node = this->create_node( item );
+			return *this->emplace( this->cend(), std::forward< Args >( args )... );
+		}
 
+		T
+		pop_front() noexcept
+		{
 			if ( this->empty() )
 			{
-				this->front_node = new_node;
-				this->back_node = new_node;
+				return T();
 			}
-			else
-			{
-				new_node->previous = this->back_node;
 
-				this->back_node->next = new_node;
-				this->back_node = new_node;
-			}
+			// Moved out of the node, then returned without a further copy.
+			auto item = std::move( this->sentinel.next->item );
 
-			this->update_sentinel();
+			this->erase( this->cbegin() );
 
-			++( this->nodes );
+			return item;
 		}
 
 		T
-		pop_front() noexcept
+		pop_back() noexcept
 		{
 			if ( this->empty() )
 			{
 				return T();
 			}
 
-			const auto item = this->front_node->item;
-			auto next_node = this->front_node->next;
+			auto item = std::move( this->sentinel.previous->item );
 
-			this->destroy_node( this->front_node );
+			this->erase( const_iterator( this->sentinel.previous ) );
 
-			if ( this->valid_node( next_node ) )
+			return item;
+		}
+
+		// Constructs an element before the given position.
+		template < typename... Args >
+		iterator
+		emplace(
+			const_iterator position,
+			Args&&... args )
+		{
+			const auto new_node = this->create_node( std::in_place, std::forward< Args >( args )... );
+
+			link( position.node, new_node, new_node );
+			++( this->nodes );
+
+			return iterator( new_node );
+		}
+
+		iterator
+		insert(
+			const_iterator position,
+			const T& item )
+		{
+			return this->emplace( position, item );
+		}
+
+		iterator
+		insert(
+			const_iterator position,
+			T&& item )
+		{
+			return this->emplace( position, std::move( item ) );
+		}
+
+		/**
+		 * Inserts copies of [first, last) before the given position, returning an iterator to the
+		 * first inserted element. The nodes are created as a detached chain which is then linked
+		 * in at once, so the list is left untouched if an allocation or a copy throws.
+		 */
+		template < typename InputIterator >
+		iterator
+		insert(
+			const_iterator position,
+			InputIterator first,
+			InputIterator last )
+		{
+			if ( first == last )
 			{
-				next_node->previous = nullptr;
-				this->front_node = next_node;
+				return iterator( position.node );
 			}
-			else
+
+			const auto chain_front = this->create_node( std::in_place, *first );
+			auto chain_back = chain_front;
+			size_type count = 1;
+
+			try
+			{
+				for ( ++first; first != last; ++first, ++count )
+				{
+					const auto new_node = this->create_node( std::in_place, *first );
+
+					new_node->previous = chain_back;
+					chain_back->next = new_node;
+					chain_back = new_node;
+				}
+			}
+			catch ( ... )
 			{
-				this->front_node = nullptr;
-				this->back_node = nullptr;
+				for ( auto node = chain_front; node; )
+				{
+					const auto next_node = node->next;
+
+					this->destroy_node( node );
+					node = next_node;
+				}
+
+				throw;
 			}
 
+			link( position.node, chain_front, chain_back );
+			this->nodes += count;
+
+			return iterator( chain_front );
+		}
+
+		// Removes the element at the given position, returning an iterator to the following one.
+		iterator
+		erase( const_iterator position ) noexcept
+		{
+			const auto node = position.node;
+			const auto next_node = node->next;
+
+			unlink( node, node );
+			this->destroy_node( node );
 			--( this->nodes );
 
-			return item;
+			return iterator( next_node );
 		}
 
-		T
-		pop_back() noexcept
+		iterator
+		erase(
+			const_iterator first,
+			const_iterator last ) noexcept
 		{
-			if ( this->empty() )
+			while ( first.node != last.node )
 			{
-				return T();
+				first = this->erase( first );
 			}
 
-			const auto item = this->back_node->item;
-			auto previous_node = this->back_node->previous;
+			return iterator( last.node );
+		}
 
-			this->destroy_node( this->back_node );
+		/**
+		 * Moves every element of the other list before the given position.
+		 * The allocators of both lists must compare equal.
+		 */
+		void
+		splice(
+			const_iterator position,
+			doubly_linked_list& other ) noexcept
+		{
+			if ( ( &other == this ) || other.empty() )
+			{
+				return;
+			}
+
+			link( position.node, other.sentinel.next, other.sentinel.previous );
 
-			if ( previous_node )
+			this->nodes += other.nodes;
+
+			other.reset();
+			other.nodes = 0;
+		}
+
+		// Moves the element at it (in the other list) before the given position.
+		void
+		splice(
+			const_iterator position,
+			doubly_linked_list& other,
+			const_iterator it ) noexcept
+		{
+			if ( ( position.node == it.node ) || ( position.node == it.node->next ) )
 			{
-				previous_node->next = nullptr;
-				this->back_node = previous_node;
+				return;
+			}
+
+			unlink( it.node, it.node );
+			link( position.node, it.node, it.node );
+
+			--( other.nodes );
+			++( this->nodes );
+		}
 
-				this->update_sentinel();
+		/**
+		 * Moves [first, last) from the other list before the given position, which must not lie in the
+		 * range. This is constant time within a list, and linear in the length of the range otherwise.
+		 */
+		void
+		splice(
+			const_iterator position,
+			doubly_linked_list& other,
+			const_iterator first,
+			const_iterator last ) noexcept
+		{
+			if ( ( first.node == last.node ) || ( position.node == last.node ) )
+			{
+				return;
 			}
-			else
+
+			if ( &other != this )
+			{
+				size_type count = 0;
+
+				for ( auto node = first.node; node != last.node; node = node->next )
+				{
+					++count;
+				}
+
+				other.nodes -= count;
+				this->nodes += count;
+			}
+
+			const auto range_back = last.node->previous;
+
+			unlink( first.node, range_back );
+			link( position.node, first.node, range_back );
+		}
+
+		/**
+		 * Merges the other sorted list into this sorted list by relinking its nodes, leaving it empty.
+		 * The merge is stable: equivalent elements of this list precede those of the other list.
+		 */
+		template < typename Compare = std::less<> >
+		void
+		merge(
+			doubly_linked_list& other,
+			Compare compare = Compare() )
+		{
+			if ( &other == this )
 			{
-				this->front_node = nullptr;
-				this->back_node = nullptr;
+				return;
 			}
 
-			--( this->nodes );
+			auto position = this->sentinel.next;
 
-			return item;
+			while ( !other.empty() )
+			{
+				const auto run_front = other.sentinel.next;
+
+				while ( ( position != &this->sentinel ) && !compare( run_front->item, position->item ) )
+				{
+					position = position->next;
+				}
+
+				if ( position == &this->sentinel )
+				{
+					this->splice( this->cend(), other );
+
+					return;
+				}
+
+				// Move the whole run of the other list which precedes the current position at once.
+				auto run_back = run_front;
+				size_type count = 1;
+
+				while ( ( run_back->next != &other.sentinel ) && compare( run_back->next->item, position->item ) )
+				{
+					run_back = run_back->next;
+					++count;
+				}
+
+				unlink( run_front, run_back );
+				link( position, run_front, run_back );
+
+				other.nodes -= count;
+				this->nodes += count;
+			}
 		}
 
 		void
@@ -464,9 +672,7 @@ namespace dsa
 		bool
 		empty() const noexcept
 		{
-			return ( ( !this->front_node ) &&
-					 ( !this->back_node ) &&
-					 ( this->nodes == 0 ) );
+			return ( this->nodes == 0 );
 		}
 
 		size_type
@@ -478,76 +684,124 @@ namespace dsa
 		size_type
 		max_size() const noexcept
 		{
-			return std::allocator_traits< allocator_type >::max_size();
+			return std::allocator_traits< allocator_type >::max_size( this->allocator );
 		}
 
 	private:
-		typename std::allocator_traits< allocator_type >::pointer
-		create_node( T item )
+		template < typename... Args >
+		pointer
+		create_node( Args&&... args )
 		{
 			auto node = std::allocator_traits< allocator_type >::allocate( this->allocator, 1 );
-			std::allocator_traits< allocator_type >::construct( this->allocator, node, item );
+
+			try
+			{
+				std::allocator_traits< allocator_type >::construct( this->allocator, node, std::forward< Args >( args )... );
+			}
+			catch ( ... )
+			{
+				std::allocator_traits< allocator_type >::deallocate( this->allocator, node, 1 );
+				throw;
+			}
 
 			return node;
 		}
 
 		void destroy_node( typename std::allocator_traits< allocator_type >::pointer node ) noexcept
 		{
+			std::allocator_traits< allocator_type >::destroy( this->allocator, node );
 			std::allocator_traits< allocator_type >::deallocate( this->allocator, node, 1 );
 		}
 
 		static void
 		clear( doubly_linked_list& instance ) noexcept
 		{
-			while ( !instance.empty() )
+			for ( auto node = instance.sentinel.next; node != &instance.sentinel; )
 			{
-				instance.pop_back();
+				const auto next_node = node->next;
+
+				instance.destroy_node( node );
+				node = next_node;
 			}
+
+			instance.reset();
+			instance.nodes = 0;
+		}
+
+		// Links the chain [chain_front, chain_back] before the given node.
+		static void
+		link(
+			pointer position,
+			pointer chain_front,
+			pointer chain_back ) noexcept
+		{
+			chain_front->previous = position->previous;
+			chain_back->next = position;
+
+			position->previous->next = chain_front;
+			position->previous = chain_back;
+		}
+
+		// Unlinks the chain [chain_front, chain_back] from its neighbours.
+		static void
+		unlink(
+			pointer chain_front,
+			pointer chain_back ) noexcept
+		{
+			chain_front->previous->next = chain_back->next;
+			chain_back->next->previous = chain_front->previous;
 		}
 
 		void
-		update_sentinel()
+		reset() noexcept
 		{
-			this->sentinel.previous = this->back_node;
-			this->back_node->next = &this->sentinel;
+			this->sentinel.previous = &this->sentinel;
+			this->sentinel.next = &this->sentinel;
 		}
 
-		pointer
-		first() const noexcept
+		void
+		swap_nodes( doubly_linked_list& other ) noexcept
 		{
-			return this->front_node;
+			using std::swap;
+
+			swap( this->sentinel.previous, other.sentinel.previous );
+			swap( this->sentinel.next, other.sentinel.next );
+			swap( this->nodes, other.nodes );
+
+			this->relink();
+			other.relink();
 		}
 
-		pointer
-		last() const noexcept
+		// Points the first and last nodes back at this sentinel (after it was swapped).
+		void
+		relink() noexcept
 		{
-			return this->back_node->next;
+			if ( this->empty() )
+			{
+				this->reset();
+			}
+			else
+			{
+				this->sentinel.next->previous = &this->sentinel;
+				this->sentinel.previous->next = &this->sentinel;
+			}
 		}
 
-		bool
-		valid_node( pointer node ) const
+		pointer
+		first() const noexcept
 		{
-			return node && ( node != &this->sentinel );
+			return this->sentinel.next;
 		}
 
-		static bool
-		equals(
-			pointer node1,
-			pointer node2 ) noexcept
+		pointer
+		last() const noexcept
 		{
-			return
-				( node1 == node2 ) ||
-				( ( node1 && node2 ) &&
-					( *node1 == *node2 ) &&
-					equals( node1->next, node2->next ) );
-		} 
+			return const_cast< pointer >( &this->sentinel );
+		}
 
 		allocator_type allocator;
 
-		pointer front_node = nullptr;
-		pointer back_node = nullptr;
-
-		// Sentinel used to point to the past-the-end sequence for iteration.
+		// Circular sentinel used as the past-the-end node: next is the first node, previous is the last node.
 		typename std::allocator_traits< allocator_type >::value_type sentinel;
 
 		size_type nodes = 0;
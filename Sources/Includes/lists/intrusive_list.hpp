@@ -0,0 +1,491 @@
+/**
+ * Daniel Sebastian Iliescu, http://dansil.net
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ *
+ * An intrusive doubly-linked list, where the links are stored in a hook member of the items.
+ *
+ * The list never allocates and does not own its items: it links and unlinks objects which
+ * live elsewhere, and whose lifetime must exceed their membership. An object may be on as
+ * many lists at once as it has hooks, for instance an LRU list and a dirty list. Given only
+ * an object, it can be found in or removed from a list in constant time.
+ *
+ * It offers the iterators of doubly_linked_list and a similar modifier interface, taking and
+ * returning the items by reference or pointer rather than by value. All operations are in
+ * constant time, except for clear which is linear.
+ */
+
+#pragma once
+
+#include "list_iterator.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <utility>
+
+namespace dsa
+{
+	/**
+	 * The links to embed in an object for each list it may belong to.
+	 * Copies of a hook are unlinked, so copying an object does not copy its memberships.
+	 */
+	struct intrusive_list_hook
+	{
+		intrusive_list_hook() noexcept = default;
+		~intrusive_list_hook() noexcept = default;
+
+		intrusive_list_hook( const intrusive_list_hook& ) noexcept
+		{
+		}
+
+		intrusive_list_hook&
+		operator=( const intrusive_list_hook& ) noexcept
+		{
+			return *this;
+		}
+
+		bool
+		is_linked() const noexcept
+		{
+			return ( this->next != nullptr );
+		}
+
+		intrusive_list_hook* previous = nullptr;
+		intrusive_list_hook* next = nullptr;
+	};
+
+	template <
+		typename T,
+		intrusive_list_hook T::* Hook >
+	class intrusive_list
+	{
+		// Traversal of the hooks by the iterators.
+		struct node_traits
+		{
+			using owner_type = intrusive_list;
+			using value_type = T;
+			using node_pointer = intrusive_list_hook*;
+
+			static node_pointer
+			next( const node_pointer node ) noexcept
+			{
+				return node->next;
+			}
+
+			static node_pointer
+			previous( const node_pointer node ) noexcept
+			{
+				return node->previous;
+			}
+
+			static T&
+			item( const node_pointer node ) noexcept
+			{
+				return *intrusive_list::owner( node );
+			}
+		};
+
+	public:
+		using iterator = list_iterator< node_traits, false >;
+		using const_iterator = list_iterator< node_traits, true >;
+		using reverse_iterator = std::reverse_iterator< iterator >;
+		using const_reverse_iterator = std::reverse_iterator< const_iterator >;
+
+		using value_type = T;
+		using size_type = std::size_t;
+		using difference_type = typename std::iterator_traits< iterator >::difference_type;
+		using reference = value_type&;
+		using const_reference = const value_type&;
+		using pointer = value_type*;
+		using const_pointer = const value_type*;
+
+		intrusive_list() noexcept
+		{
+			this->reset();
+		}
+
+		// The items are unlinked, not destroyed.
+		~intrusive_list() noexcept
+		{
+			this->clear();
+		}
+
+		intrusive_list( const intrusive_list& ) = delete;
+
+		intrusive_list( intrusive_list&& other ) noexcept :
+			intrusive_list()
+		{
+			swap( *this, other );
+		}
+
+		intrusive_list& operator=( const intrusive_list& ) = delete;
+
+		intrusive_list&
+		operator=( intrusive_list&& rhs ) noexcept
+		{
+			swap( *this, rhs );
+
+			return *this;
+		}
+
+		friend void
+		swap( intrusive_list& first, intrusive_list& second ) noexcept
+		{
+			using std::swap;
+
+			swap( first.sentinel.previous, second.sentinel.previous );
+			swap( first.sentinel.next, second.sentinel.next );
+			swap( first.nodes, second.nodes );
+
+			first.relink();
+			second.relink();
+		}
+
+		/**
+		 * Element access
+		 */
+
+		// The list must not be empty.
+		reference
+		front() noexcept
+		{
+			return *owner( this->sentinel.next );
+		}
+
+		const_reference
+		front() const noexcept
+		{
+			return *owner( this->sentinel.next );
+		}
+
+		reference
+		back() noexcept
+		{
+			return *owner( this->sentinel.previous );
+		}
+
+		const_reference
+		back() const noexcept
+		{
+			return *owner( this->sentinel.previous );
+		}
+
+		/**
+		 * Iterators
+		 */
+
+		iterator
+		begin() noexcept
+		{
+			return iterator( this->sentinel.next );
+		}
+
+		const_iterator
+		begin() const noexcept
+		{
+			return const_iterator( this->sentinel.next );
+		}
+
+		const_iterator
+		cbegin() const noexcept
+		{
+			return this->begin();
+		}
+
+		iterator
+		end() noexcept
+		{
+			return iterator( &this->sentinel );
+		}
+
+		const_iterator
+		end() const noexcept
+		{
+			return const_iterator( const_cast< intrusive_list_hook* >( &this->sentinel ) );
+		}
+
+		const_iterator
+		cend() const noexcept
+		{
+			return this->end();
+		}
+
+		reverse_iterator
+		rbegin() noexcept
+		{
+			return reverse_iterator( this->end() );
+		}
+
+		const_reverse_iterator
+		rbegin() const noexcept
+		{
+			return const_reverse_iterator( this->end() );
+		}
+
+		const_reverse_iterator
+		crbegin() const noexcept
+		{
+			return this->rbegin();
+		}
+
+		reverse_iterator
+		rend() noexcept
+		{
+			return reverse_iterator( this->begin() );
+		}
+
+		const_reverse_iterator
+		rend() const noexcept
+		{
+			return const_reverse_iterator( this->begin() );
+		}
+
+		const_reverse_iterator
+		crend() const noexcept
+		{
+			return this->rend();
+		}
+
+		// Iterator to an item which is in this list.
+		static iterator
+		iterator_to( reference item ) noexcept
+		{
+			return iterator( &( item.*Hook ) );
+		}
+
+		static const_iterator
+		iterator_to( const_reference item ) noexcept
+		{
+			return const_iterator( const_cast< intrusive_list_hook* >( &( item.*Hook ) ) );
+		}
+
+		/**
+		 * Modifiers
+		 */
+
+		// The item must not already be in a list through this hook.
+		void
+		push_front( reference item ) noexcept
+		{
+			this->insert( this->cbegin(), item );
+		}
+
+		void
+		push_back( reference item ) noexcept
+		{
+			this->insert( this->cend(), item );
+		}
+
+		// Unlinks the front item and returns it, or returns a null pointer if the list is empty.
+		pointer
+		pop_front() noexcept
+		{
+			if ( this->empty() )
+			{
+				return nullptr;
+			}
+
+			const auto item = owner( this->sentinel.next );
+
+			this->erase( this->cbegin() );
+
+			return item;
+		}
+
+		pointer
+		pop_back() noexcept
+		{
+			if ( this->empty() )
+			{
+				return nullptr;
+			}
+
+			const auto item = owner( this->sentinel.previous );
+
+			this->erase( const_iterator( this->sentinel.previous ) );
+
+			return item;
+		}
+
+		// Links the item before the given position.
+		iterator
+		insert(
+			const_iterator position,
+			reference item ) noexcept
+		{
+			const auto hook = &( item.*Hook );
+
+			record_hook_offset( item, hook );
+
+			hook->previous = position.node->previous;
+			hook->next = position.node;
+
+			position.node->previous->next = hook;
+			position.node->previous = hook;
+
+			++( this->nodes );
+
+			return iterator( hook );
+		}
+
+		// Unlinks the item at the given position, returning an iterator to the following one.
+		iterator
+		erase( const_iterator position ) noexcept
+		{
+			const auto hook = position.node;
+			const auto next_hook = hook->next;
+
+			hook->previous->next = next_hook;
+			next_hook->previous = hook->previous;
+
+			hook->previous = nullptr;
+			hook->next = nullptr;
+
+			--( this->nodes );
+
+			return iterator( next_hook );
+		}
+
+		// Unlinks the given item, which must be in this list.
+		iterator
+		erase( reference item ) noexcept
+		{
+			return this->erase( iterator_to( item ) );
+		}
+
+		// Moves every item of the other list before the given position.
+		void
+		splice(
+			const_iterator position,
+			intrusive_list& other ) noexcept
+		{
+			if ( ( &other == this ) || other.empty() )
+			{
+				return;
+			}
+
+			other.sentinel.next->previous = position.node->previous;
+			other.sentinel.previous->next = position.node;
+
+			position.node->previous->next = other.sentinel.next;
+			position.node->previous = other.sentinel.previous;
+
+			this->nodes += other.nodes;
+
+			other.reset();
+			other.nodes = 0;
+		}
+
+		// Moves the item at it (in the other list) before the given position.
+		void
+		splice(
+			const_iterator position,
+			intrusive_list& other,
+			const_iterator it ) noexcept
+		{
+			if ( ( position.node == it.node ) || ( position.node == it.node->next ) )
+			{
+				return;
+			}
+
+			auto& item = *owner( it.node );
+
+			other.erase( it );
+			this->insert( position, item );
+		}
+
+		// Unlinks every item.
+		void
+		clear() noexcept
+		{
+			for ( auto hook = this->sentinel.next; hook != &this->sentinel; )
+			{
+				const auto next_hook = hook->next;
+
+				hook->previous = nullptr;
+				hook->next = nullptr;
+
+				hook = next_hook;
+			}
+
+			this->reset();
+			this->nodes = 0;
+		}
+
+		bool
+		empty() const noexcept
+		{
+			return ( this->nodes == 0 );
+		}
+
+		size_type
+		size() const noexcept
+		{
+			return this->nodes;
+		}
+
+	private:
+		// The item whose hook is given.
+		static pointer
+		owner( intrusive_list_hook* const hook ) noexcept
+		{
+			return reinterpret_cast< pointer >( reinterpret_cast< unsigned char* >( hook ) - hook_offset.load( std::memory_order_relaxed ) );
+		}
+
+		static const_pointer
+		owner( const intrusive_list_hook* const hook ) noexcept
+		{
+			return owner( const_cast< intrusive_list_hook* >( hook ) );
+		}
+
+		/**
+		 * Records the offset of the hook within the items from an item being linked, since a pointer to
+		 * member only yields it given an object. Every item gives the same offset, so it is only stored
+		 * once. Relaxed accesses suffice: an item is linked, and the offset stored, before any owner is
+		 * looked up through a list, which is not thread-safe and thus synchronized with its insertions.
+		 */
+		static void
+		record_hook_offset(
+			const_reference item,
+			const intrusive_list_hook* const hook ) noexcept
+		{
+			const auto offset = reinterpret_cast< const unsigned char* >( hook ) - reinterpret_cast< const unsigned char* >( std::addressof( item ) );
+
+			if ( hook_offset.load( std::memory_order_relaxed ) != offset )
+			{
+				hook_offset.store( offset, std::memory_order_relaxed );
+			}
+		}
+
+		void
+		reset() noexcept
+		{
+			this->sentinel.previous = &this->sentinel;
+			this->sentinel.next = &this->sentinel;
+		}
+
+		// Points the first and last hooks back at this sentinel (after it was swapped).
+		void
+		relink() noexcept
+		{
+			if ( this->empty() )
+			{
+				this->reset();
+			}
+			else
+			{
+				this->sentinel.next->previous = &this->sentinel;
+				this->sentinel.previous->next = &this->sentinel;
+			}
+		}
+
+		// Offset of the hook within the items, shared by every list of this type.
+		static inline std::atomic< std::ptrdiff_t > hook_offset { 0 };
+
+		// Circular sentinel used as the past-the-end hook: next is the first hook, previous is the last hook.
+		intrusive_list_hook sentinel;
+
+		size_type nodes = 0;
+	};
+}
\ No newline at end of file
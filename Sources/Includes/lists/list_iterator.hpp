@@ -0,0 +1,137 @@
+/**
+ * Daniel Sebastian Iliescu, http://dansil.net
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ *
+ * A bidirectional iterator over a doubly-linked chain of nodes, shared by the linked lists.
+ *
+ * How a node is traversed and how its item is reached are given by NodeTraits, which provides:
+ *  - owner_type, the container, which may access the node held by an iterator;
+ *  - value_type and node_pointer;
+ *  - next( node ) and previous( node );
+ *  - item( node ), returning a reference to the item of the node.
+ *
+ * Iterators are equal when they refer to the same node, regardless of the items held.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace dsa
+{
+	// Iterator class for both mutable and const iterators.
+	template <
+		typename NodeTraits,
+		bool IsConstIterator >
+	class list_iterator
+	{
+	public:
+		using iterator_category = std::bidirectional_iterator_tag;
+		using value_type = typename NodeTraits::value_type;
+		using difference_type = std::ptrdiff_t;
+		using pointer =
+			typename std::conditional<
+				IsConstIterator,
+				const value_type*,
+				value_type* >::type;
+		using reference =
+			typename std::conditional<
+				IsConstIterator,
+				const value_type&,
+				value_type& >::type;
+		using node_pointer = typename NodeTraits::node_pointer;
+
+		list_iterator( const node_pointer input_node ) noexcept :
+			node( input_node )
+		{
+		}
+
+		list_iterator( const list_iterator< NodeTraits, false >& it ) noexcept :
+			node( it.node )
+		{
+		}
+
+		 // Copy construction for const iterators is handled by the default
+		 // generated implementation. The copy constructor specialization for
+		 // mutable iterators allows for the conversion from mutable to const.
+		list_iterator& operator=( const list_iterator< NodeTraits, false >& it ) noexcept
+		{
+			this->node = it.node;
+
+			return *this;
+		}
+
+		void
+		swap( list_iterator& it ) noexcept
+		{
+			std::swap( this->node, it.node );
+		}
+
+		list_iterator&
+		operator++() noexcept
+		{
+			this->node = NodeTraits::next( this->node );
+
+			return *this;
+		}
+
+		list_iterator
+		operator++( int ) noexcept
+		{
+			const list_iterator iterator( *this );
+			++( *this );
+
+			return iterator;
+		}
+
+		list_iterator&
+		operator--() noexcept
+		{
+			this->node = NodeTraits::previous( this->node );
+
+			return *this;
+		}
+
+		list_iterator
+		operator--( int ) noexcept
+		{
+			const list_iterator iterator( *this );
+			--( *this );
+
+			return iterator;
+		}
+
+		reference
+		operator*() const noexcept
+		{
+			return NodeTraits::item( this->node );
+		}
+
+		pointer
+		operator->() const noexcept
+		{
+			return &( **this );
+		}
+
+		bool
+		operator==( const list_iterator& it ) const noexcept
+		{
+			return ( this->node == it.node );
+		}
+
+		bool
+		operator!=( const list_iterator& it ) const noexcept
+		{
+			return !( *this == it );
+		}
+
+	private:
+		friend typename NodeTraits::owner_type;
+		friend class list_iterator< NodeTraits, !IsConstIterator >;
+
+		node_pointer node;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,617 @@
+/**
+ * Daniel Sebastian Iliescu, http://dansil.net
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ *
+ * A persistent (immutable) list, stored as a radix-balanced trie of 32-way nodes.
+ *
+ * The modifiers leave the list unchanged and return a new version, which shares every node off the
+ * path to the modified element with the original: pushing, popping or replacing an element copies
+ * O(log32 n) nodes, and copying a version is O(1). Nodes are reference counted, so a node is
+ * released with the last version using it, and versions can be read by any number of threads while
+ * another derives new ones from them (publishing a version to another thread still requires the
+ * usual synchronization, such as a mutex).
+ *
+ * The elements occupy the range [origin, origin + size) of the index space of the trie. Pushing past
+ * either end of the space adds a level above the root, placing the old root at the front (for the
+ * back) or in the middle (for the front), and popping drops the root as long as it only has a single
+ * child, so the trie is never deeper than one level more than its size requires. Node slots outside
+ * the range are empty.
+ *
+ * Nodes are allocated through the given allocator with std::allocate_shared, so each node keeps a
+ * copy of the allocator which released it, and the allocator must be thread-safe if versions are
+ * shared between threads. Copies of a version share its allocator, since they allocate nothing.
+ *
+ * front(), back(), pop_front() and pop_back() require a non-empty list.
+ */
+
+#pragma once
+
+#include "memory/allocator_propagation.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace dsa
+{
+	template <
+		typename T,
+		typename Allocator = std::allocator< T > >
+	class persistent_list
+	{
+		static constexpr std::size_t BITS = 5;
+		static constexpr std::size_t BRANCHES = std::size_t( 1 ) << BITS;
+		static constexpr std::size_t MASK = BRANCHES - 1;
+
+		struct trie_node
+		{
+		};
+
+		using node_pointer = std::shared_ptr< const trie_node >;
+
+		struct inner_node : trie_node
+		{
+			std::array< node_pointer, BRANCHES > children;
+		};
+
+		struct leaf_node : trie_node
+		{
+			std::array< std::optional< T >, BRANCHES > items;
+		};
+
+	public:
+		using value_type = T;
+		using size_type = std::size_t;
+		using reference = const value_type&;
+		using const_reference = const value_type&;
+		using allocator_type = Allocator;
+
+		// Iterates over the elements of a version, which must outlive the iterator.
+		class const_iterator
+		{
+		public:
+			using iterator_category = std::bidirectional_iterator_tag;
+			using value_type = T;
+			using difference_type = std::ptrdiff_t;
+			using pointer = const T*;
+			using reference = const T&;
+
+			const_iterator(
+				const persistent_list* const input_list,
+				const size_type input_index ) noexcept :
+				list( input_list ),
+				index( input_index ),
+				leaf( input_list->find_leaf( input_index ) )
+			{
+			}
+
+			const_iterator&
+			operator++() noexcept
+			{
+				// The leaf only changes at its boundaries.
+				if ( ( ( this->list->origin + ++( this->index ) ) & MASK ) == 0 )
+				{
+					this->leaf = this->list->find_leaf( this->index );
+				}
+
+				return *this;
+			}
+
+			const_iterator
+			operator++( int ) noexcept
+			{
+				const const_iterator iterator( *this );
+				++( *this );
+
+				return iterator;
+			}
+
+			const_iterator&
+			operator--() noexcept
+			{
+				--( this->index );
+
+				// Past the end, there is no leaf to start from.
+				if ( !this->leaf || ( ( ( this->list->origin + this->index ) & MASK ) == MASK ) )
+				{
+					this->leaf = this->list->find_leaf( this->index );
+				}
+
+				return *this;
+			}
+
+			const_iterator
+			operator--( int ) noexcept
+			{
+				const const_iterator iterator( *this );
+				--( *this );
+
+				return iterator;
+			}
+
+			reference
+			operator*() const noexcept
+			{
+				return *this->leaf->items[ ( this->list->origin + this->index ) & MASK ];
+			}
+
+			pointer
+			operator->() const noexcept
+			{
+				return &( **this );
+			}
+
+			bool
+			operator==( const const_iterator& it ) const noexcept
+			{
+				return ( this->list == it.list ) && ( this->index == it.index );
+			}
+
+			bool
+			operator!=( const const_iterator& it ) const noexcept
+			{
+				return !( *this == it );
+			}
+
+		private:
+			const persistent_list* list;
+			size_type index;
+
+			// Leaf holding the element, or null past the end.
+			const leaf_node* leaf;
+		};
+
+		using iterator = const_iterator;
+		using reverse_iterator = std::reverse_iterator< const_iterator >;
+		using const_reverse_iterator = std::reverse_iterator< const_iterator >;
+
+		persistent_list() noexcept( std::is_nothrow_default_constructible< Allocator >::value ) = default;
+
+		explicit persistent_list( const Allocator& input_allocator ) noexcept :
+			allocator( input_allocator )
+		{
+		}
+
+		template < typename InputIterator >
+		persistent_list(
+			InputIterator first,
+			InputIterator last,
+			const Allocator& input_allocator = Allocator() ) :
+			allocator( input_allocator )
+		{
+			for ( ; first != last; ++first )
+			{
+				*this = this->push_back( *first );
+			}
+		}
+
+		persistent_list(
+			std::initializer_list< T > items,
+			const Allocator& input_allocator = Allocator() ) :
+			persistent_list( std::begin( items ), std::end( items ), input_allocator )
+		{
+		}
+
+		~persistent_list() noexcept = default;
+
+		// Copies share every node and operate in constant time.
+		persistent_list( const persistent_list& ) = default;
+		persistent_list( persistent_list&& other ) noexcept :
+			allocator( other.allocator ),
+			root( std::move( other.root ) ),
+			origin( std::exchange( other.origin, 0 ) ),
+			count( std::exchange( other.count, 0 ) ),
+			shift( std::exchange( other.shift, 0 ) )
+		{
+		}
+
+		persistent_list&
+		operator=( const persistent_list& rhs ) noexcept
+		{
+			if ( this != &rhs )
+			{
+				propagate_on_copy_assignment( this->allocator, rhs.allocator );
+
+				this->root = rhs.root;
+				this->origin = rhs.origin;
+				this->count = rhs.count;
+				this->shift = rhs.shift;
+			}
+
+			return *this;
+		}
+
+		// The nodes keep the allocator which created them, so they can be taken over whatever the allocators.
+		persistent_list&
+		operator=( persistent_list&& rhs ) noexcept
+		{
+			if ( this != &rhs )
+			{
+				propagate_on_move_assignment( this->allocator, rhs.allocator );
+
+				this->root = std::move( rhs.root );
+				this->origin = std::exchange( rhs.origin, 0 );
+				this->count = std::exchange( rhs.count, 0 );
+				this->shift = std::exchange( rhs.shift, 0 );
+			}
+
+			return *this;
+		}
+
+		allocator_type
+		get_allocator() const noexcept
+		{
+			return this->allocator;
+		}
+
+		bool
+		operator==( const persistent_list& rhs ) const
+		{
+			if ( this->count != rhs.count )
+			{
+				return false;
+			}
+
+			// Versions sharing their root hold the same elements.
+			if ( ( this->root == rhs.root ) && ( this->origin == rhs.origin ) )
+			{
+				return true;
+			}
+
+			return std::equal( this->cbegin(), this->cend(), rhs.cbegin() );
+		}
+
+		bool
+		operator!=( const persistent_list& rhs ) const
+		{
+			return !( *this == rhs );
+		}
+
+		/**
+		 * Iterators
+		 */
+
+		const_iterator
+		begin() const noexcept
+		{
+			return this->cbegin();
+		}
+
+		const_iterator
+		cbegin() const noexcept
+		{
+			return const_iterator( this, 0 );
+		}
+
+		const_iterator
+		end() const noexcept
+		{
+			return this->cend();
+		}
+
+		const_iterator
+		cend() const noexcept
+		{
+			return const_iterator( this, this->count );
+		}
+
+		const_reverse_iterator
+		rbegin() const noexcept
+		{
+			return this->crbegin();
+		}
+
+		const_reverse_iterator
+		crbegin() const noexcept
+		{
+			return const_reverse_iterator( this->cend() );
+		}
+
+		const_reverse_iterator
+		rend() const noexcept
+		{
+			return this->crend();
+		}
+
+		const_reverse_iterator
+		crend() const noexcept
+		{
+			return const_reverse_iterator( this->cbegin() );
+		}
+
+		/**
+		 * Element access
+		 */
+
+		const_reference
+		front() const noexcept
+		{
+			return ( *this )[ 0 ];
+		}
+
+		const_reference
+		back() const noexcept
+		{
+			return ( *this )[ this->count - 1 ];
+		}
+
+		// Element at the given position, found in O(log32 n).
+		const_reference
+		operator[]( const size_type index ) const noexcept
+		{
+			return *this->find_leaf( index )->items[ ( this->origin + index ) & MASK ];
+		}
+
+		/**
+		 * Modifiers, which return the new version
+		 */
+
+		persistent_list
+		push_front( T item ) const
+		{
+			auto list = *this;
+
+			if ( list.empty() )
+			{
+				list.origin = BRANCHES / 2;
+			}
+			else if ( list.origin == 0 )
+			{
+				list.add_level( BRANCHES / 2 );
+			}
+
+			--( list.origin );
+			list.root = this->assign( list.root, list.shift, list.origin, std::move( item ) );
+			++( list.count );
+
+			return list;
+		}
+
+		persistent_list
+		push_back( T item ) const
+		{
+			auto list = *this;
+
+			if ( list.empty() )
+			{
+				list.origin = BRANCHES / 2;
+			}
+			else if ( list.origin + list.count == list.capacity() )
+			{
+				list.add_level( 0 );
+			}
+
+			list.root = this->assign( list.root, list.shift, list.origin + list.count, std::move( item ) );
+			++( list.count );
+
+			return list;
+		}
+
+		persistent_list
+		pop_front() const
+		{
+			if ( this->count == 1 )
+			{
+				return persistent_list( this->allocator );
+			}
+
+			auto list = *this;
+
+			list.root = this->erase( list.root, list.shift, list.origin );
+			++( list.origin );
+			--( list.count );
+			list.remove_levels();
+
+			return list;
+		}
+
+		persistent_list
+		pop_back() const
+		{
+			if ( this->count == 1 )
+			{
+				return persistent_list( this->allocator );
+			}
+
+			auto list = *this;
+
+			--( list.count );
+			list.root = this->erase( list.root, list.shift, list.origin + list.count );
+			list.remove_levels();
+
+			return list;
+		}
+
+		// Replaces the element at the given position, which must be less than the size.
+		persistent_list
+		set(
+			const size_type index,
+			T item ) const
+		{
+			auto list = *this;
+
+			list.root = this->assign( list.root, list.shift, list.origin + index, std::move( item ) );
+
+			return list;
+		}
+
+		bool
+		empty() const noexcept
+		{
+			return ( this->count == 0 );
+		}
+
+		size_type
+		size() const noexcept
+		{
+			return this->count;
+		}
+
+	private:
+		static const inner_node&
+		as_inner( const trie_node& node ) noexcept
+		{
+			return static_cast< const inner_node& >( node );
+		}
+
+		static const leaf_node&
+		as_leaf( const trie_node& node ) noexcept
+		{
+			return static_cast< const leaf_node& >( node );
+		}
+
+		// Returns a copy of the path to the position (created where missing) with the item stored at its end.
+		node_pointer
+		assign(
+			const node_pointer& node,
+			const std::size_t level,
+			const size_type position,
+			T&& item ) const
+		{
+			if ( level == 0 )
+			{
+				auto leaf = node ?
+					std::allocate_shared< leaf_node >( this->allocator, as_leaf( *node ) ) :
+					std::allocate_shared< leaf_node >( this->allocator );
+				leaf->items[ position & MASK ] = std::move( item );
+
+				return leaf;
+			}
+
+			auto inner = node ?
+				std::allocate_shared< inner_node >( this->allocator, as_inner( *node ) ) :
+				std::allocate_shared< inner_node >( this->allocator );
+			auto& child = inner->children[ ( position >> level ) & MASK ];
+
+			child = this->assign( child, level - BITS, position, std::move( item ) );
+
+			return inner;
+		}
+
+		// Returns a copy of the path to the position without its item, or null if the node is left empty.
+		node_pointer
+		erase(
+			const node_pointer& node,
+			const std::size_t level,
+			const size_type position ) const
+		{
+			const auto slot = ( position >> level ) & MASK;
+
+			if ( level == 0 )
+			{
+				const auto& items = as_leaf( *node ).items;
+
+				if ( std::none_of(
+						std::cbegin( items ),
+						std::cend( items ),
+						[&items, slot]( const std::optional< T >& item )
+						{
+							return item.has_value() && ( &item != &items[ slot ] );
+						} ) )
+				{
+					return nullptr;
+				}
+
+				auto leaf = std::allocate_shared< leaf_node >( this->allocator, as_leaf( *node ) );
+				leaf->items[ slot ].reset();
+
+				return leaf;
+			}
+
+			auto child = this->erase( as_inner( *node ).children[ slot ], level - BITS, position );
+			const auto& children = as_inner( *node ).children;
+
+			if ( !child &&
+				 std::none_of(
+					std::cbegin( children ),
+					std::cend( children ),
+					[&children, slot]( const node_pointer& other )
+					{
+						return other && ( &other != &children[ slot ] );
+					} ) )
+			{
+				return nullptr;
+			}
+
+			auto inner = std::allocate_shared< inner_node >( this->allocator, as_inner( *node ) );
+			inner->children[ slot ] = std::move( child );
+
+			return inner;
+		}
+
+		// Number of positions in the index space of the trie.
+		size_type
+		capacity() const noexcept
+		{
+			return BRANCHES << this->shift;
+		}
+
+		// Leaf holding the element at the given position, or null if it is out of range.
+		const leaf_node*
+		find_leaf( const size_type index ) const noexcept
+		{
+			if ( index >= this->count )
+			{
+				return nullptr;
+			}
+
+			const auto position = this->origin + index;
+			auto node = this->root.get();
+
+			for ( auto level = this->shift; level > 0; level -= BITS )
+			{
+				node = as_inner( *node ).children[ ( position >> level ) & MASK ].get();
+			}
+
+			return &as_leaf( *node );
+		}
+
+		// Makes the root the child of a new root at the given slot.
+		void
+		add_level( const std::size_t slot )
+		{
+			auto inner = std::allocate_shared< inner_node >( this->allocator );
+			inner->children[ slot ] = std::move( this->root );
+
+			this->root = std::move( inner );
+			this->shift += BITS;
+			this->origin += slot << this->shift;
+		}
+
+		// Replaces the root by its child as long as every element is in the same child.
+		void
+		remove_levels()
+		{
+			while ( this->shift > 0 )
+			{
+				const auto first = this->origin >> this->shift;
+				const auto last = ( this->origin + this->count - 1 ) >> this->shift;
+
+				if ( first != last )
+				{
+					break;
+				}
+
+				this->root = as_inner( *this->root ).children[ first ];
+				this->origin -= first << this->shift;
+				this->shift -= BITS;
+			}
+		}
+
+		Allocator allocator;
+
+		node_pointer root;
+
+		size_type origin = 0;
+		size_type count = 0;
+
+		// Bits of a position below the slot of the root.
+		std::size_t shift = 0;
+	};
+}
\ No newline at end of file
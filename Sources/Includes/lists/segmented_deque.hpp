@@ -0,0 +1,1131 @@
+/**
+ * Daniel Sebastian Iliescu, http://dansil.net
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ *
+ * A double-ended queue storing its elements in fixed-size blocks, reached through a map of block pointers.
+ *
+ * It offers the same modifier interface as doubly_linked_list, so a list which is mostly pushed and popped at
+ * its ends can be replaced by a segmented_deque through a type alias. Elements are stored contiguously within a
+ * block without any per-element links, which makes iteration sequential, and random access iterators are provided.
+ *
+ * Pushing and popping at either end operates in amortized constant time and never moves other elements, so
+ * references to them stay valid (iterators are invalidated when the map grows). A block emptied by a pop is kept
+ * as a spare for the next push, so alternating at a block boundary does not allocate. Insertion and erasure in
+ * the middle, splicing and merging move the elements of the shorter side and are linear.
+ *
+ * front() and back() require a non-empty deque.
+ */
+
+#pragma once
+
+#include "memory/allocator_propagation.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace dsa
+{
+	template < typename T >
+	constexpr std::size_t
+	segmented_deque_default_block_size() noexcept
+	{
+		constexpr std::size_t BLOCK_BYTES = 512;
+
+		return ( sizeof( T ) < BLOCK_BYTES ) ? BLOCK_BYTES / sizeof( T ) : 1;
+	}
+
+	template <
+		typename T,
+		std::size_t BlockSize = segmented_deque_default_block_size< T >(),
+		typename Allocator = std::allocator< T > >
+	class segmented_deque
+	{
+		static_assert( BlockSize > 0, "A block must hold at least one element." );
+
+		static constexpr std::ptrdiff_t BLOCK_SIZE = BlockSize;
+		static constexpr std::size_t MINIMUM_MAP_SIZE = 8;
+
+	public:
+		// Iterator class for both mutable and const iterators.
+		template< bool IsConstIterator >
+		class iterator_impl
+		{
+		public:
+			using iterator_category = std::random_access_iterator_tag;
+			using value_type = T;
+			using difference_type = std::ptrdiff_t;
+			using pointer =
+				typename std::conditional<
+					IsConstIterator,
+					const T*,
+					T* >::type;
+			using reference =
+				typename std::conditional<
+					IsConstIterator,
+					const T&,
+					T& >::type;
+
+			iterator_impl() noexcept = default;
+
+			iterator_impl(
+				T** const input_block,
+				T* const input_item ) noexcept :
+				block( input_block ),
+				first( input_block ? *input_block : nullptr ),
+				item( input_item )
+			{
+			}
+
+			iterator_impl( const iterator_impl< false >& it ) noexcept :
+				block( it.block ),
+				first( it.first ),
+				item( it.item )
+			{
+			}
+
+			iterator_impl& operator=( const iterator_impl< false >& it ) noexcept
+			{
+				this->block = it.block;
+				this->first = it.first;
+				this->item = it.item;
+
+				return *this;
+			}
+
+			void
+			swap( iterator_impl& it ) noexcept
+			{
+				std::swap( this->block, it.block );
+				std::swap( this->first, it.first );
+				std::swap( this->item, it.item );
+			}
+
+			iterator_impl&
+			operator++() noexcept
+			{
+				if ( ++( this->item ) == this->first + BLOCK_SIZE )
+				{
+					this->set_block( this->block + 1 );
+					this->item = this->first;
+				}
+
+				return *this;
+			}
+
+			iterator_impl
+			operator++( int ) noexcept
+			{
+				const iterator_impl iterator( *this );
+				++( *this );
+
+				return iterator;
+			}
+
+			iterator_impl&
+			operator--() noexcept
+			{
+				if ( this->item == this->first )
+				{
+					this->set_block( this->block - 1 );
+					this->item = this->first + BLOCK_SIZE;
+				}
+
+				--( this->item );
+
+				return *this;
+			}
+
+			iterator_impl
+			operator--( int ) noexcept
+			{
+				const iterator_impl iterator( *this );
+				--( *this );
+
+				return iterator;
+			}
+
+			iterator_impl&
+			operator+=( const difference_type count ) noexcept
+			{
+				const auto offset = count + ( this->item - this->first );
+
+				if ( ( offset >= 0 ) && ( offset < BLOCK_SIZE ) )
+				{
+					this->item += count;
+				}
+				else
+				{
+					// Floored division, so that negative offsets move to a preceding block.
+					const auto blocks = ( offset >= 0 ) ? ( offset / BLOCK_SIZE ) : ( -( ( -offset - 1 ) / BLOCK_SIZE ) - 1 );
+
+					this->set_block( this->block + blocks );
+					this->item = this->first + ( offset - blocks * BLOCK_SIZE );
+				}
+
+				return *this;
+			}
+
+			iterator_impl&
+			operator-=( const difference_type count ) noexcept
+			{
+				return *this += -count;
+			}
+
+			iterator_impl
+			operator+( const difference_type count ) const noexcept
+			{
+				auto iterator = *this;
+
+				return iterator += count;
+			}
+
+			friend iterator_impl
+			operator+(
+				const difference_type count,
+				const iterator_impl& it ) noexcept
+			{
+				return it + count;
+			}
+
+			iterator_impl
+			operator-( const difference_type count ) const noexcept
+			{
+				auto iterator = *this;
+
+				return iterator -= count;
+			}
+
+			difference_type
+			operator-( const iterator_impl& it ) const noexcept
+			{
+				return
+					( this->block - it.block ) * BLOCK_SIZE +
+					( this->item - this->first ) -
+					( it.item - it.first );
+			}
+
+			reference
+			operator*() const noexcept
+			{
+				return *this->item;
+			}
+
+			pointer
+			operator->() const noexcept
+			{
+				return this->item;
+			}
+
+			reference
+			operator[]( const difference_type index ) const noexcept
+			{
+				return *( *this + index );
+			}
+
+			bool
+			operator==( const iterator_impl& it ) const noexcept
+			{
+				return ( this->item == it.item ) && ( this->block == it.block );
+			}
+
+			bool
+			operator!=( const iterator_impl& it ) const noexcept
+			{
+				return !( *this == it );
+			}
+
+			bool
+			operator<( const iterator_impl& it ) const noexcept
+			{
+				return ( this->block == it.block ) ? ( this->item < it.item ) : ( this->block < it.block );
+			}
+
+			bool
+			operator>( const iterator_impl& it ) const noexcept
+			{
+				return ( it < *this );
+			}
+
+			bool
+			operator<=( const iterator_impl& it ) const noexcept
+			{
+				return !( it < *this );
+			}
+
+			bool
+			operator>=( const iterator_impl& it ) const noexcept
+			{
+				return !( *this < it );
+			}
+
+		private:
+			friend class segmented_deque;
+			friend class iterator_impl< !IsConstIterator >;
+
+			void
+			set_block( T** const input_block ) noexcept
+			{
+				this->block = input_block;
+				this->first = *input_block;
+			}
+
+			// Slot of the current block in the map, and the first element of that block.
+			T** block = nullptr;
+			T* first = nullptr;
+
+			T* item = nullptr;
+		};
+
+		using iterator = iterator_impl< false >;
+		using const_iterator = iterator_impl< true >;
+		using reverse_iterator = std::reverse_iterator< iterator >;
+		using const_reverse_iterator = std::reverse_iterator< const_iterator >;
+
+		using value_type = T;
+		using allocator_type = typename std::allocator_traits< Allocator >::template rebind_alloc< T >;
+		using size_type = std::size_t;
+		using difference_type = typename std::iterator_traits< iterator >::difference_type;
+		using reference = value_type&;
+		using const_reference = const value_type&;
+		using pointer = typename std::allocator_traits< allocator_type >::pointer;
+		using const_pointer = typename std::allocator_traits< allocator_type >::const_pointer;
+
+		static constexpr size_type block_size = BlockSize;
+
+		segmented_deque() noexcept = default;
+
+		explicit segmented_deque( const allocator_type& input_allocator ) noexcept :
+			allocator( input_allocator )
+		{
+		}
+
+		~segmented_deque() noexcept
+		{
+			this->deallocate_storage();
+		}
+
+		template < typename InputIterator >
+		segmented_deque(
+			InputIterator first,
+			InputIterator last,
+			const allocator_type& input_allocator = allocator_type() ) :
+			segmented_deque( input_allocator )
+		{
+			this->insert( this->cend(), first, last );
+		}
+
+		segmented_deque( const segmented_deque& other ) :
+			segmented_deque(
+				other.cbegin(),
+				other.cend(),
+				std::allocator_traits< allocator_type >::select_on_container_copy_construction( other.allocator ) )
+		{
+		}
+
+		segmented_deque( segmented_deque&& other ) noexcept :
+			allocator( std::move( other.allocator ) )
+		{
+			this->swap_storage( other );
+		}
+
+		// Copies the elements into the blocks of this deque, which only takes the allocator of the source if it propagates.
+		segmented_deque&
+		operator=( const segmented_deque& rhs )
+		{
+			if ( &rhs != this )
+			{
+				if constexpr ( std::allocator_traits< allocator_type >::propagate_on_container_copy_assignment::value )
+				{
+					if ( this->allocator != rhs.allocator )
+					{
+						// The map and the spare block are returned to the allocator which allocated them.
+						this->deallocate_storage();
+					}
+				}
+
+				this->clear();
+
+				propagate_on_copy_assignment( this->allocator, rhs.allocator );
+				this->insert( this->cend(), rhs.cbegin(), rhs.cend() );
+			}
+
+			return *this;
+		}
+
+		// Takes over the storage of the source, or moves its elements if its allocator neither propagates nor compares equal.
+		segmented_deque&
+		operator=( segmented_deque&& rhs ) noexcept( allocator_moves_storage_v< allocator_type > )
+		{
+			if constexpr ( !allocator_moves_storage_v< allocator_type > )
+			{
+				if ( this->allocator != rhs.allocator )
+				{
+					this->clear();
+					this->insert( this->cend(), std::make_move_iterator( rhs.begin() ), std::make_move_iterator( rhs.end() ) );
+					rhs.clear();
+
+					return *this;
+				}
+			}
+
+			propagate_on_move_assignment( this->allocator, rhs.allocator );
+			this->swap_storage( rhs );
+
+			return *this;
+		}
+
+		/**
+		 * Compares both deques block by block, each step covering the elements up to the nearest block
+		 * boundary of either deque, so that the comparison runs over contiguous arrays.
+		 */
+		bool
+		operator==( const segmented_deque& rhs ) const noexcept
+		{
+			if ( this->size() != rhs.size() )
+			{
+				return false;
+			}
+
+			auto it1 = this->begin();
+			auto it2 = rhs.begin();
+
+			for ( auto remaining = static_cast< difference_type >( this->elements ); remaining > 0; )
+			{
+				const auto count = std::min( {
+					remaining,
+					BLOCK_SIZE - ( it1.item - it1.first ),
+					BLOCK_SIZE - ( it2.item - it2.first ) } );
+
+				if ( !std::equal( it1.item, it1.item + count, it2.item ) )
+				{
+					return false;
+				}
+
+				remaining -= count;
+				it1 += count;
+				it2 += count;
+			}
+
+			return true;
+		}
+
+		bool
+		operator!=( const segmented_deque& rhs ) const noexcept
+		{
+			return !( *this == rhs );
+		}
+
+		// The allocators of both deques must compare equal, unless they propagate on swap.
+		friend void
+		swap( segmented_deque& first, segmented_deque& second ) noexcept
+		{
+			propagate_on_swap( first.allocator, second.allocator );
+			first.swap_storage( second );
+		}
+
+		allocator_type
+		get_allocator() const
+		{
+			return this->allocator;
+		}
+
+		/**
+		 * Element access
+		 */
+
+		reference
+		front() noexcept
+		{
+			return *this->item_at( this->head );
+		}
+
+		const_reference
+		front() const noexcept
+		{
+			return *this->item_at( this->head );
+		}
+
+		reference
+		back() noexcept
+		{
+			return *this->item_at( this->head + this->elements - 1 );
+		}
+
+		const_reference
+		back() const noexcept
+		{
+			return *this->item_at( this->head + this->elements - 1 );
+		}
+
+		reference
+		operator[]( const size_type index ) noexcept
+		{
+			return *this->item_at( this->head + index );
+		}
+
+		const_reference
+		operator[]( const size_type index ) const noexcept
+		{
+			return *this->item_at( this->head + index );
+		}
+
+		/**
+		 * Iterators
+		 */
+
+		iterator
+		begin() noexcept
+		{
+			return this->iterator_at( this->head );
+		}
+
+		const_iterator
+		begin() const noexcept
+		{
+			return this->iterator_at( this->head );
+		}
+
+		const_iterator
+		cbegin() const noexcept
+		{
+			return this->begin();
+		}
+
+		iterator
+		end() noexcept
+		{
+			return this->iterator_at( this->head + this->elements );
+		}
+
+		const_iterator
+		end() const noexcept
+		{
+			return this->iterator_at( this->head + this->elements );
+		}
+
+		const_iterator
+		cend() const noexcept
+		{
+			return this->end();
+		}
+
+		reverse_iterator
+		rbegin() noexcept
+		{
+			return reverse_iterator( this->end() );
+		}
+
+		const_reverse_iterator
+		rbegin() const noexcept
+		{
+			return const_reverse_iterator( this->end() );
+		}
+
+		const_reverse_iterator
+		crbegin() const noexcept
+		{
+			return this->rbegin();
+		}
+
+		reverse_iterator
+		rend() noexcept
+		{
+			return reverse_iterator( this->begin() );
+		}
+
+		const_reverse_iterator
+		rend() const noexcept
+		{
+			return const_reverse_iterator( this->begin() );
+		}
+
+		const_reverse_iterator
+		crend() const noexcept
+		{
+			return this->rend();
+		}
+
+		/**
+		 * Modifiers
+		 */
+
+		void
+		push_front( const T& item )
+		{
+			this->emplace_front( item );
+		}
+
+		void
+		push_front( T&& item )
+		{
+			this->emplace_front( std::move( item ) );
+		}
+
+		void
+		push_back( const T& item )
+		{
+			this->emplace_back( item );
+		}
+
+		void
+		push_back( T&& item )
+		{
+			this->emplace_back( std::move( item ) );
+		}
+
+		template < typename... Args >
+		reference
+		emplace_front( Args&&... args )
+		{
+			if ( this->head == 0 )
+			{
+				this->grow_map();
+			}
+
+			const auto item = this->construct_at( this->head - 1, std::forward< Args >( args )... );
+
+			--( this->head );
+			++( this->elements );
+
+			return *item;
+		}
+
+		template < typename... Args >
+		reference
+		emplace_back( Args&&... args )
+		{
+			// The block following the last element must have a slot in the map, as it holds the end iterator.
+			if ( !this->map || ( ( this->head + this->elements + 1 ) / BlockSize >= this->map_size ) )
+			{
+				this->grow_map();
+			}
+
+			const auto item = this->construct_at( this->head + this->elements, std::forward< Args >( args )... );
+
+			++( this->elements );
+
+			return *item;
+		}
+
+		T
+		pop_front() noexcept
+		{
+			if ( this->empty() )
+			{
+				return T();
+			}
+
+			auto item = std::move( this->front() );
+
+			this->destroy_front();
+
+			return item;
+		}
+
+		T
+		pop_back() noexcept
+		{
+			if ( this->empty() )
+			{
+				return T();
+			}
+
+			auto item = std::move( this->back() );
+
+			this->destroy_back();
+
+			return item;
+		}
+
+		/**
+		 * Constructs an element before the given position, returning an iterator to it. The elements
+		 * between the position and the nearest end are moved by one place.
+		 */
+		template < typename... Args >
+		iterator
+		emplace(
+			const_iterator position,
+			Args&&... args )
+		{
+			const auto index = position - this->cbegin();
+
+			if ( index == 0 )
+			{
+				this->emplace_front( std::forward< Args >( args )... );
+			}
+			else if ( index == static_cast< difference_type >( this->elements ) )
+			{
+				this->emplace_back( std::forward< Args >( args )... );
+			}
+			else
+			{
+				T item( std::forward< Args >( args )... );
+
+				if ( index < static_cast< difference_type >( this->elements / 2 ) )
+				{
+					this->emplace_front( std::move( this->front() ) );
+					std::move( this->begin() + 2, this->begin() + index + 1, this->begin() + 1 );
+				}
+				else
+				{
+					this->emplace_back( std::move( this->back() ) );
+					std::move_backward( this->begin() + index, this->end() - 2, this->end() - 1 );
+				}
+
+				this->begin()[ index ] = std::move( item );
+			}
+
+			return this->begin() + index;
+		}
+
+		iterator
+		insert(
+			const_iterator position,
+			const T& item )
+		{
+			return this->emplace( position, item );
+		}
+
+		iterator
+		insert(
+			const_iterator position,
+			T&& item )
+		{
+			return this->emplace( position, std::move( item ) );
+		}
+
+		/**
+		 * Inserts copies of [first, last) before the given position, returning an iterator to the first
+		 * inserted element. The copies are appended, then rotated into place, so the deque is left
+		 * untouched if an allocation or a copy throws.
+		 */
+		template < typename InputIterator >
+		iterator
+		insert(
+			const_iterator position,
+			InputIterator first,
+			InputIterator last )
+		{
+			const auto index = position - this->cbegin();
+			const auto old_size = this->elements;
+
+			try
+			{
+				for ( ; first != last; ++first )
+				{
+					this->emplace_back( *first );
+				}
+			}
+			catch ( ... )
+			{
+				while ( this->elements > old_size )
+				{
+					this->destroy_back();
+				}
+
+				throw;
+			}
+
+			std::rotate( this->begin() + index, this->begin() + old_size, this->end() );
+
+			return this->begin() + index;
+		}
+
+		// Removes the element at the given position, returning an iterator to the following one.
+		iterator
+		erase( const_iterator position )
+		{
+			return this->erase( position, position + 1 );
+		}
+
+		iterator
+		erase(
+			const_iterator first,
+			const_iterator last )
+		{
+			const auto index = first - this->cbegin();
+			const auto count = static_cast< size_type >( last - first );
+
+			if ( count == 0 )
+			{
+				return this->begin() + index;
+			}
+
+			// Close the gap from whichever side has fewer elements.
+			if ( static_cast< size_type >( index ) < ( this->elements - count ) / 2 )
+			{
+				std::move_backward( this->begin(), this->begin() + index, this->begin() + index + count );
+
+				for ( size_type erased = 0; erased < count; ++erased )
+				{
+					this->destroy_front();
+				}
+			}
+			else
+			{
+				std::move( this->begin() + index + count, this->end(), this->begin() + index );
+
+				for ( size_type erased = 0; erased < count; ++erased )
+				{
+					this->destroy_back();
+				}
+			}
+
+			return this->begin() + index;
+		}
+
+		// Moves every element of the other deque before the given position.
+		void
+		splice(
+			const_iterator position,
+			segmented_deque& other )
+		{
+			if ( &other == this )
+			{
+				return;
+			}
+
+			this->insert( position, std::make_move_iterator( other.begin() ), std::make_move_iterator( other.end() ) );
+
+			other.clear();
+		}
+
+		// Moves the element at it (in the other deque) before the given position.
+		void
+		splice(
+			const_iterator position,
+			segmented_deque& other,
+			const_iterator it )
+		{
+			this->splice( position, other, it, it + 1 );
+		}
+
+		// Moves [first, last) from the other deque before the given position, which must not lie in the range.
+		void
+		splice(
+			const_iterator position,
+			segmented_deque& other,
+			const_iterator first,
+			const_iterator last )
+		{
+			if ( first == last )
+			{
+				return;
+			}
+
+			if ( &other == this )
+			{
+				// A position at either end of the range (or inside it) leaves the order unchanged.
+				if ( !( position < first ) && !( last < position ) )
+				{
+					return;
+				}
+
+				if ( position < first )
+				{
+					std::rotate( this->mutable_iterator( position ), this->mutable_iterator( first ), this->mutable_iterator( last ) );
+				}
+				else
+				{
+					std::rotate( this->mutable_iterator( first ), this->mutable_iterator( last ), this->mutable_iterator( position ) );
+				}
+
+				return;
+			}
+
+			this->insert(
+				position,
+				std::make_move_iterator( other.mutable_iterator( first ) ),
+				std::make_move_iterator( other.mutable_iterator( last ) ) );
+
+			other.erase( first, last );
+		}
+
+		/**
+		 * Merges the other sorted deque into this sorted deque, leaving it empty. The merge is stable:
+		 * equivalent elements of this deque precede those of the other deque.
+		 */
+		template < typename Compare = std::less<> >
+		void
+		merge(
+			segmented_deque& other,
+			Compare compare = Compare() )
+		{
+			if ( &other == this )
+			{
+				return;
+			}
+
+			const auto old_size = this->elements;
+
+			this->splice( this->cend(), other );
+
+			std::inplace_merge( this->begin(), this->begin() + old_size, this->end(), compare );
+		}
+
+		// Destroys every element and returns the blocks, keeping the map for further pushes.
+		void
+		clear() noexcept
+		{
+			if ( !std::is_trivially_destructible< T >::value )
+			{
+				for ( auto it = this->begin(); it != this->end(); ++it )
+				{
+					std::allocator_traits< allocator_type >::destroy( this->allocator, std::addressof( *it ) );
+				}
+			}
+
+			for ( size_type slot = 0; slot < this->map_size; ++slot )
+			{
+				if ( this->map[ slot ] )
+				{
+					std::allocator_traits< allocator_type >::deallocate( this->allocator, this->map[ slot ], BlockSize );
+					this->map[ slot ] = nullptr;
+				}
+			}
+
+			this->head = ( this->map_size / 2 ) * BlockSize;
+			this->elements = 0;
+		}
+
+		bool
+		empty() const noexcept
+		{
+			return ( this->elements == 0 );
+		}
+
+		size_type
+		size() const noexcept
+		{
+			return this->elements;
+		}
+
+		size_type
+		max_size() const noexcept
+		{
+			return std::allocator_traits< allocator_type >::max_size( this->allocator );
+		}
+
+	private:
+		using map_allocator_type = typename std::allocator_traits< Allocator >::template rebind_alloc< T* >;
+
+		T*
+		item_at( const size_type index ) const noexcept
+		{
+			return this->map[ index / BlockSize ] + index % BlockSize;
+		}
+
+		iterator
+		iterator_at( const size_type index ) const noexcept
+		{
+			if ( !this->map )
+			{
+				return iterator();
+			}
+
+			const auto block = this->map + index / BlockSize;
+
+			return iterator( block, *block + index % BlockSize );
+		}
+
+		iterator
+		mutable_iterator( const const_iterator it ) noexcept
+		{
+			return this->begin() + ( it - this->cbegin() );
+		}
+
+		// Destroys every element and returns all of the storage, leaving an empty deque without a map.
+		void
+		deallocate_storage() noexcept
+		{
+			this->clear();
+
+			if ( this->spare )
+			{
+				std::allocator_traits< allocator_type >::deallocate( this->allocator, this->spare, BlockSize );
+				this->spare = nullptr;
+			}
+
+			if ( this->map )
+			{
+				map_allocator_type map_allocator( this->allocator );
+				std::allocator_traits< map_allocator_type >::deallocate( map_allocator, this->map, this->map_size );
+
+				this->map = nullptr;
+				this->map_size = 0;
+				this->head = 0;
+			}
+		}
+
+		void
+		swap_storage( segmented_deque& other ) noexcept
+		{
+			using std::swap;
+
+			swap( this->map, other.map );
+			swap( this->map_size, other.map_size );
+			swap( this->spare, other.spare );
+			swap( this->head, other.head );
+			swap( this->elements, other.elements );
+		}
+
+		T*
+		acquire_block()
+		{
+			if ( this->spare )
+			{
+				return std::exchange( this->spare, nullptr );
+			}
+
+			return std::allocator_traits< allocator_type >::allocate( this->allocator, BlockSize );
+		}
+
+		void
+		release_block( T*& block ) noexcept
+		{
+			if ( this->spare )
+			{
+				std::allocator_traits< allocator_type >::deallocate( this->allocator, block, BlockSize );
+			}
+			else
+			{
+				this->spare = block;
+			}
+
+			block = nullptr;
+		}
+
+		// Constructs an element at the given index, allocating its block if needed.
+		template < typename... Args >
+		T*
+		construct_at(
+			const size_type index,
+			Args&&... args )
+		{
+			auto& block = this->map[ index / BlockSize ];
+			const auto allocated = !block;
+
+			if ( allocated )
+			{
+				block = this->acquire_block();
+			}
+
+			const auto item = block + index % BlockSize;
+
+			try
+			{
+				std::allocator_traits< allocator_type >::construct( this->allocator, item, std::forward< Args >( args )... );
+			}
+			catch ( ... )
+			{
+				if ( allocated )
+				{
+					this->release_block( block );
+				}
+
+				throw;
+			}
+
+			return item;
+		}
+
+		void
+		destroy_front() noexcept
+		{
+			auto& block = this->map[ this->head / BlockSize ];
+
+			std::allocator_traits< allocator_type >::destroy( this->allocator, block + this->head % BlockSize );
+
+			++( this->head );
+			--( this->elements );
+
+			if ( this->head % BlockSize == 0 )
+			{
+				this->release_block( block );
+			}
+		}
+
+		void
+		destroy_back() noexcept
+		{
+			const auto index = this->head + this->elements - 1;
+			auto& block = this->map[ index / BlockSize ];
+
+			std::allocator_traits< allocator_type >::destroy( this->allocator, block + index % BlockSize );
+
+			--( this->elements );
+
+			if ( index % BlockSize == 0 )
+			{
+				this->release_block( block );
+			}
+		}
+
+		/**
+		 * Recenters the used slots of the map, leaving at least one free slot on either side. The map is
+		 * only reallocated (doubling its size) when the used slots take more than half of it. Slots outside
+		 * of the used range are always null, so recentering in place is a rotation.
+		 */
+		void
+		grow_map()
+		{
+			const auto first_slot = this->head / BlockSize;
+			const auto used = this->map ? ( ( this->head + this->elements ) / BlockSize - first_slot + 1 ) : 0;
+
+			if ( this->map && ( 2 * ( used + 1 ) <= this->map_size ) )
+			{
+				const auto new_first_slot = ( this->map_size - used ) / 2;
+				const auto slots = this->map;
+
+				if ( new_first_slot < first_slot )
+				{
+					std::rotate( slots + new_first_slot, slots + first_slot, slots + first_slot + used );
+				}
+				else
+				{
+					std::rotate( slots + first_slot, slots + first_slot + used, slots + new_first_slot + used );
+				}
+
+				this->head = new_first_slot * BlockSize + this->head % BlockSize;
+
+				return;
+			}
+
+			map_allocator_type map_allocator( this->allocator );
+
+			const auto new_map_size = std::max( MINIMUM_MAP_SIZE, 2 * ( used + 1 ) );
+			const auto new_map = std::allocator_traits< map_allocator_type >::allocate( map_allocator, new_map_size );
+			const auto new_first_slot = ( new_map_size - used ) / 2;
+
+			std::fill( new_map, new_map + new_map_size, nullptr );
+
+			if ( this->map )
+			{
+				std::copy( this->map + first_slot, this->map + first_slot + used, new_map + new_first_slot );
+				std::allocator_traits< map_allocator_type >::deallocate( map_allocator, this->map, this->map_size );
+			}
+
+			this->map = new_map;
+			this->map_size = new_map_size;
+			this->head = new_first_slot * BlockSize + this->head % BlockSize;
+		}
+
+		allocator_type allocator;
+
+		// Block pointers; the slots outside of the blocks holding elements (and the end position) are null.
+		T** map = nullptr;
+		size_type map_size = 0;
+
+		// Most recently emptied block, reused by the next push needing a block.
+		T* spare = nullptr;
+
+		// Position of the first element, counted in elements from the start of the map.
+		size_type head = 0;
+		size_type elements = 0;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,598 @@
+/**
+ * Daniel Sebastian Iliescu, http://dansil.net
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ *
+ * An ordered map over a skip list (Pugh, 1990), with an optional lock-free concurrent mode.
+ *
+ * Every node holds a key-value pair and a random number of forward links, which are stored
+ * inline after the pair, so a node is a single variable-size allocation. Level zero links all
+ * the nodes in key order; each higher level skips over about half of the nodes of the level
+ * below, so lookups, insertions and erasures take logarithmic expected time.
+ *
+ * In concurrent mode, insert, find, lower_bound, contains and iteration may be called from any
+ * number of threads at once and are lock-free: a node is published at level zero with a CAS,
+ * then linked into its higher levels one CAS at a time, retrying the search for a level when
+ * another insertion changed it (Herlihy, Lev, Luchangco and Shavit, 2006). Iterators see the
+ * nodes linked so far. Since nodes are never unlinked concurrently, no reclamation scheme is
+ * needed; erase and clear must not run concurrently with any other operation. In the default
+ * sequential mode, the same code runs with relaxed memory orderings.
+ *
+ * Nodes are allocated through the given allocator, rebound to blocks of the alignment of a node,
+ * so it must be thread-safe for concurrent insertions (as std::allocator is).
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace dsa
+{
+	template <
+		typename Key,
+		typename Value,
+		typename Compare = std::less< Key >,
+		bool Concurrent = false,
+		typename Allocator = std::allocator< std::pair< const Key, Value > > >
+	class skip_list
+	{
+		static constexpr std::size_t MAXIMUM_HEIGHT = 32;
+
+		static constexpr auto LOAD_ORDER = Concurrent ? std::memory_order_acquire : std::memory_order_relaxed;
+
+		struct skip_node;
+
+		using link_type = std::atomic< skip_node* >;
+
+		// The links of a node follow it in the same allocation.
+		struct alignas( link_type ) skip_node
+		{
+			template < typename... Args >
+			skip_node(
+				const std::size_t input_height,
+				Args&&... args ) :
+				item( std::forward< Args >( args )... ),
+				height( input_height )
+			{
+			}
+
+			link_type*
+			links() noexcept
+			{
+				return std::launder( reinterpret_cast< link_type* >( this + 1 ) );
+			}
+
+			std::pair< const Key, Value > item;
+			std::size_t height;
+		};
+
+		// Unit of allocation, so that a node and its links take a whole number of blocks.
+		struct alignas( skip_node ) node_block
+		{
+			unsigned char bytes[ alignof( skip_node ) ];
+		};
+
+	public:
+		// Forward iterator class for both mutable and const iterators, over level zero.
+		template< bool IsConstIterator >
+		class iterator_impl
+		{
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using value_type = std::pair< const Key, Value >;
+			using difference_type = std::ptrdiff_t;
+			using pointer =
+				typename std::conditional<
+					IsConstIterator,
+					const value_type*,
+					value_type* >::type;
+			using reference =
+				typename std::conditional<
+					IsConstIterator,
+					const value_type&,
+					value_type& >::type;
+
+			iterator_impl( skip_node* const input_node = nullptr ) noexcept :
+				node( input_node )
+			{
+			}
+
+			iterator_impl( const iterator_impl< false >& it ) noexcept :
+				node( it.node )
+			{
+			}
+
+			iterator_impl& operator=( const iterator_impl< false >& it ) noexcept
+			{
+				this->node = it.node;
+
+				return *this;
+			}
+
+			iterator_impl&
+			operator++() noexcept
+			{
+				this->node = this->node->links()[ 0 ].load( LOAD_ORDER );
+
+				return *this;
+			}
+
+			iterator_impl
+			operator++( int ) noexcept
+			{
+				const iterator_impl iterator( *this );
+				++( *this );
+
+				return iterator;
+			}
+
+			reference
+			operator*() const noexcept
+			{
+				return this->node->item;
+			}
+
+			pointer
+			operator->() const noexcept
+			{
+				return &this->node->item;
+			}
+
+			bool
+			operator==( const iterator_impl& it ) const noexcept
+			{
+				return ( this->node == it.node );
+			}
+
+			bool
+			operator!=( const iterator_impl& it ) const noexcept
+			{
+				return !( *this == it );
+			}
+
+		private:
+			friend class skip_list;
+			friend class iterator_impl< !IsConstIterator >;
+
+			skip_node* node;
+		};
+
+		using iterator = iterator_impl< false >;
+		using const_iterator = iterator_impl< true >;
+
+		using key_type = Key;
+		using mapped_type = Value;
+		using value_type = std::pair< const Key, Value >;
+		using size_type = std::size_t;
+		using key_compare = Compare;
+		using reference = value_type&;
+		using const_reference = const value_type&;
+		using allocator_type = typename std::allocator_traits< Allocator >::template rebind_alloc< node_block >;
+
+		static constexpr bool is_concurrent = Concurrent;
+
+		explicit skip_list(
+			Compare input_compare = Compare(),
+			const allocator_type& input_allocator = allocator_type() ) :
+			compare( std::move( input_compare ) ),
+			allocator( input_allocator )
+		{
+		}
+
+		explicit skip_list( const allocator_type& input_allocator ) :
+			skip_list( Compare(), input_allocator )
+		{
+		}
+
+		~skip_list() noexcept
+		{
+			this->clear();
+		}
+
+		skip_list( const skip_list& ) = delete;
+		skip_list( skip_list&& ) = delete;
+
+		skip_list& operator=( const skip_list& ) = delete;
+		skip_list& operator=( skip_list&& ) = delete;
+
+		allocator_type
+		get_allocator() const noexcept
+		{
+			return this->allocator;
+		}
+
+		/**
+		 * Iterators
+		 */
+
+		iterator
+		begin() noexcept
+		{
+			return iterator( this->head[ 0 ].load( LOAD_ORDER ) );
+		}
+
+		const_iterator
+		begin() const noexcept
+		{
+			return const_iterator( this->head[ 0 ].load( LOAD_ORDER ) );
+		}
+
+		const_iterator
+		cbegin() const noexcept
+		{
+			return this->begin();
+		}
+
+		iterator
+		end() noexcept
+		{
+			return iterator();
+		}
+
+		const_iterator
+		end() const noexcept
+		{
+			return const_iterator();
+		}
+
+		const_iterator
+		cend() const noexcept
+		{
+			return this->end();
+		}
+
+		/**
+		 * Lookup
+		 */
+
+		iterator
+		find( const Key& key ) noexcept
+		{
+			const auto node = this->lower_bound_node( key );
+
+			return iterator( ( node && !this->compare( key, node->item.first ) ) ? node : nullptr );
+		}
+
+		const_iterator
+		find( const Key& key ) const noexcept
+		{
+			return const_cast< skip_list* >( this )->find( key );
+		}
+
+		// First item whose key is not less than the given key.
+		iterator
+		lower_bound( const Key& key ) noexcept
+		{
+			return iterator( this->lower_bound_node( key ) );
+		}
+
+		const_iterator
+		lower_bound( const Key& key ) const noexcept
+		{
+			return const_iterator( const_cast< skip_list* >( this )->lower_bound_node( key ) );
+		}
+
+		bool
+		contains( const Key& key ) const noexcept
+		{
+			return ( this->find( key ) != this->end() );
+		}
+
+		/**
+		 * Modifiers
+		 */
+
+		/**
+		 * Inserts the key with a value constructed from the arguments, unless the key is present.
+		 * Returns an iterator to the item of the key and whether it was inserted.
+		 */
+		template < typename... Args >
+		std::pair< iterator, bool >
+		try_emplace(
+			const Key& key,
+			Args&&... args )
+		{
+			link_type* predecessors[ MAXIMUM_HEIGHT ];
+			skip_node* successors[ MAXIMUM_HEIGHT ];
+
+			if ( const auto existing = this->search( key, predecessors, successors ) )
+			{
+				return { iterator( existing ), false };
+			}
+
+			const auto height = this->random_height();
+			const auto node = this->create_node(
+				height,
+				std::piecewise_construct,
+				std::forward_as_tuple( key ),
+				std::forward_as_tuple( std::forward< Args >( args )... ) );
+
+			// Publish the node at level zero; a failed CAS means another thread changed the neighbourhood.
+			while ( true )
+			{
+				node->links()[ 0 ].store( successors[ 0 ], std::memory_order_relaxed );
+
+				if ( publish( predecessors[ 0 ][ 0 ], successors[ 0 ], node ) )
+				{
+					break;
+				}
+
+				if ( const auto existing = this->search( key, predecessors, successors ) )
+				{
+					this->destroy_node( node );
+
+					return { iterator( existing ), false };
+				}
+			}
+
+			this->items.fetch_add( 1, std::memory_order_relaxed );
+			this->raise_height( height );
+
+			for ( std::size_t level = 1; level < height; ++level )
+			{
+				while ( true )
+				{
+					auto successor = successors[ level ];
+
+					node->links()[ level ].store( successor, std::memory_order_relaxed );
+
+					if ( publish( predecessors[ level ][ level ], successor, node ) )
+					{
+						break;
+					}
+
+					this->search( key, predecessors, successors, node );
+				}
+			}
+
+			return { iterator( node ), true };
+		}
+
+		std::pair< iterator, bool >
+		insert( const value_type& item )
+		{
+			return this->try_emplace( item.first, item.second );
+		}
+
+		std::pair< iterator, bool >
+		insert( value_type&& item )
+		{
+			return this->try_emplace( item.first, std::move( item.second ) );
+		}
+
+		// Removes the key; returns whether it was present. Not thread-safe in concurrent mode.
+		bool
+		erase( const Key& key )
+		{
+			link_type* predecessors[ MAXIMUM_HEIGHT ];
+			skip_node* successors[ MAXIMUM_HEIGHT ];
+
+			const auto node = this->search( key, predecessors, successors );
+
+			if ( !node )
+			{
+				return false;
+			}
+
+			for ( std::size_t level = 0; level < node->height; ++level )
+			{
+				predecessors[ level ][ level ].store( node->links()[ level ].load( std::memory_order_relaxed ), std::memory_order_relaxed );
+			}
+
+			this->destroy_node( node );
+
+			this->items.fetch_sub( 1, std::memory_order_relaxed );
+
+			return true;
+		}
+
+		// Not thread-safe in concurrent mode.
+		void
+		clear() noexcept
+		{
+			for ( auto node = this->head[ 0 ].load( std::memory_order_relaxed ); node; )
+			{
+				const auto next_node = node->links()[ 0 ].load( std::memory_order_relaxed );
+
+				this->destroy_node( node );
+				node = next_node;
+			}
+
+			for ( auto& link : this->head )
+			{
+				link.store( nullptr, std::memory_order_relaxed );
+			}
+
+			this->levels.store( 1, std::memory_order_relaxed );
+			this->items.store( 0, std::memory_order_relaxed );
+		}
+
+		/**
+		 * Capacity
+		 */
+
+		bool
+		empty() const noexcept
+		{
+			return ( this->head[ 0 ].load( LOAD_ORDER ) == nullptr );
+		}
+
+		// In concurrent mode, a snapshot which may lag behind insertions in progress.
+		size_type
+		size() const noexcept
+		{
+			return this->items.load( std::memory_order_relaxed );
+		}
+
+	private:
+		// Number of blocks holding a node and its links.
+		static std::size_t
+		node_blocks( const std::size_t height ) noexcept
+		{
+			return ( sizeof( skip_node ) + height * sizeof( link_type ) + sizeof( node_block ) - 1 ) / sizeof( node_block );
+		}
+
+		template < typename... Args >
+		skip_node*
+		create_node(
+			const std::size_t height,
+			Args&&... args )
+		{
+			const auto memory = std::allocator_traits< allocator_type >::allocate( this->allocator, node_blocks( height ) );
+
+			skip_node* node;
+
+			try
+			{
+				node = ::new ( static_cast< void* >( memory ) ) skip_node( height, std::forward< Args >( args )... );
+			}
+			catch ( ... )
+			{
+				std::allocator_traits< allocator_type >::deallocate( this->allocator, memory, node_blocks( height ) );
+				throw;
+			}
+
+			for ( std::size_t level = 0; level < height; ++level )
+			{
+				::new ( static_cast< void* >( node->links() + level ) ) link_type( nullptr );
+			}
+
+			return node;
+		}
+
+		void
+		destroy_node( skip_node* const node ) noexcept
+		{
+			const auto blocks = node_blocks( node->height );
+
+			// The links are trivially destructible.
+			node->~skip_node();
+
+			std::allocator_traits< allocator_type >::deallocate( this->allocator, reinterpret_cast< node_block* >( node ), blocks );
+		}
+
+		skip_node*
+		lower_bound_node( const Key& key ) noexcept
+		{
+			auto links = this->head;
+			skip_node* next = nullptr;
+
+			for ( auto level = this->levels.load( std::memory_order_relaxed ); level-- > 0; )
+			{
+				while ( ( next = links[ level ].load( LOAD_ORDER ) ) && this->compare( next->item.first, key ) )
+				{
+					links = next->links();
+				}
+			}
+
+			return next;
+		}
+
+		/**
+		 * Fills, for every level, the links after which the key belongs and the node they point to.
+		 * Returns the node holding the key, if any other than the excluded one.
+		 */
+		skip_node*
+		search(
+			const Key& key,
+			link_type** const predecessors,
+			skip_node** const successors,
+			const skip_node* const excluded = nullptr ) noexcept
+		{
+			auto links = this->head;
+
+			for ( auto level = MAXIMUM_HEIGHT; level-- > 0; )
+			{
+				skip_node* next;
+
+				while ( ( next = links[ level ].load( LOAD_ORDER ) ) && this->compare( next->item.first, key ) )
+				{
+					links = next->links();
+				}
+
+				predecessors[ level ] = links;
+				successors[ level ] = next;
+			}
+
+			const auto found = successors[ 0 ];
+
+			return ( found && ( found != excluded ) && !this->compare( key, found->item.first ) ) ? found : nullptr;
+		}
+
+		// Points the link to the node if it still points to the expected successor.
+		static bool
+		publish(
+			link_type& link,
+			skip_node*& successor,
+			skip_node* const node ) noexcept
+		{
+			if constexpr ( Concurrent )
+			{
+				return link.compare_exchange_strong( successor, node, std::memory_order_release, std::memory_order_relaxed );
+			}
+			else
+			{
+				link.store( node, std::memory_order_relaxed );
+
+				return true;
+			}
+		}
+
+		// Geometric height with p = 1/2, from a SplitMix64 step of a shared counter.
+		std::size_t
+		random_height() noexcept
+		{
+			auto z = this->height_seed.fetch_add( 0x9E3779B97F4A7C15ULL, std::memory_order_relaxed );
+
+			z = ( z ^ ( z >> 30 ) ) * 0xBF58476D1CE4E5B9ULL;
+			z = ( z ^ ( z >> 27 ) ) * 0x94D049BB133111EBULL;
+			z ^= ( z >> 31 );
+
+			std::size_t height = 1;
+
+			while ( ( height < MAXIMUM_HEIGHT ) && ( z & 1 ) )
+			{
+				++height;
+				z >>= 1;
+			}
+
+			return height;
+		}
+
+		// Lets lookups start from the highest level in use.
+		void
+		raise_height( const std::size_t height ) noexcept
+		{
+			auto current = this->levels.load( std::memory_order_relaxed );
+
+			while ( ( current < height ) &&
+					!this->levels.compare_exchange_weak( current, height, std::memory_order_relaxed ) )
+			{
+			}
+		}
+
+		Compare compare;
+		allocator_type allocator;
+
+		link_type head[ MAXIMUM_HEIGHT ] {};
+
+		std::atomic< std::size_t > levels { 1 };
+		std::atomic< std::size_t > items { 0 };
+		std::atomic< std::uint64_t > height_seed { 0 };
+	};
+
+	template <
+		typename Key,
+		typename Value,
+		typename Compare = std::less< Key >,
+		typename Allocator = std::allocator< std::pair< const Key, Value > > >
+	using concurrent_skip_list = skip_list< Key, Value, Compare, true, Allocator >;
+}
\ No newline at end of file
@@ -0,0 +1,280 @@
+/**
+ * Daniel Sebastian Iliescu, http://dansil.net
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ *
+ * A wait-free single-producer single-consumer FIFO ring buffer.
+ *
+ * The producer only writes the back index and the consumer only writes the front index, so
+ * no read-modify-write operation is needed. Each side keeps its own index and a cached copy
+ * of the other side's index on its own cache line, and only reloads the shared index when
+ * the cached copy says the ring is full (producer) or empty (consumer). The batch operations
+ * publish all of their items with a single store.
+ *
+ * The modifiers keep the push_back/pop_front naming of doubly_linked_list and report failure
+ * when the ring is full or empty instead of blocking. Exactly one thread may push and exactly
+ * one thread may pop at any time. size() and empty() are snapshots.
+ */
+
+#pragma once
+
+#include "memory/cache_line.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace dsa
+{
+	template <
+		typename T,
+		std::size_t Capacity >
+	class spsc_ring
+	{
+		static_assert( ( Capacity >= 2 ) && ( ( Capacity & ( Capacity - 1 ) ) == 0 ), "The capacity must be a power of two." );
+
+		struct alignas( T ) cell
+		{
+			unsigned char storage[ sizeof( T ) ];
+		};
+
+	public:
+		using value_type = T;
+		using size_type = std::size_t;
+		using reference = value_type&;
+		using const_reference = const value_type&;
+
+		spsc_ring() :
+			cells( new cell[ Capacity ] )
+		{
+		}
+
+		~spsc_ring() noexcept
+		{
+			const auto back = this->producer.index.load();
+
+			for ( auto position = this->consumer.index.load(); position != back; ++position )
+			{
+				this->item( position )->~T();
+			}
+		}
+
+		spsc_ring( const spsc_ring& ) = delete;
+		spsc_ring( spsc_ring&& ) = delete;
+
+		spsc_ring& operator=( const spsc_ring& ) = delete;
+		spsc_ring& operator=( spsc_ring&& ) = delete;
+
+		/**
+		 * Producer modifiers
+		 */
+
+		// Returns false (leaving the item untouched) if the ring is full.
+		bool
+		push_back( const T& item )
+		{
+			return this->emplace_back( item );
+		}
+
+		bool
+		push_back( T&& item )
+		{
+			return this->emplace_back( std::move( item ) );
+		}
+
+		template < typename... Args >
+		bool
+		emplace_back( Args&&... args )
+		{
+			const auto back = this->producer.index.load( std::memory_order_relaxed );
+
+			if ( this->free_slots( back, 1 ) == 0 )
+			{
+				return false;
+			}
+
+			::new ( static_cast< void* >( this->cells[ back & MASK ].storage ) ) T( std::forward< Args >( args )... );
+
+			this->producer.index.store( back + 1, std::memory_order_release );
+
+			return true;
+		}
+
+		/**
+		 * Pushes up to count items from the input and returns how many were pushed. If constructing
+		 * an item throws, none of the batch is pushed.
+		 */
+		template < typename InputIterator >
+		size_type
+		push_n(
+			InputIterator input,
+			const size_type count )
+		{
+			const auto back = this->producer.index.load( std::memory_order_relaxed );
+			const auto pushed = std::min( count, this->free_slots( back, count ) );
+
+			size_type offset = 0;
+
+			try
+			{
+				for ( ; offset < pushed; ++offset, ++input )
+				{
+					::new ( static_cast< void* >( this->cells[ ( back + offset ) & MASK ].storage ) ) T( *input );
+				}
+			}
+			catch ( ... )
+			{
+				// The items are not published yet, so the consumer cannot be reading them.
+				while ( offset > 0 )
+				{
+					this->item( back + --offset )->~T();
+				}
+
+				throw;
+			}
+
+			this->producer.index.store( back + pushed, std::memory_order_release );
+
+			return pushed;
+		}
+
+		/**
+		 * Consumer modifiers
+		 */
+
+		// Moves the front item into the argument; returns false if the ring was empty.
+		bool
+		pop_front( T& item )
+		{
+			const auto front = this->consumer.index.load( std::memory_order_relaxed );
+
+			if ( this->available_items( front, 1 ) == 0 )
+			{
+				return false;
+			}
+
+			const auto front_item = this->item( front );
+
+			item = std::move( *front_item );
+			front_item->~T();
+
+			this->consumer.index.store( front + 1, std::memory_order_release );
+
+			return true;
+		}
+
+		/**
+		 * Pops up to count items into the output and returns how many were popped. If writing an
+		 * item throws, the items already written are popped and the others are left in the ring.
+		 */
+		template < typename OutputIterator >
+		size_type
+		pop_n(
+			OutputIterator output,
+			const size_type count )
+		{
+			const auto front = this->consumer.index.load( std::memory_order_relaxed );
+			const auto popped = std::min( count, this->available_items( front, count ) );
+
+			size_type offset = 0;
+
+			try
+			{
+				for ( ; offset < popped; ++offset, ++output )
+				{
+					const auto front_item = this->item( front + offset );
+
+					*output = std::move( *front_item );
+					front_item->~T();
+				}
+			}
+			catch ( ... )
+			{
+				this->consumer.index.store( front + offset, std::memory_order_release );
+
+				throw;
+			}
+
+			this->consumer.index.store( front + popped, std::memory_order_release );
+
+			return popped;
+		}
+
+		bool
+		empty() const noexcept
+		{
+			return ( this->size() == 0 );
+		}
+
+		size_type
+		size() const noexcept
+		{
+			const auto front = this->consumer.index.load( std::memory_order_acquire );
+			const auto back = this->producer.index.load( std::memory_order_acquire );
+
+			return back - front;
+		}
+
+		static constexpr size_type
+		capacity() noexcept
+		{
+			return Capacity;
+		}
+
+	private:
+		static constexpr size_type MASK = Capacity - 1;
+
+		// The indices grow without bound and are masked on access.
+		struct alignas( cache_line_size ) side
+		{
+			std::atomic< size_type > index { 0 };
+
+			// Last observed index of the other side, only accessed by this side's thread.
+			size_type cached_index = 0;
+		};
+
+		T*
+		item( const size_type position ) noexcept
+		{
+			return std::launder( reinterpret_cast< T* >( this->cells[ position & MASK ].storage ) );
+		}
+
+		// Free slots, reloading the front index only if the cached one shows fewer than wanted.
+		size_type
+		free_slots(
+			const size_type back,
+			const size_type wanted ) noexcept
+		{
+			if ( ( Capacity - ( back - this->producer.cached_index ) ) < wanted )
+			{
+				this->producer.cached_index = this->consumer.index.load( std::memory_order_acquire );
+			}
+
+			return Capacity - ( back - this->producer.cached_index );
+		}
+
+		// Available items, reloading the back index only if the cached one shows fewer than wanted.
+		size_type
+		available_items(
+			const size_type front,
+			const size_type wanted ) noexcept
+		{
+			if ( ( this->consumer.cached_index - front ) < wanted )
+			{
+				this->consumer.cached_index = this->producer.index.load( std::memory_order_acquire );
+			}
+
+			return this->consumer.cached_index - front;
+		}
+
+		const std::unique_ptr< cell[] > cells;
+
+		// Back index written by the producer, with its cached front index.
+		side producer;
+
+		// Front index written by the consumer, with its cached back index.
+		side consumer;
+	};
+}
\ No newline at end of file
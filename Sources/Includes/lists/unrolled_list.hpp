@@ -0,0 +1,1097 @@
+/**
+ * Daniel Sebastian Iliescu, http://dansil.net
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ *
+ * An unrolled doubly-linked list, where each node holds up to N elements in a small array.
+ *
+ * It offers the same iterator and modifier interface as doubly_linked_list. Iteration only
+ * follows a pointer once every N elements, and the elements of a node are contiguous, which
+ * makes traversal bound by memory bandwidth rather than by dependent loads. By default N is
+ * chosen so that a node spans two cache lines.
+ *
+ * Pushing, popping, and inserting or erasing a single element operate in constant time, since
+ * at most N elements of one node are moved: a full node is split in two to make room. Inserting
+ * or erasing an element invalidates the iterators to the other elements of its node, except that
+ * erasing keeps the following elements in place. Range insertion builds new nodes which are then
+ * linked in, and splicing a whole list only relinks its nodes (after splitting the node at the
+ * position), whereas splicing a range moves its elements and is linear in their number, as is
+ * merging.
+ */
+
+#pragma once
+
+#include "memory/allocator_propagation.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace dsa
+{
+	template < typename T >
+	constexpr std::size_t
+	unrolled_list_default_capacity() noexcept
+	{
+		constexpr std::size_t NODE_BYTES = 128;
+		constexpr std::size_t HEADER_BYTES = 2 * sizeof( void* ) + 2 * sizeof( std::size_t );
+
+		return ( sizeof( T ) < NODE_BYTES - HEADER_BYTES ) ? ( NODE_BYTES - HEADER_BYTES ) / sizeof( T ) : 1;
+	}
+
+	template <
+		typename T,
+		std::size_t N = unrolled_list_default_capacity< T >(),
+		typename Allocator = std::allocator< T > >
+	class unrolled_list
+	{
+		static_assert( N > 0, "A node must hold at least one element." );
+
+		// Links and occupied range [first, last) of a node; the list sentinel only has these.
+		struct node_links
+		{
+			node_links* previous = nullptr;
+			node_links* next = nullptr;
+
+			std::size_t first = 0;
+			std::size_t last = 0;
+		};
+
+	public:
+		struct unrolled_node : node_links
+		{
+			T*
+			items() noexcept
+			{
+				return reinterpret_cast< T* >( this->storage );
+			}
+
+			const T*
+			items() const noexcept
+			{
+				return reinterpret_cast< const T* >( this->storage );
+			}
+
+			alignas( T ) unsigned char storage[ N * sizeof( T ) ];
+		};
+
+		// Iterator class for both mutable and const iterators.
+		template< bool IsConstIterator >
+		class iterator_impl
+		{
+		public:
+			using iterator_category = std::bidirectional_iterator_tag;
+			using value_type = T;
+			using difference_type = std::ptrdiff_t;
+			using pointer =
+				typename std::conditional<
+					IsConstIterator,
+					const T*,
+					T* >::type;
+			using reference =
+				typename std::conditional<
+					IsConstIterator,
+					const T&,
+					T& >::type;
+
+			iterator_impl(
+				node_links* const input_node,
+				const std::size_t input_index ) noexcept :
+				node( input_node ),
+				index( input_index )
+			{
+			}
+
+			iterator_impl( const iterator_impl< false >& it ) noexcept :
+				node( it.node ),
+				index( it.index )
+			{
+			}
+
+			iterator_impl& operator=( const iterator_impl< false >& it ) noexcept
+			{
+				this->node = it.node;
+				this->index = it.index;
+
+				return *this;
+			}
+
+			void
+			swap( iterator_impl& it ) noexcept
+			{
+				std::swap( this->node, it.node );
+				std::swap( this->index, it.index );
+			}
+
+			iterator_impl&
+			operator++() noexcept
+			{
+				if ( ++( this->index ) == this->node->last )
+				{
+					this->node = this->node->next;
+					this->index = this->node->first;
+				}
+
+				return *this;
+			}
+
+			iterator_impl
+			operator++( int ) noexcept
+			{
+				const iterator_impl iterator( *this );
+				++( *this );
+
+				return iterator;
+			}
+
+			iterator_impl&
+			operator--() noexcept
+			{
+				if ( this->index == this->node->first )
+				{
+					this->node = this->node->previous;
+					this->index = this->node->last;
+				}
+
+				--( this->index );
+
+				return *this;
+			}
+
+			iterator_impl
+			operator--( int ) noexcept
+			{
+				const iterator_impl iterator( *this );
+				--( *this );
+
+				return iterator;
+			}
+
+			reference
+			operator*() const noexcept
+			{
+				return static_cast< unrolled_node* >( this->node )->items()[ this->index ];
+			}
+
+			pointer
+			operator->() const noexcept
+			{
+				return &( **this );
+			}
+
+			bool
+			operator==( const iterator_impl& it ) const noexcept
+			{
+				return ( this->node == it.node ) && ( this->index == it.index );
+			}
+
+			bool
+			operator!=( const iterator_impl& it ) const noexcept
+			{
+				return !( *this == it );
+			}
+
+		private:
+			friend class unrolled_list;
+			friend class iterator_impl< !IsConstIterator >;
+
+			node_links* node;
+			std::size_t index;
+		};
+
+		using iterator = iterator_impl< false >;
+		using const_iterator = iterator_impl< true >;
+		using reverse_iterator = std::reverse_iterator< iterator >;
+		using const_reverse_iterator = std::reverse_iterator< const_iterator >;
+
+		using value_type = T;
+		using allocator_type = typename std::allocator_traits< Allocator >::template rebind_alloc< unrolled_node >;
+		using size_type = std::size_t;
+		using difference_type = typename std::iterator_traits< iterator >::difference_type;
+		using reference = value_type&;
+		using const_reference = const value_type&;
+		using pointer = typename std::allocator_traits< allocator_type >::pointer;
+		using const_pointer = typename std::allocator_traits< allocator_type >::const_pointer;
+
+		static constexpr size_type node_capacity = N;
+
+		unrolled_list() noexcept
+		{
+			this->reset();
+		}
+
+		explicit unrolled_list( const allocator_type& input_allocator ) noexcept :
+			allocator( input_allocator )
+		{
+			this->reset();
+		}
+
+		~unrolled_list() noexcept
+		{
+			this->clear();
+		}
+
+		template < typename InputIterator >
+		unrolled_list(
+			InputIterator first,
+			InputIterator last,
+			const allocator_type& input_allocator = allocator_type() ) :
+			unrolled_list( input_allocator )
+		{
+			for ( ; first != last; ++first )
+			{
+				this->emplace_back( *first );
+			}
+		}
+
+		unrolled_list( const unrolled_list& other ) :
+			unrolled_list( std::allocator_traits< allocator_type >::select_on_container_copy_construction( other.allocator ) )
+		{
+			for ( const auto& item : other )
+			{
+				this->push_back( item );
+			}
+		}
+
+		unrolled_list( unrolled_list&& other ) noexcept :
+			allocator( std::move( other.allocator ) )
+		{
+			this->reset();
+			this->swap_nodes( other );
+		}
+
+		unrolled_list&
+		operator=( const unrolled_list& rhs )
+		{
+			if ( &rhs != this )
+			{
+				this->clear();
+
+				propagate_on_copy_assignment( this->allocator, rhs.allocator );
+
+				for ( const auto& item : rhs )
+				{
+					this->push_back( item );
+				}
+			}
+
+			return *this;
+		}
+
+		// Takes over the nodes of the source, or moves its elements if its allocator neither propagates nor compares equal.
+		unrolled_list&
+		operator=( unrolled_list&& rhs ) noexcept( allocator_moves_storage_v< allocator_type > )
+		{
+			if constexpr ( !allocator_moves_storage_v< allocator_type > )
+			{
+				if ( this->allocator != rhs.allocator )
+				{
+					this->clear();
+
+					for ( auto& item : rhs )
+					{
+						this->push_back( std::move( item ) );
+					}
+
+					rhs.clear();
+
+					return *this;
+				}
+			}
+
+			propagate_on_move_assignment( this->allocator, rhs.allocator );
+			this->swap_nodes( rhs );
+
+			return *this;
+		}
+
+		/**
+		 * Compares the occupied ranges of both lists block by block, each step covering the elements up to
+		 * the nearest node boundary of either list, so that the comparison runs over contiguous arrays.
+		 */
+		bool
+		operator==( const unrolled_list& rhs ) const noexcept
+		{
+			if ( this->size() != rhs.size() )
+			{
+				return false;
+			}
+
+			const node_links* node1 = this->sentinel.next;
+			const node_links* node2 = rhs.sentinel.next;
+			auto index1 = node1->first;
+			auto index2 = node2->first;
+
+			for ( auto remaining = this->elements; remaining > 0; )
+			{
+				const auto count = std::min( node1->last - index1, node2->last - index2 );
+				const auto items1 = static_cast< const unrolled_node* >( node1 )->items() + index1;
+				const auto items2 = static_cast< const unrolled_node* >( node2 )->items() + index2;
+
+				if ( !std::equal( items1, items1 + count, items2 ) )
+				{
+					return false;
+				}
+
+				remaining -= count;
+				index1 += count;
+				index2 += count;
+
+				if ( index1 == node1->last )
+				{
+					node1 = node1->next;
+					index1 = node1->first;
+				}
+
+				if ( index2 == node2->last )
+				{
+					node2 = node2->next;
+					index2 = node2->first;
+				}
+			}
+
+			return true;
+		}
+
+		bool
+		operator!=( const unrolled_list& rhs ) const noexcept
+		{
+			return !( *this == rhs );
+		}
+
+		// The allocators of both lists must compare equal, unless they propagate on swap.
+		friend void
+		swap( unrolled_list& first, unrolled_list& second ) noexcept
+		{
+			propagate_on_swap( first.allocator, second.allocator );
+			first.swap_nodes( second );
+		}
+
+		allocator_type
+		get_allocator() const
+		{
+			return this->allocator;
+		}
+
+		/**
+		 * Element access
+		 *
+		 * On an empty list these refer to a default constructed item owned by the list,
+		 * which must not be modified.
+		 */
+
+		reference
+		front() noexcept
+		{
+			return this->empty() ? this->empty_item : *this->begin();
+		}
+
+		const_reference
+		front() const noexcept
+		{
+			return this->empty() ? this->empty_item : *this->begin();
+		}
+
+		reference
+		back() noexcept
+		{
+			return this->empty() ? this->empty_item : *std::prev( this->end() );
+		}
+
+		const_reference
+		back() const noexcept
+		{
+			return this->empty() ? this->empty_item : *std::prev( this->end() );
+		}
+
+		/**
+		 * Iterators
+		 */
+
+		iterator
+		begin() noexcept
+		{
+			return iterator( this->sentinel.next, this->sentinel.next->first );
+		}
+
+		const_iterator
+		begin() const noexcept
+		{
+			return const_iterator( this->sentinel.next, this->sentinel.next->first );
+		}
+
+		const_iterator
+		cbegin() const noexcept
+		{
+			return this->begin();
+		}
+
+		iterator
+		end() noexcept
+		{
+			return iterator( &this->sentinel, this->sentinel.first );
+		}
+
+		const_iterator
+		end() const noexcept
+		{
+			return const_iterator( const_cast< node_links* >( &this->sentinel ), this->sentinel.first );
+		}
+
+		const_iterator
+		cend() const noexcept
+		{
+			return this->end();
+		}
+
+		reverse_iterator
+		rbegin() noexcept
+		{
+			return reverse_iterator( this->end() );
+		}
+
+		const_reverse_iterator
+		rbegin() const noexcept
+		{
+			return const_reverse_iterator( this->end() );
+		}
+
+		const_reverse_iterator
+		crbegin() const noexcept
+		{
+			return this->rbegin();
+		}
+
+		reverse_iterator
+		rend() noexcept
+		{
+			return reverse_iterator( this->begin() );
+		}
+
+		const_reverse_iterator
+		rend() const noexcept
+		{
+			return const_reverse_iterator( this->begin() );
+		}
+
+		const_reverse_iterator
+		crend() const noexcept
+		{
+			return this->rend();
+		}
+
+		/**
+		 * Modifiers
+		 */
+
+		void
+		push_front( const T& item )
+		{
+			this->emplace_front( item );
+		}
+
+		void
+		push_front( T&& item )
+		{
+			this->emplace_front( std::move( item ) );
+		}
+
+		void
+		push_back( const T& item )
+		{
+			this->emplace_back( item );
+		}
+
+		void
+		push_back( T&& item )
+		{
+			this->emplace_back( std::move( item ) );
+		}
+
+		template < typename... Args >
+		reference
+		emplace_front( Args&&... args )
+		{
+			auto node = this->front_node();
+
+			if ( this->empty() || ( node->first == 0 ) )
+			{
+				// New front nodes are filled from their end, leaving room for further push_front.
+				node = this->link_node( &this->sentinel, N );
+			}
+
+			const auto item = this->construct_item( node, node->first - 1, std::forward< Args >( args )... );
+			--( node->first );
+
+			++( this->elements );
+
+			return *item;
+		}
+
+		template < typename... Args >
+		reference
+		emplace_back( Args&&... args )
+		{
+			auto node = this->back_node();
+
+			if ( this->empty() || ( node->last == N ) )
+			{
+				node = this->link_node( this->sentinel.previous, 0 );
+			}
+
+			const auto item = this->construct_item( node, node->last, std::forward< Args >( args )... );
+			++( node->last );
+
+			++( this->elements );
+
+			return *item;
+		}
+
+		T
+		pop_front() noexcept
+		{
+			if ( this->empty() )
+			{
+				return T();
+			}
+
+			auto node = this->front_node();
+			auto item_pointer = node->items() + node->first;
+
+			auto item = std::move( *item_pointer );
+
+			std::allocator_traits< allocator_type >::destroy( this->allocator, item_pointer );
+			++( node->first );
+
+			this->remove_if_empty( node );
+
+			--( this->elements );
+
+			return item;
+		}
+
+		T
+		pop_back() noexcept
+		{
+			if ( this->empty() )
+			{
+				return T();
+			}
+
+			auto node = this->back_node();
+			auto item_pointer = node->items() + node->last - 1;
+
+			auto item = std::move( *item_pointer );
+
+			std::allocator_traits< allocator_type >::destroy( this->allocator, item_pointer );
+			--( node->last );
+
+			this->remove_if_empty( node );
+
+			--( this->elements );
+
+			return item;
+		}
+
+		/**
+		 * Constructs an element before the given position, returning an iterator to it. The elements
+		 * of the node on the side with fewer elements are moved by one place, after splitting the node
+		 * if it is full.
+		 */
+		template < typename... Args >
+		iterator
+		emplace(
+			const_iterator position,
+			Args&&... args )
+		{
+			if ( position.node == &this->sentinel )
+			{
+				this->emplace_back( std::forward< Args >( args )... );
+
+				return iterator( this->sentinel.previous, this->sentinel.previous->last - 1 );
+			}
+
+			if ( position == this->cbegin() )
+			{
+				this->emplace_front( std::forward< Args >( args )... );
+
+				return this->begin();
+			}
+
+			// Constructed first, so that the list is left untouched if the construction throws.
+			T item( std::forward< Args >( args )... );
+
+			auto node = static_cast< unrolled_node* >( position.node );
+			auto index = position.index;
+
+			if ( ( node->first == 0 ) && ( node->last == N ) )
+			{
+				if ( index == 0 )
+				{
+					// Start a node before this one, filled from its end like a new front node.
+					node = this->link_node( node->previous, N );
+					this->construct_item( node, N - 1, std::move( item ) );
+					--( node->first );
+
+					++( this->elements );
+
+					return iterator( node, node->first );
+				}
+
+				const auto upper = this->split_node( node, N / 2 );
+
+				if ( index > N / 2 )
+				{
+					node = upper;
+					index -= N / 2;
+				}
+			}
+
+			const auto items = node->items();
+
+			if ( ( node->last < N ) && ( ( node->first == 0 ) || ( node->last - index <= index - node->first ) ) )
+			{
+				if ( index == node->last )
+				{
+					this->construct_item( node, index, std::move( item ) );
+				}
+				else
+				{
+					this->construct_item( node, node->last, std::move( items[ node->last - 1 ] ) );
+					std::move_backward( items + index, items + node->last - 1, items + node->last );
+					items[ index ] = std::move( item );
+				}
+
+				++( node->last );
+			}
+			else
+			{
+				if ( index == node->first )
+				{
+					this->construct_item( node, index - 1, std::move( item ) );
+				}
+				else
+				{
+					this->construct_item( node, node->first - 1, std::move( items[ node->first ] ) );
+					std::move( items + node->first + 1, items + index, items + node->first );
+					items[ index - 1 ] = std::move( item );
+				}
+
+				--( node->first );
+				--index;
+			}
+
+			++( this->elements );
+
+			return iterator( node, index );
+		}
+
+		iterator
+		insert(
+			const_iterator position,
+			const T& item )
+		{
+			return this->emplace( position, item );
+		}
+
+		iterator
+		insert(
+			const_iterator position,
+			T&& item )
+		{
+			return this->emplace( position, std::move( item ) );
+		}
+
+		/**
+		 * Inserts copies of [first, last) before the given position, returning an iterator to the
+		 * first inserted element. The copies are made into new nodes which are then spliced in,
+		 * so the list is left untouched if an allocation or a copy throws.
+		 */
+		template < typename InputIterator >
+		iterator
+		insert(
+			const_iterator position,
+			InputIterator first,
+			InputIterator last )
+		{
+			unrolled_list chain( first, last, this->allocator );
+
+			if ( chain.empty() )
+			{
+				return this->mutable_iterator( position );
+			}
+
+			const auto chain_front = chain.sentinel.next;
+
+			this->splice( position, chain );
+
+			return iterator( chain_front, chain_front->first );
+		}
+
+		/**
+		 * Removes the element at the given position, returning an iterator to the following one. The
+		 * preceding elements of the node are moved by one place, so the following elements stay put.
+		 */
+		iterator
+		erase( const_iterator position )
+		{
+			const auto node = static_cast< unrolled_node* >( position.node );
+			const auto items = node->items();
+
+			std::move_backward( items + node->first, items + position.index, items + position.index + 1 );
+			std::allocator_traits< allocator_type >::destroy( this->allocator, items + node->first );
+			++( node->first );
+
+			--( this->elements );
+
+			if ( position.index + 1 == node->last )
+			{
+				const auto next_node = node->next;
+
+				this->remove_if_empty( node );
+
+				return iterator( next_node, next_node->first );
+			}
+
+			return iterator( node, position.index + 1 );
+		}
+
+		iterator
+		erase(
+			const_iterator first,
+			const_iterator last )
+		{
+			while ( first != last )
+			{
+				first = this->erase( first );
+			}
+
+			return this->mutable_iterator( last );
+		}
+
+		/**
+		 * Moves every element of the other list before the given position by relinking its nodes.
+		 * The allocators of both lists must compare equal.
+		 */
+		void
+		splice(
+			const_iterator position,
+			unrolled_list& other )
+		{
+			if ( ( &other == this ) || other.empty() )
+			{
+				return;
+			}
+
+			auto next_node = position.node;
+
+			if ( position.index != next_node->first )
+			{
+				next_node = this->split_node( static_cast< unrolled_node* >( next_node ), position.index );
+			}
+
+			const auto chain_front = other.sentinel.next;
+			const auto chain_back = other.sentinel.previous;
+
+			chain_front->previous = next_node->previous;
+			chain_back->next = next_node;
+			next_node->previous->next = chain_front;
+			next_node->previous = chain_back;
+
+			this->elements += other.elements;
+
+			other.reset();
+			other.elements = 0;
+		}
+
+		// Moves the element at it (in the other list) before the given position.
+		void
+		splice(
+			const_iterator position,
+			unrolled_list& other,
+			const_iterator it )
+		{
+			this->splice( position, other, it, std::next( it ) );
+		}
+
+		// Moves [first, last) from the other list before the given position, which must not lie in the range.
+		void
+		splice(
+			const_iterator position,
+			unrolled_list& other,
+			const_iterator first,
+			const_iterator last )
+		{
+			if ( ( first == last ) || ( position == last ) )
+			{
+				return;
+			}
+
+			if ( &other == this )
+			{
+				if ( this->follows( position, last ) )
+				{
+					std::rotate( this->mutable_iterator( first ), this->mutable_iterator( last ), this->mutable_iterator( position ) );
+				}
+				else
+				{
+					std::rotate( this->mutable_iterator( position ), this->mutable_iterator( first ), this->mutable_iterator( last ) );
+				}
+
+				return;
+			}
+
+			this->insert(
+				position,
+				std::make_move_iterator( other.mutable_iterator( first ) ),
+				std::make_move_iterator( other.mutable_iterator( last ) ) );
+
+			other.erase( first, last );
+		}
+
+		/**
+		 * Merges the other sorted list into this sorted list, leaving it empty. The merge is stable:
+		 * equivalent elements of this list precede those of the other list.
+		 */
+		template < typename Compare = std::less<> >
+		void
+		merge(
+			unrolled_list& other,
+			Compare compare = Compare() )
+		{
+			if ( ( &other == this ) || other.empty() )
+			{
+				return;
+			}
+
+			const auto middle_node = other.sentinel.next;
+
+			this->splice( this->cend(), other );
+
+			std::inplace_merge( this->begin(), iterator( middle_node, middle_node->first ), this->end(), compare );
+		}
+
+		void
+		clear() noexcept
+		{
+			for ( auto node = this->sentinel.next; node != &this->sentinel; )
+			{
+				const auto next_node = node->next;
+
+				this->destroy_node( static_cast< unrolled_node* >( node ) );
+				node = next_node;
+			}
+
+			this->reset();
+			this->elements = 0;
+		}
+
+		bool
+		empty() const noexcept
+		{
+			return ( this->elements == 0 );
+		}
+
+		size_type
+		size() const noexcept
+		{
+			return this->elements;
+		}
+
+		size_type
+		max_size() const noexcept
+		{
+			return std::allocator_traits< allocator_type >::max_size( this->allocator ) * N;
+		}
+
+	private:
+		unrolled_node*
+		front_node() noexcept
+		{
+			return static_cast< unrolled_node* >( this->sentinel.next );
+		}
+
+		unrolled_node*
+		back_node() noexcept
+		{
+			return static_cast< unrolled_node* >( this->sentinel.previous );
+		}
+
+		iterator
+		mutable_iterator( const const_iterator it ) noexcept
+		{
+			return iterator( it.node, it.index );
+		}
+
+		// Whether the position lies at or after the given iterator, found by walking to the end.
+		bool
+		follows(
+			const const_iterator position,
+			const_iterator it ) const noexcept
+		{
+			for ( ; it != this->cend(); ++it )
+			{
+				if ( it == position )
+				{
+					return true;
+				}
+			}
+
+			return ( position == this->cend() );
+		}
+
+		// Constructs an item in the given slot of the node, removing the node if it was left empty by a throw.
+		template < typename... Args >
+		T*
+		construct_item(
+			unrolled_node* const node,
+			const std::size_t index,
+			Args&&... args )
+		{
+			const auto item = node->items() + index;
+
+			try
+			{
+				std::allocator_traits< allocator_type >::construct( this->allocator, item, std::forward< Args >( args )... );
+			}
+			catch ( ... )
+			{
+				this->remove_if_empty( node );
+				throw;
+			}
+
+			return item;
+		}
+
+		// Moves the elements from the given index onwards into a new node linked after the node, which is returned.
+		unrolled_node*
+		split_node(
+			unrolled_node* const node,
+			const std::size_t index )
+		{
+			const auto upper = this->link_node( node, 0 );
+
+			try
+			{
+				for ( auto moved = index; moved < node->last; ++moved )
+				{
+					std::allocator_traits< allocator_type >::construct( this->allocator, upper->items() + upper->last, std::move( node->items()[ moved ] ) );
+					++( upper->last );
+				}
+			}
+			catch ( ... )
+			{
+				while ( upper->last > 0 )
+				{
+					std::allocator_traits< allocator_type >::destroy( this->allocator, upper->items() + --( upper->last ) );
+				}
+
+				this->remove_if_empty( upper );
+				throw;
+			}
+
+			for ( auto moved = index; moved < node->last; ++moved )
+			{
+				std::allocator_traits< allocator_type >::destroy( this->allocator, node->items() + moved );
+			}
+
+			node->last = index;
+
+			return upper;
+		}
+
+		// Creates an empty node positioned at the given index and links it after the given node.
+		unrolled_node*
+		link_node(
+			node_links* const previous_node,
+			const std::size_t position )
+		{
+			auto node = std::allocator_traits< allocator_type >::allocate( this->allocator, 1 );
+			::new ( static_cast< void* >( node ) ) unrolled_node;
+
+			node->first = position;
+			node->last = position;
+
+			node->previous = previous_node;
+			node->next = previous_node->next;
+
+			previous_node->next->previous = node;
+			previous_node->next = node;
+
+			return node;
+		}
+
+		void
+		remove_if_empty( unrolled_node* const node ) noexcept
+		{
+			if ( node->first == node->last )
+			{
+				node->previous->next = node->next;
+				node->next->previous = node->previous;
+
+				std::allocator_traits< allocator_type >::deallocate( this->allocator, node, 1 );
+			}
+		}
+
+		void
+		destroy_node( unrolled_node* const node ) noexcept
+		{
+			if ( !std::is_trivially_destructible< T >::value )
+			{
+				for ( auto index = node->first; index < node->last; ++index )
+				{
+					std::allocator_traits< allocator_type >::destroy( this->allocator, node->items() + index );
+				}
+			}
+
+			std::allocator_traits< allocator_type >::deallocate( this->allocator, node, 1 );
+		}
+
+		void
+		reset() noexcept
+		{
+			this->sentinel.previous = &this->sentinel;
+			this->sentinel.next = &this->sentinel;
+		}
+
+		void
+		swap_nodes( unrolled_list& other ) noexcept
+		{
+			using std::swap;
+
+			swap( this->sentinel, other.sentinel );
+			swap( this->elements, other.elements );
+
+			this->relink();
+			other.relink();
+		}
+
+		// Points the first and last nodes back at this sentinel (after it was swapped).
+		void
+		relink() noexcept
+		{
+			if ( this->empty() )
+			{
+				this->reset();
+			}
+			else
+			{
+				this->sentinel.next->previous = &this->sentinel;
+				this->sentinel.previous->next = &this->sentinel;
+			}
+		}
+
+		allocator_type allocator;
+
+		// Circular sentinel: next is the first node, previous is the last node.
+		node_links sentinel;
+
+		size_type elements = 0;
+
+		// Referred to by front() and back() on an empty list.
+		T empty_item = T();
+	};
+}
@@ -0,0 +1,229 @@
+/**
+ * Daniel Sebastian Iliescu, http://dansil.net
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ *
+ * A lock-free work-stealing deque (Chase and Lev, 2005) over a growable circular array,
+ * using the memory orderings of Le, Pop, Cohen and Zappa Nardelli (2013).
+ *
+ * One thread owns the deque and pushes and pops at its back, like a stack. The owner only
+ * synchronizes with other threads when it takes the last item. Any number of other threads
+ * may steal from the front with a single CAS. When the array is full the owner copies the
+ * items into one twice as large. Thieves may still be reading the old array, so it is kept
+ * until the deque is destroyed. This at most doubles the memory held.
+ *
+ * A thief may read an item while the owner overwrites it (the thief's CAS then fails), so
+ * items are stored in atomics and must be trivially copyable, such as indices or pointers
+ * to tasks. size() and empty() are snapshots.
+ */
+
+#pragma once
+
+#include "memory/cache_line.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace dsa
+{
+	template < typename T >
+	class work_stealing_deque
+	{
+		static_assert( std::is_trivially_copyable< T >::value, "The items must be trivially copyable." );
+
+		struct ring_buffer
+		{
+			explicit ring_buffer( const std::size_t input_capacity ) :
+				capacity( input_capacity ),
+				items( new std::atomic< T >[ input_capacity ] )
+			{
+			}
+
+			T
+			load( const std::ptrdiff_t position ) const noexcept
+			{
+				return this->items[ static_cast< std::size_t >( position ) & ( this->capacity - 1 ) ].load( std::memory_order_relaxed );
+			}
+
+			void
+			store(
+				const std::ptrdiff_t position,
+				const T item ) noexcept
+			{
+				this->items[ static_cast< std::size_t >( position ) & ( this->capacity - 1 ) ].store( item, std::memory_order_relaxed );
+			}
+
+			const std::size_t capacity;
+			const std::unique_ptr< std::atomic< T >[] > items;
+		};
+
+	public:
+		using value_type = T;
+		using size_type = std::size_t;
+		using reference = value_type&;
+		using const_reference = const value_type&;
+
+		// The initial capacity is rounded up to a power of two.
+		explicit work_stealing_deque( const size_type minimum_capacity = 64 )
+		{
+			size_type capacity = 2;
+
+			while ( capacity < minimum_capacity )
+			{
+				capacity <<= 1;
+			}
+
+			this->buffers.push_back( std::make_unique< ring_buffer >( capacity ) );
+			this->buffer.store( this->buffers.back().get(), std::memory_order_relaxed );
+		}
+
+		~work_stealing_deque() noexcept = default;
+
+		work_stealing_deque( const work_stealing_deque& ) = delete;
+		work_stealing_deque( work_stealing_deque&& ) = delete;
+
+		work_stealing_deque& operator=( const work_stealing_deque& ) = delete;
+		work_stealing_deque& operator=( work_stealing_deque&& ) = delete;
+
+		/**
+		 * Owner modifiers
+		 */
+
+		void
+		push_back( const T item )
+		{
+			const auto back = this->bottom.load( std::memory_order_relaxed );
+			const auto front = this->top.load( std::memory_order_acquire );
+
+			auto array = this->buffer.load( std::memory_order_relaxed );
+
+			if ( static_cast< size_type >( back - front ) >= array->capacity )
+			{
+				array = this->grow( array, front, back );
+			}
+
+			array->store( back, item );
+
+			// Publishes the item to the thieves.
+			this->bottom.store( back + 1, std::memory_order_release );
+		}
+
+		// Pops the most recently pushed item; returns false if the deque was empty.
+		bool
+		pop_back( T& item )
+		{
+			const auto back = this->bottom.load( std::memory_order_relaxed ) - 1;
+			const auto array = this->buffer.load( std::memory_order_relaxed );
+
+			// Reserve the back item before looking at the front, so a thief sees either one or the other.
+			this->bottom.store( back, std::memory_order_seq_cst );
+
+			auto front = this->top.load( std::memory_order_seq_cst );
+
+			if ( front > back )
+			{
+				this->bottom.store( back + 1, std::memory_order_relaxed );
+
+				return false;
+			}
+
+			item = array->load( back );
+
+			if ( front < back )
+			{
+				return true;
+			}
+
+			// Last item: race the thieves for it.
+			const auto taken = this->top.compare_exchange_strong( front, front + 1, std::memory_order_seq_cst, std::memory_order_relaxed );
+
+			this->bottom.store( back + 1, std::memory_order_relaxed );
+
+			return taken;
+		}
+
+		/**
+		 * Thief modifiers
+		 */
+
+		// Steals the oldest item; returns false if the deque was empty or another thread took it first.
+		bool
+		steal_front( T& item )
+		{
+			auto front = this->top.load( std::memory_order_seq_cst );
+			const auto back = this->bottom.load( std::memory_order_seq_cst );
+
+			if ( front >= back )
+			{
+				return false;
+			}
+
+			const auto stolen = this->buffer.load( std::memory_order_acquire )->load( front );
+
+			if ( !this->top.compare_exchange_strong( front, front + 1, std::memory_order_seq_cst, std::memory_order_relaxed ) )
+			{
+				return false;
+			}
+
+			item = stolen;
+
+			return true;
+		}
+
+		bool
+		empty() const noexcept
+		{
+			return ( this->size() == 0 );
+		}
+
+		size_type
+		size() const noexcept
+		{
+			const auto front = this->top.load( std::memory_order_acquire );
+			const auto back = this->bottom.load( std::memory_order_acquire );
+
+			return ( back > front ) ? static_cast< size_type >( back - front ) : 0;
+		}
+
+		size_type
+		capacity() const noexcept
+		{
+			return this->buffer.load( std::memory_order_acquire )->capacity;
+		}
+
+	private:
+		// Copies the items into an array twice as large, which becomes the current one.
+		ring_buffer*
+		grow(
+			const ring_buffer* const array,
+			const std::ptrdiff_t front,
+			const std::ptrdiff_t back )
+		{
+			this->buffers.push_back( std::make_unique< ring_buffer >( 2 * array->capacity ) );
+
+			const auto larger = this->buffers.back().get();
+
+			for ( auto position = front; position != back; ++position )
+			{
+				larger->store( position, array->load( position ) );
+			}
+
+			this->buffer.store( larger, std::memory_order_release );
+
+			return larger;
+		}
+
+		// Front index, advanced by thieves and by the owner taking the last item.
+		alignas( cache_line_size ) std::atomic< std::ptrdiff_t > top { 0 };
+
+		// Back index, only written by the owner.
+		alignas( cache_line_size ) std::atomic< std::ptrdiff_t > bottom { 0 };
+
+		alignas( cache_line_size ) std::atomic< ring_buffer* > buffer { nullptr };
+
+		// Every array allocated so far (only accessed by the owner), the last one being current.
+		std::vector< std::unique_ptr< ring_buffer > > buffers;
+	};
+}
\ No newline at end of file
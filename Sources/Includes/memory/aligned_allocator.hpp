@@ -0,0 +1,85 @@
+/**
+ * Daniel Sebastian Iliescu, http://dansil.net
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ *
+ * An allocator returning memory aligned to a given boundary (a cache line by default).
+ *
+ * It is stateless, so all instances compare equal, and is meant for arrays whose layout
+ * is arranged around cache lines (e.g. the d-ary heap, whose sibling groups start on one).
+ */
+
+#pragma once
+
+#include "cache_line.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <new>
+
+namespace dsa
+{
+	template <
+		typename T,
+		std::size_t Alignment = cache_line_size >
+	class aligned_allocator
+	{
+	public:
+		static constexpr std::size_t ALIGNMENT = std::max( Alignment, alignof( T ) );
+
+		using value_type = T;
+		using size_type = std::size_t;
+		using difference_type = std::ptrdiff_t;
+
+		template < typename U >
+		struct rebind
+		{
+			using other = aligned_allocator< U, Alignment >;
+		};
+
+		aligned_allocator() noexcept = default;
+		~aligned_allocator() noexcept = default;
+
+		template < typename U >
+		aligned_allocator( const aligned_allocator< U, Alignment >& ) noexcept
+		{
+		}
+
+		aligned_allocator( const aligned_allocator& ) noexcept = default;
+		aligned_allocator( aligned_allocator&& ) noexcept = default;
+
+		aligned_allocator& operator=( const aligned_allocator& ) noexcept = default;
+		aligned_allocator& operator=( aligned_allocator&& ) noexcept = default;
+
+		bool
+		operator==( const aligned_allocator& ) const noexcept
+		{
+			return true;
+		}
+
+		bool
+		operator!=( const aligned_allocator& ) const noexcept
+		{
+			return false;
+		}
+
+		T*
+		allocate( const size_type count )
+		{
+			if ( count > std::numeric_limits< size_type >::max() / sizeof( T ) )
+			{
+				throw std::bad_array_new_length();
+			}
+
+			return static_cast< T* >( ::operator new( count * sizeof( T ), std::align_val_t( ALIGNMENT ) ) );
+		}
+
+		void
+		deallocate(
+			T* const item,
+			const size_type ) noexcept
+		{
+			::operator delete( item, std::align_val_t( ALIGNMENT ) );
+		}
+	};
+}
\ No newline at end of file
@@ -0,0 +1,65 @@
+/**
+ * Daniel Sebastian Iliescu, http://dansil.net
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ *
+ * Allocator propagation for the containers of the collection.
+ *
+ * The containers copy assign by clearing their contents before copying the new ones, and move assign
+ * and swap by exchanging their contents, so an allocator which propagates on move assignment or swap
+ * is exchanged along with them, leaving every allocator with the storage it allocated. Allocators which
+ * do not propagate (e.g. std::pmr::polymorphic_allocator, which cannot even be assigned) stay with
+ * their container. Only the branches matching the traits of the allocator are instantiated.
+ */
+
+#pragma once
+
+#include <memory>
+#include <utility>
+
+namespace dsa
+{
+	// Whether move assignment can always take over the storage of the source, whatever the allocators.
+	template < typename Allocator >
+	constexpr bool allocator_moves_storage_v =
+		std::allocator_traits< Allocator >::propagate_on_container_move_assignment::value ||
+		std::allocator_traits< Allocator >::is_always_equal::value;
+
+	// Assigns the allocator of the source to the target (whose contents were cleared beforehand).
+	template < typename Allocator >
+	void
+	propagate_on_copy_assignment(
+		Allocator& target,
+		const Allocator& source ) noexcept
+	{
+		if constexpr ( std::allocator_traits< Allocator >::propagate_on_container_copy_assignment::value )
+		{
+			target = source;
+		}
+	}
+
+	template < typename Allocator >
+	void
+	propagate_on_move_assignment(
+		Allocator& target,
+		Allocator& source ) noexcept
+	{
+		if constexpr ( std::allocator_traits< Allocator >::propagate_on_container_move_assignment::value )
+		{
+			using std::swap;
+			swap( target, source );
+		}
+	}
+
+	template < typename Allocator >
+	void
+	propagate_on_swap(
+		Allocator& first,
+		Allocator& second ) noexcept
+	{
+		if constexpr ( std::allocator_traits< Allocator >::propagate_on_container_swap::value )
+		{
+			using std::swap;
+			swap( first, second );
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,18 @@
+/**
+ * Daniel Sebastian Iliescu, http://dansil.net
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ *
+ * Cache line size used to keep concurrently written data on separate lines.
+ *
+ * std::hardware_destructive_interference_size is not used since its value may
+ * change between compiler versions and flags, which would change class layouts.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+namespace dsa
+{
+	static constexpr std::size_t cache_line_size = 64;
+}
@@ -0,0 +1,220 @@
+/**
+ * Daniel Sebastian Iliescu, http://dansil.net
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ *
+ * Hazard pointers (Michael, 2004) for reclaiming the nodes of lock-free structures.
+ *
+ * A thread publishes the nodes it is about to dereference in the hazard slots of a
+ * record it holds for the duration of an operation. Unlinked nodes are retired to
+ * that record and only deleted once no slot of any record points to them.
+ *
+ * Records are claimed per operation (through a hazard_guard) rather than per thread,
+ * so a domain needs no thread-local state and can be owned by a single container.
+ * Records are never freed before the domain, and retired nodes left in a released
+ * record are reclaimed by whichever thread claims it next.
+ */
+
+#pragma once
+
+#include "cache_line.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace dsa
+{
+	template <
+		typename Node,
+		std::size_t Slots = 2 >
+	class hazard_domain
+	{
+		struct alignas( cache_line_size ) hazard_record
+		{
+			std::array< std::atomic< Node* >, Slots > hazards {};
+			std::atomic< bool > active { false };
+
+			hazard_record* next = nullptr;
+
+			// Only accessed by the thread holding the record.
+			std::vector< Node* > retired;
+		};
+
+	public:
+		class hazard_guard
+		{
+		public:
+			explicit hazard_guard( hazard_domain& input_domain ) :
+				domain( input_domain ),
+				record( input_domain.acquire() )
+			{
+			}
+
+			~hazard_guard() noexcept
+			{
+				for ( auto& hazard : this->record->hazards )
+				{
+					hazard.store( nullptr, std::memory_order_release );
+				}
+
+				this->record->active.store( false, std::memory_order_release );
+			}
+
+			hazard_guard( const hazard_guard& ) = delete;
+			hazard_guard( hazard_guard&& ) = delete;
+
+			hazard_guard& operator=( const hazard_guard& ) = delete;
+			hazard_guard& operator=( hazard_guard&& ) = delete;
+
+			// Loads the pointer and publishes it in the given slot until it is stable.
+			Node*
+			protect(
+				const std::size_t slot,
+				const std::atomic< Node* >& source ) noexcept
+			{
+				auto node = source.load();
+
+				while ( true )
+				{
+					this->record->hazards[ slot ].store( node );
+
+					const auto current = source.load();
+
+					if ( current == node )
+					{
+						return node;
+					}
+
+					node = current;
+				}
+			}
+
+			void
+			clear( const std::size_t slot ) noexcept
+			{
+				this->record->hazards[ slot ].store( nullptr, std::memory_order_release );
+			}
+
+			// Hands over an unlinked node; it is deleted once no longer protected.
+			void
+			retire( Node* const node )
+			{
+				this->record->retired.push_back( node );
+
+				if ( this->record->retired.size() >= this->domain.scan_threshold() )
+				{
+					this->domain.scan( *this->record );
+				}
+			}
+
+		private:
+			hazard_domain& domain;
+			hazard_record* record;
+		};
+
+		hazard_domain() noexcept = default;
+
+		~hazard_domain() noexcept
+		{
+			auto record = this->records.load();
+
+			while ( record )
+			{
+				for ( const auto node : record->retired )
+				{
+					delete node;
+				}
+
+				const auto next_record = record->next;
+
+				delete record;
+				record = next_record;
+			}
+		}
+
+		hazard_domain( const hazard_domain& ) = delete;
+		hazard_domain( hazard_domain&& ) = delete;
+
+		hazard_domain& operator=( const hazard_domain& ) = delete;
+		hazard_domain& operator=( hazard_domain&& ) = delete;
+
+	private:
+		hazard_record*
+		acquire()
+		{
+			for ( auto record = this->records.load( std::memory_order_acquire ); record; record = record->next )
+			{
+				auto expected = false;
+
+				if ( !record->active.load( std::memory_order_relaxed ) &&
+					 record->active.compare_exchange_strong( expected, true, std::memory_order_acquire ) )
+				{
+					return record;
+				}
+			}
+
+			auto record = new hazard_record();
+			record->active.store( true, std::memory_order_relaxed );
+
+			auto head = this->records.load( std::memory_order_relaxed );
+
+			do
+			{
+				record->next = head;
+			}
+			while ( !this->records.compare_exchange_weak( head, record, std::memory_order_release, std::memory_order_relaxed ) );
+
+			this->record_count.fetch_add( 1, std::memory_order_relaxed );
+
+			return record;
+		}
+
+		std::size_t
+		scan_threshold() const noexcept
+		{
+			return 2 * Slots * this->record_count.load( std::memory_order_relaxed ) + 16;
+		}
+
+		void
+		scan( hazard_record& owner )
+		{
+			std::vector< Node* > protected_nodes;
+
+			for ( auto record = this->records.load( std::memory_order_acquire ); record; record = record->next )
+			{
+				for ( const auto& hazard : record->hazards )
+				{
+					if ( const auto node = hazard.load() )
+					{
+						protected_nodes.push_back( node );
+					}
+				}
+			}
+
+			std::sort( std::begin( protected_nodes ), std::end( protected_nodes ) );
+
+			const auto still_protected = std::partition(
+				std::begin( owner.retired ),
+				std::end( owner.retired ),
+				[&protected_nodes]( Node* const node )
+				{
+					return std::binary_search( std::cbegin( protected_nodes ), std::cend( protected_nodes ), node );
+				} );
+
+			std::for_each(
+				still_protected,
+				std::end( owner.retired ),
+				[]( Node* const node )
+				{
+					delete node;
+				} );
+
+			owner.retired.erase( still_protected, std::end( owner.retired ) );
+		}
+
+		std::atomic< hazard_record* > records { nullptr };
+		std::atomic< std::size_t > record_count { 0 };
+	};
+}
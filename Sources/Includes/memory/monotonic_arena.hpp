@@ -0,0 +1,285 @@
+/**
+ * Daniel Sebastian Iliescu, http://dansil.net
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ *
+ * A monotonic arena, which frees everything it allocated at once.
+ *
+ * Allocation bumps a pointer through the current chunk, and a new chunk (twice as large as the
+ * previous one) is taken from the upstream resource when it runs out. Deallocation does nothing:
+ * memory is only returned when the arena is released or destroyed. This suits containers which are
+ * built, used and thrown away together (e.g. all the nodes of a tree built for a single query), where
+ * tearing them down then costs a handful of upstream deallocations rather than one per node.
+ *
+ * The arena is a std::pmr::memory_resource, so it can back std::pmr::polymorphic_allocator. The
+ * arena_allocator below calls it directly instead, without going through a virtual call, and propagates
+ * with the contents of a container. The arena is not thread-safe.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <new>
+
+namespace dsa
+{
+	class monotonic_arena : public std::pmr::memory_resource
+	{
+	public:
+		static constexpr std::size_t DEFAULT_CHUNK_BYTES = 4096;
+
+		explicit monotonic_arena(
+			const std::size_t input_chunk_bytes = DEFAULT_CHUNK_BYTES,
+			std::pmr::memory_resource* const input_upstream = std::pmr::get_default_resource() ) noexcept :
+			upstream( input_upstream ),
+			initial_chunk_bytes( std::max( input_chunk_bytes, sizeof( chunk_header ) + alignof( std::max_align_t ) ) ),
+			next_chunk_bytes( this->initial_chunk_bytes )
+		{
+		}
+
+		// Serves allocations from the given buffer first, which the arena does not own.
+		monotonic_arena(
+			void* const buffer,
+			const std::size_t buffer_bytes,
+			std::pmr::memory_resource* const input_upstream = std::pmr::get_default_resource() ) noexcept :
+			monotonic_arena( std::max( buffer_bytes, DEFAULT_CHUNK_BYTES ), input_upstream )
+		{
+			this->buffer_begin = static_cast< unsigned char* >( buffer );
+			this->buffer_size = buffer_bytes;
+
+			this->current = this->buffer_begin;
+			this->remaining = this->buffer_size;
+		}
+
+		~monotonic_arena() noexcept override
+		{
+			this->release();
+		}
+
+		monotonic_arena( const monotonic_arena& ) = delete;
+		monotonic_arena( monotonic_arena&& ) = delete;
+
+		monotonic_arena& operator=( const monotonic_arena& ) = delete;
+		monotonic_arena& operator=( monotonic_arena&& ) = delete;
+
+		// Hides memory_resource::allocate, so that direct calls are not virtual.
+		void*
+		allocate(
+			const std::size_t bytes,
+			const std::size_t alignment = alignof( std::max_align_t ) )
+		{
+			void* memory = this->current;
+
+			if ( std::align( alignment, bytes, memory, this->remaining ) && memory )
+			{
+				this->current = static_cast< unsigned char* >( memory ) + bytes;
+				this->remaining -= bytes;
+
+				return memory;
+			}
+
+			return this->grow( bytes, alignment );
+		}
+
+		/**
+		 * Returns every chunk to the upstream resource at once. All the objects allocated from the
+		 * arena are invalidated without being destroyed.
+		 */
+		void
+		release() noexcept
+		{
+			while ( this->chunks_list )
+			{
+				const auto previous = this->chunks_list->previous;
+
+				this->upstream->deallocate( this->chunks_list, this->chunks_list->bytes, alignof( std::max_align_t ) );
+				this->chunks_list = previous;
+			}
+
+			this->chunk_count = 0;
+			this->next_chunk_bytes = this->initial_chunk_bytes;
+
+			this->current = this->buffer_begin;
+			this->remaining = this->buffer_size;
+		}
+
+		// Number of chunks currently taken from the upstream resource.
+		std::size_t
+		chunks() const noexcept
+		{
+			return this->chunk_count;
+		}
+
+		std::pmr::memory_resource*
+		upstream_resource() const noexcept
+		{
+			return this->upstream;
+		}
+
+	private:
+		struct alignas( std::max_align_t ) chunk_header
+		{
+			chunk_header* previous;
+			std::size_t bytes;
+		};
+
+		void*
+		do_allocate(
+			const std::size_t bytes,
+			const std::size_t alignment ) override
+		{
+			return this->allocate( bytes, alignment );
+		}
+
+		void
+		do_deallocate(
+			void*,
+			std::size_t,
+			std::size_t ) override
+		{
+		}
+
+		bool
+		do_is_equal( const std::pmr::memory_resource& other ) const noexcept override
+		{
+			return ( this == &other );
+		}
+
+		// Takes a chunk large enough for the allocation from the upstream resource, and allocates from it.
+		void*
+		grow(
+			const std::size_t bytes,
+			const std::size_t alignment )
+		{
+			if ( bytes > std::numeric_limits< std::size_t >::max() / 2 - sizeof( chunk_header ) - alignment )
+			{
+				throw std::bad_alloc();
+			}
+
+			const auto chunk_bytes = std::max( this->next_chunk_bytes, sizeof( chunk_header ) + bytes + alignment );
+			const auto chunk = static_cast< chunk_header* >( this->upstream->allocate( chunk_bytes, alignof( std::max_align_t ) ) );
+
+			chunk->previous = this->chunks_list;
+			chunk->bytes = chunk_bytes;
+
+			this->chunks_list = chunk;
+			++( this->chunk_count );
+
+			if ( this->next_chunk_bytes <= std::numeric_limits< std::size_t >::max() / 2 )
+			{
+				this->next_chunk_bytes *= 2;
+			}
+
+			void* memory = chunk + 1;
+			auto space = chunk_bytes - sizeof( chunk_header );
+
+			std::align( alignment, bytes, memory, space );
+
+			this->current = static_cast< unsigned char* >( memory ) + bytes;
+			this->remaining = space - bytes;
+
+			return memory;
+		}
+
+		std::pmr::memory_resource* upstream;
+
+		std::size_t initial_chunk_bytes;
+		std::size_t next_chunk_bytes;
+
+		// Newest chunk, linked to the previous ones through their headers.
+		chunk_header* chunks_list = nullptr;
+		std::size_t chunk_count = 0;
+
+		// Buffer given on construction, used before any chunk.
+		unsigned char* buffer_begin = nullptr;
+		std::size_t buffer_size = 0;
+
+		// Unused part of the current chunk.
+		unsigned char* current = nullptr;
+		std::size_t remaining = 0;
+	};
+
+	/**
+	 * An allocator drawing from a monotonic_arena, which must outlive it.
+	 *
+	 * Copies and rebound copies draw from the same arena and compare equal. The allocator propagates
+	 * on move assignment and swap, so containers sharing an arena exchange their contents freely.
+	 */
+	template < typename T >
+	class arena_allocator
+	{
+	public:
+		using value_type = T;
+		using size_type = std::size_t;
+		using difference_type = std::ptrdiff_t;
+		using propagate_on_container_move_assignment = std::true_type;
+		using propagate_on_container_swap = std::true_type;
+
+		template < typename U >
+		struct rebind
+		{
+			using other = arena_allocator< U >;
+		};
+
+		arena_allocator( monotonic_arena& input_arena ) noexcept :
+			arena( &input_arena )
+		{
+		}
+
+		~arena_allocator() noexcept = default;
+
+		template < typename U >
+		arena_allocator( const arena_allocator< U >& other ) noexcept :
+			arena( other.resource() )
+		{
+		}
+
+		arena_allocator( const arena_allocator& ) noexcept = default;
+		arena_allocator( arena_allocator&& ) noexcept = default;
+
+		arena_allocator& operator=( const arena_allocator& ) noexcept = default;
+		arena_allocator& operator=( arena_allocator&& ) noexcept = default;
+
+		bool
+		operator==( const arena_allocator& rhs ) const noexcept
+		{
+			return ( this->arena == rhs.arena );
+		}
+
+		bool
+		operator!=( const arena_allocator& rhs ) const noexcept
+		{
+			return !( *this == rhs );
+		}
+
+		T*
+		allocate( const size_type count )
+		{
+			if ( count > std::numeric_limits< size_type >::max() / sizeof( T ) )
+			{
+				throw std::bad_array_new_length();
+			}
+
+			return static_cast< T* >( this->arena->allocate( count * sizeof( T ), alignof( T ) ) );
+		}
+
+		void
+		deallocate(
+			T* const,
+			const size_type ) noexcept
+		{
+		}
+
+		monotonic_arena*
+		resource() const noexcept
+		{
+			return this->arena;
+		}
+
+	private:
+		monotonic_arena* arena;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,217 @@
+/**
+ * Daniel Sebastian Iliescu, http://dansil.net
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ *
+ * A slab allocator for node-based containers.
+ *
+ * Single objects are carved out of slabs holding NodesPerSlab objects each,
+ * and freed objects are kept on an intrusive free list for reuse, so that
+ * allocation and deallocation are a handful of pointer operations. Memory is
+ * only returned in whole slabs, when the last copy of the pool is destroyed or
+ * when release() is called explicitly; containers never release a pool, since
+ * it may still hold the nodes of other containers.
+ * Requests for more than one object are forwarded to the global allocator.
+ *
+ * Copies (and moves) of a pool share the same slabs and compare equal, while
+ * rebound copies start with slabs of their own, and so do copies of the
+ * containers using a pool. The pool is not thread-safe.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace dsa
+{
+	template <
+		typename T,
+		std::size_t NodesPerSlab = 512 >
+	class node_pool
+	{
+	public:
+		static_assert( NodesPerSlab > 0, "A slab must hold at least one node." );
+
+		using value_type = T;
+		using size_type = std::size_t;
+		using difference_type = std::ptrdiff_t;
+		using propagate_on_container_move_assignment = std::true_type;
+		using propagate_on_container_swap = std::true_type;
+
+		template < typename U >
+		struct rebind
+		{
+			using other = node_pool< U, NodesPerSlab >;
+		};
+
+		// The state is created up front so that the equality of copies never changes.
+		node_pool() :
+			state( std::make_shared< pool_state >() )
+		{
+		}
+
+		~node_pool() noexcept = default;
+
+		// Slabs are sized for a single node type, so rebound pools start empty.
+		template < typename U >
+		node_pool( const node_pool< U, NodesPerSlab >& ) :
+			node_pool()
+		{
+		}
+
+		// Moves copy the state, since a moved-from pool must still free the nodes it handed out.
+		node_pool( const node_pool& ) noexcept = default;
+		node_pool& operator=( const node_pool& ) noexcept = default;
+
+		bool
+		operator==( const node_pool& rhs ) const noexcept
+		{
+			return ( this->state == rhs.state );
+		}
+
+		bool
+		operator!=( const node_pool& rhs ) const noexcept
+		{
+			return !( *this == rhs );
+		}
+
+		// A copy of a container starts with a pool of its own, since releasing a shared pool would free the nodes of both.
+		node_pool
+		select_on_container_copy_construction() const
+		{
+			return node_pool();
+		}
+
+		T*
+		allocate( const size_type count )
+		{
+			if ( count != 1 )
+			{
+				return static_cast< T* >( ::operator new( count * sizeof( T ), std::align_val_t( alignof( T ) ) ) );
+			}
+
+			return static_cast< T* >( this->state->allocate() );
+		}
+
+		void
+		deallocate(
+			T* const item,
+			const size_type count ) noexcept
+		{
+			if ( count != 1 )
+			{
+				::operator delete( item, std::align_val_t( alignof( T ) ) );
+			}
+			else
+			{
+				this->state->deallocate( item );
+			}
+		}
+
+		/**
+		 * Returns every slab at once. All the objects allocated from this
+		 * pool (or any of its copies) are invalidated without being destroyed,
+		 * so no container may still be using the pool.
+		 */
+		void
+		release() noexcept
+		{
+			this->state->release();
+		}
+
+		// Number of slabs currently held by the pool.
+		size_type
+		slabs() const noexcept
+		{
+			return this->state->slabs.size();
+		}
+
+	private:
+		union slot
+		{
+			slot* next;
+			alignas( T ) unsigned char storage[ sizeof( T ) ];
+		};
+
+		struct pool_state
+		{
+			pool_state() = default;
+
+			~pool_state() noexcept
+			{
+				this->release();
+			}
+
+			pool_state( const pool_state& ) = delete;
+			pool_state& operator=( const pool_state& ) = delete;
+
+			void*
+			allocate()
+			{
+				if ( this->free_list )
+				{
+					const auto item = this->free_list;
+					this->free_list = item->next;
+
+					return item;
+				}
+
+				if ( this->unused == this->unused_end )
+				{
+					// Track the slab before allocating it so that a failure cannot leak it.
+					this->slabs.push_back( nullptr );
+
+					const auto slab = static_cast< slot* >( ::operator new( NodesPerSlab * sizeof( slot ), std::align_val_t( alignof( slot ) ) ) );
+
+					this->slabs.back() = slab;
+					this->unused = slab;
+					this->unused_end = slab + NodesPerSlab;
+				}
+
+				return this->unused++;
+			}
+
+			void
+			deallocate( void* const item ) noexcept
+			{
+				const auto freed = static_cast< slot* >( item );
+
+				freed->next = this->free_list;
+				this->free_list = freed;
+			}
+
+			void
+			release() noexcept
+			{
+				for ( const auto slab : this->slabs )
+				{
+					::operator delete( slab, std::align_val_t( alignof( slot ) ) );
+				}
+
+				this->slabs.clear();
+				this->free_list = nullptr;
+				this->unused = nullptr;
+				this->unused_end = nullptr;
+			}
+
+			std::vector< slot* > slabs;
+
+			slot* free_list = nullptr;
+
+			// Slots of the newest slab which were never handed out.
+			slot* unused = nullptr;
+			slot* unused_end = nullptr;
+		};
+
+		template <
+			typename U,
+			std::size_t N >
+		friend class node_pool;
+
+		std::shared_ptr< pool_state > state;
+	};
+}
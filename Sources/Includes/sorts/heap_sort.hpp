@@ -0,0 +1,93 @@
+/**
+ * Daniel Sebastian Iliescu, http://dansil.net
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ *
+ * Implementation of heap sort.
+ */
+
+#pragma once
+
+#include "sort.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+namespace dsa
+{
+	struct heap
+	{
+		struct std_implementation
+		{
+			template < typename RandomAccessIterator >
+			static DSA_CONSTEXPR_SORT void
+			sort(
+				RandomAccessIterator begin,
+				RandomAccessIterator end )
+			{
+				std::make_heap( begin, end );
+				std::sort_heap( begin, end );
+			}
+		};
+
+		struct custom_implementation
+		{
+			template < typename RandomAccessIterator >
+			static DSA_CONSTEXPR_SORT void
+			sort(
+				RandomAccessIterator begin,
+				RandomAccessIterator end )
+			{
+				using std::swap;
+
+				using difference_type = typename std::iterator_traits< RandomAccessIterator >::difference_type;
+
+				const difference_type size = end - begin;
+
+				// Build a max-heap bottom-up, starting at the last parent.
+				for ( difference_type root = size / 2; root > 0; --root )
+				{
+					sift_down( begin, root - 1, size );
+				}
+
+				// Repeatedly move the maximum behind the shrinking heap.
+				for ( difference_type last = size - 1; last > 0; --last )
+				{
+					swap( *begin, *( begin + last ) );
+
+					sift_down( begin, difference_type( 0 ), last );
+				}
+			}
+
+		private:
+			template <
+				typename RandomAccessIterator,
+				typename Distance >
+			static DSA_CONSTEXPR_SORT void
+			sift_down(
+				RandomAccessIterator begin,
+				Distance root,
+				const Distance size )
+			{
+				using std::swap;
+
+				for ( auto child = 2 * root + 1; child < size; child = 2 * root + 1 )
+				{
+					if ( ( child + 1 < size ) &&
+						 ( *( begin + child ) < *( begin + child + 1 ) ) )
+					{
+						++child;
+					}
+
+					if ( !( *( begin + root ) < *( begin + child ) ) )
+					{
+						break;
+					}
+
+					swap( *( begin + root ), *( begin + child ) );
+					root = child;
+				}
+			}
+		};
+	};
+}
\ No newline at end of file
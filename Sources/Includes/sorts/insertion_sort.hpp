@@ -7,6 +7,12 @@
 
 #pragma once
 
+#include "sort.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
 namespace dsa
 {
 	struct insertion
@@ -14,7 +20,7 @@ namespace dsa
 		struct std_implementation
 		{
 			template < typename Iterator >
-			static void
+			static DSA_CONSTEXPR_SORT void
 			sort(
 				Iterator begin,
 				Iterator end )
@@ -35,24 +41,35 @@ namespace dsa
 		struct custom_implementation
 		{
 			template < typename Iterator >
-			static void
+			static DSA_CONSTEXPR_SORT void
 			sort(
 				Iterator begin,
 				Iterator end )
 			{
+				if ( begin == end )
+				{
+					return;
+				}
+
 				for ( auto it = std::next( begin ); it != end; ++it )
 				{
-					const auto previousItem = std::prev( it );
-					auto insertPosition = it;
+					auto item = std::move( *it );
+					auto insert_position = it;
 
-					while ( ( insertPosition != begin ) &&
-							( *it < *previousItem ) )
+					while ( insert_position != begin )
 					{
-						*insertPosition = *previousItem;
-						--insertPosition;
+						const auto previous_item = std::prev( insert_position );
+
+						if ( !( item < *previous_item ) )
+						{
+							break;
+						}
+
+						*insert_position = std::move( *previous_item );
+						insert_position = previous_item;
 					}
 
-					*insertPosition = *it;
+					*insert_position = std::move( item );
 				}
 			}
 		};
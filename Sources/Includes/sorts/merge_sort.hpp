@@ -8,6 +8,7 @@
 #pragma once
 
 #include "sort.hpp"
+#include "insertion_sort.hpp"
 
 namespace
 {
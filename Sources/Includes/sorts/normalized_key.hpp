@@ -0,0 +1,244 @@
+/**
+ * Daniel Sebastian Iliescu, http://dansil.net
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ *
+ * Order-preserving binary encoding of multi-field records.
+ *
+ * Each appended field is written so that comparing two keys byte by byte
+ * (memcmp, shorter key first on a common prefix) yields the same order as
+ * comparing the original fields one after the other:
+ *  - integers are written big-endian with the sign bit flipped,
+ *  - floating point values have their sign bit flipped when positive and
+ *    all bits flipped when negative,
+ *  - strings have 0x00 escaped as 0x00 0xFF and are terminated by 0x00 0x00.
+ *
+ * Descending fields are written as the complement of their ascending bytes.
+ *
+ * Strings may be truncated to a prefix. A truncated string is terminated by
+ * 0x01 instead, so that it sorts after the complete string equal to its
+ * prefix and before any string greater than its prefix. A truncated key no
+ * longer identifies its record: it is then marked incomplete, later fields
+ * are dropped, and equal keys have to be resolved by comparing the records
+ * themselves. This requires every key to truncate a field to the same length.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace dsa
+{
+	enum class sort_order
+	{
+		ascending,
+		descending
+	};
+
+	class normalized_key
+	{
+	public:
+		normalized_key() = default;
+		~normalized_key() noexcept = default;
+
+		normalized_key( const normalized_key& ) = default;
+		normalized_key( normalized_key&& ) noexcept = default;
+
+		normalized_key& operator=( const normalized_key& ) = default;
+		normalized_key& operator=( normalized_key&& ) noexcept = default;
+
+		bool
+		operator==( const normalized_key& rhs ) const noexcept
+		{
+			return ( compare( *this, rhs ) == 0 );
+		}
+
+		bool
+		operator!=( const normalized_key& rhs ) const noexcept
+		{
+			return !( *this == rhs );
+		}
+
+		bool
+		operator<( const normalized_key& rhs ) const noexcept
+		{
+			return ( compare( *this, rhs ) < 0 );
+		}
+
+		template < typename Integral >
+		std::enable_if_t< std::is_integral< Integral >::value, normalized_key& >
+		append(
+			const Integral value,
+			const sort_order order = sort_order::ascending )
+		{
+			using unsigned_type = std::make_unsigned_t< Integral >;
+
+			auto bits = static_cast< unsigned_type >( value );
+
+			if ( std::is_signed< Integral >::value )
+			{
+				bits ^= static_cast< unsigned_type >( unsigned_type( 1 ) << ( std::numeric_limits< unsigned_type >::digits - 1 ) );
+			}
+
+			this->append_big_endian( bits, order );
+
+			return *this;
+		}
+
+		template < typename Floating >
+		std::enable_if_t< std::is_floating_point< Floating >::value, normalized_key& >
+		append(
+			const Floating value,
+			const sort_order order = sort_order::ascending )
+		{
+			using unsigned_type =
+				std::conditional_t<
+					sizeof( Floating ) == sizeof( std::uint32_t ),
+					std::uint32_t,
+					std::uint64_t >;
+
+			static_assert( sizeof( Floating ) == sizeof( unsigned_type ), "Unsupported floating point width." );
+
+			// Collapse -0.0 onto +0.0 so that both encode to the same key.
+			const Floating canonical = ( value == Floating( 0 ) ) ? Floating( 0 ) : value;
+
+			unsigned_type bits;
+			std::memcpy( &bits, &canonical, sizeof( bits ) );
+
+			const auto sign = static_cast< unsigned_type >( unsigned_type( 1 ) << ( std::numeric_limits< unsigned_type >::digits - 1 ) );
+
+			bits = ( bits & sign ) ? static_cast< unsigned_type >( ~bits ) : static_cast< unsigned_type >( bits ^ sign );
+
+			this->append_big_endian( bits, order );
+
+			return *this;
+		}
+
+		normalized_key&
+		append(
+			const std::string_view value,
+			const sort_order order = sort_order::ascending,
+			const std::size_t max_length = std::string_view::npos )
+		{
+			if ( !this->is_complete )
+			{
+				return *this;
+			}
+
+			const auto mask = this->mask( order );
+			const auto length = std::min( value.size(), max_length );
+
+			for ( std::size_t character = 0; character < length; ++character )
+			{
+				const auto byte = static_cast< unsigned char >( value[ character ] );
+
+				this->bytes.push_back( static_cast< unsigned char >( byte ^ mask ) );
+
+				if ( byte == 0x00 )
+				{
+					this->bytes.push_back( static_cast< unsigned char >( 0xFF ^ mask ) );
+				}
+			}
+
+			if ( length < value.size() )
+			{
+				this->bytes.push_back( static_cast< unsigned char >( 0x01 ^ mask ) );
+				this->is_complete = false;
+			}
+			else
+			{
+				this->bytes.push_back( mask );
+				this->bytes.push_back( mask );
+			}
+
+			return *this;
+		}
+
+		// Whether equal keys imply equal records.
+		bool
+		complete() const noexcept
+		{
+			return this->is_complete;
+		}
+
+		void
+		clear() noexcept
+		{
+			this->bytes.clear();
+			this->is_complete = true;
+		}
+
+		const unsigned char*
+		data() const noexcept
+		{
+			return this->bytes.data();
+		}
+
+		std::size_t
+		size() const noexcept
+		{
+			return this->bytes.size();
+		}
+
+		static int
+		compare(
+			const unsigned char* lhs,
+			const std::size_t lhs_size,
+			const unsigned char* rhs,
+			const std::size_t rhs_size ) noexcept
+		{
+			const auto common_size = std::min( lhs_size, rhs_size );
+			const auto result = ( common_size == 0 ) ? 0 : std::memcmp( lhs, rhs, common_size );
+
+			if ( result != 0 )
+			{
+				return result;
+			}
+
+			return ( lhs_size < rhs_size ) ? -1 : ( ( lhs_size > rhs_size ) ? 1 : 0 );
+		}
+
+		static int
+		compare(
+			const normalized_key& lhs,
+			const normalized_key& rhs ) noexcept
+		{
+			return compare( lhs.data(), lhs.size(), rhs.data(), rhs.size() );
+		}
+
+	private:
+		static unsigned char
+		mask( const sort_order order ) noexcept
+		{
+			return ( order == sort_order::descending ) ? 0xFF : 0x00;
+		}
+
+		template < typename Unsigned >
+		void
+		append_big_endian(
+			const Unsigned bits,
+			const sort_order order )
+		{
+			if ( !this->is_complete )
+			{
+				return;
+			}
+
+			const auto mask = this->mask( order );
+
+			for ( auto shift = static_cast< int >( sizeof( Unsigned ) ) - 1; shift >= 0; --shift )
+			{
+				this->bytes.push_back( static_cast< unsigned char >( ( bits >> ( 8 * shift ) ) ^ mask ) );
+			}
+		}
+
+		std::vector< unsigned char > bytes;
+		bool is_complete = true;
+	};
+}
@@ -0,0 +1,243 @@
+/**
+ * Daniel Sebastian Iliescu, http://dansil.net
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ *
+ * Sort of multi-field records through their normalized keys.
+ *
+ * Every record is encoded once into a normalized_key. The first eight bytes
+ * of every key are radix sorted as a big-endian integer, and only records
+ * whose prefixes match compare the rest of their keys with memcmp. Records
+ * whose keys are still equal and incomplete (truncated strings) fall back to
+ * the optional full comparator. The user comparator chain is therefore never
+ * called for records that a key prefix already tells apart.
+ */
+
+#pragma once
+
+#include "normalized_key.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace dsa
+{
+	struct normalized
+	{
+		/**
+		 * Encoder is invoked as encoder( record, key ) and appends the fields
+		 * of the record to the (cleared) key. Records with equal keys keep
+		 * their relative order.
+		 */
+		template <
+			typename RandomAccessIterator,
+			typename Encoder >
+		static void
+		sort(
+			RandomAccessIterator begin,
+			RandomAccessIterator end,
+			Encoder encoder )
+		{
+			sort(
+				begin,
+				end,
+				std::move( encoder ),
+				[]( const auto&, const auto& )
+				{
+					return false;
+				} );
+		}
+
+		template <
+			typename RandomAccessIterator,
+			typename Encoder,
+			typename Compare >
+		static void
+		sort(
+			RandomAccessIterator begin,
+			RandomAccessIterator end,
+			Encoder encoder,
+			Compare full_compare )
+		{
+			using value_type = typename std::iterator_traits< RandomAccessIterator >::value_type;
+
+			const auto size = static_cast< std::size_t >( end - begin );
+
+			if ( size < 2 )
+			{
+				return;
+			}
+
+			// All keys share one buffer to avoid an allocation per record.
+			std::vector< unsigned char > storage;
+			std::vector< key_reference > keys( size );
+			std::vector< entry > entries( size );
+
+			normalized_key key;
+
+			for ( std::size_t record = 0; record < size; ++record )
+			{
+				key.clear();
+				encoder( static_cast< const value_type& >( begin[ record ] ), key );
+
+				keys[ record ] = { storage.size(), key.size(), key.complete() };
+				storage.insert( std::end( storage ), key.data(), key.data() + key.size() );
+			}
+
+			for ( std::size_t record = 0; record < size; ++record )
+			{
+				entries[ record ] = { load_prefix( storage.data() + keys[ record ].offset, keys[ record ].size ), record };
+			}
+
+			radix_sort( entries );
+
+			// Only runs of equal prefixes look at the remaining bytes.
+			for ( auto run_begin = std::begin( entries ); run_begin != std::end( entries ); )
+			{
+				const auto run_end = std::find_if(
+					std::next( run_begin ),
+					std::end( entries ),
+					[run_begin]( const entry& item )
+					{
+						return ( item.prefix != run_begin->prefix );
+					} );
+
+				if ( std::distance( run_begin, run_end ) > 1 )
+				{
+					std::stable_sort(
+						run_begin,
+						run_end,
+						[&]( const entry& lhs, const entry& rhs )
+						{
+							const auto& lhs_key = keys[ lhs.index ];
+							const auto& rhs_key = keys[ rhs.index ];
+
+							const auto result = normalized_key::compare(
+								storage.data() + lhs_key.offset,
+								lhs_key.size,
+								storage.data() + rhs_key.offset,
+								rhs_key.size );
+
+							if ( result != 0 )
+							{
+								return ( result < 0 );
+							}
+
+							return ( !lhs_key.complete || !rhs_key.complete ) &&
+								full_compare(
+									static_cast< const value_type& >( begin[ lhs.index ] ),
+									static_cast< const value_type& >( begin[ rhs.index ] ) );
+						} );
+				}
+
+				run_begin = run_end;
+			}
+
+			std::vector< value_type > sorted;
+			sorted.reserve( size );
+
+			for ( const auto& item : entries )
+			{
+				sorted.push_back( std::move( begin[ item.index ] ) );
+			}
+
+			std::move( std::begin( sorted ), std::end( sorted ), begin );
+		}
+
+	private:
+		struct key_reference
+		{
+			std::size_t offset;
+			std::size_t size;
+			bool complete;
+		};
+
+		struct entry
+		{
+			std::uint64_t prefix;
+			std::size_t index;
+		};
+
+		static std::uint64_t
+		load_prefix(
+			const unsigned char* bytes,
+			const std::size_t size ) noexcept
+		{
+			std::uint64_t prefix = 0;
+
+			for ( std::size_t byte = 0; byte < sizeof( prefix ); ++byte )
+			{
+				prefix = ( prefix << 8 ) | ( ( byte < size ) ? bytes[ byte ] : 0 );
+			}
+
+			return prefix;
+		}
+
+		/**
+		 * Stable least-significant-digit radix sort on the prefixes. All byte
+		 * histograms are gathered in one pass and passes in which every entry
+		 * falls in the same bucket are skipped.
+		 */
+		static void
+		radix_sort( std::vector< entry >& entries )
+		{
+			constexpr std::size_t BYTES = sizeof( std::uint64_t );
+			constexpr std::size_t BUCKETS = 256;
+
+			std::vector< std::array< std::size_t, BUCKETS > > histograms( BYTES );
+
+			for ( auto& histogram : histograms )
+			{
+				histogram.fill( 0 );
+			}
+
+			for ( const auto& item : entries )
+			{
+				for ( std::size_t byte = 0; byte < BYTES; ++byte )
+				{
+					++histograms[ byte ][ ( item.prefix >> ( 8 * byte ) ) & 0xFF ];
+				}
+			}
+
+			std::vector< entry > buffer( entries.size() );
+
+			for ( std::size_t byte = 0; byte < BYTES; ++byte )
+			{
+				auto& histogram = histograms[ byte ];
+
+				const auto skip = std::any_of(
+					std::cbegin( histogram ),
+					std::cend( histogram ),
+					[&entries]( const std::size_t count )
+					{
+						return ( count == entries.size() );
+					} );
+
+				if ( skip )
+				{
+					continue;
+				}
+
+				std::size_t offset = 0;
+				for ( auto& count : histogram )
+				{
+					const auto bucket_size = count;
+
+					count = offset;
+					offset += bucket_size;
+				}
+
+				for ( const auto& item : entries )
+				{
+					buffer[ histogram[ ( item.prefix >> ( 8 * byte ) ) & 0xFF ]++ ] = item;
+				}
+
+				entries.swap( buffer );
+			}
+		}
+	};
+}
@@ -8,6 +8,7 @@
 #pragma once
 
 #include "sort.hpp"
+#include "insertion_sort.hpp"
 
 namespace
 {
@@ -28,7 +29,7 @@ namespace dsa
 			{
 				if ( begin != end )
 				{
-					const auto size = static_cast< decltype( MERGE_THRESHOLD ) >( std::distance( begin, end ) );
+					const auto size = static_cast< decltype( PARTITION_THRESHOLD ) >( std::distance( begin, end ) );
 
 					if ( size > PARTITION_THRESHOLD )
 					{
@@ -87,14 +88,14 @@ namespace dsa
 			{
 				if ( begin != end )
 				{
-					const auto size = static_cast< decltype( MERGE_THRESHOLD ) >( begin - end );
+					const auto size = static_cast< decltype( PARTITION_THRESHOLD ) >( end - begin );
 
 					if ( size > PARTITION_THRESHOLD )
 					{
-						const auto partition = dsa::partition( begin, end );
+						const auto equal_range = dsa::partition_equal_range( begin, end );
 
-						sort( begin, partition );
-						sort( partition + 1, end );
+						sort( begin, equal_range.first );
+						sort( equal_range.second, end );
 					}
 					else
 					{
@@ -0,0 +1,347 @@
+/**
+ * Daniel Sebastian Iliescu, http://dansil.net
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ *
+ * Implementation of a parallel sample sort over pre-sharded data.
+ *
+ * The input is a collection of P shards (e.g. one per NUMA node). P - 1
+ * splitters are chosen from an oversampled set of keys, every shard is
+ * classified locally with a branchless splitter tree (Super Scalar Sample
+ * Sort), the buckets are exchanged so that shard i receives bucket i from
+ * every other shard, and each shard is then sorted locally. Every step
+ * after splitter selection runs on one thread per shard and only touches
+ * the memory of the shard it owns, apart from the single pull of buckets
+ * during the exchange.
+ *
+ * On completion each shard is sorted and every element of shard i is
+ * less than or equal to every element of shard i + 1.
+ */
+
+#pragma once
+
+#include "sort.hpp"
+#include "quick_sort.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <future>
+#include <iterator>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace
+{
+	// Samples drawn per output shard when choosing splitters.
+	static constexpr std::size_t SAMPLE_OVERSAMPLING = 16;
+
+	// Below this size the iterator interface sorts locally instead of sharding.
+	static constexpr std::size_t SAMPLE_THRESHOLD = 1U << 14;
+}
+
+namespace dsa
+{
+	struct sample
+	{
+		template <
+			typename LocalSort = quick::std_implementation,
+			typename T,
+			typename ShardAllocator,
+			typename ShardsAllocator >
+		static void
+		sort( std::vector< std::vector< T, ShardAllocator >, ShardsAllocator >& shards )
+		{
+			using shard_type = std::vector< T, ShardAllocator >;
+
+			const auto shard_count = shards.size();
+
+			if ( shard_count <= 1 )
+			{
+				for ( auto& shard : shards )
+				{
+					LocalSort::sort( std::begin( shard ), std::end( shard ) );
+				}
+
+				return;
+			}
+
+			const classifier< T > splitter_tree( select_splitters( shards ), shard_count );
+
+			// Local classification: buckets[ source ][ destination ].
+			std::vector< std::vector< shard_type > > buckets( shard_count );
+
+			for_each_shard(
+				shard_count,
+				[&]( const std::size_t source )
+				{
+					buckets[ source ] = splitter_tree.distribute( std::move( shards[ source ] ) );
+				} );
+
+			// Exchange and local sort: each shard pulls its bucket from every source.
+			for_each_shard(
+				shard_count,
+				[&]( const std::size_t destination )
+				{
+					std::size_t received = 0;
+
+					for ( const auto& source_buckets : buckets )
+					{
+						received += source_buckets[ destination ].size();
+					}
+
+					shard_type shard;
+					shard.reserve( received );
+
+					for ( auto& source_buckets : buckets )
+					{
+						auto& bucket = source_buckets[ destination ];
+
+						std::move(
+							std::begin( bucket ),
+							std::end( bucket ),
+							std::back_inserter( shard ) );
+
+						shard_type().swap( bucket );
+					}
+
+					LocalSort::sort( std::begin( shard ), std::end( shard ) );
+
+					shards[ destination ] = std::move( shard );
+				} );
+		}
+
+		/**
+		 * Range interface so that the sample sort can be used like the other
+		 * engines. The range is split into one shard per hardware thread and
+		 * copied back once the shards are sorted.
+		 */
+		template <
+			typename LocalSort = quick::std_implementation,
+			typename RandomAccessIterator >
+		static void
+		sort(
+			RandomAccessIterator begin,
+			RandomAccessIterator end )
+		{
+			const auto size = static_cast< std::size_t >( end - begin );
+
+			sort< LocalSort >(
+				begin,
+				end,
+				std::min< std::size_t >(
+					std::max( 1U, std::thread::hardware_concurrency() ),
+					size / SAMPLE_THRESHOLD ) );
+		}
+
+		// Range interface splitting the range into the given number of shards.
+		template <
+			typename LocalSort = quick::std_implementation,
+			typename RandomAccessIterator >
+		static void
+		sort(
+			RandomAccessIterator begin,
+			RandomAccessIterator end,
+			const std::size_t shard_count )
+		{
+			using value_type = typename std::iterator_traits< RandomAccessIterator >::value_type;
+
+			const auto size = static_cast< std::size_t >( end - begin );
+
+			if ( ( shard_count <= 1 ) || ( size < shard_count ) )
+			{
+				LocalSort::sort( begin, end );
+
+				return;
+			}
+
+			std::vector< std::vector< value_type > > shards( shard_count );
+
+			for ( std::size_t shard = 0; shard < shard_count; ++shard )
+			{
+				shards[ shard ].assign(
+					std::make_move_iterator( begin + ( size * shard ) / shard_count ),
+					std::make_move_iterator( begin + ( size * ( shard + 1 ) ) / shard_count ) );
+			}
+
+			sort< LocalSort >( shards );
+
+			for ( auto& shard : shards )
+			{
+				begin = std::move( std::begin( shard ), std::end( shard ), begin );
+			}
+		}
+
+	private:
+		/**
+		 * Implicit binary search tree over the splitters (Eytzinger layout).
+		 * Classification descends the tree using the comparison result as an
+		 * index offset, so there are no data-dependent branches and the loop
+		 * count is the same for every element.
+		 */
+		template < typename T >
+		class classifier
+		{
+		public:
+			classifier(
+				std::vector< T > splitters,
+				const std::size_t input_buckets ) :
+				buckets( input_buckets )
+			{
+				while ( ( std::size_t( 1 ) << this->levels ) < this->buckets )
+				{
+					++( this->levels );
+				}
+
+				// Pad with the largest splitter to complete the tree; the padded
+				// buckets are folded back into the last bucket on classification.
+				splitters.resize( ( std::size_t( 1 ) << this->levels ) - 1, splitters.back() );
+
+				this->tree.resize( std::size_t( 1 ) << this->levels );
+				this->build( splitters, 0, splitters.size(), 1 );
+			}
+
+			std::size_t
+			classify( const T& item ) const
+			{
+				std::size_t index = 1;
+
+				for ( std::size_t level = 0; level < this->levels; ++level )
+				{
+					index = 2 * index + static_cast< std::size_t >( this->tree[ index ] < item );
+				}
+
+				return std::min( index - this->tree.size(), this->buckets - 1 );
+			}
+
+			template < typename Shard >
+			std::vector< Shard >
+			distribute( Shard shard ) const
+			{
+				std::vector< std::size_t > oracle( shard.size() );
+				std::vector< std::size_t > counts( this->buckets );
+
+				for ( std::size_t item = 0; item < shard.size(); ++item )
+				{
+					oracle[ item ] = this->classify( shard[ item ] );
+					++counts[ oracle[ item ] ];
+				}
+
+				std::vector< Shard > distributed( this->buckets );
+
+				for ( std::size_t bucket = 0; bucket < this->buckets; ++bucket )
+				{
+					distributed[ bucket ].reserve( counts[ bucket ] );
+				}
+
+				for ( std::size_t item = 0; item < shard.size(); ++item )
+				{
+					distributed[ oracle[ item ] ].push_back( std::move( shard[ item ] ) );
+				}
+
+				return distributed;
+			}
+
+		private:
+			void
+			build(
+				const std::vector< T >& splitters,
+				const std::size_t first,
+				const std::size_t last,
+				const std::size_t index )
+			{
+				if ( first < last )
+				{
+					const auto mid = first + ( last - first ) / 2;
+
+					this->tree[ index ] = splitters[ mid ];
+
+					this->build( splitters, first, mid, 2 * index );
+					this->build( splitters, mid + 1, last, 2 * index + 1 );
+				}
+			}
+
+			std::vector< T > tree;
+			std::size_t buckets;
+			std::size_t levels = 0;
+		};
+
+		template < typename Shards >
+		static auto
+		select_splitters( const Shards& shards )
+		{
+			using value_type = typename Shards::value_type::value_type;
+
+			const auto shard_count = shards.size();
+
+			std::size_t total = 0;
+			for ( const auto& shard : shards )
+			{
+				total += shard.size();
+			}
+
+			// Every shard contributes samples in proportion to its size.
+			std::vector< value_type > samples;
+			samples.reserve( SAMPLE_OVERSAMPLING * shard_count + shard_count );
+
+			for ( std::size_t shard = 0; shard < shard_count; ++shard )
+			{
+				const auto& items = shards[ shard ];
+
+				if ( items.empty() )
+				{
+					continue;
+				}
+
+				const auto sample_count = std::min(
+					items.size(),
+					( SAMPLE_OVERSAMPLING * shard_count * items.size() + total - 1 ) / total );
+
+				std::minstd_rand engine( static_cast< std::minstd_rand::result_type >( shard + 1 ) );
+				std::uniform_int_distribution< std::size_t > distribution( 0, items.size() - 1 );
+
+				for ( std::size_t drawn = 0; drawn < sample_count; ++drawn )
+				{
+					samples.push_back( items[ distribution( engine ) ] );
+				}
+			}
+
+			if ( samples.empty() )
+			{
+				samples.emplace_back();
+			}
+
+			std::sort( std::begin( samples ), std::end( samples ) );
+
+			std::vector< value_type > splitters;
+			splitters.reserve( shard_count - 1 );
+
+			for ( std::size_t splitter = 1; splitter < shard_count; ++splitter )
+			{
+				splitters.push_back( samples[ ( splitter * samples.size() ) / shard_count ] );
+			}
+
+			return splitters;
+		}
+
+		template < typename Function >
+		static void
+		for_each_shard(
+			const std::size_t shard_count,
+			Function&& function )
+		{
+			std::vector< std::future< void > > tasks;
+			tasks.reserve( shard_count );
+
+			for ( std::size_t shard = 0; shard < shard_count; ++shard )
+			{
+				tasks.push_back( std::async( std::launch::async, function, shard ) );
+			}
+
+			for ( auto& task : tasks )
+			{
+				task.get();
+			}
+		}
+	};
+}
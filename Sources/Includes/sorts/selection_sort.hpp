@@ -7,6 +7,8 @@
 
 #pragma once
 
+#include "sort.hpp"
+
 #include <algorithm>
 #include <utility>
 
@@ -17,7 +19,7 @@ namespace dsa
 		struct std_implementation
 		{
 			template < typename Iterator >
-			static void
+			static DSA_CONSTEXPR_SORT void
 			sort(
 				Iterator begin,
 				Iterator end )
@@ -36,13 +38,18 @@ namespace dsa
 		struct custom_implementation
 		{
 			template < typename Iterator >
-			static void
+			static DSA_CONSTEXPR_SORT void
 			sort(
 				Iterator begin,
 				Iterator end )
 			{
 				using std::swap;
 
+				if ( begin == end )
+				{
+					return;
+				}
+
 				for ( auto current_it = begin; current_it != std::prev( end ); ++current_it )
 				{
 					auto current_minimum = current_it;
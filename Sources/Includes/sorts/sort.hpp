@@ -7,9 +7,22 @@
 
 #pragma once
 
+#include "three_way_partition.hpp"
+
+#include <algorithm>
 #include <iterator>
 #include <vector>
 
+/**
+ * Sorts which only rely on constexpr standard algorithms can be
+ * evaluated at compile time once the library supports it (C++20).
+ */
+#if defined( __cpp_lib_constexpr_algorithms )
+#define DSA_CONSTEXPR_SORT constexpr
+#else
+#define DSA_CONSTEXPR_SORT
+#endif
+
 namespace dsa
 {
 	template<
@@ -53,10 +66,14 @@ namespace dsa
 	 * is different than a partition algorithm which 
 	 * groups values less than the pivot but forgoes
 	 * any guarantees about the relative pivot position.
+	 *
+	 * All the elements equal to the pivot are grouped
+	 * together and their range is returned, which lets
+	 * callers skip them entirely on low-cardinality keys.
 	 */
 	template < typename RandomAccessIterator >
 	auto
-	partition(
+	partition_equal_range(
 		RandomAccessIterator begin,
 		RandomAccessIterator end )
 	{
@@ -69,29 +86,15 @@ namespace dsa
 				std::min( *begin, *container_end ),
 				std::min( std::max( *begin, *container_end ), *center ) );
 
-		auto mid = begin;
-
-		while ( mid != end )
-		{
-			if ( *mid < pivot )
-			{
-				std::swap( *begin, *mid );
-
-				++begin;
-				++mid;
-			}
-			else if ( *mid == pivot )
-			{
-				++mid;
-			}
-			else
-			{
-				--end;
-
-				std::swap( *end, *mid );
-			}
-		}
+		return three_way_partition::partition( begin, end, pivot );
+	}
 
-		return begin;
+	template < typename RandomAccessIterator >
+	auto
+	partition(
+		RandomAccessIterator begin,
+		RandomAccessIterator end )
+	{
+		return partition_equal_range( begin, end ).first;
 	}
 }
\ No newline at end of file
@@ -0,0 +1,418 @@
+/**
+ * Daniel Sebastian Iliescu, http://dansil.net
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ *
+ * Three-way partition around a given pivot value.
+ *
+ * The range is rearranged into [ less | equal | greater ] and the bounds of
+ * the equal region are returned. Three implementations are provided:
+ *  - generic: Dutch national flag loop for any element type,
+ *  - branchless: two Lomuto passes (less, then equal) whose only
+ *    data-dependent operation is an index increment, for arithmetic types,
+ *  - vectorized: the same two passes with AVX2 compress-store emulation,
+ *    in place, for contiguous ranges of 32-bit integers and floats (only
+ *    when compiled with AVX2 enabled).
+ *
+ * Elements which are neither less than nor equal to the pivot (e.g. NaN)
+ * are placed in the greater region by every implementation.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#if defined( __AVX2__ )
+#include <immintrin.h>
+#endif
+
+namespace dsa
+{
+	struct three_way_partition
+	{
+		struct generic_implementation
+		{
+			template <
+				typename RandomAccessIterator,
+				typename T >
+			static std::pair< RandomAccessIterator, RandomAccessIterator >
+			partition(
+				RandomAccessIterator begin,
+				RandomAccessIterator end,
+				const T& pivot )
+			{
+				using std::swap;
+
+				auto mid = begin;
+
+				while ( mid != end )
+				{
+					if ( *mid < pivot )
+					{
+						swap( *begin, *mid );
+
+						++begin;
+						++mid;
+					}
+					else if ( *mid == pivot )
+					{
+						++mid;
+					}
+					else
+					{
+						--end;
+
+						swap( *end, *mid );
+					}
+				}
+
+				return { begin, end };
+			}
+		};
+
+		struct branchless_implementation
+		{
+			template <
+				typename RandomAccessIterator,
+				typename T >
+			static std::pair< RandomAccessIterator, RandomAccessIterator >
+			partition(
+				RandomAccessIterator begin,
+				RandomAccessIterator end,
+				const T pivot )
+			{
+				const auto less_end = lomuto(
+					begin,
+					end,
+					[pivot]( const T item )
+					{
+						return ( item < pivot );
+					} );
+
+				const auto equal_end = lomuto(
+					less_end,
+					end,
+					[pivot]( const T item )
+					{
+						return ( item == pivot );
+					} );
+
+				return { less_end, equal_end };
+			}
+
+			// Every element is swapped unconditionally; the predicate only moves the boundary.
+			template <
+				typename RandomAccessIterator,
+				typename Predicate >
+			static RandomAccessIterator
+			lomuto(
+				RandomAccessIterator begin,
+				RandomAccessIterator end,
+				Predicate predicate )
+			{
+				auto boundary = begin;
+
+				for ( auto it = begin; it != end; ++it )
+				{
+					const auto item = *it;
+
+					*it = *boundary;
+					*boundary = item;
+
+					boundary += static_cast< std::ptrdiff_t >( predicate( item ) );
+				}
+
+				return boundary;
+			}
+		};
+
+#if defined( __AVX2__ )
+		struct vectorized_implementation
+		{
+			template < typename T >
+			static constexpr bool supported =
+				std::is_same< T, std::int32_t >::value ||
+				std::is_same< T, std::uint32_t >::value ||
+				std::is_same< T, float >::value;
+
+			template < typename T >
+			static std::pair< T*, T* >
+			partition(
+				T* begin,
+				T* end,
+				const T pivot )
+			{
+				const auto pivots = broadcast( pivot );
+
+				const auto less_end = two_way(
+					begin,
+					end,
+					[pivots]( const __m256i items )
+					{
+						return classify< T >( items, pivots ).less;
+					},
+					[pivot]( const T item )
+					{
+						return ( item < pivot );
+					} );
+
+				const auto equal_end = two_way(
+					less_end,
+					end,
+					[pivots]( const __m256i items )
+					{
+						return classify< T >( items, pivots ).equal;
+					},
+					[pivot]( const T item )
+					{
+						return ( item == pivot );
+					} );
+
+				return { less_end, equal_end };
+			}
+
+		private:
+			static constexpr std::ptrdiff_t LANES = 8;
+
+			/**
+			 * In-place vectorized two-way partition. One vector from each end
+			 * is held in registers, which leaves room to write a full vector
+			 * on both sides: matching lanes are stored at the left write
+			 * position and the others at the right write position, using a
+			 * single permutation that moves the matching lanes to the front.
+			 * Vectors are read from whichever side has the least room left.
+			 */
+			template <
+				typename T,
+				typename VectorPredicate,
+				typename Predicate >
+			static T*
+			two_way(
+				T* begin,
+				T* end,
+				VectorPredicate vector_predicate,
+				Predicate predicate )
+			{
+				const auto remainder = ( end - begin ) % LANES;
+
+				if ( ( end - begin ) < ( 2 * LANES + remainder ) )
+				{
+					return branchless_implementation::lomuto( begin, end, predicate );
+				}
+
+				// The tail which does not fill a vector is held aside and inserted last.
+				T tail[ LANES ];
+				std::copy( end - remainder, end, tail );
+
+				auto read_left = begin;
+				auto read_right = end - remainder;
+				auto store_left = begin;
+				auto store_right = end - remainder;
+
+				const auto first = _mm256_loadu_si256( reinterpret_cast< const __m256i* >( read_left ) );
+				const auto last = _mm256_loadu_si256( reinterpret_cast< const __m256i* >( read_right - LANES ) );
+
+				read_left += LANES;
+				read_right -= LANES;
+
+				const auto store = [&]( const __m256i items )
+				{
+					const auto mask = static_cast< unsigned >( _mm256_movemask_ps( _mm256_castsi256_ps( vector_predicate( items ) ) ) );
+					const auto matches = static_cast< std::ptrdiff_t >( _mm_popcnt_u32( mask ) );
+					const auto permuted = _mm256_permutevar8x32_epi32( items, permutation( mask ) );
+
+					_mm256_storeu_si256( reinterpret_cast< __m256i* >( store_right - LANES ), permuted );
+					_mm256_storeu_si256( reinterpret_cast< __m256i* >( store_left ), permuted );
+
+					store_left += matches;
+					store_right -= LANES - matches;
+				};
+
+				while ( read_left != read_right )
+				{
+					__m256i items;
+
+					if ( ( read_left - store_left ) <= ( store_right - read_right ) )
+					{
+						items = _mm256_loadu_si256( reinterpret_cast< const __m256i* >( read_left ) );
+						read_left += LANES;
+					}
+					else
+					{
+						read_right -= LANES;
+						items = _mm256_loadu_si256( reinterpret_cast< const __m256i* >( read_right ) );
+					}
+
+					store( items );
+				}
+
+				store( first );
+				store( last );
+
+				// The remaining slots past the partitioned vectors receive the tail.
+				auto boundary = store_left;
+				auto false_end = end - remainder;
+
+				for ( std::ptrdiff_t item = 0; item < remainder; ++item )
+				{
+					if ( predicate( tail[ item ] ) )
+					{
+						*false_end = *boundary;
+						*boundary = tail[ item ];
+
+						++boundary;
+					}
+					else
+					{
+						*false_end = tail[ item ];
+					}
+
+					++false_end;
+				}
+
+				return boundary;
+			}
+
+			// Permutation indices which move the selected lanes to the front and the others to the back.
+			struct permutation_table
+			{
+				constexpr permutation_table() :
+					indices()
+				{
+					for ( std::size_t mask = 0; mask < 256; ++mask )
+					{
+						std::size_t position = 0;
+
+						for ( std::uint32_t lane = 0; lane < LANES; ++lane )
+						{
+							if ( mask & ( std::size_t( 1 ) << lane ) )
+							{
+								indices[ mask ][ position++ ] = lane;
+							}
+						}
+
+						for ( std::uint32_t lane = 0; lane < LANES; ++lane )
+						{
+							if ( !( mask & ( std::size_t( 1 ) << lane ) ) )
+							{
+								indices[ mask ][ position++ ] = lane;
+							}
+						}
+					}
+				}
+
+				alignas( 32 ) std::uint32_t indices[ 256 ][ LANES ];
+			};
+
+			static __m256i
+			permutation( const unsigned mask ) noexcept
+			{
+				static constexpr permutation_table table;
+
+				return _mm256_load_si256( reinterpret_cast< const __m256i* >( table.indices[ mask ] ) );
+			}
+
+			template < typename T >
+			static __m256i
+			broadcast( const T pivot ) noexcept
+			{
+				std::int32_t bits;
+				std::memcpy( &bits, &pivot, sizeof( bits ) );
+
+				return _mm256_set1_epi32( bits );
+			}
+
+			struct lane_masks
+			{
+				__m256i less;
+				__m256i equal;
+			};
+
+			template < typename T >
+			static lane_masks
+			classify(
+				const __m256i items,
+				const __m256i pivots ) noexcept
+			{
+				if constexpr ( std::is_same< T, float >::value )
+				{
+					const auto values = _mm256_castsi256_ps( items );
+					const auto pivot_values = _mm256_castsi256_ps( pivots );
+
+					return {
+						_mm256_castps_si256( _mm256_cmp_ps( values, pivot_values, _CMP_LT_OQ ) ),
+						_mm256_castps_si256( _mm256_cmp_ps( values, pivot_values, _CMP_EQ_OQ ) ) };
+				}
+				else if constexpr ( std::is_same< T, std::uint32_t >::value )
+				{
+					// Flip the sign bits so that the signed comparison orders unsigned values.
+					const auto sign = _mm256_set1_epi32( std::numeric_limits< std::int32_t >::min() );
+
+					return {
+						_mm256_cmpgt_epi32( _mm256_xor_si256( pivots, sign ), _mm256_xor_si256( items, sign ) ),
+						_mm256_cmpeq_epi32( items, pivots ) };
+				}
+				else
+				{
+					return {
+						_mm256_cmpgt_epi32( pivots, items ),
+						_mm256_cmpeq_epi32( items, pivots ) };
+				}
+			}
+		};
+#endif
+
+		/**
+		 * Picks the fastest implementation available for the iterator and
+		 * element type.
+		 */
+		template <
+			typename RandomAccessIterator,
+			typename T >
+		static std::pair< RandomAccessIterator, RandomAccessIterator >
+		partition(
+			RandomAccessIterator begin,
+			RandomAccessIterator end,
+			const T& pivot )
+		{
+			using value_type = typename std::iterator_traits< RandomAccessIterator >::value_type;
+
+#if defined( __AVX2__ )
+#if defined( __cpp_lib_concepts )
+			constexpr bool contiguous = std::contiguous_iterator< RandomAccessIterator >;
+#else
+			constexpr bool contiguous = std::is_pointer< RandomAccessIterator >::value;
+#endif
+
+			if constexpr ( contiguous &&
+						   vectorized_implementation::supported< value_type > )
+			{
+				if ( begin == end )
+				{
+					return { begin, end };
+				}
+
+				const auto data = &*begin;
+				const auto bounds = vectorized_implementation::partition( data, data + ( end - begin ), static_cast< value_type >( pivot ) );
+
+				return { begin + ( bounds.first - data ), begin + ( bounds.second - data ) };
+			}
+			else
+#endif
+			if constexpr ( std::is_arithmetic< value_type >::value )
+			{
+				return branchless_implementation::partition( begin, end, static_cast< value_type >( pivot ) );
+			}
+			else
+			{
+				return generic_implementation::partition( begin, end, pivot );
+			}
+		}
+	};
+}
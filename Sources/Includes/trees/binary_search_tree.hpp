@@ -1,14 +1,27 @@
 /**
  * Daniel Sebastian Iliescu, http://dansil.net
  * MIT License (MIT), http://opensource.org/licenses/MIT
+ *
+ * The nodes are kept by a storage policy (see binary_search_tree_storage.hpp): individually allocated
+ * and linked by pointer by default, or packed into a vector and linked by index with flat_tree_storage.
+ * The shape of the tree is kept by a balancing policy (see binary_search_tree_balance.hpp): unbalanced by
+ * default, or AVL or red-black.
+ *
+ * Every node keeps the height and the balance of its subtree, which are updated along the paths modified
+ * by insert and erase, so that height() and balanced() operate in constant time.
  */
 
 #pragma once
 
+#include "binary_search_tree_balance.hpp"
 #include "binary_search_tree_node.hpp"
+#include "binary_search_tree_storage.hpp"
 
+#include <algorithm>
+#include <cstdint>
 #include <memory>
 #include <functional>
+#include <utility>
 
 #include <iostream>
 
@@ -16,26 +29,59 @@ namespace dsa
 {
 	template <
 		typename Key,
-		typename Value >
+		typename Value,
+		typename Allocator = std::allocator< std::pair< const Key, Value > >,
+		template < typename, typename, typename > class Storage = linked_tree_storage,
+		typename Balance = unbalanced_policy >
 	class binary_search_tree
 	{
+		friend Balance;
+
+		template < typename Policy >
+		friend struct rebalancing_policy;
+
+		using storage_type = Storage< Key, Value, Allocator >;
+		using link_type = typename storage_type::link_type;
+
+		static constexpr link_type null = storage_type::null;
 
 	public:
-		using node_type = std::unique_ptr< binary_search_tree_node< Key, Value > >;
+		using node_type = typename storage_type::node_type*;
+		using allocator_type = typename storage_type::allocator_type;
 
 		binary_search_tree() = default;
+
+		explicit binary_search_tree( const allocator_type& input_allocator ) noexcept :
+			storage( input_allocator )
+		{
+		}
+
 		~binary_search_tree() noexcept = default;
 
+		// Copies every node; persistent_map shares them instead.
 		binary_search_tree( const binary_search_tree& other ) = default;
-		binary_search_tree( binary_search_tree&& other ) noexcept = default;
+
+		binary_search_tree( binary_search_tree&& other ) noexcept :
+			storage( std::move( other.storage ) ),
+			nodes( std::exchange( other.nodes, 0 ) )
+		{
+		}
 
 		binary_search_tree& operator=( const binary_search_tree& rhs ) = default;
-		binary_search_tree& operator=( binary_search_tree&& rhs ) noexcept = default;
+
+		binary_search_tree&
+		operator=( binary_search_tree&& rhs ) noexcept( allocator_moves_storage_v< allocator_type > )
+		{
+			this->storage = std::move( rhs.storage );
+			this->nodes = std::exchange( rhs.nodes, 0 );
+
+			return *this;
+		}
 
 		bool
 		operator==( const binary_search_tree& other ) const
 		{
-			return ( this != &other && this->are_equal( root, other.root ) );
+			return ( this != &other && this->are_equal( this->storage.root(), other.storage.root() ) );
 		}
 
 		bool
@@ -49,19 +95,19 @@ namespace dsa
 			const Key key,
 			const Value value )
 		{
-			this->insert( this->root, key, value );
+			this->storage.root() = Balance::insert( *this, this->storage.root(), key, value );
 		}
 
 		void
 		erase( const Key key )
 		{
-			this->erase( this->root, key );
+			this->storage.root() = Balance::erase( *this, this->storage.root(), key );
 		}
 
 		bool
 		contains( const Key key )
 		{
-			return this->contains( this->root, key );
+			return this->contains( this->storage.root(), key );
 		}
 
 		std::size_t
@@ -69,7 +115,7 @@ namespace dsa
 		{
 			std::size_t calculated_nodes = 0;
 
-			this->preorder( this->root, [&calculated_nodes](const auto&)
+			this->preorder( this->storage.root(), [&calculated_nodes](const auto&)
 			{
 				++calculated_nodes;
 			});
@@ -80,21 +126,29 @@ namespace dsa
 		std::size_t
 		height()
 		{
-			const auto height = this->height( this->root );
+			const auto height = this->height( this->storage.root() );
 
 			return ( height == 0 ) ? height : height - 1;
 		}
 
+		// Whether the heights of the children of every node differ by at most one.
 		bool
 		balanced()
 		{
-			return this->balanced( this->root );
+			return this->balanced( this->storage.root() );
+		}
+
+		void
+		clear() noexcept
+		{
+			this->storage.clear();
+			this->nodes = 0;
 		}
 
 		bool
 		empty() const
 		{
-			return ( !this->root && !this->nodes );
+			return ( ( this->storage.root() == null ) && !this->nodes );
 		}
 
 		auto
@@ -103,217 +157,227 @@ namespace dsa
 			return this->nodes;
 		}
 
+		allocator_type
+		get_allocator() const
+		{
+			return this->storage.get_allocator();
+		}
+
 		void
 		preorder( std::function< void( node_type const & ) >&& callback )
 		{
-			this->preorder( this->root, std::move( callback ) );
+			this->preorder( this->storage.root(), std::move( callback ) );
 		}
 
 		void
 		inorder( std::function< void( node_type const & ) >&& callback )
 		{
-			this->inorder( this->root, std::move( callback ) );
+			this->inorder( this->storage.root(), std::move( callback ) );
 		}
 
 		void
 		postorder( std::function< void( node_type const & ) >&& callback )
 		{
-			this->postorder( this->root, std::move( callback ) );
+			this->postorder( this->storage.root(), std::move( callback ) );
 		}
 
 	private:
+		auto&
+		node( const link_type link )
+		{
+			return this->storage.node( link );
+		}
 
-		auto
-		create_node(
-			const Key key,
-			const Value value )
+		link_type
+		create(
+			const Key& key,
+			const Value& value )
 		{
-			return std::make_unique< binary_search_tree_node< Key, Value > >( key, value );
+			const auto node = this->storage.create( key, value );
+
+			++( this->nodes );
+
+			return node;
 		}
 
 		void
-		insert(
-			node_type& current,
-			const Key key,
-			const Value value )
+		destroy( const link_type link ) noexcept
 		{
-			if( !current )
-			{
-				current = this->create_node( key, value );
+			this->storage.destroy( link );
 
-				++( this->nodes );
-			}
-			else if ( key > current->key )
-			{
-				this->insert( current->right, key, value );
-			}
-			else if ( key < current->key )
-			{
-				this->insert( current->left, key, value );
-			}
+			--( this->nodes );
 		}
 
+		// Recomputes the height and the balance of the subtree of a node from those of its children.
 		void
-		erase(
-			node_type& current,
-			const Key key )
+		update( const link_type current )
 		{
-			if ( current )
-			{
-				if ( key == current->key )
-				{
-					if ( !current->left && !current->right )
-					{
-						current = nullptr;
-						--nodes;
-					}
-					else if ( current->left && !current->right )
-					{
-						current = std::move( current->left );
-						--nodes;
-					}
-					else if ( current->right && !current->left )
-					{
-						current = std::move( current->right );
-						--nodes;
-					}
-					else
-					{
-						const binary_search_tree_node<Key, Value> temp_node = this->find_max( current->left );
-
-						current->key = temp_node.key;
-						current->value = temp_node.value;
-
-						this->erase( current->left, current->key );
-					}
-				}
-				else if ( key > current->key )
-				{
-					this->erase( current->right, key );
-				}
-				else if ( key < current->key )
-				{
-					this->erase( current->left, key );
-				}
-			}
+			auto& node = this->node( current );
+
+			const auto left_height = this->height( node.left );
+			const auto right_height = this->height( node.right );
+
+			node.height = 1 + std::max( left_height, right_height );
+			node.balanced =
+				this->balanced( node.left ) &&
+				this->balanced( node.right ) &&
+				( std::max( left_height, right_height ) - std::min( left_height, right_height ) <= 1 );
+		}
+
+		// Rotates the right child of the node up, and returns it.
+		link_type
+		rotate_left( const link_type current )
+		{
+			const auto right = this->node( current ).right;
+
+			this->node( current ).right = this->node( right ).left;
+			this->node( right ).left = current;
+
+			this->update( current );
+			this->update( right );
+
+			return right;
+		}
+
+		// Rotates the left child of the node up, and returns it.
+		link_type
+		rotate_right( const link_type current )
+		{
+			const auto left = this->node( current ).left;
+
+			this->node( current ).left = this->node( left ).right;
+			this->node( left ).right = current;
+
+			this->update( current );
+			this->update( left );
+
+			return left;
 		}
 
-		binary_search_tree_node<Key, Value>
-		find_max( node_type& current )
+		link_type
+		find_min( link_type current )
 		{
-			if ( current )
+			while ( this->node( current ).left != null )
 			{
-				auto* node = current.get();
+				current = this->node( current ).left;
+			}
 
-				while ( node->right )
-				{
-					node = node->right.get();
-				}
+			return current;
+		}
 
-				return binary_search_tree_node<Key, Value>( node->key, node->value );
+		link_type
+		find_max( link_type current )
+		{
+			while ( this->node( current ).right != null )
+			{
+				current = this->node( current ).right;
 			}
 
-			return binary_search_tree_node<Key, Value>();
+			return current;
 		}
 
 		bool
 		contains(
-			node_type& current,
+			const link_type current,
 			const Key key )
 		{
-			if ( current )
+			if ( current != null )
 			{
-				if ( key == current->key )
+				if ( key == this->node( current ).key )
 				{
 					return true;
 				}
-				else if ( key > current->key )
+				else if ( key > this->node( current ).key )
 				{
-					return this->contains( current->right, key );
+					return this->contains( this->node( current ).right, key );
 				}
-				else if ( key < current->key )
+				else if ( key < this->node( current ).key )
 				{
-					return this->contains( current->left, key );
+					return this->contains( this->node( current ).left, key );
 				}
 			}
 
 			return false;
 		}
 
-		std::size_t
-		height( node_type& current )
+		std::uint32_t
+		height( const link_type current )
 		{
-			if ( current )
-			{
-				return 1 + std::max( this->height( current->left ), this->height( current->right ));
-			}
-
-			return 0;
+			return ( current != null ) ? this->node( current ).height : 0;
 		}
 
 		bool
-		balanced( node_type& current )
+		balanced( const link_type current )
 		{
-			if ( current )
-			{
-				if ( this->balanced( current->left ) && this->balanced( current->right ) )
-				{
-					const auto left_subtree_height = static_cast<int>( this->height( current->left ) );
-					const auto right_subtree_height = static_cast<int>( this->height( current->right ) );
-
-					return ( std::abs( left_subtree_height - right_subtree_height ) <= 1 );
-				}
-
-				return false;
-			}
-
-			return true;
+			return ( current == null ) || this->node( current ).balanced;
 		}
 
 		void
 		preorder(
-			node_type& current,
+			const link_type current,
 			std::function< void( node_type const & ) >&& callback )
 		{
-			if ( current )
+			if ( current != null )
 			{
-				callback( current );
+				callback( &this->node( current ) );
 
-				this->preorder( current->left, std::move( callback ) );
-				this->preorder( current->right, std::move( callback ) );
+				this->preorder( this->node( current ).left, std::move( callback ) );
+				this->preorder( this->node( current ).right, std::move( callback ) );
 			}
 		}
 
 		void
 		inorder(
-			node_type& current,
+			const link_type current,
 			std::function< void( node_type const & ) >&& callback )
 		{
-			if ( current )
+			if ( current != null )
 			{
-				this->inorder( current->left, std::move( callback ) );
+				this->inorder( this->node( current ).left, std::move( callback ) );
 
-				callback( current );
+				callback( &this->node( current ) );
 
-				this->inorder( current->right, std::move( callback ) );
+				this->inorder( this->node( current ).right, std::move( callback ) );
 			}
 		}
 
 		void
 		postorder(
-			node_type& current,
+			const link_type current,
 			std::function< void( node_type const & ) >&& callback )
 		{
-			if ( current )
+			if ( current != null )
 			{
-				this->preorder( current->left, std::move( callback ) );
-				this->preorder( current->right, std::move( callback ) );
+				this->postorder( this->node( current ).left, std::move( callback ) );
+				this->postorder( this->node( current ).right, std::move( callback ) );
 
-				callback( current );
+				callback( &this->node( current ) );
 			}
 		}
 
-		node_type root;
+		storage_type storage;
+
 		std::size_t nodes = 0;
 	};
-}
+
+	// A binary search tree whose nodes are packed into a vector and linked by 32-bit indices.
+	template <
+		typename Key,
+		typename Value,
+		typename Allocator = std::allocator< std::pair< const Key, Value > > >
+	using flat_binary_search_tree = binary_search_tree< Key, Value, Allocator, flat_tree_storage >;
+
+	template <
+		typename Key,
+		typename Value,
+		typename Allocator = std::allocator< std::pair< const Key, Value > >,
+		template < typename, typename, typename > class Storage = linked_tree_storage >
+	using avl_tree = binary_search_tree< Key, Value, Allocator, Storage, avl_policy >;
+
+	template <
+		typename Key,
+		typename Value,
+		typename Allocator = std::allocator< std::pair< const Key, Value > >,
+		template < typename, typename, typename > class Storage = linked_tree_storage >
+	using red_black_tree = binary_search_tree< Key, Value, Allocator, Storage, red_black_policy >;
+}
\ No newline at end of file
@@ -0,0 +1,469 @@
+/**
+ * Daniel Sebastian Iliescu, http://dansil.net
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ *
+ * Balancing policies for binary_search_tree.
+ *
+ * A policy inserts and erases a key in the subtree of a link, and returns the new root of the subtree.
+ * It works through the primitives of the tree: node access, creation and destruction, rotations, and
+ * update(), which recomputes the height and balance of a node from its children.
+ *
+ * unbalanced_policy keeps the shape given by the order of insertion, so sorted keys build a tree of
+ * height n. avl_policy keeps the heights of the children of every node within one of each other, for
+ * a height of at most 1.44 log2( n ). red_black_policy keeps a left-leaning red-black tree (Sedgewick,
+ * 2008), for a height of at most 2 log2( n ), with fewer rotations on erasure.
+ */
+
+#pragma once
+
+namespace dsa
+{
+	/**
+	 * Insertion and erasure by recursive descent, which rebalance every node of the path on the way back
+	 * through Policy::rebalance. A node with two children is erased by moving the greatest key of its left
+	 * subtree into it.
+	 */
+	template < typename Policy >
+	struct rebalancing_policy
+	{
+		template <
+			typename Tree,
+			typename Link,
+			typename Key,
+			typename Value >
+		static Link
+		insert(
+			Tree& tree,
+			const Link current,
+			const Key& key,
+			const Value& value )
+		{
+			if ( current == Tree::null )
+			{
+				return tree.create( key, value );
+			}
+			else if ( key > tree.node( current ).key )
+			{
+				// Assigned once the recursive call returns, since creating a node may move the nodes of a flat storage.
+				const auto right = insert( tree, tree.node( current ).right, key, value );
+				tree.node( current ).right = right;
+			}
+			else if ( key < tree.node( current ).key )
+			{
+				const auto left = insert( tree, tree.node( current ).left, key, value );
+				tree.node( current ).left = left;
+			}
+			else
+			{
+				return current;
+			}
+
+			return Policy::rebalance( tree, current );
+		}
+
+		template <
+			typename Tree,
+			typename Link,
+			typename Key >
+		static Link
+		erase(
+			Tree& tree,
+			const Link current,
+			const Key& key )
+		{
+			if ( current == Tree::null )
+			{
+				return current;
+			}
+
+			auto& node = tree.node( current );
+
+			if ( key == node.key )
+			{
+				if ( ( node.left == Tree::null ) || ( node.right == Tree::null ) )
+				{
+					const auto child = ( node.left != Tree::null ) ? node.left : node.right;
+
+					tree.destroy( current );
+
+					return child;
+				}
+
+				const auto& max_node = tree.node( tree.find_max( node.left ) );
+
+				node.key = max_node.key;
+				node.value = max_node.value;
+
+				node.left = erase( tree, node.left, node.key );
+			}
+			else if ( key > node.key )
+			{
+				node.right = erase( tree, node.right, key );
+			}
+			else if ( key < node.key )
+			{
+				node.left = erase( tree, node.left, key );
+			}
+
+			return Policy::rebalance( tree, current );
+		}
+	};
+
+	struct unbalanced_policy : rebalancing_policy< unbalanced_policy >
+	{
+		template <
+			typename Tree,
+			typename Link >
+		static Link
+		rebalance(
+			Tree& tree,
+			const Link current )
+		{
+			tree.update( current );
+
+			return current;
+		}
+	};
+
+	struct avl_policy : rebalancing_policy< avl_policy >
+	{
+		// Restores the AVL invariant at a node whose children are AVL trees with heights differing by at most two.
+		template <
+			typename Tree,
+			typename Link >
+		static Link
+		rebalance(
+			Tree& tree,
+			Link current )
+		{
+			tree.update( current );
+
+			const auto left = tree.node( current ).left;
+			const auto right = tree.node( current ).right;
+
+			if ( tree.height( left ) > tree.height( right ) + 1 )
+			{
+				if ( tree.height( tree.node( left ).left ) < tree.height( tree.node( left ).right ) )
+				{
+					tree.node( current ).left = tree.rotate_left( left );
+				}
+
+				current = tree.rotate_right( current );
+			}
+			else if ( tree.height( right ) > tree.height( left ) + 1 )
+			{
+				if ( tree.height( tree.node( right ).right ) < tree.height( tree.node( right ).left ) )
+				{
+					tree.node( current ).right = tree.rotate_right( right );
+				}
+
+				current = tree.rotate_left( current );
+			}
+
+			return current;
+		}
+	};
+
+	struct red_black_policy
+	{
+		template <
+			typename Tree,
+			typename Link,
+			typename Key,
+			typename Value >
+		static Link
+		insert(
+			Tree& tree,
+			const Link root,
+			const Key& key,
+			const Value& value )
+		{
+			const auto new_root = insert_node( tree, root, key, value );
+			tree.node( new_root ).red = false;
+
+			return new_root;
+		}
+
+		template <
+			typename Tree,
+			typename Link,
+			typename Key >
+		static Link
+		erase(
+			Tree& tree,
+			Link root,
+			const Key& key )
+		{
+			// The descent assumes that the key is present.
+			if ( !tree.contains( root, key ) )
+			{
+				return root;
+			}
+
+			if ( !is_red( tree, tree.node( root ).left ) && !is_red( tree, tree.node( root ).right ) )
+			{
+				tree.node( root ).red = true;
+			}
+
+			root = erase_node( tree, root, key );
+
+			if ( root != Tree::null )
+			{
+				tree.node( root ).red = false;
+			}
+
+			return root;
+		}
+
+	private:
+		template <
+			typename Tree,
+			typename Link >
+		static bool
+		is_red(
+			Tree& tree,
+			const Link link )
+		{
+			return ( link != Tree::null ) && tree.node( link ).red;
+		}
+
+		template <
+			typename Tree,
+			typename Link >
+		static Link
+		rotate_left(
+			Tree& tree,
+			const Link current )
+		{
+			const auto red = tree.node( current ).red;
+			const auto new_root = tree.rotate_left( current );
+
+			tree.node( new_root ).red = red;
+			tree.node( current ).red = true;
+
+			return new_root;
+		}
+
+		template <
+			typename Tree,
+			typename Link >
+		static Link
+		rotate_right(
+			Tree& tree,
+			const Link current )
+		{
+			const auto red = tree.node( current ).red;
+			const auto new_root = tree.rotate_right( current );
+
+			tree.node( new_root ).red = red;
+			tree.node( current ).red = true;
+
+			return new_root;
+		}
+
+		template <
+			typename Tree,
+			typename Link >
+		static void
+		flip_colors(
+			Tree& tree,
+			const Link current )
+		{
+			auto& node = tree.node( current );
+
+			node.red = !node.red;
+			tree.node( node.left ).red = !tree.node( node.left ).red;
+			tree.node( node.right ).red = !tree.node( node.right ).red;
+		}
+
+		// Restores the left-leaning invariants on the way back up.
+		template <
+			typename Tree,
+			typename Link >
+		static Link
+		fix_up(
+			Tree& tree,
+			Link current )
+		{
+			if ( is_red( tree, tree.node( current ).right ) && !is_red( tree, tree.node( current ).left ) )
+			{
+				current = rotate_left( tree, current );
+			}
+
+			if ( is_red( tree, tree.node( current ).left ) && is_red( tree, tree.node( tree.node( current ).left ).left ) )
+			{
+				current = rotate_right( tree, current );
+			}
+
+			if ( is_red( tree, tree.node( current ).left ) && is_red( tree, tree.node( current ).right ) )
+			{
+				flip_colors( tree, current );
+			}
+
+			tree.update( current );
+
+			return current;
+		}
+
+		template <
+			typename Tree,
+			typename Link,
+			typename Key,
+			typename Value >
+		static Link
+		insert_node(
+			Tree& tree,
+			const Link current,
+			const Key& key,
+			const Value& value )
+		{
+			if ( current == Tree::null )
+			{
+				return tree.create( key, value );
+			}
+			else if ( key > tree.node( current ).key )
+			{
+				const auto right = insert_node( tree, tree.node( current ).right, key, value );
+				tree.node( current ).right = right;
+			}
+			else if ( key < tree.node( current ).key )
+			{
+				const auto left = insert_node( tree, tree.node( current ).left, key, value );
+				tree.node( current ).left = left;
+			}
+			else
+			{
+				return current;
+			}
+
+			return fix_up( tree, current );
+		}
+
+		// Makes the left child or one of its children red, so that a node can be removed from the left subtree.
+		template <
+			typename Tree,
+			typename Link >
+		static Link
+		move_red_left(
+			Tree& tree,
+			Link current )
+		{
+			flip_colors( tree, current );
+
+			const auto right = tree.node( current ).right;
+
+			if ( is_red( tree, tree.node( right ).left ) )
+			{
+				tree.node( current ).right = rotate_right( tree, right );
+				current = rotate_left( tree, current );
+
+				flip_colors( tree, current );
+			}
+
+			return current;
+		}
+
+		template <
+			typename Tree,
+			typename Link >
+		static Link
+		move_red_right(
+			Tree& tree,
+			Link current )
+		{
+			flip_colors( tree, current );
+
+			if ( is_red( tree, tree.node( tree.node( current ).left ).left ) )
+			{
+				current = rotate_right( tree, current );
+
+				flip_colors( tree, current );
+			}
+
+			return current;
+		}
+
+		template <
+			typename Tree,
+			typename Link >
+		static Link
+		erase_min(
+			Tree& tree,
+			Link current )
+		{
+			if ( tree.node( current ).left == Tree::null )
+			{
+				tree.destroy( current );
+
+				return Tree::null;
+			}
+
+			if ( !is_red( tree, tree.node( current ).left ) && !is_red( tree, tree.node( tree.node( current ).left ).left ) )
+			{
+				current = move_red_left( tree, current );
+			}
+
+			tree.node( current ).left = erase_min( tree, tree.node( current ).left );
+
+			return fix_up( tree, current );
+		}
+
+		template <
+			typename Tree,
+			typename Link,
+			typename Key >
+		static Link
+		erase_node(
+			Tree& tree,
+			Link current,
+			const Key& key )
+		{
+			if ( key < tree.node( current ).key )
+			{
+				if ( !is_red( tree, tree.node( current ).left ) && !is_red( tree, tree.node( tree.node( current ).left ).left ) )
+				{
+					current = move_red_left( tree, current );
+				}
+
+				tree.node( current ).left = erase_node( tree, tree.node( current ).left, key );
+			}
+			else
+			{
+				if ( is_red( tree, tree.node( current ).left ) )
+				{
+					current = rotate_right( tree, current );
+				}
+
+				if ( ( key == tree.node( current ).key ) && ( tree.node( current ).right == Tree::null ) )
+				{
+					tree.destroy( current );
+
+					return Tree::null;
+				}
+
+				const auto right = tree.node( current ).right;
+
+				if ( !is_red( tree, right ) && !is_red( tree, tree.node( right ).left ) )
+				{
+					current = move_red_right( tree, current );
+				}
+
+				if ( key == tree.node( current ).key )
+				{
+					// Replaced by its successor, which is then removed from the right subtree.
+					const auto& min_node = tree.node( tree.find_min( tree.node( current ).right ) );
+
+					tree.node( current ).key = min_node.key;
+					tree.node( current ).value = min_node.value;
+					tree.node( current ).right = erase_min( tree, tree.node( current ).right );
+				}
+				else
+				{
+					tree.node( current ).right = erase_node( tree, tree.node( current ).right, key );
+				}
+			}
+
+			return fix_up( tree, current );
+		}
+	};
+}
\ No newline at end of file
@@ -4,22 +4,35 @@
 
 #pragma once
 
-#include <memory>
+#include <cstdint>
+#include <type_traits>
 
 namespace dsa
 {
+	// Children are linked by pointer, or by index into the node array when Index is given (see flat_tree_storage).
 	template <
 		typename Key,
-		typename Value >
+		typename Value,
+		typename Index = void >
 	struct binary_search_tree_node
 	{
-		binary_search_tree_node() = default;
+		using link_type = std::conditional_t< std::is_void< Index >::value, binary_search_tree_node*, Index >;
+
+		binary_search_tree_node() :
+			height( 1 ),
+			balanced( true ),
+			red( true )
+		{
+		}
 
 		binary_search_tree_node(
 			Key input_key,
 			Value input_value ) :
 			key( input_key ),
-			value( input_value )
+			value( input_value ),
+			height( 1 ),
+			balanced( true ),
+			red( true )
 		{
 		}
 
@@ -46,7 +59,18 @@ namespace dsa
 		Key key = Key();
 		Value value = Value();
 
-		std::unique_ptr< binary_search_tree_node > left;
-		std::unique_ptr< binary_search_tree_node > right;
+		// Owned by the storage of the tree, which allocates and destroys the nodes through its allocator.
+		link_type left = link_type();
+		link_type right = link_type();
+
+		/**
+		 * Maintained by the tree along every path it modifies: the height of the subtree (in nodes), whether
+		 * the heights of the children differ by at most one throughout the subtree, and the color of the node
+		 * under red_black_policy. They share a single 32-bit word, so a flat node of 32-bit keys and values
+		 * takes 20 bytes.
+		 */
+		std::uint32_t height : 30;
+		bool balanced : 1;
+		bool red : 1;
 	};
 }
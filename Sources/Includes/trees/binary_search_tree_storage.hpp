@@ -0,0 +1,373 @@
+/**
+ * Daniel Sebastian Iliescu, http://dansil.net
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ *
+ * Storage policies for the nodes of binary_search_tree.
+ *
+ * A storage owns the nodes of a tree along with its root, and hands out links to them: the tree
+ * only ever reaches a node through node( link ), and compares links against null.
+ *
+ * linked_tree_storage allocates every node on its own through the allocator and links the nodes by
+ * pointer. flat_tree_storage keeps the nodes in a single vector and links them by 32-bit index, so
+ * that the links of a node take half the space, the nodes of a tree lie next to each other
+ * (in insertion order), and copying the tree or writing it out copies a single array. Erased nodes are
+ * chained into a free list, through their left link, for reuse by the next insertion. Creating a node
+ * may reallocate the vector, so node references do not survive a create().
+ */
+
+#pragma once
+
+#include "binary_search_tree_node.hpp"
+#include "memory/allocator_propagation.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace dsa
+{
+	template <
+		typename Key,
+		typename Value,
+		typename Allocator >
+	class linked_tree_storage
+	{
+	public:
+		using node_type = binary_search_tree_node< Key, Value >;
+		using link_type = typename node_type::link_type;
+		using allocator_type = typename std::allocator_traits< Allocator >::template rebind_alloc< node_type >;
+
+		static constexpr link_type null = nullptr;
+
+		linked_tree_storage() = default;
+
+		explicit linked_tree_storage( const allocator_type& input_allocator ) noexcept :
+			allocator( input_allocator )
+		{
+		}
+
+		~linked_tree_storage() noexcept
+		{
+			this->clear();
+		}
+
+		linked_tree_storage( const linked_tree_storage& other ) :
+			allocator( std::allocator_traits< allocator_type >::select_on_container_copy_construction( other.allocator ) ),
+			root_link( this->clone( other, other.root_link ) )
+		{
+		}
+
+		linked_tree_storage( linked_tree_storage&& other ) noexcept :
+			allocator( std::move( other.allocator ) ),
+			root_link( std::exchange( other.root_link, null ) )
+		{
+		}
+
+		linked_tree_storage&
+		operator=( const linked_tree_storage& rhs )
+		{
+			if ( this != &rhs )
+			{
+				this->clear();
+
+				propagate_on_copy_assignment( this->allocator, rhs.allocator );
+
+				this->root_link = this->clone( rhs, rhs.root_link );
+			}
+
+			return *this;
+		}
+
+		// Takes over the nodes of the source, or copies them if its allocator neither propagates nor compares equal.
+		linked_tree_storage&
+		operator=( linked_tree_storage&& rhs ) noexcept( allocator_moves_storage_v< allocator_type > )
+		{
+			if constexpr ( !allocator_moves_storage_v< allocator_type > )
+			{
+				if ( this->allocator != rhs.allocator )
+				{
+					*this = static_cast< const linked_tree_storage& >( rhs );
+					rhs.clear();
+
+					return *this;
+				}
+			}
+
+			propagate_on_move_assignment( this->allocator, rhs.allocator );
+			std::swap( this->root_link, rhs.root_link );
+
+			return *this;
+		}
+
+		allocator_type
+		get_allocator() const
+		{
+			return this->allocator;
+		}
+
+		link_type&
+		root() noexcept
+		{
+			return this->root_link;
+		}
+
+		link_type
+		root() const noexcept
+		{
+			return this->root_link;
+		}
+
+		node_type&
+		node( const link_type link ) const noexcept
+		{
+			return *link;
+		}
+
+		link_type
+		create(
+			const Key& key,
+			const Value& value )
+		{
+			return this->construct( key, value );
+		}
+
+		void
+		destroy( const link_type link ) noexcept
+		{
+			std::allocator_traits< allocator_type >::destroy( this->allocator, link );
+			std::allocator_traits< allocator_type >::deallocate( this->allocator, link, 1 );
+		}
+
+		// Destroys every node reachable from the root.
+		void
+		clear() noexcept
+		{
+			this->destroy_subtree( this->root_link );
+			this->root_link = null;
+		}
+
+	private:
+		template < typename... Args >
+		link_type
+		construct( Args&&... args )
+		{
+			auto node = std::allocator_traits< allocator_type >::allocate( this->allocator, 1 );
+
+			try
+			{
+				std::allocator_traits< allocator_type >::construct( this->allocator, node, std::forward< Args >( args )... );
+			}
+			catch ( ... )
+			{
+				std::allocator_traits< allocator_type >::deallocate( this->allocator, node, 1 );
+				throw;
+			}
+
+			return node;
+		}
+
+		void
+		destroy_subtree( const link_type current ) noexcept
+		{
+			if ( current )
+			{
+				this->destroy_subtree( current->left );
+				this->destroy_subtree( current->right );
+
+				this->destroy( current );
+			}
+		}
+
+		// Copies the subtree of the other storage, releasing the copied nodes if a copy throws.
+		link_type
+		clone(
+			const linked_tree_storage& other,
+			const link_type current )
+		{
+			if ( !current )
+			{
+				return null;
+			}
+
+			// Copies the metadata of the node along with its key and value.
+			const auto node = this->construct( *current );
+
+			node->left = null;
+			node->right = null;
+
+			try
+			{
+				node->left = this->clone( other, current->left );
+				node->right = this->clone( other, current->right );
+			}
+			catch ( ... )
+			{
+				this->destroy_subtree( node );
+				throw;
+			}
+
+			return node;
+		}
+
+		allocator_type allocator;
+
+		link_type root_link = null;
+	};
+
+	template <
+		typename Key,
+		typename Value,
+		typename Allocator >
+	class flat_tree_storage
+	{
+	public:
+		using node_type = binary_search_tree_node< Key, Value, std::uint32_t >;
+		using link_type = typename node_type::link_type;
+		using allocator_type = typename std::allocator_traits< Allocator >::template rebind_alloc< node_type >;
+
+		static constexpr link_type null = std::numeric_limits< link_type >::max();
+
+		flat_tree_storage() = default;
+
+		explicit flat_tree_storage( const allocator_type& input_allocator ) noexcept :
+			nodes( input_allocator )
+		{
+		}
+
+		~flat_tree_storage() noexcept = default;
+
+		// The links are indices, so copies of the vector and of the links make a valid copy of the tree.
+		flat_tree_storage( const flat_tree_storage& ) = default;
+
+		flat_tree_storage( flat_tree_storage&& other ) noexcept :
+			nodes( std::move( other.nodes ) ),
+			free_list( std::exchange( other.free_list, null ) ),
+			root_link( std::exchange( other.root_link, null ) )
+		{
+			other.nodes.clear();
+		}
+
+		flat_tree_storage& operator=( const flat_tree_storage& ) = default;
+
+		// Moving the vector preserves the indices of the nodes, whether it takes over their storage or moves them one by one.
+		flat_tree_storage&
+		operator=( flat_tree_storage&& rhs ) noexcept( allocator_moves_storage_v< allocator_type > )
+		{
+			this->nodes = std::move( rhs.nodes );
+			this->free_list = std::exchange( rhs.free_list, null );
+			this->root_link = std::exchange( rhs.root_link, null );
+
+			rhs.nodes.clear();
+
+			return *this;
+		}
+
+		allocator_type
+		get_allocator() const
+		{
+			return this->nodes.get_allocator();
+		}
+
+		link_type&
+		root() noexcept
+		{
+			return this->root_link;
+		}
+
+		link_type
+		root() const noexcept
+		{
+			return this->root_link;
+		}
+
+		node_type&
+		node( const link_type link ) noexcept
+		{
+			return this->nodes[ link ];
+		}
+
+		const node_type&
+		node( const link_type link ) const noexcept
+		{
+			return this->nodes[ link ];
+		}
+
+		link_type
+		create(
+			const Key& key,
+			const Value& value )
+		{
+			link_type link = null;
+
+			if ( this->free_list != null )
+			{
+				link = this->free_list;
+				this->free_list = this->nodes[ link ].left;
+
+				this->nodes[ link ] = node_type( key, value );
+			}
+			else
+			{
+				if ( this->nodes.size() >= null )
+				{
+					throw std::length_error( "flat_tree_storage holds at most 2^32 - 1 nodes." );
+				}
+
+				link = static_cast< link_type >( this->nodes.size() );
+				this->nodes.emplace_back( key, value );
+			}
+
+			this->nodes[ link ].left = null;
+			this->nodes[ link ].right = null;
+
+			return link;
+		}
+
+		// Releases the key and value of the node, and chains it into the free list.
+		void
+		destroy( const link_type link ) noexcept
+		{
+			auto& node = this->nodes[ link ];
+
+			node.key = Key();
+			node.value = Value();
+			node.left = this->free_list;
+			node.right = null;
+
+			this->free_list = link;
+		}
+
+		void
+		clear() noexcept
+		{
+			this->nodes.clear();
+			this->free_list = null;
+			this->root_link = null;
+		}
+
+		// Reserves room for the given number of nodes, so that creating them does not reallocate.
+		void
+		reserve( const std::size_t count )
+		{
+			this->nodes.reserve( count );
+		}
+
+		// Slots of the node array, including the free ones.
+		std::size_t
+		capacity() const noexcept
+		{
+			return this->nodes.size();
+		}
+
+	private:
+		std::vector< node_type, allocator_type > nodes;
+
+		// First free slot, whose left link chains the next one.
+		link_type free_list = null;
+		link_type root_link = null;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,208 @@
+/**
+ * Daniel Sebastian Iliescu, http://dansil.net
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ *
+ * Search for the position of a key among the sorted keys of a B-tree node.
+ *
+ * The position returned is the number of keys less than the given key. Three implementations
+ * are provided:
+ *  - generic: binary search, for any key type,
+ *  - branchless: a count of the lesser keys over the whole node, for arithmetic types, which
+ *    compilers turn into vector code and which has no mispredicted branch,
+ *  - vectorized: SSE2 (or AVX2, when compiled with it enabled) comparisons of a whole vector
+ *    of keys at a time, stopping at the first vector holding a key which is not less, for
+ *    32-bit and 64-bit integers and floating-point keys.
+ *
+ * A node spans a few cache lines, so reading all of its keys costs about as much as reading
+ * the ones a binary search would visit, and a linear search avoids its unpredictable branches.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#if defined( __AVX2__ )
+#include <immintrin.h>
+#elif defined( __SSE2__ )
+#include <emmintrin.h>
+#endif
+
+namespace dsa
+{
+	struct btree_key_search
+	{
+		struct generic_implementation
+		{
+			template < typename Key >
+			static std::size_t
+			lower_bound(
+				const Key* keys,
+				const std::size_t count,
+				const Key& key )
+			{
+				return static_cast< std::size_t >( std::lower_bound( keys, keys + count, key ) - keys );
+			}
+		};
+
+		struct branchless_implementation
+		{
+			template < typename Key >
+			static std::size_t
+			lower_bound(
+				const Key* keys,
+				const std::size_t count,
+				const Key key ) noexcept
+			{
+				std::size_t position = 0;
+
+				for ( std::size_t index = 0; index < count; ++index )
+				{
+					position += static_cast< std::size_t >( keys[ index ] < key );
+				}
+
+				return position;
+			}
+		};
+
+#if defined( __SSE2__ )
+		struct vectorized_implementation
+		{
+			template < typename Key >
+			static constexpr bool supported =
+				std::is_same< Key, std::int32_t >::value ||
+				std::is_same< Key, std::uint32_t >::value ||
+				std::is_same< Key, float >::value ||
+				std::is_same< Key, double >::value
+#if defined( __AVX2__ )
+				|| std::is_same< Key, std::int64_t >::value
+				|| std::is_same< Key, std::uint64_t >::value
+#endif
+				;
+
+			template < typename Key >
+			static std::size_t
+			lower_bound(
+				const Key* keys,
+				const std::size_t count,
+				const Key key ) noexcept
+			{
+				constexpr std::size_t LANES = VECTOR_BYTES / sizeof( Key );
+				constexpr unsigned ALL_LANES = ( 1U << LANES ) - 1;
+
+				std::size_t position = 0;
+
+				// The keys are sorted, so the lesser keys of a vector are the first ones.
+				for ( ; position + LANES <= count; position += LANES )
+				{
+					const auto mask = less_mask( keys + position, key );
+
+					if ( mask != ALL_LANES )
+					{
+						return position + std::bitset< LANES >( mask ).count();
+					}
+				}
+
+				while ( ( position < count ) && ( keys[ position ] < key ) )
+				{
+					++position;
+				}
+
+				return position;
+			}
+
+		private:
+#if defined( __AVX2__ )
+			static constexpr std::size_t VECTOR_BYTES = 32;
+#else
+			static constexpr std::size_t VECTOR_BYTES = 16;
+#endif
+
+			// One bit per lane, set if the key of the lane is less than the given key.
+			template < typename Key >
+			static unsigned
+			less_mask(
+				const Key* keys,
+				const Key key ) noexcept
+			{
+#if defined( __AVX2__ )
+				if constexpr ( std::is_same< Key, float >::value )
+				{
+					return static_cast< unsigned >( _mm256_movemask_ps( _mm256_cmp_ps( _mm256_loadu_ps( keys ), _mm256_set1_ps( key ), _CMP_LT_OQ ) ) );
+				}
+				else if constexpr ( std::is_same< Key, double >::value )
+				{
+					return static_cast< unsigned >( _mm256_movemask_pd( _mm256_cmp_pd( _mm256_loadu_pd( keys ), _mm256_set1_pd( key ), _CMP_LT_OQ ) ) );
+				}
+				else if constexpr ( sizeof( Key ) == sizeof( std::int32_t ) )
+				{
+					// Flipping the sign bits makes the signed comparison order unsigned keys.
+					const auto sign = _mm256_set1_epi32( std::is_signed< Key >::value ? 0 : std::numeric_limits< std::int32_t >::min() );
+					const auto items = _mm256_xor_si256( _mm256_loadu_si256( reinterpret_cast< const __m256i* >( keys ) ), sign );
+					const auto pivots = _mm256_xor_si256( _mm256_set1_epi32( static_cast< std::int32_t >( key ) ), sign );
+
+					return static_cast< unsigned >( _mm256_movemask_ps( _mm256_castsi256_ps( _mm256_cmpgt_epi32( pivots, items ) ) ) );
+				}
+				else
+				{
+					const auto sign = _mm256_set1_epi64x( std::is_signed< Key >::value ? 0 : std::numeric_limits< std::int64_t >::min() );
+					const auto items = _mm256_xor_si256( _mm256_loadu_si256( reinterpret_cast< const __m256i* >( keys ) ), sign );
+					const auto pivots = _mm256_xor_si256( _mm256_set1_epi64x( static_cast< long long >( key ) ), sign );
+
+					return static_cast< unsigned >( _mm256_movemask_pd( _mm256_castsi256_pd( _mm256_cmpgt_epi64( pivots, items ) ) ) );
+				}
+#else
+				if constexpr ( std::is_same< Key, float >::value )
+				{
+					return static_cast< unsigned >( _mm_movemask_ps( _mm_cmplt_ps( _mm_loadu_ps( keys ), _mm_set1_ps( key ) ) ) );
+				}
+				else if constexpr ( std::is_same< Key, double >::value )
+				{
+					return static_cast< unsigned >( _mm_movemask_pd( _mm_cmplt_pd( _mm_loadu_pd( keys ), _mm_set1_pd( key ) ) ) );
+				}
+				else
+				{
+					// Flipping the sign bits makes the signed comparison order unsigned keys.
+					const auto sign = _mm_set1_epi32( std::is_signed< Key >::value ? 0 : std::numeric_limits< std::int32_t >::min() );
+					const auto items = _mm_xor_si128( _mm_loadu_si128( reinterpret_cast< const __m128i* >( keys ) ), sign );
+					const auto pivots = _mm_xor_si128( _mm_set1_epi32( static_cast< std::int32_t >( key ) ), sign );
+
+					return static_cast< unsigned >( _mm_movemask_ps( _mm_castsi128_ps( _mm_cmpgt_epi32( pivots, items ) ) ) );
+				}
+#endif
+			}
+		};
+#endif
+
+		/**
+		 * Picks the fastest implementation available for the key type.
+		 */
+		template < typename Key >
+		static std::size_t
+		lower_bound(
+			const Key* keys,
+			const std::size_t count,
+			const Key& key )
+		{
+#if defined( __SSE2__ )
+			if constexpr ( vectorized_implementation::supported< Key > )
+			{
+				return vectorized_implementation::lower_bound( keys, count, key );
+			}
+			else
+#endif
+			if constexpr ( std::is_arithmetic< Key >::value )
+			{
+				return branchless_implementation::lower_bound( keys, count, key );
+			}
+			else
+			{
+				return generic_implementation::lower_bound( keys, count, key );
+			}
+		}
+	};
+}
\ No newline at end of file
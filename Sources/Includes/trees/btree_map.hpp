@@ -0,0 +1,920 @@
+/**
+ * Daniel Sebastian Iliescu, http://dansil.net
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ *
+ * An ordered map over a B+-tree, whose nodes span NodeBytes bytes (four cache lines by default).
+ *
+ * The key-value pairs are kept in the leaves, and the internal nodes only hold the keys which
+ * separate their children. A node holds as many keys as fit in NodeBytes along with its padding
+ * (but at least three, which may exceed it), in an array of their own (apart from the values or
+ * the children), which is searched as a whole with vector comparisons for arithmetic keys
+ * (see btree_key_search.hpp). With 256-byte nodes and 32-bit
+ * keys, an internal node has 21 children, so a lookup among millions of keys reads about five
+ * nodes, rather than the twenty-odd nodes of a balanced binary tree, each on its own cache line.
+ *
+ * Every leaf links to the next one, so inorder() and scan() walk the leaves without going back
+ * up the tree. Full nodes are split on the way down during insertion, and nodes left with too
+ * few keys by an erasure borrow a key from a sibling or are merged with it on the way back up.
+ * A key greater than every key of a full node on the rightmost path splits it unevenly, leaving
+ * the left node almost full, so that keys inserted in increasing order fill the nodes rather
+ * than halving them; only the nodes of the rightmost path may then hold less than the minimum.
+ *
+ * Keys and values must be default constructible, since the nodes hold arrays of them.
+ */
+
+#pragma once
+
+#include "btree_key_search.hpp"
+#include "memory/allocator_propagation.hpp"
+#include "memory/cache_line.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace dsa
+{
+	template <
+		typename Key,
+		typename Value,
+		std::size_t NodeBytes = 4 * cache_line_size,
+		typename Allocator = std::allocator< std::pair< const Key, Value > > >
+	class btree_map
+	{
+		static_assert( std::is_default_constructible< Key >::value && std::is_default_constructible< Value >::value, "The nodes hold arrays of keys and values." );
+		static_assert( ( NodeBytes > 0 ) && ( NodeBytes % cache_line_size == 0 ), "A node must span whole cache lines." );
+
+		static constexpr std::size_t MINIMUM_CAPACITY = 3;
+
+		static constexpr std::size_t
+		align_up(
+			const std::size_t bytes,
+			const std::size_t alignment ) noexcept
+		{
+			return ( bytes + alignment - 1 ) / alignment * alignment;
+		}
+
+		/**
+		 * Bytes spanned by the members of a node holding the given number of keys: its count, its keys, as
+		 * many entries (values or children) and the link following them (the next leaf, or the last child),
+		 * including the padding between them.
+		 */
+		static constexpr std::size_t
+		node_bytes(
+			const std::size_t capacity,
+			const std::size_t entry_size,
+			const std::size_t entry_alignment ) noexcept
+		{
+			const auto keys_end = align_up( sizeof( std::uint32_t ), alignof( Key ) ) + capacity * sizeof( Key );
+			const auto entries_end = align_up( keys_end, entry_alignment ) + capacity * entry_size;
+
+			return align_up( entries_end, alignof( void* ) ) + sizeof( void* );
+		}
+
+		// Largest number of keys whose node fits in NodeBytes, but no fewer than the minimum.
+		static constexpr std::size_t
+		fitting_capacity(
+			const std::size_t entry_size,
+			const std::size_t entry_alignment ) noexcept
+		{
+			auto capacity = std::max( MINIMUM_CAPACITY, NodeBytes / ( sizeof( Key ) + entry_size ) );
+
+			while ( ( capacity > MINIMUM_CAPACITY ) && ( node_bytes( capacity, entry_size, entry_alignment ) > NodeBytes ) )
+			{
+				--capacity;
+			}
+
+			return capacity;
+		}
+
+	public:
+		static constexpr std::size_t LEAF_CAPACITY = fitting_capacity( sizeof( Value ), alignof( Value ) );
+		static constexpr std::size_t INTERNAL_CAPACITY = fitting_capacity( sizeof( void* ), alignof( void* ) );
+
+	private:
+		// Fewest keys held by a node outside of the root and the rightmost path.
+		static constexpr std::size_t LEAF_MINIMUM = LEAF_CAPACITY / 2;
+		static constexpr std::size_t INTERNAL_MINIMUM = ( INTERNAL_CAPACITY - 1 ) / 2;
+
+		// Leaves and internal nodes are told apart by their depth, since every leaf is at the same depth.
+		struct btree_node
+		{
+		};
+
+		struct alignas( cache_line_size ) leaf_node : btree_node
+		{
+			std::uint32_t count = 0;
+
+			Key keys[ LEAF_CAPACITY ];
+			Value values[ LEAF_CAPACITY ];
+
+			leaf_node* next = nullptr;
+		};
+
+		struct alignas( cache_line_size ) internal_node : btree_node
+		{
+			// Number of keys, one less than the number of children.
+			std::uint32_t count = 0;
+
+			// Every key of children[ i ] is less than keys[ i ], which is not greater than any key of children[ i + 1 ].
+			Key keys[ INTERNAL_CAPACITY ];
+			btree_node* children[ INTERNAL_CAPACITY + 1 ];
+		};
+
+		// Only nodes of the minimum capacity may exceed the node size, for keys or values too large for it.
+		static_assert(
+			( ( sizeof( leaf_node ) <= NodeBytes ) || ( LEAF_CAPACITY == MINIMUM_CAPACITY ) ) &&
+			( ( sizeof( internal_node ) <= NodeBytes ) || ( INTERNAL_CAPACITY == MINIMUM_CAPACITY ) ),
+			"A node must fit in the node size." );
+
+		using internal_allocator_type = typename std::allocator_traits< Allocator >::template rebind_alloc< internal_node >;
+
+	public:
+		using key_type = Key;
+		using mapped_type = Value;
+		using size_type = std::size_t;
+		using allocator_type = typename std::allocator_traits< Allocator >::template rebind_alloc< leaf_node >;
+
+		btree_map() = default;
+
+		explicit btree_map( const allocator_type& input_allocator ) noexcept :
+			allocator( input_allocator ),
+			internal_allocator( input_allocator )
+		{
+		}
+
+		~btree_map() noexcept
+		{
+			this->clear();
+		}
+
+		btree_map( const btree_map& other ) :
+			allocator( std::allocator_traits< allocator_type >::select_on_container_copy_construction( other.allocator ) ),
+			internal_allocator( std::allocator_traits< internal_allocator_type >::select_on_container_copy_construction( other.internal_allocator ) )
+		{
+			this->copy_nodes( other );
+		}
+
+		// The nodes now belong to the allocators moved out of the source.
+		btree_map( btree_map&& other ) noexcept :
+			allocator( std::move( other.allocator ) ),
+			internal_allocator( std::move( other.internal_allocator ) )
+		{
+			this->swap_nodes( other );
+		}
+
+		btree_map&
+		operator=( const btree_map& rhs )
+		{
+			if ( this != &rhs )
+			{
+				this->clear();
+
+				propagate_on_copy_assignment( this->allocator, rhs.allocator );
+				propagate_on_copy_assignment( this->internal_allocator, rhs.internal_allocator );
+
+				this->copy_nodes( rhs );
+			}
+
+			return *this;
+		}
+
+		// Takes over the nodes of the source, or copies them if its allocator neither propagates nor compares equal.
+		btree_map&
+		operator=( btree_map&& rhs ) noexcept( allocator_moves_storage_v< allocator_type > )
+		{
+			if constexpr ( !allocator_moves_storage_v< allocator_type > )
+			{
+				if ( this->allocator != rhs.allocator )
+				{
+					*this = static_cast< const btree_map& >( rhs );
+					rhs.clear();
+
+					return *this;
+				}
+			}
+
+			propagate_on_move_assignment( this->allocator, rhs.allocator );
+			propagate_on_move_assignment( this->internal_allocator, rhs.internal_allocator );
+
+			this->swap_nodes( rhs );
+
+			return *this;
+		}
+
+		// The allocators of both maps must compare equal, unless they propagate on swap.
+		friend void
+		swap( btree_map& first, btree_map& second ) noexcept
+		{
+			propagate_on_swap( first.allocator, second.allocator );
+			propagate_on_swap( first.internal_allocator, second.internal_allocator );
+
+			first.swap_nodes( second );
+		}
+
+		allocator_type
+		get_allocator() const
+		{
+			return this->allocator;
+		}
+
+		// Inserts the key with the value, unless the key is present. Returns whether it was inserted.
+		bool
+		insert(
+			const Key& key,
+			const Value& value )
+		{
+			if ( !this->root )
+			{
+				this->root = this->create_leaf();
+				this->levels = 1;
+			}
+
+			if ( this->full( this->root, 0 ) )
+			{
+				this->grow( key );
+			}
+
+			auto node = this->root;
+			auto rightmost = true;
+
+			for ( std::size_t depth = 1; depth < this->levels; ++depth )
+			{
+				const auto parent = static_cast< internal_node* >( node );
+				auto index = child_index( parent, key );
+
+				if ( this->full( parent->children[ index ], depth ) )
+				{
+					this->split_child( parent, index, depth, rightmost && ( index == parent->count ), key );
+
+					index = child_index( parent, key );
+				}
+
+				rightmost = rightmost && ( index == parent->count );
+				node = parent->children[ index ];
+			}
+
+			const auto leaf = static_cast< leaf_node* >( node );
+			const auto position = btree_key_search::lower_bound( leaf->keys, leaf->count, key );
+
+			if ( ( position < leaf->count ) && !( key < leaf->keys[ position ] ) )
+			{
+				return false;
+			}
+
+			std::move_backward( leaf->keys + position, leaf->keys + leaf->count, leaf->keys + leaf->count + 1 );
+			std::move_backward( leaf->values + position, leaf->values + leaf->count, leaf->values + leaf->count + 1 );
+
+			leaf->keys[ position ] = key;
+			leaf->values[ position ] = value;
+
+			++( leaf->count );
+			++( this->items );
+
+			return true;
+		}
+
+		// Removes the key; returns whether it was present.
+		bool
+		erase( const Key& key )
+		{
+			if ( !this->root || !this->erase( this->root, 0, key ) )
+			{
+				return false;
+			}
+
+			--( this->items );
+
+			// The root is replaced by its only child once its last key is merged away.
+			if ( this->levels > 1 )
+			{
+				const auto node = static_cast< internal_node* >( this->root );
+
+				if ( node->count == 0 )
+				{
+					this->root = node->children[ 0 ];
+					--( this->levels );
+
+					this->destroy_internal( node );
+				}
+			}
+			else if ( static_cast< leaf_node* >( this->root )->count == 0 )
+			{
+				this->destroy_leaf( static_cast< leaf_node* >( this->root ) );
+
+				this->root = nullptr;
+				this->levels = 0;
+			}
+
+			return true;
+		}
+
+		Value*
+		find( const Key& key )
+		{
+			if ( !this->root )
+			{
+				return nullptr;
+			}
+
+			const auto leaf = this->find_leaf( key );
+			const auto position = btree_key_search::lower_bound( leaf->keys, leaf->count, key );
+
+			return ( ( position < leaf->count ) && !( key < leaf->keys[ position ] ) ) ? &leaf->values[ position ] : nullptr;
+		}
+
+		const Value*
+		find( const Key& key ) const
+		{
+			return const_cast< btree_map* >( this )->find( key );
+		}
+
+		bool
+		contains( const Key& key ) const
+		{
+			return ( this->find( key ) != nullptr );
+		}
+
+		void
+		clear() noexcept
+		{
+			this->destroy_subtree( this->root, 0 );
+
+			this->root = nullptr;
+			this->levels = 0;
+			this->items = 0;
+		}
+
+		bool
+		empty() const noexcept
+		{
+			return ( this->items == 0 );
+		}
+
+		size_type
+		size() const noexcept
+		{
+			return this->items;
+		}
+
+		// Number of levels below the root, as for binary_search_tree.
+		size_type
+		height() const noexcept
+		{
+			return ( this->levels == 0 ) ? 0 : this->levels - 1;
+		}
+
+		void
+		inorder( std::function< void( const Key&, Value& ) >&& callback )
+		{
+			if ( !this->root )
+			{
+				return;
+			}
+
+			auto node = this->root;
+
+			for ( std::size_t depth = 1; depth < this->levels; ++depth )
+			{
+				node = static_cast< internal_node* >( node )->children[ 0 ];
+			}
+
+			for ( auto leaf = static_cast< leaf_node* >( node ); leaf; leaf = leaf->next )
+			{
+				for ( std::size_t position = 0; position < leaf->count; ++position )
+				{
+					callback( leaf->keys[ position ], leaf->values[ position ] );
+				}
+			}
+		}
+
+		// Calls the callback on every key in [first, last) in order, following the links between the leaves.
+		void
+		scan(
+			const Key& first,
+			const Key& last,
+			std::function< void( const Key&, Value& ) >&& callback )
+		{
+			if ( !this->root )
+			{
+				return;
+			}
+
+			auto leaf = this->find_leaf( first );
+			auto position = btree_key_search::lower_bound( leaf->keys, leaf->count, first );
+
+			for ( ; leaf; leaf = leaf->next, position = 0 )
+			{
+				for ( ; position < leaf->count; ++position )
+				{
+					if ( !( leaf->keys[ position ] < last ) )
+					{
+						return;
+					}
+
+					callback( leaf->keys[ position ], leaf->values[ position ] );
+				}
+			}
+		}
+
+	private:
+		// Index of the child whose subtree would hold the key.
+		static std::size_t
+		child_index(
+			const internal_node* const node,
+			const Key& key )
+		{
+			const auto position = btree_key_search::lower_bound( node->keys, node->count, key );
+
+			return ( ( position < node->count ) && !( key < node->keys[ position ] ) ) ? position + 1 : position;
+		}
+
+		bool
+		is_leaf( const std::size_t depth ) const noexcept
+		{
+			return ( depth + 1 == this->levels );
+		}
+
+		std::size_t
+		count(
+			const btree_node* const node,
+			const std::size_t depth ) const noexcept
+		{
+			return this->is_leaf( depth ) ? static_cast< const leaf_node* >( node )->count : static_cast< const internal_node* >( node )->count;
+		}
+
+		bool
+		full(
+			const btree_node* const node,
+			const std::size_t depth ) const noexcept
+		{
+			return ( this->count( node, depth ) == ( this->is_leaf( depth ) ? LEAF_CAPACITY : INTERNAL_CAPACITY ) );
+		}
+
+		leaf_node*
+		find_leaf( const Key& key ) const
+		{
+			auto node = this->root;
+
+			for ( std::size_t depth = 1; depth < this->levels; ++depth )
+			{
+				node = static_cast< internal_node* >( node )->children[ child_index( static_cast< internal_node* >( node ), key ) ];
+			}
+
+			return static_cast< leaf_node* >( node );
+		}
+
+		// Splits the full root under a new root, which adds a level to the tree.
+		void
+		grow( const Key& key )
+		{
+			const auto new_root = this->create_internal();
+
+			new_root->children[ 0 ] = this->root;
+
+			this->root = new_root;
+			++( this->levels );
+
+			try
+			{
+				this->split_child( new_root, 0, 1, true, key );
+			}
+			catch ( ... )
+			{
+				this->root = new_root->children[ 0 ];
+				--( this->levels );
+
+				this->destroy_internal( new_root );
+				throw;
+			}
+		}
+
+		/**
+		 * Moves the upper keys of the full child at the given index into a new node, which is inserted after
+		 * it in the parent (which is not full). The child keeps half of its keys, or all but one if the key
+		 * being inserted follows all of them on the rightmost path.
+		 */
+		void
+		split_child(
+			internal_node* const parent,
+			const std::size_t index,
+			const std::size_t depth,
+			const bool rightmost,
+			const Key& key )
+		{
+			Key separator;
+			btree_node* right_node = nullptr;
+
+			if ( this->is_leaf( depth ) )
+			{
+				const auto left = static_cast< leaf_node* >( parent->children[ index ] );
+				const auto right = this->create_leaf();
+
+				const auto left_count = ( rightmost && ( left->keys[ LEAF_CAPACITY - 1 ] < key ) ) ? LEAF_CAPACITY - 1 : LEAF_CAPACITY / 2;
+
+				std::move( left->keys + left_count, left->keys + LEAF_CAPACITY, right->keys );
+				std::move( left->values + left_count, left->values + LEAF_CAPACITY, right->values );
+
+				right->count = static_cast< std::uint32_t >( LEAF_CAPACITY - left_count );
+				left->count = static_cast< std::uint32_t >( left_count );
+
+				right->next = left->next;
+				left->next = right;
+
+				separator = right->keys[ 0 ];
+				right_node = right;
+			}
+			else
+			{
+				const auto left = static_cast< internal_node* >( parent->children[ index ] );
+				const auto right = this->create_internal();
+
+				const auto left_count = ( rightmost && ( left->keys[ INTERNAL_CAPACITY - 1 ] < key ) ) ? INTERNAL_CAPACITY - 2 : INTERNAL_CAPACITY / 2;
+
+				// The middle key moves up into the parent.
+				std::move( left->keys + left_count + 1, left->keys + INTERNAL_CAPACITY, right->keys );
+				std::copy( left->children + left_count + 1, left->children + INTERNAL_CAPACITY + 1, right->children );
+
+				right->count = static_cast< std::uint32_t >( INTERNAL_CAPACITY - left_count - 1 );
+				left->count = static_cast< std::uint32_t >( left_count );
+
+				separator = std::move( left->keys[ left_count ] );
+				right_node = right;
+			}
+
+			std::move_backward( parent->keys + index, parent->keys + parent->count, parent->keys + parent->count + 1 );
+			std::copy_backward( parent->children + index + 1, parent->children + parent->count + 1, parent->children + parent->count + 2 );
+
+			parent->keys[ index ] = std::move( separator );
+			parent->children[ index + 1 ] = right_node;
+
+			++( parent->count );
+		}
+
+		bool
+		erase(
+			btree_node* const node,
+			const std::size_t depth,
+			const Key& key )
+		{
+			if ( this->is_leaf( depth ) )
+			{
+				const auto leaf = static_cast< leaf_node* >( node );
+				const auto position = btree_key_search::lower_bound( leaf->keys, leaf->count, key );
+
+				if ( ( position == leaf->count ) || ( key < leaf->keys[ position ] ) )
+				{
+					return false;
+				}
+
+				std::move( leaf->keys + position + 1, leaf->keys + leaf->count, leaf->keys + position );
+				std::move( leaf->values + position + 1, leaf->values + leaf->count, leaf->values + position );
+
+				--( leaf->count );
+
+				return true;
+			}
+
+			const auto parent = static_cast< internal_node* >( node );
+			const auto index = child_index( parent, key );
+
+			if ( !this->erase( parent->children[ index ], depth + 1, key ) )
+			{
+				return false;
+			}
+
+			const auto minimum = this->is_leaf( depth + 1 ) ? LEAF_MINIMUM : INTERNAL_MINIMUM;
+
+			if ( this->count( parent->children[ index ], depth + 1 ) < minimum )
+			{
+				this->rebalance( parent, index, depth + 1 );
+			}
+
+			return true;
+		}
+
+		// Refills the child at the given index with a key of a sibling, or merges it with one.
+		void
+		rebalance(
+			internal_node* const parent,
+			const std::size_t index,
+			const std::size_t depth )
+		{
+			const auto minimum = this->is_leaf( depth ) ? LEAF_MINIMUM : INTERNAL_MINIMUM;
+
+			if ( ( index > 0 ) && ( this->count( parent->children[ index - 1 ], depth ) > minimum ) )
+			{
+				this->borrow_from_left( parent, index, depth );
+			}
+			else if ( ( index < parent->count ) && ( this->count( parent->children[ index + 1 ], depth ) > minimum ) )
+			{
+				this->borrow_from_right( parent, index, depth );
+			}
+			else if ( index > 0 )
+			{
+				this->merge( parent, index - 1, depth );
+			}
+			else if ( index < parent->count )
+			{
+				this->merge( parent, index, depth );
+			}
+		}
+
+		void
+		borrow_from_left(
+			internal_node* const parent,
+			const std::size_t index,
+			const std::size_t depth )
+		{
+			if ( this->is_leaf( depth ) )
+			{
+				const auto left = static_cast< leaf_node* >( parent->children[ index - 1 ] );
+				const auto node = static_cast< leaf_node* >( parent->children[ index ] );
+
+				std::move_backward( node->keys, node->keys + node->count, node->keys + node->count + 1 );
+				std::move_backward( node->values, node->values + node->count, node->values + node->count + 1 );
+
+				--( left->count );
+				++( node->count );
+
+				node->keys[ 0 ] = std::move( left->keys[ left->count ] );
+				node->values[ 0 ] = std::move( left->values[ left->count ] );
+
+				parent->keys[ index - 1 ] = node->keys[ 0 ];
+			}
+			else
+			{
+				const auto left = static_cast< internal_node* >( parent->children[ index - 1 ] );
+				const auto node = static_cast< internal_node* >( parent->children[ index ] );
+
+				std::move_backward( node->keys, node->keys + node->count, node->keys + node->count + 1 );
+				std::copy_backward( node->children, node->children + node->count + 1, node->children + node->count + 2 );
+
+				// The separator comes down in front of the node, and the last key of the left sibling replaces it.
+				node->keys[ 0 ] = std::move( parent->keys[ index - 1 ] );
+				node->children[ 0 ] = left->children[ left->count ];
+
+				--( left->count );
+				++( node->count );
+
+				parent->keys[ index - 1 ] = std::move( left->keys[ left->count ] );
+			}
+		}
+
+		void
+		borrow_from_right(
+			internal_node* const parent,
+			const std::size_t index,
+			const std::size_t depth )
+		{
+			if ( this->is_leaf( depth ) )
+			{
+				const auto node = static_cast< leaf_node* >( parent->children[ index ] );
+				const auto right = static_cast< leaf_node* >( parent->children[ index + 1 ] );
+
+				node->keys[ node->count ] = std::move( right->keys[ 0 ] );
+				node->values[ node->count ] = std::move( right->values[ 0 ] );
+
+				std::move( right->keys + 1, right->keys + right->count, right->keys );
+				std::move( right->values + 1, right->values + right->count, right->values );
+
+				++( node->count );
+				--( right->count );
+
+				parent->keys[ index ] = right->keys[ 0 ];
+			}
+			else
+			{
+				const auto node = static_cast< internal_node* >( parent->children[ index ] );
+				const auto right = static_cast< internal_node* >( parent->children[ index + 1 ] );
+
+				// The separator comes down behind the node, and the first key of the right sibling replaces it.
+				node->keys[ node->count ] = std::move( parent->keys[ index ] );
+				node->children[ node->count + 1 ] = right->children[ 0 ];
+
+				parent->keys[ index ] = std::move( right->keys[ 0 ] );
+
+				std::move( right->keys + 1, right->keys + right->count, right->keys );
+				std::copy( right->children + 1, right->children + right->count + 1, right->children );
+
+				++( node->count );
+				--( right->count );
+			}
+		}
+
+		// Moves the child following the given index into the child at the index, and removes their separator.
+		void
+		merge(
+			internal_node* const parent,
+			const std::size_t index,
+			const std::size_t depth )
+		{
+			if ( this->is_leaf( depth ) )
+			{
+				const auto left = static_cast< leaf_node* >( parent->children[ index ] );
+				const auto right = static_cast< leaf_node* >( parent->children[ index + 1 ] );
+
+				std::move( right->keys, right->keys + right->count, left->keys + left->count );
+				std::move( right->values, right->values + right->count, left->values + left->count );
+
+				left->count += right->count;
+				left->next = right->next;
+
+				this->destroy_leaf( right );
+			}
+			else
+			{
+				const auto left = static_cast< internal_node* >( parent->children[ index ] );
+				const auto right = static_cast< internal_node* >( parent->children[ index + 1 ] );
+
+				left->keys[ left->count ] = std::move( parent->keys[ index ] );
+
+				std::move( right->keys, right->keys + right->count, left->keys + left->count + 1 );
+				std::copy( right->children, right->children + right->count + 1, left->children + left->count + 1 );
+
+				left->count += right->count + 1;
+
+				this->destroy_internal( right );
+			}
+
+			std::move( parent->keys + index + 1, parent->keys + parent->count, parent->keys + index );
+			std::copy( parent->children + index + 2, parent->children + parent->count + 1, parent->children + index + 1 );
+
+			--( parent->count );
+		}
+
+		// Copies the nodes of the other map into this empty one, releasing the copied nodes if a copy throws.
+		void
+		copy_nodes( const btree_map& other )
+		{
+			if ( !other.root )
+			{
+				return;
+			}
+
+			this->levels = other.levels;
+
+			try
+			{
+				leaf_node* previous = nullptr;
+
+				this->copy_subtree( other.root, 0, this->root, previous );
+			}
+			catch ( ... )
+			{
+				this->clear();
+				throw;
+			}
+
+			this->items = other.items;
+		}
+
+		// Every copied node is attached to its parent before being filled, so that a failed copy can be released from the root.
+		void
+		copy_subtree(
+			const btree_node* const source,
+			const std::size_t depth,
+			btree_node*& target,
+			leaf_node*& previous )
+		{
+			if ( this->is_leaf( depth ) )
+			{
+				const auto source_leaf = static_cast< const leaf_node* >( source );
+				const auto leaf = this->create_leaf();
+
+				target = leaf;
+
+				if ( previous )
+				{
+					previous->next = leaf;
+				}
+
+				previous = leaf;
+
+				std::copy( source_leaf->keys, source_leaf->keys + source_leaf->count, leaf->keys );
+				std::copy( source_leaf->values, source_leaf->values + source_leaf->count, leaf->values );
+
+				leaf->count = source_leaf->count;
+			}
+			else
+			{
+				const auto source_node = static_cast< const internal_node* >( source );
+				const auto node = this->create_internal();
+
+				target = node;
+
+				std::copy( source_node->keys, source_node->keys + source_node->count, node->keys );
+
+				// The children not copied yet are null, which releasing the node skips.
+				node->count = source_node->count;
+
+				for ( std::size_t child = 0; child <= source_node->count; ++child )
+				{
+					this->copy_subtree( source_node->children[ child ], depth + 1, node->children[ child ], previous );
+				}
+			}
+		}
+
+		void
+		swap_nodes( btree_map& other ) noexcept
+		{
+			std::swap( this->root, other.root );
+			std::swap( this->levels, other.levels );
+			std::swap( this->items, other.items );
+		}
+
+		void
+		destroy_subtree(
+			btree_node* const node,
+			const std::size_t depth ) noexcept
+		{
+			if ( !node )
+			{
+				return;
+			}
+
+			if ( this->is_leaf( depth ) )
+			{
+				this->destroy_leaf( static_cast< leaf_node* >( node ) );
+			}
+			else
+			{
+				const auto internal = static_cast< internal_node* >( node );
+
+				for ( std::size_t child = 0; child <= internal->count; ++child )
+				{
+					this->destroy_subtree( internal->children[ child ], depth + 1 );
+				}
+
+				this->destroy_internal( internal );
+			}
+		}
+
+		leaf_node*
+		create_leaf()
+		{
+			return create_node( this->allocator );
+		}
+
+		internal_node*
+		create_internal()
+		{
+			return create_node( this->internal_allocator );
+		}
+
+		void
+		destroy_leaf( leaf_node* const node ) noexcept
+		{
+			destroy_node( this->allocator, node );
+		}
+
+		void
+		destroy_internal( internal_node* const node ) noexcept
+		{
+			destroy_node( this->internal_allocator, node );
+		}
+
+		// Nodes are value-initialized, so that the children of a new internal node are null.
+		template < typename NodeAllocator >
+		static auto
+		create_node( NodeAllocator& node_allocator )
+		{
+			auto node = std::allocator_traits< NodeAllocator >::allocate( node_allocator, 1 );
+
+			try
+			{
+				std::allocator_traits< NodeAllocator >::construct( node_allocator, node );
+			}
+			catch ( ... )
+			{
+				std::allocator_traits< NodeAllocator >::deallocate( node_allocator, node, 1 );
+				throw;
+			}
+
+			return node;
+		}
+
+		template < typename NodeAllocator >
+		static void
+		destroy_node(
+			NodeAllocator& node_allocator,
+			typename std::allocator_traits< NodeAllocator >::pointer node ) noexcept
+		{
+			std::allocator_traits< NodeAllocator >::destroy( node_allocator, node );
+			std::allocator_traits< NodeAllocator >::deallocate( node_allocator, node, 1 );
+		}
+
+		allocator_type allocator;
+		internal_allocator_type internal_allocator;
+
+		btree_node* root = nullptr;
+
+		// Number of levels of nodes, zero when the map is empty.
+		std::size_t levels = 0;
+		std::size_t items = 0;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,643 @@
+/**
+ * Daniel Sebastian Iliescu, http://dansil.net
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ *
+ * A persistent (immutable) ordered map, stored as a path-copying red-black tree.
+ *
+ * The modifiers leave the map unchanged and return a new version, which only copies the nodes on
+ * the path from the root to the modified key (and the few nodes rebalancing touches) and shares
+ * every other subtree with the original: inserting or erasing copies O(log n) nodes, and copying a
+ * version is O(1). Nodes are reference counted, so a node is released with the last version using
+ * it, and versions can be read by any number of threads while another derives new ones from them
+ * (publishing a version to another thread still requires the usual synchronization, such as a mutex).
+ *
+ * Insertion follows Okasaki, rebalancing red-red violations on the way up; erasure follows Kahrs,
+ * rebalancing whenever a black subtree loses one black node and fusing the two subtrees of the
+ * erased node. Either operation keeps the height of the tree within 2 log2(n + 1).
+ *
+ * Nodes are allocated through the given allocator with std::allocate_shared, so each node keeps a
+ * copy of the allocator which released it, and the allocator must be thread-safe if versions are
+ * shared between threads. Copies of a version share its allocator, since they allocate nothing.
+ */
+
+#pragma once
+
+#include "persistent_map_node.hpp"
+#include "memory/allocator_propagation.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace dsa
+{
+	template <
+		typename Key,
+		typename Value,
+		typename Compare = std::less< Key >,
+		typename Allocator = std::allocator< std::pair< const Key, Value > > >
+	class persistent_map
+	{
+	public:
+		using node_type = std::shared_ptr< const persistent_map_node< Key, Value > >;
+		using key_type = Key;
+		using mapped_type = Value;
+		using size_type = std::size_t;
+		using allocator_type = Allocator;
+
+		persistent_map() = default;
+
+		explicit persistent_map( const Allocator& input_allocator ) :
+			allocator( input_allocator )
+		{
+		}
+
+		explicit persistent_map(
+			Compare input_compare,
+			const Allocator& input_allocator = Allocator() ) :
+			compare( std::move( input_compare ) ),
+			allocator( input_allocator )
+		{
+		}
+
+		~persistent_map() noexcept = default;
+
+		// Copies share every node and operate in constant time.
+		persistent_map( const persistent_map& ) = default;
+		// The source keeps its comparison object, so it is left as a usable empty map.
+		persistent_map( persistent_map&& other ) noexcept( std::is_nothrow_copy_constructible< Compare >::value ) :
+			root( std::move( other.root ) ),
+			nodes( std::exchange( other.nodes, 0 ) ),
+			compare( other.compare ),
+			allocator( other.allocator )
+		{
+		}
+
+		persistent_map&
+		operator=( const persistent_map& rhs ) noexcept( std::is_nothrow_copy_assignable< Compare >::value )
+		{
+			if ( this != &rhs )
+			{
+				propagate_on_copy_assignment( this->allocator, rhs.allocator );
+
+				this->root = rhs.root;
+				this->nodes = rhs.nodes;
+				this->compare = rhs.compare;
+			}
+
+			return *this;
+		}
+
+		// The nodes keep the allocator which created them, so they can be taken over whatever the allocators.
+		persistent_map&
+		operator=( persistent_map&& rhs ) noexcept( std::is_nothrow_copy_assignable< Compare >::value )
+		{
+			if ( this != &rhs )
+			{
+				propagate_on_move_assignment( this->allocator, rhs.allocator );
+
+				this->root = std::move( rhs.root );
+				this->nodes = std::exchange( rhs.nodes, 0 );
+				this->compare = rhs.compare;
+			}
+
+			return *this;
+		}
+
+		allocator_type
+		get_allocator() const noexcept
+		{
+			return this->allocator;
+		}
+
+		// Whether both maps hold the same keys with the same values.
+		bool
+		operator==( const persistent_map& rhs ) const
+		{
+			if ( this->nodes != rhs.nodes )
+			{
+				return false;
+			}
+
+			if ( this->root == rhs.root )
+			{
+				return true;
+			}
+
+			// Both in order traversals advance in lockstep, on explicit stacks.
+			std::vector< const persistent_map_node< Key, Value >* > left_path;
+			std::vector< const persistent_map_node< Key, Value >* > right_path;
+
+			auto left = this->root.get();
+			auto right = rhs.root.get();
+
+			while ( true )
+			{
+				for ( ; left; left = left->left.get() )
+				{
+					left_path.push_back( left );
+				}
+
+				for ( ; right; right = right->left.get() )
+				{
+					right_path.push_back( right );
+				}
+
+				// Both maps having the same size, both traversals end together.
+				if ( left_path.empty() )
+				{
+					break;
+				}
+
+				left = left_path.back();
+				right = right_path.back();
+
+				left_path.pop_back();
+				right_path.pop_back();
+
+				if ( !( left->key == right->key ) || !( left->value == right->value ) )
+				{
+					return false;
+				}
+
+				left = left->right.get();
+				right = right->right.get();
+
+				// Shared subtrees hold the same elements; skip them when the remaining paths are shared as well.
+				if ( ( left == right ) && ( left_path == right_path ) )
+				{
+					break;
+				}
+			}
+
+			return true;
+		}
+
+		bool
+		operator!=( const persistent_map& rhs ) const
+		{
+			return !( *this == rhs );
+		}
+
+		/**
+		 * Lookup
+		 */
+
+		bool
+		contains( const Key& key ) const
+		{
+			return ( this->find( key ) != nullptr );
+		}
+
+		// Value of the key, or null if it is not in the map.
+		const Value*
+		find( const Key& key ) const
+		{
+			auto current = this->root.get();
+
+			while ( current )
+			{
+				if ( this->compare( key, current->key ) )
+				{
+					current = current->left.get();
+				}
+				else if ( this->compare( current->key, key ) )
+				{
+					current = current->right.get();
+				}
+				else
+				{
+					return &current->value;
+				}
+			}
+
+			return nullptr;
+		}
+
+		/**
+		 * Modifiers, which return the new version
+		 */
+
+		// Adds the key with the given value, unless it is already in the map.
+		persistent_map
+		insert(
+			const Key& key,
+			const Value& value ) const
+		{
+			return this->insert( key, value, false );
+		}
+
+		// Adds the key with the given value, or replaces its value if it is already in the map.
+		persistent_map
+		insert_or_assign(
+			const Key& key,
+			const Value& value ) const
+		{
+			return this->insert( key, value, true );
+		}
+
+		persistent_map
+		erase( const Key& key ) const
+		{
+			if ( !this->contains( key ) )
+			{
+				return *this;
+			}
+
+			auto map = *this;
+
+			map.root = this->blacken( map.erase( map.root, key ) );
+			--( map.nodes );
+
+			return map;
+		}
+
+		/**
+		 * Capacity
+		 */
+
+		std::size_t
+		height() const
+		{
+			const auto height = this->height( this->root );
+
+			return ( height == 0 ) ? height : height - 1;
+		}
+
+		bool
+		empty() const noexcept
+		{
+			return ( this->nodes == 0 );
+		}
+
+		size_type
+		size() const noexcept
+		{
+			return this->nodes;
+		}
+
+		/**
+		 * Traversal
+		 */
+
+		void
+		preorder( std::function< void( node_type const & ) >&& callback ) const
+		{
+			this->preorder( this->root, callback );
+		}
+
+		void
+		inorder( std::function< void( node_type const & ) >&& callback ) const
+		{
+			this->inorder( this->root, callback );
+		}
+
+		void
+		postorder( std::function< void( node_type const & ) >&& callback ) const
+		{
+			this->postorder( this->root, callback );
+		}
+
+	private:
+		node_type
+		make_node(
+			const node_color color,
+			node_type left,
+			const Key& key,
+			const Value& value,
+			node_type right ) const
+		{
+			return std::allocate_shared< persistent_map_node< Key, Value > >(
+				this->allocator,
+				color,
+				std::move( left ),
+				key,
+				value,
+				std::move( right ) );
+		}
+
+		// Copy of the entry of a node with the given color and subtrees.
+		node_type
+		red(
+			node_type left,
+			const node_type& entry,
+			node_type right ) const
+		{
+			return this->make_node( node_color::red, std::move( left ), entry->key, entry->value, std::move( right ) );
+		}
+
+		node_type
+		black(
+			node_type left,
+			const node_type& entry,
+			node_type right ) const
+		{
+			return this->make_node( node_color::black, std::move( left ), entry->key, entry->value, std::move( right ) );
+		}
+
+		static bool
+		is_red( const node_type& node ) noexcept
+		{
+			return node && ( node->color == node_color::red );
+		}
+
+		// Whether the node exists and is black (the empty leaves are black too, but hold nothing to recolor).
+		static bool
+		is_black( const node_type& node ) noexcept
+		{
+			return node && ( node->color == node_color::black );
+		}
+
+		node_type
+		blacken( const node_type& node ) const
+		{
+			return is_red( node ) ? this->black( node->left, node, node->right ) : node;
+		}
+
+		// Recolors a black node red, which removes one black node from its paths.
+		node_type
+		redden( const node_type& node ) const
+		{
+			return this->red( node->left, node, node->right );
+		}
+
+		// Black node with the given subtrees, turned into a red node with two black children if either has a red-red violation.
+		node_type
+		balance(
+			const node_type& left,
+			const node_type& entry,
+			const node_type& right ) const
+		{
+			if ( is_red( left ) && is_red( right ) )
+			{
+				return this->red( this->blacken( left ), entry, this->blacken( right ) );
+			}
+
+			if ( is_red( left ) && is_red( left->left ) )
+			{
+				return this->red( this->blacken( left->left ), left, this->black( left->right, entry, right ) );
+			}
+
+			if ( is_red( left ) && is_red( left->right ) )
+			{
+				return this->red( this->black( left->left, left, left->right->left ), left->right, this->black( left->right->right, entry, right ) );
+			}
+
+			if ( is_red( right ) && is_red( right->right ) )
+			{
+				return this->red( this->black( left, entry, right->left ), right, this->blacken( right->right ) );
+			}
+
+			if ( is_red( right ) && is_red( right->left ) )
+			{
+				return this->red( this->black( left, entry, right->left->left ), right->left, this->black( right->left->right, right, right->right ) );
+			}
+
+			return this->black( left, entry, right );
+		}
+
+		// Rebalances a node whose left subtree lost a black node.
+		node_type
+		balance_left(
+			const node_type& left,
+			const node_type& entry,
+			const node_type& right ) const
+		{
+			if ( is_red( left ) )
+			{
+				return this->red( this->blacken( left ), entry, right );
+			}
+
+			if ( is_black( right ) )
+			{
+				return this->balance( left, entry, this->redden( right ) );
+			}
+
+			// The right subtree is red, with a black left child.
+			return this->red(
+				this->black( left, entry, right->left->left ),
+				right->left,
+				this->balance( right->left->right, right, this->redden( right->right ) ) );
+		}
+
+		// Rebalances a node whose right subtree lost a black node.
+		node_type
+		balance_right(
+			const node_type& left,
+			const node_type& entry,
+			const node_type& right ) const
+		{
+			if ( is_red( right ) )
+			{
+				return this->red( left, entry, this->blacken( right ) );
+			}
+
+			if ( is_black( left ) )
+			{
+				return this->balance( this->redden( left ), entry, right );
+			}
+
+			// The left subtree is red, with a black right child.
+			return this->red(
+				this->balance( this->redden( left->left ), left, left->right->left ),
+				left->right,
+				this->black( left->right->right, entry, right ) );
+		}
+
+		// Joins the subtrees of an erased node, every key of the left one being less than those of the right one.
+		node_type
+		fuse(
+			const node_type& left,
+			const node_type& right ) const
+		{
+			if ( !left )
+			{
+				return right;
+			}
+
+			if ( !right )
+			{
+				return left;
+			}
+
+			if ( is_red( left ) && is_red( right ) )
+			{
+				const auto middle = this->fuse( left->right, right->left );
+
+				if ( is_red( middle ) )
+				{
+					return this->red( this->red( left->left, left, middle->left ), middle, this->red( middle->right, right, right->right ) );
+				}
+
+				return this->red( left->left, left, this->red( middle, right, right->right ) );
+			}
+
+			if ( is_black( left ) && is_black( right ) )
+			{
+				const auto middle = this->fuse( left->right, right->left );
+
+				if ( is_red( middle ) )
+				{
+					return this->red( this->black( left->left, left, middle->left ), middle, this->black( middle->right, right, right->right ) );
+				}
+
+				return this->balance_left( left->left, left, this->black( middle, right, right->right ) );
+			}
+
+			if ( is_red( right ) )
+			{
+				return this->red( this->fuse( left, right->left ), right, right->right );
+			}
+
+			return this->red( left->left, left, this->fuse( left->right, right ) );
+		}
+
+		persistent_map
+		insert(
+			const Key& key,
+			const Value& value,
+			const bool assign ) const
+		{
+			auto map = *this;
+			auto inserted = false;
+
+			map.root = this->blacken( map.insert( map.root, key, value, assign, inserted ) );
+
+			if ( inserted )
+			{
+				++( map.nodes );
+			}
+
+			return map;
+		}
+
+		node_type
+		insert(
+			const node_type& current,
+			const Key& key,
+			const Value& value,
+			const bool assign,
+			bool& inserted ) const
+		{
+			if ( !current )
+			{
+				inserted = true;
+
+				return this->make_node( node_color::red, nullptr, key, value, nullptr );
+			}
+
+			if ( this->compare( key, current->key ) )
+			{
+				auto left = this->insert( current->left, key, value, assign, inserted );
+
+				return is_black( current ) ? this->balance( left, current, current->right ) : this->red( left, current, current->right );
+			}
+
+			if ( this->compare( current->key, key ) )
+			{
+				auto right = this->insert( current->right, key, value, assign, inserted );
+
+				return is_black( current ) ? this->balance( current->left, current, right ) : this->red( current->left, current, right );
+			}
+
+			if ( !assign )
+			{
+				return current;
+			}
+
+			return this->make_node( current->color, current->left, current->key, value, current->right );
+		}
+
+		// Erases a key of the subtree; the black height of a black subtree decreases by one.
+		node_type
+		erase(
+			const node_type& current,
+			const Key& key ) const
+		{
+			if ( !current )
+			{
+				return nullptr;
+			}
+
+			if ( this->compare( key, current->key ) )
+			{
+				auto left = this->erase( current->left, key );
+
+				return is_black( current->left ) ? this->balance_left( left, current, current->right ) : this->red( left, current, current->right );
+			}
+
+			if ( this->compare( current->key, key ) )
+			{
+				auto right = this->erase( current->right, key );
+
+				return is_black( current->right ) ? this->balance_right( current->left, current, right ) : this->red( current->left, current, right );
+			}
+
+			return this->fuse( current->left, current->right );
+		}
+
+		std::size_t
+		height( const node_type& current ) const
+		{
+			if ( current )
+			{
+				return 1 + std::max( this->height( current->left ), this->height( current->right ) );
+			}
+
+			return 0;
+		}
+
+		void
+		preorder(
+			const node_type& current,
+			const std::function< void( node_type const & ) >& callback ) const
+		{
+			if ( current )
+			{
+				callback( current );
+
+				this->preorder( current->left, callback );
+				this->preorder( current->right, callback );
+			}
+		}
+
+		void
+		inorder(
+			const node_type& current,
+			const std::function< void( node_type const & ) >& callback ) const
+		{
+			if ( current )
+			{
+				this->inorder( current->left, callback );
+
+				callback( current );
+
+				this->inorder( current->right, callback );
+			}
+		}
+
+		void
+		postorder(
+			const node_type& current,
+			const std::function< void( node_type const & ) >& callback ) const
+		{
+			if ( current )
+			{
+				this->postorder( current->left, callback );
+				this->postorder( current->right, callback );
+
+				callback( current );
+			}
+		}
+
+		node_type root;
+		size_type nodes = 0;
+
+		Compare compare;
+		Allocator allocator;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,57 @@
+/**
+ * Daniel Sebastian Iliescu, http://dansil.net
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include <memory>
+#include <utility>
+
+namespace dsa
+{
+	enum class node_color : bool
+	{
+		red,
+		black
+	};
+
+	// Immutable node, shared between the versions of a persistent_map.
+	template <
+		typename Key,
+		typename Value >
+	struct persistent_map_node
+	{
+		using node_type = std::shared_ptr< const persistent_map_node >;
+
+		persistent_map_node(
+			const node_color input_color,
+			node_type input_left,
+			Key input_key,
+			Value input_value,
+			node_type input_right ) :
+			color( input_color ),
+			key( std::move( input_key ) ),
+			value( std::move( input_value ) ),
+			left( std::move( input_left ) ),
+			right( std::move( input_right ) )
+		{
+		}
+
+		~persistent_map_node() = default;
+
+		persistent_map_node( const persistent_map_node& ) = default;
+		persistent_map_node( persistent_map_node&& ) noexcept = default;
+
+		persistent_map_node& operator=( const persistent_map_node& ) = default;
+		persistent_map_node& operator=( persistent_map_node&& ) noexcept = default;
+
+		node_color color;
+
+		Key key;
+		Value value;
+
+		node_type left;
+		node_type right;
+	};
+}
\ No newline at end of file
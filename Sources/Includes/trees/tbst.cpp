@@ -22,12 +22,15 @@ namespace dsa
     static bool isTokenChar(char ch);
 
     /**
-     * ThreadedBinarySearchTree()
+     * ThreadedBinarySearchTree(std::pmr::memory_resource* resource)
      *
-     * Default constructor
+     * Constructor
+     * @param resource Memory resource from which the nodes are allocated
      */
-    ThreadedBinarySearchTree::ThreadedBinarySearchTree()
-        : rootNode(nullptr),
+    ThreadedBinarySearchTree::ThreadedBinarySearchTree(
+        std::pmr::memory_resource* resource)
+        : nodeAllocator(resource),
+          rootNode(nullptr),
           treeSize(0),
           treeHeight(0)
     {
@@ -41,7 +44,8 @@ namespace dsa
      */
     ThreadedBinarySearchTree::ThreadedBinarySearchTree(
         const ThreadedBinarySearchTree& source)
-        : rootNode(nullptr),
+        : nodeAllocator(std::pmr::get_default_resource()),
+          rootNode(nullptr),
           treeSize(0),
           treeHeight(0)
     {
@@ -352,14 +356,14 @@ namespace dsa
 
         if (success)
         {
-            Node* newNode = new Node(token);
+            Node* newNode = createNode(Node(token));
 
             // If insertHelper returns false, it means that we found
             // a duplicate whose frequency was incremented.
             // The operation is still a success
             if (!insertHelper(newNode))
             {
-                delete newNode;
+                destroyNode(newNode);
             }
         }
 
@@ -379,7 +383,7 @@ namespace dsa
      */
     bool ThreadedBinarySearchTree::insert(const Node& node)
     {
-        Node* newNode = new Node(node);
+        Node* newNode = createNode(node);
         bool success = newNode->data.isValid();
 
         if (success)
@@ -389,7 +393,7 @@ namespace dsa
             // The operation is still a success
             if (!insertHelper(newNode))
             {
-                delete newNode;
+                destroyNode(newNode);
             }
         }
 
@@ -628,7 +632,7 @@ namespace dsa
                     current->rightNode->parentNode = nullptr;
                 }
 
-                delete current;
+                destroyNode(current);
 
                 // Reset the nodes depths and parents
                 init(nullptr);
@@ -1344,8 +1348,50 @@ namespace dsa
                 destroy(node->rightNode);
             }
 
-            delete node;
+            destroyNode(node);
+        }
+    }
+
+    /**
+     * createNode(const Node& source)
+     *
+     * Helper method allocating a copy of a node from the memory resource
+     *
+     * @param source Node to copy
+     * @pre None
+     * @post Returns the new node
+     * @return new node
+     */
+    Node* ThreadedBinarySearchTree::createNode(const Node& source)
+    {
+        Node* node = nodeAllocator.allocate(1);
+
+        try
+        {
+            nodeAllocator.construct(node, source);
+        }
+        catch (...)
+        {
+            nodeAllocator.deallocate(node, 1);
+            throw;
         }
+
+        return node;
+    }
+
+    /**
+     * destroyNode(Node* node)
+     *
+     * Helper method destroying a single node and returning its memory
+     *
+     * @param node Node to destroy
+     * @pre Node was created by createNode
+     * @post The node is deleted
+     */
+    void ThreadedBinarySearchTree::destroyNode(Node* node)
+    {
+        node->~Node();
+        nodeAllocator.deallocate(node, 1);
     }
 
     /**
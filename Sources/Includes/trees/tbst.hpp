@@ -6,6 +6,8 @@
 
 #include "node.hpp"
 
+#include <memory_resource>
+
 namespace dsa
 {
     // Tree traversal types
@@ -30,7 +32,9 @@ namespace dsa
     class ThreadedBinarySearchTree
     {
     public:
-        ThreadedBinarySearchTree();
+        explicit ThreadedBinarySearchTree(
+            std::pmr::memory_resource* resource =
+                std::pmr::get_default_resource());
         ThreadedBinarySearchTree(const ThreadedBinarySearchTree& source);
         ~ThreadedBinarySearchTree();
 
@@ -87,7 +91,9 @@ namespace dsa
         void init(Node* node);
         bool insertHelper(Node* newNode);
         void compress(int nonThreadCount, int threadCount) const;
-        static void destroy(Node* node);
+        Node* createNode(const Node& source);
+        void destroyNode(Node* node);
+        void destroy(Node* node);
         static void traverseHelper(
             int traverseType,
             Node* node,
@@ -97,6 +103,7 @@ namespace dsa
             std::ostream& output, Node** nodesList, int first, int last);
 
         // Tree data
+        std::pmr::polymorphic_allocator<Node> nodeAllocator; // node memory
         Node* rootNode;         // root node
         int treeSize;           // total number of nodes
         int treeHeight;         // tree height (i.e. number of layers)
@@ -11,7 +11,13 @@
 
 #include <catch.hpp>
 
+#include <algorithm>
 #include <array>
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace
 {
@@ -20,6 +26,77 @@ namespace
 	using key_type = std::int32_t;
 	using value_type = std::int32_t;
 	constexpr std::size_t ITERATIONS = 10000;
+
+	// Number of black nodes on every path below a red-black node, or -1 if the paths differ or the colors are misplaced.
+	template < typename Node >
+	int
+	black_height( const Node node )
+	{
+		if ( !node )
+		{
+			return 1;
+		}
+
+		const auto left = black_height( node->left );
+		const auto right = black_height( node->right );
+
+		// Red nodes lean left, and never follow each other.
+		const auto misplaced =
+			( node->right && node->right->red ) ||
+			( node->red && node->left && node->left->red );
+
+		return ( ( left < 0 ) || ( left != right ) || misplaced ) ? -1 : left + !node->red;
+	}
+
+	// Inserts and erases random keys, checking the contents of the tree against a sorted vector.
+	template < typename Tree >
+	void
+	random_insert_erase( Tree& bst )
+	{
+		std::vector< key_type > keys;
+		generator< key_type >().fill_buffer_n( std::back_inserter( keys ), ITERATIONS );
+
+		std::vector< key_type > expected;
+		for ( std::size_t index = 0; index < keys.size(); ++index )
+		{
+			const auto key = keys[ index ] % static_cast< key_type >( ITERATIONS / 4 );
+			const auto position = std::lower_bound( expected.begin(), expected.end(), key );
+			const auto present = ( position != expected.end() ) && ( *position == key );
+
+			if ( index % 3 == 2 )
+			{
+				bst.erase( key );
+
+				if ( present )
+				{
+					expected.erase( position );
+				}
+			}
+			else
+			{
+				bst.insert( key, static_cast< value_type >( key ) );
+
+				if ( !present )
+				{
+					expected.insert( position, key );
+				}
+			}
+
+			REQUIRE( bst.size() == expected.size() );
+			REQUIRE( bst.contains( key ) != ( index % 3 == 2 ) );
+		}
+
+		std::vector< key_type > inorder;
+		bst.inorder( [&inorder]( const auto& node )
+		{
+			REQUIRE( node->key == node->value );
+
+			inorder.push_back( node->key );
+		});
+
+		REQUIRE( inorder == expected );
+		REQUIRE( bst.calculated_size() == expected.size() );
+	}
 }
 
 namespace dsa
@@ -70,6 +147,32 @@ namespace dsa
 		REQUIRE( bst.size() == 1 );
 	}
 
+	TEST_CASE( ( UNIT_NAME + "copy_constructor" ).c_str() )
+	{
+		std::vector< key_type > keys;
+		generator< value_type >().fill_buffer_n( std::back_inserter( keys ), ITERATIONS );
+
+		binary_search_tree< key_type, value_type > bst;
+		for ( auto key : keys )
+		{
+			bst.insert( key, static_cast< value_type >( key ) );
+		}
+
+		auto copy = bst;
+
+		REQUIRE( copy.size() == bst.size() );
+		REQUIRE( copy.calculated_size() == bst.calculated_size() );
+
+		copy.erase( keys.front() );
+
+		REQUIRE( !copy.contains( keys.front() ) );
+		REQUIRE( bst.contains( keys.front() ) );
+
+		copy = bst;
+
+		REQUIRE( copy.contains( keys.front() ) );
+	}
+
 	TEST_CASE( ( UNIT_NAME + "contains" ).c_str() )
 	{
 		std::vector< key_type > keys;
@@ -235,4 +338,248 @@ namespace dsa
 
 		REQUIRE( !bst.balanced() );
 	}
+
+	TEST_CASE( ( UNIT_NAME + "flat_insert_erase" ).c_str() )
+	{
+		std::vector< key_type > keys;
+		generator< value_type >().fill_buffer_n( std::back_inserter( keys ), ITERATIONS );
+
+		flat_binary_search_tree< key_type, value_type > flat;
+		binary_search_tree< key_type, value_type > linked;
+
+		for ( auto key : keys )
+		{
+			flat.insert( key, static_cast< value_type >( key ) );
+			linked.insert( key, static_cast< value_type >( key ) );
+		}
+
+		for ( std::size_t index = 0; index < keys.size(); index += 2 )
+		{
+			flat.erase( keys[ index ] );
+			linked.erase( keys[ index ] );
+		}
+
+		REQUIRE( flat.size() == linked.size() );
+		REQUIRE( flat.calculated_size() == flat.size() );
+		REQUIRE( flat.height() == linked.height() );
+
+		std::vector< std::pair< key_type, value_type > > flat_items;
+		flat.inorder( [&flat_items]( auto const & node )
+		{
+			flat_items.emplace_back( node->key, node->value );
+		} );
+
+		std::vector< std::pair< key_type, value_type > > linked_items;
+		linked.inorder( [&linked_items]( auto const & node )
+		{
+			linked_items.emplace_back( node->key, node->value );
+		} );
+
+		REQUIRE( flat_items == linked_items );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "flat_free_list" ).c_str() )
+	{
+		flat_binary_search_tree< key_type, value_type > bst;
+
+		for ( key_type key = 0; key < 100; ++key )
+		{
+			bst.insert( ( key * 37 ) % 100, value_type() );
+		}
+
+		for ( key_type key = 0; key < 50; ++key )
+		{
+			bst.erase( key );
+		}
+
+		// Erased nodes are reused before the node array grows.
+		for ( key_type key = 100; key < 150; ++key )
+		{
+			bst.insert( key, value_type() );
+		}
+
+		REQUIRE( bst.size() == 100 );
+		REQUIRE( bst.calculated_size() == 100 );
+
+		for ( key_type key = 50; key < 150; ++key )
+		{
+			REQUIRE( bst.contains( key ) );
+		}
+
+		REQUIRE( sizeof( std::remove_pointer_t< flat_binary_search_tree< key_type, value_type >::node_type > ) < sizeof( std::remove_pointer_t< binary_search_tree< key_type, value_type >::node_type > ) );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "node_size" ).c_str() )
+	{
+		using flat_node = binary_search_tree_node< std::int32_t, std::int32_t, std::uint32_t >;
+		using linked_node = binary_search_tree_node< std::int32_t, std::int32_t >;
+
+		// The height, balance and color share one word: two links and three words for a flat node,
+		// two pointers and three words, padded to a pointer, for a linked one.
+		REQUIRE( sizeof( flat_node ) == 5 * sizeof( std::uint32_t ) );
+		REQUIRE( sizeof( linked_node ) == ( 2 * sizeof( linked_node* ) + 3 * sizeof( std::uint32_t ) + alignof( linked_node* ) - 1 ) / alignof( linked_node* ) * alignof( linked_node* ) );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "flat_copy_move" ).c_str() )
+	{
+		std::vector< key_type > keys;
+		generator< value_type >().fill_buffer_n( std::back_inserter( keys ), ITERATIONS );
+
+		flat_binary_search_tree< key_type, value_type > bst;
+		for ( auto key : keys )
+		{
+			bst.insert( key, static_cast< value_type >( key ) );
+		}
+
+		auto copy = bst;
+		copy.erase( keys.front() );
+
+		REQUIRE( !copy.contains( keys.front() ) );
+		REQUIRE( bst.contains( keys.front() ) );
+
+		const auto size = bst.size();
+		auto moved = std::move( bst );
+
+		REQUIRE( moved.size() == size );
+		REQUIRE( moved.contains( keys.front() ) );
+		REQUIRE( bst.empty() );
+
+		bst = std::move( copy );
+
+		REQUIRE( bst.size() == size - 1 );
+		REQUIRE( bst.calculated_size() == size - 1 );
+		REQUIRE( copy.empty() );
+
+		// The moved-from trees remain usable.
+		copy.insert( 1, 1 );
+
+		REQUIRE( copy.contains( 1 ) );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "constant_time_queries" ).c_str() )
+	{
+		binary_search_tree< key_type, value_type > bst;
+
+		for ( key_type key = 0; key < static_cast< key_type >( ITERATIONS ); ++key )
+		{
+			bst.insert( key, value_type() );
+		}
+
+		// Sorted keys build a list, and the queries read its height and balance off the root.
+		REQUIRE( bst.height() == ITERATIONS - 1 );
+		REQUIRE( !bst.balanced() );
+
+		for ( key_type key = 1; key < static_cast< key_type >( ITERATIONS ); ++key )
+		{
+			bst.erase( key );
+		}
+
+		REQUIRE( bst.height() == 0 );
+		REQUIRE( bst.balanced() );
+
+		bst.erase( 0 );
+
+		REQUIRE( bst.empty() );
+		REQUIRE( bst.height() == 0 );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "avl_sorted" ).c_str() )
+	{
+		avl_tree< key_type, value_type > bst;
+
+		for ( key_type key = 0; key < static_cast< key_type >( ITERATIONS ); ++key )
+		{
+			bst.insert( key, static_cast< value_type >( key ) );
+
+			REQUIRE( bst.balanced() );
+		}
+
+		REQUIRE( bst.size() == ITERATIONS );
+		REQUIRE( bst.height() < 1.44 * std::log2( ITERATIONS + 2 ) );
+
+		for ( key_type key = 0; key < static_cast< key_type >( ITERATIONS ); key += 2 )
+		{
+			bst.erase( key );
+
+			REQUIRE( bst.balanced() );
+		}
+
+		for ( key_type key = 0; key < static_cast< key_type >( ITERATIONS ); ++key )
+		{
+			REQUIRE( bst.contains( key ) == ( key % 2 == 1 ) );
+		}
+
+		REQUIRE( bst.calculated_size() == ITERATIONS / 2 );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "red_black_sorted" ).c_str() )
+	{
+		red_black_tree< key_type, value_type > bst;
+		const auto find_root = [&bst]()
+		{
+			red_black_tree< key_type, value_type >::node_type root = nullptr;
+
+			bst.preorder( [&root]( const auto& node )
+			{
+				root = root ? root : node;
+			});
+
+			return root;
+		};
+
+		for ( key_type key = static_cast< key_type >( ITERATIONS ); key > 0; --key )
+		{
+			bst.insert( key, static_cast< value_type >( key ) );
+		}
+
+		REQUIRE( bst.size() == ITERATIONS );
+		REQUIRE( bst.height() < 2 * std::log2( ITERATIONS + 1 ) );
+		REQUIRE( !find_root()->red );
+		REQUIRE( black_height( find_root() ) > 0 );
+
+		for ( key_type key = 1; key <= static_cast< key_type >( ITERATIONS ); key += 2 )
+		{
+			bst.erase( key );
+
+			REQUIRE( black_height( find_root() ) > 0 );
+		}
+
+		for ( key_type key = 1; key <= static_cast< key_type >( ITERATIONS ); ++key )
+		{
+			REQUIRE( bst.contains( key ) == ( key % 2 == 0 ) );
+		}
+
+		REQUIRE( bst.calculated_size() == ITERATIONS / 2 );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "balanced_random" ).c_str() )
+	{
+		binary_search_tree< key_type, value_type > unbalanced;
+		avl_tree< key_type, value_type > avl;
+		red_black_tree< key_type, value_type > red_black;
+		avl_tree< key_type, value_type, std::allocator< std::pair< const key_type, value_type > >, flat_tree_storage > flat_avl;
+		red_black_tree< key_type, value_type, std::allocator< std::pair< const key_type, value_type > >, flat_tree_storage > flat_red_black;
+
+		random_insert_erase( unbalanced );
+		random_insert_erase( avl );
+		random_insert_erase( red_black );
+		random_insert_erase( flat_avl );
+		random_insert_erase( flat_red_black );
+
+		REQUIRE( avl.balanced() );
+		REQUIRE( flat_avl.balanced() );
+		REQUIRE( avl.height() <= unbalanced.height() );
+
+		// Copies keep the balance metadata of their nodes.
+		auto copy = red_black;
+		const auto flat_copy = flat_avl;
+
+		REQUIRE( copy.height() == red_black.height() );
+		REQUIRE( flat_copy.size() == flat_avl.size() );
+
+		copy.insert( static_cast< key_type >( ITERATIONS ), value_type() );
+
+		REQUIRE( copy.contains( static_cast< key_type >( ITERATIONS ) ) );
+		REQUIRE( copy.size() == red_black.size() + 1 );
+	}
 }
\ No newline at end of file
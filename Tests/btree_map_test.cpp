@@ -0,0 +1,409 @@
+/**
+ * Daniel Sebastian Iliescu, http://dansil.net
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ *
+ * B-Tree Map Unit Tests.
+ */
+
+#include "trees/btree_map.hpp"
+
+#include "utilities/generator.hpp"
+
+#include <catch.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <memory_resource>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+	const std::string UNIT_NAME = "btree_map_";
+
+	using key_type = std::int32_t;
+	using value_type = std::int32_t;
+	constexpr std::size_t ITERATIONS = 10000;
+
+	// Nodes of a single cache line hold a handful of keys, which makes the trees deep.
+	constexpr std::size_t SMALL_NODE_BYTES = 64;
+
+	template < typename Map >
+	std::vector< std::pair< typename Map::key_type, typename Map::mapped_type > >
+	items( Map& map )
+	{
+		std::vector< std::pair< typename Map::key_type, typename Map::mapped_type > > result;
+
+		map.inorder( [&result]( const auto& key, auto& value )
+		{
+			result.emplace_back( key, value );
+		});
+
+		return result;
+	}
+
+	// Inserts and erases random keys, checking the contents of the map against std::map.
+	template < typename Map >
+	void
+	random_insert_erase( Map& map )
+	{
+		std::vector< key_type > keys;
+		generator< key_type >().fill_buffer_n( std::back_inserter( keys ), ITERATIONS );
+
+		std::map< key_type, value_type > expected;
+		for ( std::size_t index = 0; index < keys.size(); ++index )
+		{
+			// A narrow range of keys makes insertions of present keys and erasures of absent ones frequent.
+			const auto key = keys[ index ] % static_cast< key_type >( ITERATIONS / 4 );
+
+			if ( index % 3 == 2 )
+			{
+				REQUIRE( map.erase( key ) == ( expected.erase( key ) == 1 ) );
+				REQUIRE( !map.contains( key ) );
+			}
+			else
+			{
+				REQUIRE( map.insert( key, static_cast< value_type >( index ) ) == expected.emplace( key, static_cast< value_type >( index ) ).second );
+				REQUIRE( *map.find( key ) == expected[ key ] );
+			}
+
+			REQUIRE( map.size() == expected.size() );
+		}
+
+		const std::vector< std::pair< key_type, value_type > > expected_items( expected.cbegin(), expected.cend() );
+
+		REQUIRE( items( map ) == expected_items );
+
+		for ( const auto& item : expected )
+		{
+			REQUIRE( map.erase( item.first ) );
+		}
+
+		REQUIRE( map.empty() );
+		REQUIRE( map.height() == 0 );
+	}
+
+	template < typename Key >
+	void
+	check_key_search( std::vector< Key > keys )
+	{
+		std::sort( keys.begin(), keys.end() );
+		keys.erase( std::unique( keys.begin(), keys.end() ), keys.end() );
+
+		for ( std::size_t count = 0; count <= keys.size(); ++count )
+		{
+			for ( const auto key : keys )
+			{
+				const auto expected = static_cast< std::size_t >( std::lower_bound( keys.data(), keys.data() + count, key ) - keys.data() );
+
+				REQUIRE( dsa::btree_key_search::lower_bound( keys.data(), count, key ) == expected );
+			}
+
+			REQUIRE( dsa::btree_key_search::lower_bound( keys.data(), count, std::numeric_limits< Key >::max() ) == ( ( count == keys.size() ) ? count - ( keys.back() == std::numeric_limits< Key >::max() ) : count ) );
+		}
+	}
+}
+
+namespace dsa
+{
+	TEST_CASE( ( UNIT_NAME + "empty" ).c_str() )
+	{
+		btree_map< key_type, value_type > map;
+
+		REQUIRE( map.empty() );
+		REQUIRE( map.size() == 0 );
+		REQUIRE( map.height() == 0 );
+		REQUIRE( !map.contains( 0 ) );
+		REQUIRE( !map.find( 0 ) );
+		REQUIRE( !map.erase( 0 ) );
+		REQUIRE( items( map ).empty() );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "node_capacity" ).c_str() )
+	{
+		using map_type = btree_map< key_type, value_type >;
+		using page_map_type = btree_map< std::int64_t, std::int64_t, 4096 >;
+		using string_map_type = btree_map< std::string, std::string, 64 >;
+		using padded_map_type = btree_map< double, char, 256 >;
+
+		// The arrays of a node and its header fit in the node size.
+		REQUIRE( map_type::LEAF_CAPACITY * ( sizeof( key_type ) + sizeof( value_type ) ) + sizeof( std::uint32_t ) + sizeof( void* ) <= 256 );
+		REQUIRE( map_type::INTERNAL_CAPACITY * ( sizeof( key_type ) + sizeof( void* ) ) + sizeof( std::uint32_t ) + sizeof( void* ) <= 256 );
+		REQUIRE( map_type::INTERNAL_CAPACITY >= 16 );
+
+		REQUIRE( page_map_type::LEAF_CAPACITY * 2 * sizeof( std::int64_t ) + sizeof( std::uint32_t ) + sizeof( void* ) <= 4096 );
+		REQUIRE( page_map_type::LEAF_CAPACITY >= 200 );
+
+		// The padding between the count, the arrays and the link counts against the node size: a leaf of
+		// 26 doubles and chars spans 256 bytes, while 27 would need 264.
+		REQUIRE( padded_map_type::LEAF_CAPACITY == 26 );
+
+		// Keys too large for the node size still give nodes of three keys.
+		REQUIRE( string_map_type::LEAF_CAPACITY == 3 );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "key_search" ).c_str() )
+	{
+		std::vector< std::int32_t > signed_keys;
+		generator< std::int32_t >().fill_buffer_n( std::back_inserter( signed_keys ), 40 );
+		signed_keys.push_back( std::numeric_limits< std::int32_t >::min() );
+
+		std::vector< std::uint32_t > unsigned_keys;
+		for ( const auto key : signed_keys )
+		{
+			unsigned_keys.push_back( static_cast< std::uint32_t >( key ) );
+		}
+
+		std::vector< std::int64_t > wide_keys;
+		std::vector< std::uint64_t > wide_unsigned_keys;
+		std::vector< std::int16_t > narrow_keys;
+		std::vector< float > float_keys;
+		std::vector< double > double_keys;
+		std::vector< std::string > string_keys;
+
+		for ( const auto key : signed_keys )
+		{
+			wide_keys.push_back( static_cast< std::int64_t >( key ) * key * ( key < 0 ? -1 : 1 ) );
+			wide_unsigned_keys.push_back( static_cast< std::uint64_t >( wide_keys.back() ) );
+			narrow_keys.push_back( static_cast< std::int16_t >( key ) );
+			float_keys.push_back( static_cast< float >( key ) / 7 );
+			double_keys.push_back( static_cast< double >( key ) / 7 );
+			string_keys.push_back( std::to_string( key ) );
+		}
+
+		check_key_search( signed_keys );
+		check_key_search( unsigned_keys );
+		check_key_search( wide_keys );
+		check_key_search( wide_unsigned_keys );
+		check_key_search( narrow_keys );
+		check_key_search( float_keys );
+		check_key_search( double_keys );
+
+		std::sort( string_keys.begin(), string_keys.end() );
+		for ( std::size_t index = 0; index < string_keys.size(); ++index )
+		{
+			REQUIRE( btree_key_search::lower_bound( string_keys.data(), string_keys.size(), string_keys[ index ] ) == index );
+		}
+	}
+
+	TEST_CASE( ( UNIT_NAME + "insert_erase" ).c_str() )
+	{
+		btree_map< key_type, value_type > map;
+		btree_map< key_type, value_type, SMALL_NODE_BYTES > small_map;
+		btree_map< key_type, value_type, 4096 > page_map;
+
+		random_insert_erase( map );
+		random_insert_erase( small_map );
+		random_insert_erase( page_map );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "insert_duplicate" ).c_str() )
+	{
+		btree_map< key_type, value_type > map;
+
+		REQUIRE( map.insert( 1, 1 ) );
+		REQUIRE( !map.insert( 1, 2 ) );
+		REQUIRE( map.size() == 1 );
+		REQUIRE( *map.find( 1 ) == 1 );
+
+		// Values are updated through find.
+		*map.find( 1 ) = 2;
+
+		REQUIRE( *map.find( 1 ) == 2 );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "sorted_insert" ).c_str() )
+	{
+		using map_type = btree_map< key_type, value_type >;
+
+		map_type ascending;
+		map_type descending;
+
+		for ( key_type key = 0; key < static_cast< key_type >( ITERATIONS ); ++key )
+		{
+			ascending.insert( key, key );
+			descending.insert( static_cast< key_type >( ITERATIONS ) - key - 1, key );
+		}
+
+		// Splits on the rightmost path leave the nodes almost full, which bounds the height of the ascending tree.
+		std::size_t nodes = ( ITERATIONS + map_type::LEAF_CAPACITY - 2 ) / ( map_type::LEAF_CAPACITY - 1 );
+		std::size_t height = 0;
+		while ( nodes > 1 )
+		{
+			nodes = ( nodes + map_type::INTERNAL_CAPACITY - 2 ) / ( map_type::INTERNAL_CAPACITY - 1 );
+			++height;
+		}
+
+		REQUIRE( ascending.height() <= height );
+		REQUIRE( ascending.height() <= descending.height() );
+		REQUIRE( items( ascending ).size() == ITERATIONS );
+
+		for ( key_type key = 0; key < static_cast< key_type >( ITERATIONS ); ++key )
+		{
+			REQUIRE( *ascending.find( key ) == key );
+			REQUIRE( *descending.find( key ) == static_cast< key_type >( ITERATIONS ) - key - 1 );
+		}
+
+		// Erasing from the front merges the leaves emptied along the left of the tree.
+		for ( key_type key = 0; key < static_cast< key_type >( ITERATIONS ) - 1; ++key )
+		{
+			REQUIRE( ascending.erase( key ) );
+			REQUIRE( descending.erase( static_cast< key_type >( ITERATIONS ) - key - 1 ) );
+		}
+
+		REQUIRE( ascending.height() == 0 );
+		REQUIRE( ascending.contains( static_cast< key_type >( ITERATIONS ) - 1 ) );
+		REQUIRE( descending.contains( 0 ) );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "scan" ).c_str() )
+	{
+		btree_map< key_type, value_type, SMALL_NODE_BYTES > map;
+
+		map.scan( 0, 10, []( const auto&, auto& )
+		{
+			REQUIRE( false );
+		});
+
+		for ( key_type key = 0; key < static_cast< key_type >( ITERATIONS ); key += 2 )
+		{
+			map.insert( key, -key );
+		}
+
+		std::vector< key_type > keys;
+		map.scan( 101, 1001, [&keys]( const auto& key, auto& value )
+		{
+			REQUIRE( value == -key );
+
+			keys.push_back( key );
+		});
+
+		REQUIRE( keys.size() == 450 );
+		REQUIRE( keys.front() == 102 );
+		REQUIRE( keys.back() == 1000 );
+		REQUIRE( std::is_sorted( keys.cbegin(), keys.cend() ) );
+
+		// Ranges past the last key, and empty ranges, visit nothing.
+		keys.clear();
+		map.scan( static_cast< key_type >( ITERATIONS ), static_cast< key_type >( 2 * ITERATIONS ), [&keys]( const auto& key, auto& )
+		{
+			keys.push_back( key );
+		});
+		map.scan( 10, 10, [&keys]( const auto& key, auto& )
+		{
+			keys.push_back( key );
+		});
+
+		REQUIRE( keys.empty() );
+
+		// Scanning through the whole map visits the same items as inorder.
+		std::vector< std::pair< key_type, value_type > > scanned;
+		map.scan( std::numeric_limits< key_type >::min(), std::numeric_limits< key_type >::max(), [&scanned]( const auto& key, auto& value )
+		{
+			scanned.emplace_back( key, value );
+		});
+
+		REQUIRE( scanned == items( map ) );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "string_keys" ).c_str() )
+	{
+		btree_map< std::string, std::string, 512 > map;
+		std::map< std::string, std::string > expected;
+
+		std::vector< key_type > keys;
+		generator< key_type >().fill_buffer_n( std::back_inserter( keys ), ITERATIONS );
+
+		for ( const auto key : keys )
+		{
+			const auto text = std::to_string( key );
+
+			REQUIRE( map.insert( text, text + text ) == expected.emplace( text, text + text ).second );
+		}
+
+		for ( std::size_t index = 0; index < keys.size(); index += 2 )
+		{
+			const auto text = std::to_string( keys[ index ] );
+
+			REQUIRE( map.erase( text ) == ( expected.erase( text ) == 1 ) );
+		}
+
+		const std::vector< std::pair< std::string, std::string > > expected_items( expected.cbegin(), expected.cend() );
+
+		REQUIRE( items( map ) == expected_items );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "copy_move" ).c_str() )
+	{
+		btree_map< key_type, value_type, SMALL_NODE_BYTES > map;
+
+		std::vector< key_type > keys;
+		generator< key_type >().fill_buffer_n( std::back_inserter( keys ), ITERATIONS );
+
+		for ( const auto key : keys )
+		{
+			map.insert( key, key );
+		}
+
+		auto copy = map;
+
+		REQUIRE( items( copy ) == items( map ) );
+		REQUIRE( copy.height() == map.height() );
+
+		copy.erase( keys.front() );
+
+		REQUIRE( !copy.contains( keys.front() ) );
+		REQUIRE( map.contains( keys.front() ) );
+
+		const auto size = map.size();
+		auto moved = std::move( map );
+
+		REQUIRE( moved.size() == size );
+		REQUIRE( map.empty() );
+
+		map = std::move( copy );
+
+		REQUIRE( map.size() == size - 1 );
+		REQUIRE( copy.empty() );
+
+		copy = moved;
+		swap( copy, map );
+
+		REQUIRE( map.size() == size );
+		REQUIRE( copy.size() == size - 1 );
+
+		// The moved-from maps remain usable.
+		moved.clear();
+		moved.insert( 1, 1 );
+
+		REQUIRE( moved.contains( 1 ) );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "polymorphic_allocator" ).c_str() )
+	{
+		using map_type = btree_map< key_type, value_type, SMALL_NODE_BYTES, std::pmr::polymorphic_allocator< std::pair< const key_type, value_type > > >;
+
+		std::pmr::monotonic_buffer_resource resource;
+		std::pmr::monotonic_buffer_resource other_resource;
+
+		map_type map( &resource );
+		map_type other( &other_resource );
+
+		for ( key_type key = 0; key < static_cast< key_type >( ITERATIONS ); ++key )
+		{
+			map.insert( key, key );
+		}
+
+		// Polymorphic allocators stay with their map, so the items are copied into its own nodes.
+		other = std::move( map );
+
+		REQUIRE( map.empty() );
+		REQUIRE( other.size() == ITERATIONS );
+		REQUIRE( other.get_allocator().resource() == &other_resource );
+		REQUIRE( items( other ).back().first == static_cast< key_type >( ITERATIONS ) - 1 );
+	}
+}
\ No newline at end of file
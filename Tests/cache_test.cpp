@@ -0,0 +1,329 @@
+/**
+ * Daniel Sebastian Iliescu, http://dansil.net
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ *
+ * Cache Unit Tests.
+ */
+
+#include "caches/lfu_cache.hpp"
+#include "caches/lru_cache.hpp"
+#include "caches/sharded_cache.hpp"
+
+#include "utilities/generator.hpp"
+
+#include <catch.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <list>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace
+{
+	const std::string UNIT_NAME = "cache_";
+
+	using value_type = std::int32_t;
+	constexpr auto ITERATIONS = 10000U;
+	constexpr std::size_t THREADS = 4;
+
+	// Bounds a cache of strings by the number of characters it holds.
+	struct string_size_weigher
+	{
+		std::size_t
+		operator()(
+			const value_type&,
+			const std::string& value ) const noexcept
+		{
+			return value.size();
+		}
+	};
+}
+
+namespace dsa
+{
+	TEST_CASE( ( UNIT_NAME + "lru_eviction_order" ).c_str() )
+	{
+		lru_cache< value_type, std::string > cache( 3 );
+
+		cache.put( 1, "one" );
+		cache.put( 2, "two" );
+		cache.put( 3, "three" );
+
+		REQUIRE( *cache.get( 1 ) == "one" );
+
+		cache.put( 4, "four" );
+
+		REQUIRE( cache.size() == 3 );
+		REQUIRE( !cache.contains( 2 ) );
+		REQUIRE( cache.get( 2 ) == nullptr );
+
+		// Replacing a value makes it the most recently used.
+		cache.put( 3, "THREE" );
+		cache.put( 5, "five" );
+
+		REQUIRE( !cache.contains( 1 ) );
+		REQUIRE( *cache.get( 3 ) == "THREE" );
+
+		REQUIRE( cache.erase( 4 ) );
+		REQUIRE( !cache.erase( 4 ) );
+		REQUIRE( cache.size() == 2 );
+
+		const auto& statistics = cache.statistics();
+
+		REQUIRE( statistics.hits == 2 );
+		REQUIRE( statistics.misses == 1 );
+		REQUIRE( statistics.evictions == 2 );
+		REQUIRE( statistics.hit_ratio() == Approx( 2.0 / 3.0 ) );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "lru_matches_model" ).c_str() )
+	{
+		constexpr std::size_t CAPACITY = 64;
+
+		generator< value_type > keys( generators::random_seed(), std::uniform_int_distribution< value_type >( 0, 4 * CAPACITY ) );
+
+		lru_cache< value_type, value_type > cache( CAPACITY );
+		std::list< std::pair< value_type, value_type > > model;
+
+		for ( value_type iteration = 0; iteration < static_cast< value_type >( ITERATIONS ); ++iteration )
+		{
+			const auto key = keys();
+			const auto found = std::find_if(
+				std::begin( model ),
+				std::end( model ),
+				[key]( const std::pair< value_type, value_type >& entry )
+				{
+					return entry.first == key;
+				} );
+
+			if ( iteration % 2 == 0 )
+			{
+				const auto value = cache.get( key );
+
+				REQUIRE( ( value != nullptr ) == ( found != std::end( model ) ) );
+
+				if ( value )
+				{
+					REQUIRE( *value == found->second );
+
+					model.splice( std::begin( model ), model, found );
+				}
+			}
+			else
+			{
+				cache.put( key, iteration );
+
+				if ( found != std::end( model ) )
+				{
+					model.erase( found );
+				}
+
+				model.emplace_front( key, iteration );
+
+				if ( model.size() > CAPACITY )
+				{
+					model.pop_back();
+				}
+			}
+		}
+
+		REQUIRE( cache.size() == model.size() );
+
+		for ( const auto& entry : model )
+		{
+			REQUIRE( cache.contains( entry.first ) );
+		}
+	}
+
+	TEST_CASE( ( UNIT_NAME + "lru_weight" ).c_str() )
+	{
+		lru_cache< value_type, std::string, string_size_weigher > cache( 10 );
+
+		cache.put( 1, "abcd" );
+		cache.put( 2, "efgh" );
+
+		REQUIRE( cache.weight() == 8 );
+
+		// Growing the first entry pushes out the second.
+		cache.put( 1, "abcdefg" );
+
+		REQUIRE( cache.weight() == 7 );
+		REQUIRE( !cache.contains( 2 ) );
+
+		// An entry heavier than the capacity does not stay.
+		cache.put( 3, std::string( 11, 'x' ) );
+
+		REQUIRE( cache.empty() );
+		REQUIRE( cache.weight() == 0 );
+		REQUIRE( cache.statistics().evictions == 3 );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "lfu_eviction_order" ).c_str() )
+	{
+		lfu_cache< value_type, std::string > cache( 3 );
+
+		cache.put( 1, "one" );
+		cache.put( 2, "two" );
+		cache.put( 3, "three" );
+
+		REQUIRE( *cache.get( 1 ) == "one" );
+		REQUIRE( *cache.get( 1 ) == "one" );
+		REQUIRE( *cache.get( 2 ) == "two" );
+
+		REQUIRE( cache.frequency( 1 ) == 3 );
+		REQUIRE( cache.frequency( 2 ) == 2 );
+		REQUIRE( cache.frequency( 3 ) == 1 );
+
+		// 3 is the least frequently used.
+		cache.put( 4, "four" );
+
+		REQUIRE( !cache.contains( 3 ) );
+
+		// 4 is now the only entry used once.
+		cache.put( 5, "five" );
+
+		REQUIRE( !cache.contains( 4 ) );
+		REQUIRE( cache.contains( 5 ) );
+
+		REQUIRE( *cache.get( 5 ) == "five" );
+		REQUIRE( cache.frequency( 5 ) == 2 );
+
+		REQUIRE( cache.erase( 2 ) );
+		REQUIRE( cache.size() == 2 );
+		REQUIRE( cache.get( 2 ) == nullptr );
+
+		const auto& statistics = cache.statistics();
+
+		REQUIRE( statistics.hits == 4 );
+		REQUIRE( statistics.misses == 1 );
+		REQUIRE( statistics.evictions == 2 );
+
+		cache.clear();
+
+		REQUIRE( cache.empty() );
+		REQUIRE( cache.frequency( 1 ) == 0 );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "lfu_recency_ties" ).c_str() )
+	{
+		lfu_cache< value_type, value_type > cache( 2 );
+
+		cache.put( 1, 1 );
+		cache.put( 2, 2 );
+
+		// 1 and 2 are used once, 1 less recently.
+		cache.put( 3, 3 );
+
+		REQUIRE( !cache.contains( 1 ) );
+		REQUIRE( cache.contains( 2 ) );
+		REQUIRE( cache.contains( 3 ) );
+
+		// Touching 2 makes 3 the candidate.
+		cache.get( 2 );
+		cache.put( 2, 4 );
+		cache.put( 4, 4 );
+
+		REQUIRE( cache.frequency( 2 ) == 3 );
+		REQUIRE( !cache.contains( 3 ) );
+		REQUIRE( *cache.get( 2 ) == 4 );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "lfu_admits_new_keys" ).c_str() )
+	{
+		lfu_cache< value_type, value_type > cache( 2 );
+
+		cache.put( 1, 1 );
+		cache.put( 2, 2 );
+		cache.get( 1 );
+		cache.get( 2 );
+
+		// Every cached entry is used more often than a new one, which must still be admitted.
+		for ( value_type key = 3; key < 10; ++key )
+		{
+			cache.put( key, key );
+
+			REQUIRE( cache.contains( key ) );
+			REQUIRE( cache.size() == 2 );
+			REQUIRE( *cache.get( key ) == key );
+		}
+
+		REQUIRE( cache.statistics().evictions == 7 );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "lfu_weight" ).c_str() )
+	{
+		lfu_cache< value_type, std::string, string_size_weigher > cache( 10 );
+
+		cache.put( 1, "abcd" );
+		cache.put( 2, "efgh" );
+		cache.get( 2 );
+
+		cache.put( 3, "ijkl" );
+
+		REQUIRE( cache.weight() == 8 );
+		REQUIRE( !cache.contains( 1 ) );
+		REQUIRE( cache.frequency( 2 ) == 2 );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "sharded" ).c_str() )
+	{
+		constexpr std::size_t CAPACITY = 256;
+
+		sharded_cache< lru_cache< value_type, value_type > > cache( CAPACITY, 8 );
+
+		REQUIRE( cache.shard_count() == 8 );
+		REQUIRE( cache.capacity() == CAPACITY );
+
+		// Catch assertions are not thread-safe, so the threads only count wrong values.
+		std::atomic< std::size_t > mismatches { 0 };
+		std::vector< std::thread > threads;
+
+		for ( std::size_t thread = 0; thread < THREADS; ++thread )
+		{
+			threads.emplace_back( [&cache, &mismatches, thread]()
+			{
+				generator< value_type > keys( generators::derive_seed( 0, thread ), std::uniform_int_distribution< value_type >( 0, 2 * CAPACITY ) );
+
+				for ( std::size_t iteration = 0; iteration < ITERATIONS; ++iteration )
+				{
+					const auto key = keys();
+
+					if ( const auto value = cache.get( key ) )
+					{
+						// Values always derive from their key.
+						if ( *value != 2 * key )
+						{
+							++mismatches;
+						}
+					}
+					else
+					{
+						cache.put( key, 2 * key );
+					}
+				}
+			} );
+		}
+
+		for ( auto& thread : threads )
+		{
+			thread.join();
+		}
+
+		const auto statistics = cache.statistics();
+
+		REQUIRE( mismatches == 0 );
+		REQUIRE( statistics.hits + statistics.misses == THREADS * ITERATIONS );
+		REQUIRE( statistics.hits > 0 );
+		REQUIRE( cache.size() <= CAPACITY );
+
+		sharded_cache< lfu_cache< value_type, value_type > > frequency_cache( 4, 4 );
+
+		frequency_cache.put( 1, 2 );
+
+		REQUIRE( *frequency_cache.get( 1 ) == 2 );
+		REQUIRE( !frequency_cache.get( 2 ) );
+	}
+}
\ No newline at end of file
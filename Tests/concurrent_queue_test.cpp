@@ -0,0 +1,260 @@
+/**
+ * Daniel Sebastian Iliescu, http://dansil.net
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ *
+ * Concurrent Queue Unit Tests.
+ */
+
+#include "lists/concurrent_queue.hpp"
+#include "lists/bounded_concurrent_queue.hpp"
+
+#include <catch.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	const std::string UNIT_NAME = "concurrent_queue_";
+
+	using value_type = std::uint64_t;
+	constexpr std::size_t ITERATIONS = 20000;
+	constexpr std::size_t PRODUCERS = 4;
+	constexpr std::size_t CONSUMERS = 4;
+
+	/**
+	 * Every producer pushes a distinct range of values while the consumers
+	 * drain the queue; every value must be received exactly once, and the
+	 * values of a given producer must arrive in order at each consumer.
+	 */
+	template < typename Queue >
+	void
+	producer_consumer_tester( Queue& queue )
+	{
+		std::vector< std::vector< value_type > > received( CONSUMERS );
+		std::atomic< std::size_t > remaining { PRODUCERS * ITERATIONS };
+
+		std::vector< std::thread > threads;
+
+		for ( std::size_t producer = 0; producer < PRODUCERS; ++producer )
+		{
+			threads.emplace_back( [&queue, producer]()
+			{
+				for ( std::size_t iteration = 0; iteration < ITERATIONS; ++iteration )
+				{
+					while ( !queue.push_back( producer * ITERATIONS + iteration ) )
+					{
+						std::this_thread::yield();
+					}
+				}
+			} );
+		}
+
+		for ( std::size_t consumer = 0; consumer < CONSUMERS; ++consumer )
+		{
+			threads.emplace_back( [&queue, &remaining, &items = received[ consumer ]]()
+			{
+				value_type item;
+
+				while ( remaining.load() > 0 )
+				{
+					if ( queue.pop_front( item ) )
+					{
+						items.push_back( item );
+						--remaining;
+					}
+					else
+					{
+						std::this_thread::yield();
+					}
+				}
+			} );
+		}
+
+		for ( auto& thread : threads )
+		{
+			thread.join();
+		}
+
+		std::vector< value_type > all;
+
+		for ( const auto& items : received )
+		{
+			std::vector< value_type > last( PRODUCERS, 0 );
+			std::vector< bool > seen( PRODUCERS, false );
+
+			for ( const auto item : items )
+			{
+				const auto producer = item / ITERATIONS;
+
+				REQUIRE( ( !seen[ producer ] || ( last[ producer ] < item ) ) );
+
+				seen[ producer ] = true;
+				last[ producer ] = item;
+			}
+
+			all.insert( std::end( all ), std::cbegin( items ), std::cend( items ) );
+		}
+
+		std::sort( std::begin( all ), std::end( all ) );
+
+		REQUIRE( all.size() == PRODUCERS * ITERATIONS );
+
+		for ( std::size_t item = 0; item < all.size(); ++item )
+		{
+			REQUIRE( all[ item ] == item );
+		}
+
+		REQUIRE( queue.empty() );
+	}
+
+	// Adapts the unbounded queue to the bounded push_back signature used by the tester.
+	template < typename T >
+	struct unbounded_adapter
+	{
+		bool
+		push_back( T item )
+		{
+			this->queue.push_back( std::move( item ) );
+
+			return true;
+		}
+
+		bool
+		pop_front( T& item )
+		{
+			return this->queue.pop_front( item );
+		}
+
+		bool
+		empty() const
+		{
+			return this->queue.empty();
+		}
+
+		dsa::concurrent_queue< T > queue;
+	};
+}
+
+namespace dsa
+{
+	TEST_CASE( ( UNIT_NAME + "fifo" ).c_str() )
+	{
+		concurrent_queue< value_type > queue;
+
+		REQUIRE( queue.empty() );
+
+		for ( value_type item = 0; item < ITERATIONS; ++item )
+		{
+			queue.push_back( item );
+		}
+
+		REQUIRE( queue.size() == ITERATIONS );
+
+		value_type item;
+		for ( value_type expected = 0; expected < ITERATIONS; ++expected )
+		{
+			REQUIRE( queue.pop_front( item ) );
+			REQUIRE( item == expected );
+		}
+
+		REQUIRE( !queue.pop_front( item ) );
+		REQUIRE( queue.empty() );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "move_only" ).c_str() )
+	{
+		concurrent_queue< std::unique_ptr< std::string > > queue;
+
+		queue.push_back( std::make_unique< std::string >( "first" ) );
+		queue.emplace_back( new std::string( "second" ) );
+		queue.push_back( std::make_unique< std::string >( "left in the queue" ) );
+
+		std::unique_ptr< std::string > item;
+
+		REQUIRE( queue.pop_front( item ) );
+		REQUIRE( *item == "first" );
+		REQUIRE( queue.pop_front( item ) );
+		REQUIRE( *item == "second" );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "producer_consumer" ).c_str() )
+	{
+		unbounded_adapter< value_type > queue;
+
+		producer_consumer_tester( queue );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "bounded_fifo" ).c_str() )
+	{
+		bounded_concurrent_queue< std::string > queue( 5 );
+
+		REQUIRE( queue.capacity() == 8 );
+
+		for ( std::size_t item = 0; item < queue.capacity(); ++item )
+		{
+			REQUIRE( queue.push_back( std::to_string( item ) ) );
+		}
+
+		REQUIRE( !queue.push_back( "full" ) );
+		REQUIRE( queue.size() == queue.capacity() );
+
+		std::string item;
+		for ( std::size_t expected = 0; expected < queue.capacity() / 2; ++expected )
+		{
+			REQUIRE( queue.pop_front( item ) );
+			REQUIRE( item == std::to_string( expected ) );
+		}
+
+		// Wrap around the ring.
+		REQUIRE( queue.push_back( "wrapped" ) );
+		REQUIRE( queue.size() == queue.capacity() / 2 + 1 );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "bounded_throwing_construction" ).c_str() )
+	{
+		// Throws when built from a negative value, but moves without throwing.
+		struct checked_item
+		{
+			checked_item() noexcept = default;
+
+			explicit checked_item( const int input_value ) :
+				value( input_value )
+			{
+				if ( input_value < 0 )
+				{
+					throw std::invalid_argument( "negative" );
+				}
+			}
+
+			int value = 0;
+		};
+
+		bounded_concurrent_queue< checked_item > queue( 4 );
+
+		REQUIRE( queue.emplace_back( 1 ) );
+		REQUIRE_THROWS_AS( queue.emplace_back( -1 ), const std::invalid_argument& );
+
+		// The failed construction must not have claimed a cell.
+		REQUIRE( queue.size() == 1 );
+		REQUIRE( queue.emplace_back( 2 ) );
+
+		checked_item item;
+		REQUIRE( queue.pop_front( item ) );
+		REQUIRE( item.value == 1 );
+		REQUIRE( queue.pop_front( item ) );
+		REQUIRE( item.value == 2 );
+		REQUIRE( !queue.pop_front( item ) );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "bounded_producer_consumer" ).c_str() )
+	{
+		bounded_concurrent_queue< value_type > queue( 64 );
+
+		producer_consumer_tester( queue );
+	}
+}
@@ -11,7 +11,12 @@
 
 #include <catch.hpp>
 
+#include <algorithm>
 #include <array>
+#include <list>
+#include <memory>
+#include <string>
+#include <vector>
 
 namespace
 {
@@ -19,6 +24,33 @@ namespace
 
 	using value_type = std::int32_t;
 	constexpr auto ITERATIONS = 1000U;
+
+	// Counts the copies made of any instance.
+	struct copy_counter
+	{
+		copy_counter() noexcept = default;
+		~copy_counter() noexcept = default;
+
+		copy_counter( const copy_counter& ) noexcept
+		{
+			++copies;
+		}
+
+		copy_counter( copy_counter&& ) noexcept = default;
+
+		copy_counter& operator=( const copy_counter& ) noexcept
+		{
+			++copies;
+
+			return *this;
+		}
+
+		copy_counter& operator=( copy_counter&& ) noexcept = default;
+
+		static std::size_t copies;
+	};
+
+	std::size_t copy_counter::copies = 0;
 }
 
 namespace dsa
@@ -28,6 +60,27 @@ namespace dsa
 		doubly_linked_list< value_type > list;
 
 		REQUIRE( list.empty() );
+		REQUIRE( list.cbegin() == list.cend() );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "range_constructor" ).c_str() )
+	{
+		std::array< value_type, ITERATIONS > values;
+
+		generator< value_type > generator;
+		generator.fill_buffer(
+			std::begin( values ),
+			std::end( values ) );
+
+		const doubly_linked_list< value_type > list( std::cbegin( values ), std::cend( values ) );
+
+		REQUIRE( ITERATIONS == list.size() );
+		REQUIRE(
+			std::equal(
+				std::cbegin( values ),
+				std::cend( values ),
+				std::cbegin( list ),
+				std::cend( list ) ) );
 	}
 
 	TEST_CASE( ( UNIT_NAME + "copy_constructor_push_front" ).c_str() )
@@ -174,6 +227,44 @@ namespace dsa
 		REQUIRE( list != list_copy );
 	}
 
+	TEST_CASE( ( UNIT_NAME + "equality_operator_long_list" ).c_str() )
+	{
+		// Long enough to overflow the stack if the comparison recursed once per node.
+		constexpr std::size_t LONG_LIST = 1000000;
+
+		doubly_linked_list< value_type > list;
+
+		for ( std::size_t item = 0; item < LONG_LIST; ++item )
+		{
+			list.push_back( static_cast< value_type >( item % 7 ) );
+		}
+
+		auto list_copy = list;
+
+		REQUIRE( list == list_copy );
+
+		list_copy.back() = 7;
+
+		REQUIRE( list != list_copy );
+
+		list_copy.pop_back();
+
+		REQUIRE( list != list_copy );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "iterator_identity" ).c_str() )
+	{
+		// Equal items, including the default constructed item held by the sentinel.
+		const std::vector< value_type > values( 5, value_type() );
+
+		doubly_linked_list< value_type > list( std::cbegin( values ), std::cend( values ) );
+
+		REQUIRE( list.begin() != list.end() );
+		REQUIRE( std::next( list.begin() ) != list.begin() );
+		REQUIRE( std::distance( list.begin(), list.end() ) == 5 );
+		REQUIRE( std::distance( list.crbegin(), list.crend() ) == 5 );
+	}
+
 	TEST_CASE( ( UNIT_NAME + "empty_pop_front" ).c_str() )
 	{
 		doubly_linked_list< value_type > list;
@@ -525,4 +616,219 @@ namespace dsa
 				std::crbegin( list ),
 				std::crend( list ) ) );
 	}
-}
+
+	TEST_CASE( ( UNIT_NAME + "copy_assignment_operator" ).c_str() )
+	{
+		doubly_linked_list< value_type > list;
+		doubly_linked_list< value_type > list_copy;
+
+		generator< value_type > generator;
+		generator.fill_buffer_n( std::back_inserter( list ), ITERATIONS );
+		generator.fill_buffer_n( std::back_inserter( list_copy ), ITERATIONS / 2 );
+
+		list_copy = list;
+
+		REQUIRE( ITERATIONS == list_copy.size() );
+		REQUIRE( list == list_copy );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "emplace" ).c_str() )
+	{
+		doubly_linked_list< std::string > list;
+
+		REQUIRE( list.emplace_back( 3, 'b' ) == "bbb" );
+		REQUIRE( list.emplace_front( 2, 'a' ) == "aa" );
+
+		const auto it = list.emplace( std::next( list.cbegin() ), "between" );
+
+		REQUIRE( *it == "between" );
+		REQUIRE( 3 == list.size() );
+		REQUIRE( list.front() == "aa" );
+		REQUIRE( list.back() == "bbb" );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "insert_erase" ).c_str() )
+	{
+		std::vector< value_type > values( ITERATIONS );
+
+		generator< value_type > generator;
+		generator.fill_buffer(
+			std::begin( values ),
+			std::end( values ) );
+
+		std::list< value_type > expected( std::cbegin( values ), std::cend( values ) );
+		doubly_linked_list< value_type > list( std::cbegin( values ), std::cend( values ) );
+
+		// Insert a range in the middle, a single element at the front, then erase every third element.
+		auto expected_position = std::next( std::begin( expected ), ITERATIONS / 2 );
+		auto position = std::next( list.cbegin(), ITERATIONS / 2 );
+
+		expected.insert( expected_position, std::cbegin( values ), std::cend( values ) );
+		const auto inserted = list.insert( position, std::cbegin( values ), std::cend( values ) );
+
+		REQUIRE( *inserted == values.front() );
+
+		expected.insert( std::begin( expected ), 42 );
+		REQUIRE( *list.insert( list.cbegin(), 42 ) == 42 );
+
+		auto expected_it = std::begin( expected );
+		auto it = list.begin();
+
+		for ( std::size_t index = 0; it != list.end(); ++index )
+		{
+			if ( index % 3 == 0 )
+			{
+				expected_it = expected.erase( expected_it );
+				it = list.erase( it );
+			}
+			else
+			{
+				++expected_it;
+				++it;
+			}
+		}
+
+		REQUIRE( expected.size() == list.size() );
+		REQUIRE(
+			std::equal(
+				std::cbegin( expected ),
+				std::cend( expected ),
+				std::cbegin( list ),
+				std::cend( list ) ) );
+
+		REQUIRE( list.erase( list.cbegin(), list.cend() ) == list.end() );
+		REQUIRE( list.empty() );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "splice" ).c_str() )
+	{
+		const std::vector< value_type > values { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+
+		doubly_linked_list< value_type > list( std::cbegin( values ), std::cbegin( values ) + 5 );
+		doubly_linked_list< value_type > other( std::cbegin( values ) + 5, std::cend( values ) );
+
+		// Whole list.
+		list.splice( list.cend(), other );
+
+		REQUIRE( other.empty() );
+		REQUIRE( values.size() == list.size() );
+		REQUIRE( std::equal( std::cbegin( values ), std::cend( values ), std::cbegin( list ), std::cend( list ) ) );
+
+		// Range into another list: 3, 4, 5.
+		other.splice( other.cend(), list, std::next( list.cbegin(), 2 ), std::next( list.cbegin(), 5 ) );
+
+		REQUIRE( 7 == list.size() );
+		REQUIRE( 3 == other.size() );
+		REQUIRE( other.front() == 3 );
+		REQUIRE( other.back() == 5 );
+
+		// Single element to the front: 6.
+		other.splice( other.cbegin(), list, std::next( list.cbegin(), 2 ) );
+
+		REQUIRE( 6 == list.size() );
+		REQUIRE( 4 == other.size() );
+		REQUIRE( other.front() == 6 );
+
+		// Range within the same list: move 1, 2 to the back.
+		list.splice( list.cend(), list, list.cbegin(), std::next( list.cbegin(), 2 ) );
+
+		const std::vector< value_type > expected { 7, 8, 9, 10, 1, 2 };
+
+		REQUIRE( 6 == list.size() );
+		REQUIRE( std::equal( std::cbegin( expected ), std::cend( expected ), std::cbegin( list ), std::cend( list ) ) );
+		REQUIRE( std::equal( std::crbegin( expected ), std::crend( expected ), std::crbegin( list ), std::crend( list ) ) );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "merge" ).c_str() )
+	{
+		std::vector< value_type > first_values( ITERATIONS );
+		std::vector< value_type > second_values( ITERATIONS / 3 );
+
+		generator< value_type > generator;
+		generator.fill_buffer( std::begin( first_values ), std::end( first_values ) );
+		generator.fill_buffer( std::begin( second_values ), std::end( second_values ) );
+
+		std::sort( std::begin( first_values ), std::end( first_values ) );
+		std::sort( std::begin( second_values ), std::end( second_values ) );
+
+		doubly_linked_list< value_type > list( std::cbegin( first_values ), std::cend( first_values ) );
+		doubly_linked_list< value_type > other( std::cbegin( second_values ), std::cend( second_values ) );
+
+		list.merge( other );
+
+		std::vector< value_type > expected;
+		std::merge(
+			std::cbegin( first_values ),
+			std::cend( first_values ),
+			std::cbegin( second_values ),
+			std::cend( second_values ),
+			std::back_inserter( expected ) );
+
+		REQUIRE( other.empty() );
+		REQUIRE( expected.size() == list.size() );
+		REQUIRE( std::equal( std::cbegin( expected ), std::cend( expected ), std::cbegin( list ), std::cend( list ) ) );
+		REQUIRE( std::equal( std::crbegin( expected ), std::crend( expected ), std::crbegin( list ), std::crend( list ) ) );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "move_only" ).c_str() )
+	{
+		doubly_linked_list< std::unique_ptr< value_type > > list;
+
+		for ( value_type item = 0; item < 10; ++item )
+		{
+			list.push_back( std::make_unique< value_type >( item ) );
+			list.push_front( std::make_unique< value_type >( -item ) );
+		}
+
+		REQUIRE( *list.front() == -9 );
+		REQUIRE( *list.back() == 9 );
+
+		auto front = list.pop_front();
+		auto back = list.pop_back();
+
+		REQUIRE( *front == -9 );
+		REQUIRE( *back == 9 );
+		REQUIRE( 18 == list.size() );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "no_copies" ).c_str() )
+	{
+		copy_counter::copies = 0;
+
+		doubly_linked_list< copy_counter > list;
+
+		for ( std::size_t item = 0; item < ITERATIONS; ++item )
+		{
+			list.push_back( copy_counter() );
+			list.emplace_front();
+		}
+
+		while ( !list.empty() )
+		{
+			const auto front = list.pop_front();
+			const auto back = list.pop_back();
+		}
+
+		REQUIRE( 0 == copy_counter::copies );
+
+		const copy_counter item;
+		list.push_back( item );
+
+		REQUIRE( 1 == copy_counter::copies );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "reference_access" ).c_str() )
+	{
+		doubly_linked_list< std::string > list;
+
+		list.push_back( "front" );
+		list.push_back( "back" );
+
+		list.front() += " modified";
+		list.back().clear();
+
+		REQUIRE( list.front() == "front modified" );
+		REQUIRE( list.back().empty() );
+		REQUIRE( &list.front() == &*list.begin() );
+	}
+}
\ No newline at end of file
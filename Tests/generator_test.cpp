@@ -0,0 +1,158 @@
+/**
+ * Daniel Sebastian Iliescu, http://dansil.net
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ *
+ * Tester for the random data generators.
+ */
+
+#include "utilities/generator.hpp"
+
+#include <catch.hpp>
+
+#include <array>
+
+namespace
+{
+	const std::string UNIT_NAME = "generator_";
+
+	using value_type = std::int32_t;
+	constexpr std::size_t ITERATIONS = 1000;
+	constexpr generators::seed_type SEED = 42;
+}
+
+TEST_CASE( ( UNIT_NAME + "seeded" ).c_str() )
+{
+	std::vector< value_type > first;
+	std::vector< value_type > second;
+
+	generator< value_type >( SEED ).fill_buffer_n( std::back_inserter( first ), ITERATIONS );
+	generator< value_type >( SEED ).fill_buffer_n( std::back_inserter( second ), ITERATIONS );
+
+	REQUIRE( first == second );
+
+	generator< value_type > random;
+	generator< value_type > replay( random.seed() );
+
+	REQUIRE( random() == replay() );
+}
+
+TEST_CASE( ( UNIT_NAME + "copy" ).c_str() )
+{
+	generator< value_type > original( SEED );
+	original();
+
+	auto copy = original;
+
+	REQUIRE( original() == copy() );
+}
+
+TEST_CASE( ( UNIT_NAME + "parallel_fill" ).c_str() )
+{
+	// Spans several chunks, the last one partial.
+	const auto size = 3 * generators::PARALLEL_CHUNK + 17;
+
+	std::vector< value_type > single_thread( size );
+	std::vector< value_type > multi_thread( size );
+
+	const generator< value_type > generator( SEED );
+	generator.fill_buffer_parallel( std::begin( single_thread ), std::end( single_thread ), 1 );
+	generator.fill_buffer_parallel( std::begin( multi_thread ), std::end( multi_thread ), 3 );
+
+	REQUIRE( single_thread == multi_thread );
+}
+
+TEST_CASE( ( UNIT_NAME + "zipf" ).c_str() )
+{
+	constexpr std::uint64_t ELEMENTS = 100;
+
+	zipf_generator< std::uint64_t > generator( SEED, zipf_distribution< std::uint64_t >( ELEMENTS, 1.2 ) );
+
+	std::array< std::size_t, ELEMENTS + 1 > counts {};
+
+	for ( std::size_t iteration = 0; iteration < 100 * ITERATIONS; ++iteration )
+	{
+		const auto rank = generator();
+
+		REQUIRE( rank >= 1 );
+		REQUIRE( rank <= ELEMENTS );
+
+		++counts[ rank ];
+	}
+
+	// Lower ranks are drawn more often.
+	REQUIRE( counts[ 1 ] > counts[ 2 ] );
+	REQUIRE( counts[ 2 ] > counts[ 10 ] );
+	REQUIRE( counts[ 10 ] > counts[ ELEMENTS ] );
+}
+
+TEST_CASE( ( UNIT_NAME + "normal" ).c_str() )
+{
+	normal_generator< double > generator( SEED, std::normal_distribution< double >( 10.0, 2.0 ) );
+
+	double sum = 0.0;
+	for ( std::size_t iteration = 0; iteration < ITERATIONS; ++iteration )
+	{
+		sum += generator();
+	}
+
+	REQUIRE( std::abs( sum / ITERATIONS - 10.0 ) < 0.5 );
+}
+
+TEST_CASE( ( UNIT_NAME + "sorted_with_inversions" ).c_str() )
+{
+	constexpr std::size_t INVERSIONS = 10;
+
+	std::vector< value_type > container( ITERATIONS );
+
+	generator< value_type > generator( SEED );
+	generator.fill_buffer_sorted( std::begin( container ), std::end( container ), INVERSIONS );
+
+	std::size_t inversions = 0;
+	for ( std::size_t first = 0; first < container.size(); ++first )
+	{
+		for ( std::size_t second = first + 1; second < container.size(); ++second )
+		{
+			inversions += ( container[ second ] < container[ first ] ) ? 1 : 0;
+		}
+	}
+
+	REQUIRE( inversions <= INVERSIONS );
+
+	generator.fill_buffer_sorted( std::begin( container ), std::end( container ) );
+
+	REQUIRE( std::is_sorted( std::cbegin( container ), std::cend( container ) ) );
+}
+
+TEST_CASE( ( UNIT_NAME + "strings" ).c_str() )
+{
+	string_generator generator( SEED, 2, 5, "ab" );
+
+	for ( std::size_t iteration = 0; iteration < ITERATIONS; ++iteration )
+	{
+		const auto item = generator();
+
+		REQUIRE( item.size() >= 2 );
+		REQUIRE( item.size() <= 5 );
+		REQUIRE( item.find_first_not_of( "ab" ) == std::string::npos );
+	}
+
+	REQUIRE( string_generator( SEED )() == string_generator( SEED )() );
+}
+
+TEST_CASE( ( UNIT_NAME + "records" ).c_str() )
+{
+	auto generator = make_record_generator(
+		::generator< value_type >( SEED ),
+		string_generator( SEED + 1 ),
+		normal_generator< double >( SEED + 2 ) );
+
+	auto replay = generator;
+
+	std::vector< decltype( generator )::result_type > records;
+	generator.fill_buffer_n( std::back_inserter( records ), ITERATIONS );
+
+	for ( const auto& record : records )
+	{
+		REQUIRE( record == replay() );
+	}
+}
@@ -0,0 +1,120 @@
+/**
+ * Daniel Sebastian Iliescu, http://dansil.net
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ *
+ * Hash Table Unit Tests.
+ */
+
+#include "hashing/hash_table.hpp"
+
+#include "utilities/generator.hpp"
+
+#include <catch.hpp>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+	const std::string UNIT_NAME = "hash_table_";
+
+	using value_type = std::int32_t;
+	constexpr auto ITERATIONS = 10000U;
+}
+
+namespace dsa
+{
+	TEST_CASE( ( UNIT_NAME + "default_constructor" ).c_str() )
+	{
+		HashTable< value_type, value_type > table;
+
+		REQUIRE( table.empty() );
+		REQUIRE( table.find( 0 ) == nullptr );
+		REQUIRE( !table.erase( 0 ) );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "insert_find" ).c_str() )
+	{
+		HashTable< std::string, std::size_t > table;
+
+		REQUIRE( table.try_emplace( "first", 1U ).second );
+		REQUIRE( !table.try_emplace( "first", 2U ).second );
+		REQUIRE( *table.find( "first" ) == 1 );
+
+		REQUIRE( !table.insert_or_assign( "first", 3U ).second );
+		REQUIRE( *table.find( "first" ) == 3 );
+
+		table[ "second" ] = 4;
+
+		REQUIRE( table.size() == 2 );
+		REQUIRE( table.contains( "second" ) );
+		REQUIRE( !table.contains( "third" ) );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "reserve" ).c_str() )
+	{
+		HashTable< value_type, value_type > table( ITERATIONS );
+		const auto capacity = table.capacity();
+
+		for ( value_type key = 0; key < static_cast< value_type >( ITERATIONS ); ++key )
+		{
+			table.try_emplace( key, key );
+		}
+
+		REQUIRE( capacity == table.capacity() );
+		REQUIRE( ( capacity & ( capacity - 1 ) ) == 0 );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "matches_unordered_map" ).c_str() )
+	{
+		// A narrow key range makes inserting existing keys and erasing within clusters frequent.
+		generator< value_type > keys( generators::random_seed(), std::uniform_int_distribution< value_type >( 0, ITERATIONS / 4 ) );
+		generator< value_type > operations( keys.seed() + 1, std::uniform_int_distribution< value_type >( 0, 2 ) );
+
+		HashTable< value_type, value_type > table;
+		std::unordered_map< value_type, value_type > expected;
+
+		for ( value_type iteration = 0; iteration < static_cast< value_type >( ITERATIONS ); ++iteration )
+		{
+			const auto key = keys();
+
+			switch ( operations() )
+			{
+			case 0:
+				REQUIRE( table.try_emplace( key, iteration ).second == expected.try_emplace( key, iteration ).second );
+				break;
+			case 1:
+				table.insert_or_assign( key, iteration );
+				expected.insert_or_assign( key, iteration );
+				break;
+			default:
+				REQUIRE( table.erase( key ) == ( expected.erase( key ) == 1 ) );
+				break;
+			}
+		}
+
+		REQUIRE( table.size() == expected.size() );
+
+		for ( const auto& entry : expected )
+		{
+			REQUIRE( table.find( entry.first ) != nullptr );
+			REQUIRE( *table.find( entry.first ) == entry.second );
+		}
+
+		std::size_t visited = 0;
+
+		table.for_each( [&expected, &visited]( const value_type key, const value_type value )
+		{
+			REQUIRE( expected.at( key ) == value );
+			++visited;
+		} );
+
+		REQUIRE( visited == expected.size() );
+
+		table.clear();
+
+		REQUIRE( table.empty() );
+		REQUIRE( !table.contains( expected.begin()->first ) );
+	}
+}
\ No newline at end of file
@@ -0,0 +1,451 @@
+/**
+ * Daniel Sebastian Iliescu, http://dansil.net
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ *
+ * Heap Unit Tests.
+ */
+
+#include "heaps/d_ary_heap.hpp"
+#include "heaps/pairing_heap.hpp"
+#include "heaps/radix_heap.hpp"
+
+#include "utilities/generator.hpp"
+
+#include <catch.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+	const std::string UNIT_NAME = "heap_";
+
+	using value_type = std::int32_t;
+	constexpr auto ITERATIONS = 10000U;
+
+	using distance_type = std::uint32_t;
+	using vertex_type = std::uint32_t;
+	using graph_type = std::vector< std::vector< std::pair< vertex_type, distance_type > > >;
+
+	constexpr auto UNREACHABLE = std::numeric_limits< distance_type >::max();
+	constexpr vertex_type VERTICES = 500;
+	constexpr std::size_t EDGES = 4000;
+
+	struct pointee_less
+	{
+		bool
+		operator()(
+			const std::unique_ptr< value_type >& lhs,
+			const std::unique_ptr< value_type >& rhs ) const noexcept
+		{
+			return ( *lhs < *rhs );
+		}
+	};
+
+	graph_type
+	random_graph()
+	{
+		generator< vertex_type > vertices( generators::random_seed(), std::uniform_int_distribution< vertex_type >( 0, VERTICES - 1 ) );
+		generator< distance_type > weights( vertices.seed(), std::uniform_int_distribution< distance_type >( 0, 100 ) );
+
+		graph_type graph( VERTICES );
+
+		for ( std::size_t edge = 0; edge < EDGES; ++edge )
+		{
+			const auto from = vertices();
+			graph[ from ].emplace_back( vertices(), weights() );
+		}
+
+		return graph;
+	}
+
+	// Dijkstra's algorithm selecting the closest vertex by a linear scan.
+	std::vector< distance_type >
+	reference_distances( const graph_type& graph )
+	{
+		std::vector< distance_type > distances( graph.size(), UNREACHABLE );
+		std::vector< bool > visited( graph.size(), false );
+
+		distances[ 0 ] = 0;
+
+		while ( true )
+		{
+			auto closest = graph.size();
+
+			for ( std::size_t vertex = 0; vertex < graph.size(); ++vertex )
+			{
+				if ( !visited[ vertex ] && ( distances[ vertex ] != UNREACHABLE ) &&
+					 ( ( closest == graph.size() ) || ( distances[ vertex ] < distances[ closest ] ) ) )
+				{
+					closest = vertex;
+				}
+			}
+
+			if ( closest == graph.size() )
+			{
+				return distances;
+			}
+
+			visited[ closest ] = true;
+
+			for ( const auto& edge : graph[ closest ] )
+			{
+				distances[ edge.first ] = std::min( distances[ edge.first ], distances[ closest ] + edge.second );
+			}
+		}
+	}
+}
+
+namespace dsa
+{
+	TEST_CASE( ( UNIT_NAME + "d_ary_heap_order" ).c_str() )
+	{
+		std::vector< value_type > values( ITERATIONS );
+
+		generator< value_type > generator;
+		generator.fill_buffer( std::begin( values ), std::end( values ) );
+
+		d_ary_heap< value_type > heap;
+
+		REQUIRE( heap.empty() );
+
+		for ( std::size_t index = 0; index < values.size(); ++index )
+		{
+			REQUIRE( heap.push( static_cast< d_ary_heap< value_type >::handle_type >( index ), values[ index ] ) );
+		}
+
+		REQUIRE( !heap.push( 0, 0 ) );
+		REQUIRE( ITERATIONS == heap.size() );
+
+		// Lower every tenth priority, then check that the entries come out sorted.
+		for ( std::size_t index = 0; index < values.size(); index += 10 )
+		{
+			values[ index ] = values[ index ] / 2 - 1000;
+			heap.decrease_key( static_cast< d_ary_heap< value_type >::handle_type >( index ), values[ index ] );
+
+			REQUIRE( heap.priority( static_cast< d_ary_heap< value_type >::handle_type >( index ) ) == values[ index ] );
+		}
+
+		std::vector< value_type > popped;
+
+		while ( !heap.empty() )
+		{
+			const auto entry = heap.pop();
+
+			REQUIRE( entry.priority == values[ entry.handle ] );
+			REQUIRE( !heap.contains( entry.handle ) );
+
+			popped.push_back( entry.priority );
+		}
+
+		std::sort( std::begin( values ), std::end( values ) );
+
+		REQUIRE( popped == values );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "d_ary_heap_clear" ).c_str() )
+	{
+		d_ary_heap< std::string, 2, std::greater< std::string > > heap( 4 );
+
+		heap.push( 3, "c" );
+		heap.push( 1, "a" );
+		heap.push( 10, "j" );
+
+		REQUIRE( heap.top().handle == 10 );
+		REQUIRE( !heap.push_or_decrease( 3, "b" ) );
+		REQUIRE( heap.push_or_decrease( 3, "z" ) );
+		REQUIRE( heap.top().priority == "z" );
+
+		heap.clear();
+
+		REQUIRE( heap.empty() );
+		REQUIRE( !heap.contains( 3 ) );
+		REQUIRE( heap.push( 3, "c" ) );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "d_ary_heap_move" ).c_str() )
+	{
+		d_ary_heap< value_type > heap;
+
+		heap.push( 0, 5 );
+		heap.push( 1, 3 );
+
+		auto moved( std::move( heap ) );
+
+		// A moved-from heap must still be a usable empty heap.
+		REQUIRE( heap.empty() );
+		REQUIRE( heap.size() == 0 );
+		REQUIRE( !heap.contains( 0 ) );
+		REQUIRE( heap.push( 1, 7 ) );
+		REQUIRE( heap.top().priority == 7 );
+
+		REQUIRE( moved.size() == 2 );
+		REQUIRE( moved.top().handle == 1 );
+
+		heap = std::move( moved );
+
+		REQUIRE( moved.empty() );
+		REQUIRE( !moved.contains( 1 ) );
+		REQUIRE( moved.push( 0, 1 ) );
+		REQUIRE( moved.size() == 1 );
+
+		REQUIRE( heap.size() == 2 );
+		REQUIRE( heap.pop().priority == 3 );
+		REQUIRE( heap.pop().priority == 5 );
+		REQUIRE( heap.empty() );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "radix_heap_move" ).c_str() )
+	{
+		radix_heap< std::uint64_t, std::uint64_t > heap;
+
+		heap.push( 5, 0 );
+		heap.push( 3, 1 );
+		heap.pop();
+
+		auto moved( std::move( heap ) );
+
+		// A moved-from heap must still be a usable empty heap, accepting any key again.
+		REQUIRE( heap.empty() );
+		REQUIRE( heap.size() == 0 );
+		REQUIRE( heap.last_key() == 0 );
+
+		heap.push( 1, 2 );
+
+		REQUIRE( heap.pop().second == 2 );
+		REQUIRE( heap.empty() );
+
+		REQUIRE( moved.size() == 1 );
+		REQUIRE( moved.last_key() == 3 );
+
+		heap = std::move( moved );
+
+		REQUIRE( moved.empty() );
+		REQUIRE( moved.last_key() == 0 );
+
+		moved.push( 1, 3 );
+
+		REQUIRE( moved.pop().second == 3 );
+
+		REQUIRE( heap.size() == 1 );
+		REQUIRE( heap.pop().second == 0 );
+		REQUIRE( heap.empty() );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "pairing_heap_order" ).c_str() )
+	{
+		std::vector< value_type > values( ITERATIONS );
+
+		generator< value_type > generator;
+		generator.fill_buffer( std::begin( values ), std::end( values ) );
+
+		pairing_heap< value_type > heap;
+		std::vector< pairing_heap< value_type >::handle > handles;
+
+		for ( const auto value : values )
+		{
+			handles.push_back( heap.push( value ) );
+		}
+
+		for ( std::size_t index = 0; index < values.size(); index += 10 )
+		{
+			values[ index ] = values[ index ] / 2 - 1000;
+			heap.decrease_key( handles[ index ], values[ index ] );
+
+			REQUIRE( *handles[ index ] == values[ index ] );
+		}
+
+		std::sort( std::begin( values ), std::end( values ) );
+
+		// Pop half of the elements, so that the remaining half is destroyed by the heap.
+		for ( std::size_t index = 0; index < values.size() / 2; ++index )
+		{
+			REQUIRE( heap.top() == values[ index ] );
+			REQUIRE( heap.pop() == values[ index ] );
+		}
+
+		REQUIRE( values.size() - values.size() / 2 == heap.size() );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "pairing_heap_meld" ).c_str() )
+	{
+		pairing_heap< std::unique_ptr< value_type >, pointee_less > first;
+		pairing_heap< std::unique_ptr< value_type >, pointee_less > second;
+
+		for ( value_type item = 0; item < 100; ++item )
+		{
+			first.push( std::make_unique< value_type >( 2 * item ) );
+			second.push( std::make_unique< value_type >( 2 * item + 1 ) );
+		}
+
+		const auto handle = second.push( std::make_unique< value_type >( 500 ) );
+
+		first.meld( second );
+
+		REQUIRE( second.empty() );
+		REQUIRE( 201 == first.size() );
+
+		first.decrease_key( handle, std::make_unique< value_type >( -1 ) );
+
+		REQUIRE( *first.pop() == -1 );
+
+		for ( value_type item = 0; item < 200; ++item )
+		{
+			REQUIRE( *first.pop() == item );
+		}
+
+		REQUIRE( first.empty() );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "radix_heap_order" ).c_str() )
+	{
+		generator< std::uint64_t > generator;
+		radix_heap< std::uint64_t, std::uint64_t > heap;
+
+		std::vector< std::uint64_t > keys;
+
+		for ( std::size_t index = 0; index < ITERATIONS; ++index )
+		{
+			const auto key = generator();
+
+			keys.push_back( key );
+			heap.push( key, ~key );
+		}
+
+		std::sort( std::begin( keys ), std::end( keys ) );
+
+		// Interleave monotone pushes with the pops: the key popped last may be pushed again.
+		for ( std::size_t index = 0; index < ITERATIONS / 2; ++index )
+		{
+			REQUIRE( heap.top().first == keys[ index ] );
+
+			const auto entry = heap.pop();
+
+			REQUIRE( entry.first == keys[ index ] );
+			REQUIRE( entry.second == ~keys[ index ] );
+			REQUIRE( heap.last_key() <= entry.first );
+
+			heap.push( entry.first, entry.second );
+			heap.pop();
+		}
+
+		REQUIRE( ITERATIONS - ITERATIONS / 2 == heap.size() );
+
+		heap.clear();
+
+		REQUIRE( heap.empty() );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "shortest_paths" ).c_str() )
+	{
+		const auto graph = random_graph();
+		const auto expected = reference_distances( graph );
+
+		// The d-ary heap lowers the priority of a vertex in place.
+		{
+			std::vector< distance_type > distances( VERTICES, UNREACHABLE );
+			d_ary_heap< distance_type > heap( VERTICES );
+
+			distances[ 0 ] = 0;
+			heap.push( 0, 0 );
+
+			while ( !heap.empty() )
+			{
+				const auto closest = heap.pop();
+
+				for ( const auto& edge : graph[ closest.handle ] )
+				{
+					const auto distance = closest.priority + edge.second;
+
+					if ( distance < distances[ edge.first ] )
+					{
+						distances[ edge.first ] = distance;
+						heap.push_or_decrease( edge.first, distance );
+					}
+				}
+			}
+
+			REQUIRE( distances == expected );
+		}
+
+		// The pairing heap does the same through the handles of the vertices.
+		{
+			using entry_type = std::pair< distance_type, vertex_type >;
+
+			std::vector< distance_type > distances( VERTICES, UNREACHABLE );
+			std::vector< pairing_heap< entry_type >::handle > handles( VERTICES );
+			std::vector< bool > queued( VERTICES, false );
+			pairing_heap< entry_type > heap;
+
+			distances[ 0 ] = 0;
+			handles[ 0 ] = heap.push( entry_type( 0, 0 ) );
+			queued[ 0 ] = true;
+
+			while ( !heap.empty() )
+			{
+				const auto closest = heap.pop();
+				queued[ closest.second ] = false;
+
+				for ( const auto& edge : graph[ closest.second ] )
+				{
+					const auto distance = closest.first + edge.second;
+
+					if ( distance < distances[ edge.first ] )
+					{
+						distances[ edge.first ] = distance;
+
+						if ( queued[ edge.first ] )
+						{
+							heap.decrease_key( handles[ edge.first ], entry_type( distance, edge.first ) );
+						}
+						else
+						{
+							handles[ edge.first ] = heap.push( entry_type( distance, edge.first ) );
+							queued[ edge.first ] = true;
+						}
+					}
+				}
+			}
+
+			REQUIRE( distances == expected );
+		}
+
+		// The radix heap has no decrease_key, so outdated entries are skipped when popped.
+		{
+			std::vector< distance_type > distances( VERTICES, UNREACHABLE );
+			radix_heap< distance_type, vertex_type > heap;
+
+			distances[ 0 ] = 0;
+			heap.push( 0, 0 );
+
+			while ( !heap.empty() )
+			{
+				const auto closest = heap.pop();
+
+				if ( closest.first != distances[ closest.second ] )
+				{
+					continue;
+				}
+
+				for ( const auto& edge : graph[ closest.second ] )
+				{
+					const auto distance = closest.first + edge.second;
+
+					if ( distance < distances[ edge.first ] )
+					{
+						distances[ edge.first ] = distance;
+						heap.push( distance, edge.first );
+					}
+				}
+			}
+
+			REQUIRE( distances == expected );
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,276 @@
+/**
+ * Daniel Sebastian Iliescu, http://dansil.net
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ *
+ * Intrusive List Unit Tests.
+ */
+
+#include "lists/intrusive_list.hpp"
+
+#include "utilities/generator.hpp"
+
+#include <catch.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+	const std::string UNIT_NAME = "intrusive_list_";
+
+	using value_type = std::int32_t;
+	constexpr auto ITERATIONS = 1000U;
+
+	// An object which can be on two lists at once.
+	struct entry
+	{
+		value_type value = value_type();
+
+		dsa::intrusive_list_hook lru;
+		dsa::intrusive_list_hook dirty;
+	};
+
+	using lru_list = dsa::intrusive_list< entry, &entry::lru >;
+	using dirty_list = dsa::intrusive_list< entry, &entry::dirty >;
+
+	// An object which is not standard-layout, with its hook after a vtable pointer and a string.
+	class polymorphic_entry
+	{
+	public:
+		explicit polymorphic_entry( std::string input_name ) :
+			name( std::move( input_name ) )
+		{
+		}
+
+		virtual ~polymorphic_entry() = default;
+
+		std::string name;
+		dsa::intrusive_list_hook hook;
+	};
+
+	using polymorphic_list = dsa::intrusive_list< polymorphic_entry, &polymorphic_entry::hook >;
+
+	template < typename List >
+	std::vector< value_type >
+	values( const List& list )
+	{
+		std::vector< value_type > result;
+
+		for ( const auto& item : list )
+		{
+			result.push_back( item.value );
+		}
+
+		return result;
+	}
+}
+
+namespace dsa
+{
+	TEST_CASE( ( UNIT_NAME + "default_constructor" ).c_str() )
+	{
+		lru_list list;
+
+		REQUIRE( list.empty() );
+		REQUIRE( list.cbegin() == list.cend() );
+		REQUIRE( list.pop_front() == nullptr );
+		REQUIRE( list.pop_back() == nullptr );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "push_pop" ).c_str() )
+	{
+		std::vector< entry > entries( ITERATIONS );
+
+		generator< value_type > generator;
+
+		for ( auto& item : entries )
+		{
+			item.value = generator();
+		}
+
+		lru_list list;
+
+		for ( auto& item : entries )
+		{
+			list.push_back( item );
+		}
+
+		REQUIRE( ITERATIONS == list.size() );
+		REQUIRE( &list.front() == &entries.front() );
+		REQUIRE( &list.back() == &entries.back() );
+
+		for ( auto& item : entries )
+		{
+			REQUIRE( list.pop_front() == &item );
+			REQUIRE( !item.lru.is_linked() );
+		}
+
+		for ( auto& item : entries )
+		{
+			list.push_front( item );
+		}
+
+		for ( auto& item : entries )
+		{
+			REQUIRE( list.pop_back() == &item );
+		}
+
+		REQUIRE( list.empty() );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "iterators" ).c_str() )
+	{
+		std::vector< entry > entries( ITERATIONS );
+
+		lru_list list;
+
+		for ( std::size_t index = 0; index < entries.size(); ++index )
+		{
+			entries[ index ].value = static_cast< value_type >( index );
+			list.push_back( entries[ index ] );
+		}
+
+		REQUIRE(
+			std::equal(
+				std::cbegin( entries ),
+				std::cend( entries ),
+				std::cbegin( list ),
+				std::cend( list ),
+				[]( const entry& first, const entry& second )
+				{
+					return &first == &second;
+				} ) );
+
+		REQUIRE(
+			std::equal(
+				std::crbegin( entries ),
+				std::crend( entries ),
+				std::crbegin( list ),
+				std::crend( list ),
+				[]( const entry& first, const entry& second )
+				{
+					return &first == &second;
+				} ) );
+
+		REQUIRE( lru_list::iterator_to( entries[ 10 ] )->value == 10 );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "several_lists" ).c_str() )
+	{
+		std::vector< entry > entries( 6 );
+
+		lru_list lru;
+		dirty_list dirty;
+
+		for ( std::size_t index = 0; index < entries.size(); ++index )
+		{
+			entries[ index ].value = static_cast< value_type >( index );
+
+			lru.push_back( entries[ index ] );
+
+			if ( index % 2 == 0 )
+			{
+				dirty.push_front( entries[ index ] );
+			}
+		}
+
+		REQUIRE( ( values( lru ) == std::vector< value_type > { 0, 1, 2, 3, 4, 5 } ) );
+		REQUIRE( ( values( dirty ) == std::vector< value_type > { 4, 2, 0 } ) );
+
+		// Touch an entry: move it to the back of the LRU list without affecting the dirty list.
+		lru.splice( lru.cend(), lru, lru_list::iterator_to( entries[ 2 ] ) );
+
+		// Clean an entry and evict another from the middle, given only the objects.
+		dirty.erase( entries[ 4 ] );
+		lru.erase( entries[ 3 ] );
+
+		REQUIRE( ( values( lru ) == std::vector< value_type > { 0, 1, 4, 5, 2 } ) );
+		REQUIRE( ( values( dirty ) == std::vector< value_type > { 2, 0 } ) );
+		REQUIRE( !entries[ 3 ].lru.is_linked() );
+		REQUIRE( !entries[ 4 ].dirty.is_linked() );
+		REQUIRE( entries[ 4 ].lru.is_linked() );
+		REQUIRE( entries[ 0 ].dirty.is_linked() );
+
+		// A copy of an entry belongs to no list.
+		const auto copy = entries[ 0 ];
+
+		REQUIRE( !copy.lru.is_linked() );
+		REQUIRE( !copy.dirty.is_linked() );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "splice_move_clear" ).c_str() )
+	{
+		std::vector< entry > entries( 8 );
+
+		lru_list first;
+		lru_list second;
+
+		for ( std::size_t index = 0; index < entries.size(); ++index )
+		{
+			entries[ index ].value = static_cast< value_type >( index );
+
+			( ( index < 4 ) ? first : second ).push_back( entries[ index ] );
+		}
+
+		first.splice( std::next( first.cbegin() ), second );
+
+		REQUIRE( second.empty() );
+		REQUIRE( ( values( first ) == std::vector< value_type > { 0, 4, 5, 6, 7, 1, 2, 3 } ) );
+
+		second.splice( second.cend(), first, first.cbegin() );
+
+		REQUIRE( 7 == first.size() );
+		REQUIRE( ( values( second ) == std::vector< value_type > { 0 } ) );
+
+		auto moved( std::move( first ) );
+
+		REQUIRE( first.empty() );
+		REQUIRE( 7 == moved.size() );
+		REQUIRE( ( values( moved ) == std::vector< value_type > { 4, 5, 6, 7, 1, 2, 3 } ) );
+
+		moved.clear();
+
+		REQUIRE( moved.empty() );
+		REQUIRE(
+			std::none_of(
+				std::cbegin( entries ) + 1,
+				std::cend( entries ),
+				[]( const entry& item )
+				{
+					return item.lru.is_linked();
+				} ) );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "non_standard_layout" ).c_str() )
+	{
+		std::vector< polymorphic_entry > entries;
+		for ( std::size_t index = 0; index < 10; ++index )
+		{
+			entries.emplace_back( std::to_string( index ) );
+		}
+
+		polymorphic_list list;
+		for ( auto& item : entries )
+		{
+			list.push_front( item );
+		}
+
+		REQUIRE( &list.front() == &entries.back() );
+		REQUIRE( &list.back() == &entries.front() );
+
+		auto expected = entries.crbegin();
+		for ( const auto& item : list )
+		{
+			REQUIRE( &item == &*expected );
+			REQUIRE( item.name == expected->name );
+
+			++expected;
+		}
+
+		REQUIRE( list.pop_back() == &entries.front() );
+		REQUIRE( polymorphic_list::iterator_to( entries[ 5 ] )->name == "5" );
+	}
+}
\ No newline at end of file
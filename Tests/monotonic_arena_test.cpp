@@ -0,0 +1,476 @@
+/**
+ * Daniel Sebastian Iliescu, http://dansil.net
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ *
+ * Monotonic Arena Unit Tests.
+ */
+
+#include "memory/monotonic_arena.hpp"
+#include "caches/lfu_cache.hpp"
+#include "caches/lru_cache.hpp"
+#include "hashing/hash_table.hpp"
+#include "heaps/d_ary_heap.hpp"
+#include "heaps/pairing_heap.hpp"
+#include "heaps/radix_heap.hpp"
+#include "lists/doubly_linked_list.hpp"
+#include "lists/persistent_list.hpp"
+#include "lists/segmented_deque.hpp"
+#include "lists/skip_list.hpp"
+#include "lists/unrolled_list.hpp"
+#include "trees/binary_search_tree.hpp"
+#include "trees/persistent_map.hpp"
+
+#include "utilities/generator.hpp"
+
+#include <catch.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory_resource>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+	const std::string UNIT_NAME = "monotonic_arena_";
+
+	using value_type = std::int32_t;
+	constexpr std::size_t CHUNK_BYTES = 256;
+	constexpr auto ITERATIONS = 1000U;
+
+	// Memory resource counting the allocations it forwards to the default resource.
+	class counting_resource : public std::pmr::memory_resource
+	{
+	public:
+		std::size_t allocations = 0;
+		std::size_t deallocations = 0;
+
+	private:
+		void*
+		do_allocate(
+			const std::size_t bytes,
+			const std::size_t alignment ) override
+		{
+			++( this->allocations );
+
+			return std::pmr::get_default_resource()->allocate( bytes, alignment );
+		}
+
+		void
+		do_deallocate(
+			void* const memory,
+			const std::size_t bytes,
+			const std::size_t alignment ) override
+		{
+			++( this->deallocations );
+
+			std::pmr::get_default_resource()->deallocate( memory, bytes, alignment );
+		}
+
+		bool
+		do_is_equal( const std::pmr::memory_resource& other ) const noexcept override
+		{
+			return ( this == &other );
+		}
+	};
+}
+
+namespace dsa
+{
+	TEST_CASE( ( UNIT_NAME + "allocate_aligned" ).c_str() )
+	{
+		monotonic_arena arena( CHUNK_BYTES );
+
+		REQUIRE( arena.chunks() == 0 );
+
+		std::vector< std::pair< unsigned char*, std::size_t > > blocks;
+		for ( std::size_t iteration = 0; iteration < ITERATIONS; ++iteration )
+		{
+			const auto bytes = iteration % 100 + 1;
+			const auto alignment = std::size_t( 1 ) << ( iteration % 7 );
+
+			const auto memory = static_cast< unsigned char* >( arena.allocate( bytes, alignment ) );
+
+			REQUIRE( reinterpret_cast< std::uintptr_t >( memory ) % alignment == 0 );
+
+			std::fill( memory, memory + bytes, static_cast< unsigned char >( iteration ) );
+			blocks.emplace_back( memory, bytes );
+		}
+
+		// Every block kept its contents, so none of them overlap.
+		for ( std::size_t iteration = 0; iteration < ITERATIONS; ++iteration )
+		{
+			const auto [ memory, bytes ] = blocks[ iteration ];
+
+			REQUIRE( std::count( memory, memory + bytes, static_cast< unsigned char >( iteration ) ) == static_cast< std::ptrdiff_t >( bytes ) );
+		}
+
+		// Chunks double in size, so their number grows logarithmically.
+		REQUIRE( arena.chunks() > 1 );
+		REQUIRE( arena.chunks() < 16 );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "large_allocation" ).c_str() )
+	{
+		monotonic_arena arena( CHUNK_BYTES );
+
+		const auto memory = static_cast< unsigned char* >( arena.allocate( 16 * CHUNK_BYTES, 64 ) );
+		std::fill( memory, memory + 16 * CHUNK_BYTES, 0 );
+
+		REQUIRE( reinterpret_cast< std::uintptr_t >( memory ) % 64 == 0 );
+		REQUIRE( arena.chunks() == 1 );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "release" ).c_str() )
+	{
+		counting_resource upstream;
+
+		{
+			monotonic_arena arena( CHUNK_BYTES, &upstream );
+
+			for ( std::size_t iteration = 0; iteration < ITERATIONS; ++iteration )
+			{
+				arena.deallocate( arena.allocate( sizeof( value_type ), alignof( value_type ) ), sizeof( value_type ) );
+			}
+
+			const auto chunks = arena.chunks();
+
+			REQUIRE( upstream.allocations == chunks );
+			REQUIRE( upstream.deallocations == 0 );
+
+			arena.release();
+
+			REQUIRE( arena.chunks() == 0 );
+			REQUIRE( upstream.deallocations == chunks );
+
+			arena.allocate( sizeof( value_type ) );
+		}
+
+		REQUIRE( upstream.allocations == upstream.deallocations );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "initial_buffer" ).c_str() )
+	{
+		alignas( std::max_align_t ) std::array< unsigned char, CHUNK_BYTES > buffer;
+		monotonic_arena arena( buffer.data(), buffer.size() );
+
+		const auto memory = static_cast< unsigned char* >( arena.allocate( CHUNK_BYTES / 2 ) );
+
+		REQUIRE( memory == buffer.data() );
+		REQUIRE( arena.chunks() == 0 );
+
+		arena.allocate( CHUNK_BYTES );
+
+		REQUIRE( arena.chunks() == 1 );
+
+		// The buffer is served again once the arena is released.
+		arena.release();
+
+		REQUIRE( arena.allocate( 1 ) == buffer.data() );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "doubly_linked_list" ).c_str() )
+	{
+		monotonic_arena arena( CHUNK_BYTES );
+
+		std::vector< value_type > values;
+		generator< value_type >().fill_buffer_n( std::back_inserter( values ), ITERATIONS );
+
+		doubly_linked_list< value_type, arena_allocator< value_type > > list( values.cbegin(), values.cend(), arena );
+
+		REQUIRE( list.get_allocator().resource() == &arena );
+
+		// Copies draw from the same arena, and containers sharing it exchange their nodes.
+		auto copy = list;
+		doubly_linked_list< value_type, arena_allocator< value_type > > moved( arena );
+		moved = std::move( list );
+
+		REQUIRE( copy.get_allocator() == moved.get_allocator() );
+		REQUIRE( copy == moved );
+		REQUIRE( std::equal( values.cbegin(), values.cend(), moved.cbegin(), moved.cend() ) );
+
+		swap( copy, list );
+
+		REQUIRE( copy.empty() );
+		REQUIRE( list == moved );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "unrolled_list_segmented_deque" ).c_str() )
+	{
+		monotonic_arena arena( CHUNK_BYTES );
+
+		unrolled_list< std::string, 4, arena_allocator< std::string > > list( arena );
+		segmented_deque< std::string, 4, arena_allocator< std::string > > deque( arena );
+
+		for ( std::size_t iteration = 0; iteration < ITERATIONS; ++iteration )
+		{
+			list.push_back( std::to_string( iteration ) );
+			deque.push_front( std::to_string( iteration ) );
+		}
+
+		const auto list_copy = list;
+		const auto deque_copy = deque;
+
+		REQUIRE( list_copy == list );
+		REQUIRE( deque_copy == deque );
+		REQUIRE( std::equal( list.cbegin(), list.cend(), deque.crbegin(), deque.crend() ) );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "pairing_heap" ).c_str() )
+	{
+		monotonic_arena arena( CHUNK_BYTES );
+
+		std::vector< value_type > values;
+		generator< value_type >().fill_buffer_n( std::back_inserter( values ), ITERATIONS );
+
+		pairing_heap< value_type, std::less< value_type >, arena_allocator< value_type > > heap( arena );
+
+		for ( const auto value : values )
+		{
+			heap.push( value );
+		}
+
+		std::sort( values.begin(), values.end() );
+
+		for ( const auto value : values )
+		{
+			REQUIRE( heap.pop() == value );
+		}
+	}
+
+	TEST_CASE( ( UNIT_NAME + "binary_search_tree" ).c_str() )
+	{
+		monotonic_arena arena( CHUNK_BYTES );
+
+		std::vector< value_type > keys;
+		generator< value_type >().fill_buffer_n( std::back_inserter( keys ), ITERATIONS );
+
+		binary_search_tree< value_type, value_type, arena_allocator< value_type > > bst( arena );
+
+		for ( const auto key : keys )
+		{
+			bst.insert( key, key );
+		}
+
+		auto copy = bst;
+
+		for ( const auto key : keys )
+		{
+			bst.erase( key );
+
+			REQUIRE( copy.contains( key ) );
+		}
+
+		REQUIRE( bst.empty() );
+		REQUIRE( copy.calculated_size() == copy.size() );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "polymorphic_allocator" ).c_str() )
+	{
+		monotonic_arena arena( CHUNK_BYTES );
+		counting_resource other_resource;
+
+		using list_type = doubly_linked_list< std::string, std::pmr::polymorphic_allocator< std::string > >;
+
+		list_type list( &arena );
+		list_type other( &other_resource );
+
+		for ( std::size_t iteration = 0; iteration < ITERATIONS; ++iteration )
+		{
+			list.push_back( std::to_string( iteration ) );
+		}
+
+		// Polymorphic allocators stay with their container, so the elements are copied or moved into its own nodes.
+		other = list;
+
+		REQUIRE( other == list );
+		REQUIRE( other.get_allocator().resource() == &other_resource );
+		REQUIRE( other_resource.allocations == ITERATIONS );
+
+		const auto copy = list;
+		other = std::move( list );
+
+		REQUIRE( other == copy );
+		REQUIRE( list.empty() );
+		REQUIRE( other_resource.allocations == 2 * ITERATIONS );
+
+		// The copy constructed list takes the default resource, as the standard containers do.
+		REQUIRE( copy.get_allocator().resource() == std::pmr::get_default_resource() );
+
+		binary_search_tree< value_type, value_type, std::pmr::polymorphic_allocator< value_type > > bst( &arena );
+		binary_search_tree< value_type, value_type, std::pmr::polymorphic_allocator< value_type > > other_bst( &other_resource );
+
+		bst.insert( 1, 1 );
+		other_bst = std::move( bst );
+
+		REQUIRE( other_bst.contains( 1 ) );
+		REQUIRE( other_bst.get_allocator().resource() == &other_resource );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "hash_table_caches" ).c_str() )
+	{
+		counting_resource resource;
+
+		{
+			monotonic_arena arena( CHUNK_BYTES, &resource );
+
+			HashTable< value_type, value_type, std::hash< value_type >, std::equal_to< value_type >, arena_allocator< value_type > > table( arena );
+
+			for ( value_type key = 0; key < static_cast< value_type >( ITERATIONS ); ++key )
+			{
+				table.try_emplace( key, key );
+			}
+
+			REQUIRE( table.get_allocator().resource() == &arena );
+			REQUIRE( resource.allocations == arena.chunks() );
+			REQUIRE( *table.find( 7 ) == 7 );
+
+			using allocator_type = std::pmr::polymorphic_allocator< value_type >;
+
+			lru_cache< value_type, std::string, entry_count_weigher, std::hash< value_type >, std::equal_to< value_type >, allocator_type > lru( 16, {}, &arena );
+			lfu_cache< value_type, std::string, entry_count_weigher, std::hash< value_type >, std::equal_to< value_type >, allocator_type > lfu( 16, {}, &arena );
+
+			const auto chunks = arena.chunks();
+
+			for ( value_type key = 0; key < static_cast< value_type >( ITERATIONS ); ++key )
+			{
+				lru.put( key, std::to_string( key ) );
+				lfu.put( key, std::to_string( key ) );
+			}
+
+			REQUIRE( arena.chunks() > chunks );
+			REQUIRE( resource.allocations == arena.chunks() );
+			REQUIRE( lru.size() == 16 );
+			REQUIRE( lfu.size() == 16 );
+			REQUIRE( *lru.get( ITERATIONS - 1 ) == std::to_string( ITERATIONS - 1 ) );
+			REQUIRE( *lfu.get( ITERATIONS - 1 ) == std::to_string( ITERATIONS - 1 ) );
+		}
+
+		REQUIRE( resource.allocations == resource.deallocations );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "d_ary_radix_heap" ).c_str() )
+	{
+		monotonic_arena arena( CHUNK_BYTES );
+		counting_resource other_resource;
+
+		std::vector< value_type > values;
+		generator< value_type >().fill_buffer_n( std::back_inserter( values ), ITERATIONS );
+
+		using d_ary_type = d_ary_heap< value_type, 4, std::less< value_type >, std::pmr::polymorphic_allocator< value_type > >;
+		using radix_type = radix_heap< std::uint32_t, value_type, std::pmr::polymorphic_allocator< value_type > >;
+
+		d_ary_type heap( ITERATIONS, {}, &arena );
+		radix_type radix( &arena );
+
+		for ( std::size_t index = 0; index < values.size(); ++index )
+		{
+			heap.push( static_cast< d_ary_type::handle_type >( index ), values[ index ] );
+			radix.push( static_cast< std::uint32_t >( values[ index ] ) - static_cast< std::uint32_t >( std::numeric_limits< value_type >::min() ), values[ index ] );
+		}
+
+		REQUIRE( arena.chunks() > 0 );
+
+		// The allocators differ, so the entries are moved into the storage of the target.
+		d_ary_type other_heap( &other_resource );
+		other_heap = std::move( heap );
+
+		REQUIRE( heap.empty() );
+		REQUIRE( other_heap.get_allocator().resource() == &other_resource );
+		REQUIRE( other_resource.allocations > 0 );
+
+		std::sort( values.begin(), values.end() );
+
+		for ( const auto value : values )
+		{
+			REQUIRE( other_heap.top().priority == value );
+			REQUIRE( radix.pop().second == value );
+
+			other_heap.pop();
+		}
+	}
+
+	TEST_CASE( ( UNIT_NAME + "skip_list" ).c_str() )
+	{
+		counting_resource resource;
+
+		{
+			skip_list< value_type, std::string, std::less< value_type >, false, std::pmr::polymorphic_allocator< value_type > > list( &resource );
+			concurrent_skip_list< value_type, std::string, std::less< value_type >, std::pmr::polymorphic_allocator< value_type > > concurrent_list( &resource );
+
+			for ( value_type key = 0; key < static_cast< value_type >( ITERATIONS ); ++key )
+			{
+				list.try_emplace( key, std::to_string( key ) );
+				concurrent_list.try_emplace( key, std::to_string( key ) );
+			}
+
+			REQUIRE( resource.allocations == 2 * ITERATIONS );
+
+			for ( value_type key = 0; key < static_cast< value_type >( ITERATIONS ); key += 2 )
+			{
+				REQUIRE( list.erase( key ) );
+			}
+
+			REQUIRE( resource.deallocations == ITERATIONS / 2 );
+			REQUIRE( list.find( 1 )->second == "1" );
+			REQUIRE( concurrent_list.find( 0 )->second == "0" );
+		}
+
+		REQUIRE( resource.allocations == resource.deallocations );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "persistent_list_map" ).c_str() )
+	{
+		counting_resource resource;
+		counting_resource other_resource;
+
+		{
+			using list_type = persistent_list< value_type, std::pmr::polymorphic_allocator< value_type > >;
+			using map_type = persistent_map< value_type, value_type, std::less< value_type >, std::pmr::polymorphic_allocator< value_type > >;
+
+			list_type list( &resource );
+			map_type map( &resource );
+
+			for ( value_type value = 0; value < static_cast< value_type >( ITERATIONS ); ++value )
+			{
+				list = list.push_back( value );
+				map = map.insert( value, value );
+			}
+
+			REQUIRE( resource.allocations > 0 );
+
+			// Versions share their nodes across allocators, each node being released through its own.
+			list_type other_list( &other_resource );
+			map_type other_map( &other_resource );
+
+			other_list = list.pop_front();
+			other_map = map.erase( 0 );
+
+			REQUIRE( other_list.get_allocator().resource() == &other_resource );
+			REQUIRE( other_map.get_allocator().resource() == &other_resource );
+			REQUIRE( other_resource.allocations == 0 );
+
+			list = list_type( &resource );
+			map = map_type( &resource );
+
+			REQUIRE( other_list.size() == ITERATIONS - 1 );
+			REQUIRE( other_list.front() == 1 );
+			REQUIRE( other_map.size() == ITERATIONS - 1 );
+			REQUIRE( !other_map.contains( 0 ) );
+			REQUIRE( other_map.contains( 1 ) );
+
+			other_list = other_list.push_back( -1 );
+			other_map = other_map.insert( -1, -1 );
+
+			REQUIRE( other_resource.allocations > 0 );
+		}
+
+		REQUIRE( resource.allocations == resource.deallocations );
+		REQUIRE( other_resource.allocations == other_resource.deallocations );
+	}
+}
\ No newline at end of file
@@ -0,0 +1,170 @@
+/**
+ * Daniel Sebastian Iliescu, http://dansil.net
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ *
+ * MultiQueue Unit Tests.
+ */
+
+#include "heaps/multiqueue.hpp"
+
+#include "utilities/generator.hpp"
+
+#include <catch.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	const std::string UNIT_NAME = "multiqueue_";
+
+	using value_type = std::int32_t;
+	constexpr auto ITERATIONS = 10000U;
+	constexpr std::size_t THREADS = 4;
+}
+
+namespace dsa
+{
+	TEST_CASE( ( UNIT_NAME + "default_constructor" ).c_str() )
+	{
+		multiqueue< value_type > queue;
+		value_type item = 0;
+
+		REQUIRE( queue.empty() );
+		REQUIRE( queue.queue_count() >= 2 );
+		REQUIRE( !queue.pop( item ) );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "relaxed_order" ).c_str() )
+	{
+		std::vector< value_type > values( ITERATIONS );
+
+		generator< value_type > generator;
+		generator.fill_buffer( std::begin( values ), std::end( values ) );
+
+		multiqueue< value_type > queue( THREADS );
+
+		for ( const auto value : values )
+		{
+			queue.push( value );
+		}
+
+		REQUIRE( ITERATIONS == queue.size() );
+
+		std::multiset< value_type > remaining( std::cbegin( values ), std::cend( values ) );
+		std::size_t total_rank = 0;
+		value_type item = 0;
+
+		// Every popped element is among the smallest remaining ones, up to the relaxation.
+		while ( queue.pop( item ) )
+		{
+			const auto position = remaining.find( item );
+
+			REQUIRE( position != std::end( remaining ) );
+
+			total_rank += static_cast< std::size_t >( std::distance( std::begin( remaining ), position ) );
+			remaining.erase( position );
+		}
+
+		REQUIRE( remaining.empty() );
+		REQUIRE( queue.empty() );
+		REQUIRE( total_rank / ITERATIONS <= 4 * queue.queue_count() );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "move_only" ).c_str() )
+	{
+		multiqueue< std::unique_ptr< value_type >, std::function< bool( const std::unique_ptr< value_type >&, const std::unique_ptr< value_type >& ) > > queue(
+			1,
+			1,
+			[]( const std::unique_ptr< value_type >& lhs, const std::unique_ptr< value_type >& rhs )
+			{
+				return ( *lhs < *rhs );
+			} );
+
+		for ( value_type item = 0; item < 100; ++item )
+		{
+			queue.push( std::make_unique< value_type >( item ) );
+		}
+
+		std::unique_ptr< value_type > item;
+		value_type sum = 0;
+
+		while ( queue.pop( item ) )
+		{
+			sum += *item;
+		}
+
+		REQUIRE( sum == 99 * 100 / 2 );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "producers_consumers" ).c_str() )
+	{
+		multiqueue< value_type > queue( 2 * THREADS );
+
+		std::atomic< std::size_t > producers_done { 0 };
+		std::vector< std::vector< value_type > > consumed( THREADS );
+		std::vector< std::thread > threads;
+
+		for ( std::size_t thread = 0; thread < THREADS; ++thread )
+		{
+			threads.emplace_back( [&queue, &producers_done, thread]()
+			{
+				for ( std::size_t item = thread; item < THREADS * ITERATIONS; item += THREADS )
+				{
+					queue.push( static_cast< value_type >( item ) );
+				}
+
+				++producers_done;
+			} );
+
+			threads.emplace_back( [&queue, &producers_done, &consumed, thread]()
+			{
+				value_type item = 0;
+
+				while ( true )
+				{
+					// Read before popping: an empty queue after every producer finished is final.
+					const auto done = ( producers_done.load() == THREADS );
+
+					if ( queue.pop( item ) )
+					{
+						consumed[ thread ].push_back( item );
+					}
+					else if ( done )
+					{
+						break;
+					}
+				}
+			} );
+		}
+
+		for ( auto& thread : threads )
+		{
+			thread.join();
+		}
+
+		std::vector< value_type > all;
+
+		for ( const auto& items : consumed )
+		{
+			all.insert( std::end( all ), std::cbegin( items ), std::cend( items ) );
+		}
+
+		std::sort( std::begin( all ), std::end( all ) );
+
+		REQUIRE( THREADS * ITERATIONS == all.size() );
+
+		for ( std::size_t index = 0; index < all.size(); ++index )
+		{
+			REQUIRE( all[ index ] == static_cast< value_type >( index ) );
+		}
+
+		REQUIRE( queue.empty() );
+	}
+}
\ No newline at end of file
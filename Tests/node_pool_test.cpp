@@ -0,0 +1,193 @@
+/**
+ * Daniel Sebastian Iliescu, http://dansil.net
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ *
+ * Node Pool Unit Tests.
+ */
+
+#include "memory/node_pool.hpp"
+#include "lists/doubly_linked_list.hpp"
+
+#include "utilities/generator.hpp"
+
+#include <catch.hpp>
+
+#include <array>
+#include <string>
+
+namespace
+{
+	const std::string UNIT_NAME = "node_pool_";
+
+	using value_type = std::int32_t;
+	constexpr std::size_t NODES_PER_SLAB = 64;
+	constexpr auto ITERATIONS = 1000U;
+
+	using pool_type = dsa::node_pool< value_type, NODES_PER_SLAB >;
+}
+
+namespace dsa
+{
+	TEST_CASE( ( UNIT_NAME + "allocate_deallocate" ).c_str() )
+	{
+		pool_type pool;
+
+		REQUIRE( pool.slabs() == 0 );
+
+		std::array< value_type*, NODES_PER_SLAB + 1 > items;
+		for ( auto& item : items )
+		{
+			item = pool.allocate( 1 );
+			*item = 1;
+		}
+
+		REQUIRE( pool.slabs() == 2 );
+
+		const auto last = items.back();
+		pool.deallocate( last, 1 );
+
+		// Freed nodes are reused before any new slab is taken.
+		REQUIRE( pool.allocate( 1 ) == last );
+		REQUIRE( pool.slabs() == 2 );
+
+		pool.release();
+
+		REQUIRE( pool.slabs() == 0 );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "copies_share_slabs" ).c_str() )
+	{
+		pool_type pool;
+		const auto item = pool.allocate( 1 );
+
+		auto copy = pool;
+
+		REQUIRE( copy == pool );
+		REQUIRE( copy.slabs() == 1 );
+
+		copy.deallocate( item, 1 );
+
+		REQUIRE( pool.allocate( 1 ) == item );
+		REQUIRE( pool != pool_type() );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "copies_stay_equal" ).c_str() )
+	{
+		pool_type pool;
+		auto copy = pool;
+
+		REQUIRE( copy == pool );
+
+		copy.deallocate( copy.allocate( 1 ), 1 );
+
+		REQUIRE( copy == pool );
+		REQUIRE( pool.slabs() == 1 );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "array_allocation" ).c_str() )
+	{
+		pool_type pool;
+
+		const auto items = pool.allocate( ITERATIONS );
+		std::fill( items, items + ITERATIONS, value_type() );
+		pool.deallocate( items, ITERATIONS );
+
+		REQUIRE( pool.slabs() == 0 );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "doubly_linked_list" ).c_str() )
+	{
+		std::array< value_type, ITERATIONS > values;
+
+		generator< value_type > generator;
+		generator.fill_buffer(
+			std::begin( values ),
+			std::end( values ) );
+
+		doubly_linked_list< value_type, pool_type > list;
+		std::copy(
+			std::cbegin( values ),
+			std::cend( values ),
+			std::back_inserter( list ) );
+
+		REQUIRE( list.get_allocator().slabs() == ( ITERATIONS + NODES_PER_SLAB - 1 ) / NODES_PER_SLAB );
+
+		for ( auto&& value : values )
+		{
+			REQUIRE( value == list.pop_front() );
+		}
+
+		REQUIRE( list.empty() );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "doubly_linked_list_clear" ).c_str() )
+	{
+		doubly_linked_list< std::string, node_pool< std::string, NODES_PER_SLAB > > list;
+
+		for ( std::size_t iteration = 0; iteration < ITERATIONS; ++iteration )
+		{
+			list.push_back( std::string( 64, 'x' ) );
+		}
+
+		const auto slabs = list.get_allocator().slabs();
+
+		list.clear();
+
+		// The slabs are kept for reuse rather than released by the list.
+		REQUIRE( list.empty() );
+		REQUIRE( list.get_allocator().slabs() == slabs );
+
+		list.push_back( "reused" );
+
+		REQUIRE( list.front() == "reused" );
+		REQUIRE( list.get_allocator().slabs() == slabs );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "doubly_linked_list_shared_pool" ).c_str() )
+	{
+		using list_type = doubly_linked_list< std::string, node_pool< std::string, NODES_PER_SLAB > >;
+
+		const list_type::allocator_type pool;
+		list_type first( pool );
+		list_type second( pool );
+
+		for ( std::size_t iteration = 0; iteration < ITERATIONS; ++iteration )
+		{
+			first.push_back( std::string( 64, 'a' ) );
+			second.push_back( std::string( 64, 'b' ) );
+		}
+
+		// Clearing one list must leave the nodes of the other list in place.
+		first.clear();
+
+		REQUIRE( first.empty() );
+		REQUIRE( second.size() == ITERATIONS );
+
+		for ( auto&& item : second )
+		{
+			REQUIRE( item == std::string( 64, 'b' ) );
+		}
+
+		first.push_back( "reused" );
+
+		REQUIRE( first.front() == "reused" );
+		REQUIRE( second.front() == std::string( 64, 'b' ) );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "doubly_linked_list_move" ).c_str() )
+	{
+		doubly_linked_list< value_type, pool_type > list;
+
+		generator< value_type > generator;
+		generator.fill_buffer_n( std::back_inserter( list ), ITERATIONS );
+
+		const auto list_copy( list );
+		auto list_move( std::move( list ) );
+
+		// Clearing the source must not release the slabs now owned by the destination.
+		list.push_back( value_type() );
+		list.clear();
+
+		REQUIRE( list_move == list_copy );
+	}
+}
@@ -0,0 +1,272 @@
+/**
+ * Daniel Sebastian Iliescu, http://dansil.net
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ *
+ * Persistent List Unit Tests.
+ */
+
+#include "lists/persistent_list.hpp"
+
+#include "utilities/generator.hpp"
+
+#include <catch.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace
+{
+	const std::string UNIT_NAME = "persistent_list_";
+
+	using value_type = std::int32_t;
+	constexpr auto ITERATIONS = 10000U;
+	constexpr std::size_t THREADS = 4;
+
+	template < typename List >
+	bool
+	matches(
+		const List& list,
+		const std::deque< value_type >& expected )
+	{
+		return ( list.size() == expected.size() ) &&
+			std::equal( std::cbegin( list ), std::cend( list ), std::cbegin( expected ), std::cend( expected ) ) &&
+			std::equal( list.crbegin(), list.crend(), expected.crbegin(), expected.crend() );
+	}
+}
+
+namespace dsa
+{
+	TEST_CASE( ( UNIT_NAME + "default_constructor" ).c_str() )
+	{
+		const persistent_list< value_type > list;
+
+		REQUIRE( list.empty() );
+		REQUIRE( list.size() == 0 );
+		REQUIRE( list.begin() == list.end() );
+		REQUIRE( list.rbegin() == list.rend() );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "initializer_list_constructor" ).c_str() )
+	{
+		const persistent_list< value_type > list = { 1, 2, 3 };
+
+		REQUIRE( list.size() == 3 );
+		REQUIRE( list.front() == 1 );
+		REQUIRE( list.back() == 3 );
+		REQUIRE( list[ 1 ] == 2 );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "push_pop_both_ends" ).c_str() )
+	{
+		generator< std::uint32_t > operations( generators::random_seed(), std::uniform_int_distribution< std::uint32_t >( 0, 5 ) );
+
+		persistent_list< value_type > list;
+		std::deque< value_type > expected;
+
+		// Earlier versions, which must be left unchanged by the later modifications.
+		std::vector< std::pair< persistent_list< value_type >, std::deque< value_type > > > versions;
+
+		for ( value_type iteration = 0; iteration < static_cast< value_type >( ITERATIONS ); ++iteration )
+		{
+			const auto operation = operations();
+
+			if ( ( operation == 0 ) && !expected.empty() )
+			{
+				list = list.pop_front();
+				expected.pop_front();
+			}
+			else if ( ( operation == 1 ) && !expected.empty() )
+			{
+				list = list.pop_back();
+				expected.pop_back();
+			}
+			else if ( operation % 2 == 0 )
+			{
+				list = list.push_front( iteration );
+				expected.push_front( iteration );
+			}
+			else
+			{
+				list = list.push_back( iteration );
+				expected.push_back( iteration );
+			}
+
+			REQUIRE( list.size() == expected.size() );
+
+			if ( !expected.empty() )
+			{
+				REQUIRE( list.front() == expected.front() );
+				REQUIRE( list.back() == expected.back() );
+			}
+
+			if ( iteration % 500 == 0 )
+			{
+				versions.emplace_back( list, expected );
+			}
+		}
+
+		REQUIRE( matches( list, expected ) );
+
+		for ( const auto& version : versions )
+		{
+			REQUIRE( matches( version.first, version.second ) );
+		}
+	}
+
+	TEST_CASE( ( UNIT_NAME + "drain_both_ends" ).c_str() )
+	{
+		persistent_list< value_type > list;
+		std::deque< value_type > expected;
+
+		for ( value_type item = 0; item < static_cast< value_type >( ITERATIONS ); ++item )
+		{
+			list = ( item % 2 == 0 ) ? list.push_back( item ) : list.push_front( item );
+			( item % 2 == 0 ) ? expected.push_back( item ) : expected.push_front( item );
+		}
+
+		const auto full = list;
+
+		while ( !list.empty() )
+		{
+			REQUIRE( list.front() == expected.front() );
+
+			list = list.pop_front();
+			expected.pop_front();
+		}
+
+		REQUIRE( list.begin() == list.end() );
+		REQUIRE( full.size() == ITERATIONS );
+
+		list = full;
+
+		for ( std::size_t item = 0; item < ITERATIONS; ++item )
+		{
+			list = list.pop_back();
+		}
+
+		REQUIRE( list.empty() );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "set" ).c_str() )
+	{
+		persistent_list< value_type > list;
+
+		for ( value_type item = 0; item < static_cast< value_type >( ITERATIONS ); ++item )
+		{
+			list = list.push_back( item );
+		}
+
+		auto doubled = list;
+
+		for ( std::size_t index = 0; index < list.size(); ++index )
+		{
+			doubled = doubled.set( index, 2 * list[ index ] );
+		}
+
+		for ( std::size_t index = 0; index < list.size(); ++index )
+		{
+			REQUIRE( list[ index ] == static_cast< value_type >( index ) );
+			REQUIRE( doubled[ index ] == static_cast< value_type >( 2 * index ) );
+		}
+	}
+
+	TEST_CASE( ( UNIT_NAME + "equality_operator" ).c_str() )
+	{
+		const persistent_list< value_type > list = { 1, 2, 3 };
+
+		// Same elements, at another origin of the trie.
+		const auto shifted = persistent_list< value_type >( { 2, 3 } ).push_front( 1 );
+
+		REQUIRE( list == list.push_back( 4 ).pop_back() );
+		REQUIRE( list == shifted );
+		REQUIRE( list != list.set( 1, 4 ) );
+		REQUIRE( list != list.pop_front() );
+		REQUIRE( persistent_list< value_type >() == list.pop_front().pop_front().pop_front() );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "structural_sharing" ).c_str() )
+	{
+		persistent_list< std::string > list;
+
+		for ( std::size_t item = 0; item < 100; ++item )
+		{
+			list = list.push_back( std::to_string( item ) );
+		}
+
+		const auto updated = list.set( list.size() - 1, "last" );
+
+		REQUIRE( list.back() == "99" );
+		REQUIRE( updated.back() == "last" );
+
+		// The first element is in a leaf off the path to the last one.
+		REQUIRE( &updated.front() == &list.front() );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "snapshot_reads" ).c_str() )
+	{
+		// The writer keeps the list a run of consecutive integers, which every snapshot must be as well.
+		std::mutex mutex;
+		persistent_list< value_type > published;
+
+		std::atomic< bool > done { false };
+		std::atomic< std::size_t > failures { 0 };
+
+		std::vector< std::thread > readers;
+
+		for ( std::size_t reader = 0; reader < THREADS; ++reader )
+		{
+			readers.emplace_back( [&]
+			{
+				while ( !done.load() )
+				{
+					persistent_list< value_type > snapshot;
+
+					{
+						std::lock_guard< std::mutex > lock( mutex );
+						snapshot = published;
+					}
+
+					value_type expected = snapshot.empty() ? 0 : snapshot.front();
+
+					for ( const auto item : snapshot )
+					{
+						if ( item != expected++ )
+						{
+							++failures;
+						}
+					}
+				}
+			} );
+		}
+
+		auto list = published;
+
+		for ( value_type item = 0; item < static_cast< value_type >( ITERATIONS ); ++item )
+		{
+			list = list.push_back( item );
+
+			if ( item % 3 == 0 )
+			{
+				list = list.pop_front();
+			}
+
+			std::lock_guard< std::mutex > lock( mutex );
+			published = list;
+		}
+
+		done = true;
+
+		for ( auto& reader : readers )
+		{
+			reader.join();
+		}
+
+		REQUIRE( failures == 0 );
+	}
+}
\ No newline at end of file
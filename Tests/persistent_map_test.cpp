@@ -0,0 +1,295 @@
+/**
+ * Daniel Sebastian Iliescu, http://dansil.net
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ *
+ * Persistent Map Unit Tests.
+ */
+
+#include "trees/persistent_map.hpp"
+
+#include "utilities/generator.hpp"
+
+#include <catch.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace
+{
+	const std::string UNIT_NAME = "persistent_map_";
+
+	using key_type = std::int32_t;
+	using value_type = std::int32_t;
+	constexpr auto ITERATIONS = 10000U;
+	constexpr std::size_t THREADS = 4;
+
+	using node_type = dsa::persistent_map< key_type, value_type >::node_type;
+
+	bool
+	matches(
+		const dsa::persistent_map< key_type, value_type >& map,
+		const std::map< key_type, value_type >& expected )
+	{
+		std::vector< std::pair< const key_type, value_type > > items;
+
+		map.inorder( [&items]( const node_type& node )
+		{
+			items.emplace_back( node->key, node->value );
+		} );
+
+		return ( map.size() == expected.size() ) &&
+			std::equal( std::cbegin( items ), std::cend( items ), std::cbegin( expected ), std::cend( expected ) );
+	}
+
+	// Black height of a valid red-black subtree, or -1 if it has a red-red edge or unequal black heights.
+	int
+	black_height( const node_type& node )
+	{
+		if ( !node )
+		{
+			return 0;
+		}
+
+		const auto red = ( node->color == dsa::node_color::red );
+
+		if ( red &&
+			 ( ( node->left && ( node->left->color == dsa::node_color::red ) ) ||
+			   ( node->right && ( node->right->color == dsa::node_color::red ) ) ) )
+		{
+			return -1;
+		}
+
+		const auto left = black_height( node->left );
+		const auto right = black_height( node->right );
+
+		if ( ( left < 0 ) || ( left != right ) )
+		{
+			return -1;
+		}
+
+		return left + ( red ? 0 : 1 );
+	}
+
+	bool
+	valid( const dsa::persistent_map< key_type, value_type >& map )
+	{
+		node_type root;
+
+		map.preorder( [&root]( const node_type& node )
+		{
+			if ( !root )
+			{
+				root = node;
+			}
+		} );
+
+		return ( !root || ( root->color == dsa::node_color::black ) ) && ( black_height( root ) >= 0 );
+	}
+}
+
+namespace dsa
+{
+	TEST_CASE( ( UNIT_NAME + "default_constructor" ).c_str() )
+	{
+		const persistent_map< key_type, value_type > map;
+
+		REQUIRE( map.empty() );
+		REQUIRE( map.size() == 0 );
+		REQUIRE( map.height() == 0 );
+		REQUIRE( !map.contains( 0 ) );
+		REQUIRE( map.find( 0 ) == nullptr );
+		REQUIRE( map.erase( 0 ).empty() );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "matches_map" ).c_str() )
+	{
+		generator< key_type > keys( generators::random_seed(), std::uniform_int_distribution< key_type >( 0, ITERATIONS / 2 ) );
+
+		persistent_map< key_type, value_type > map;
+		std::map< key_type, value_type > expected;
+
+		// Earlier versions, which must be left unchanged by the later modifications.
+		std::vector< std::pair< persistent_map< key_type, value_type >, std::map< key_type, value_type > > > versions;
+
+		for ( value_type iteration = 0; iteration < static_cast< value_type >( ITERATIONS ); ++iteration )
+		{
+			const auto key = keys();
+
+			if ( iteration % 3 == 2 )
+			{
+				map = map.erase( key );
+				expected.erase( key );
+			}
+			else if ( iteration % 3 == 1 )
+			{
+				map = map.insert_or_assign( key, iteration );
+				expected[ key ] = iteration;
+			}
+			else
+			{
+				map = map.insert( key, iteration );
+				expected.emplace( key, iteration );
+			}
+
+			REQUIRE( map.size() == expected.size() );
+
+			const auto value = map.find( key );
+			const auto position = expected.find( key );
+
+			REQUIRE( ( value == nullptr ) == ( position == std::cend( expected ) ) );
+
+			if ( value )
+			{
+				REQUIRE( *value == position->second );
+			}
+
+			if ( iteration % 500 == 0 )
+			{
+				REQUIRE( matches( map, expected ) );
+				REQUIRE( valid( map ) );
+
+				versions.emplace_back( map, expected );
+			}
+		}
+
+		REQUIRE( matches( map, expected ) );
+		REQUIRE( valid( map ) );
+
+		for ( const auto& version : versions )
+		{
+			REQUIRE( matches( version.first, version.second ) );
+		}
+	}
+
+	TEST_CASE( ( UNIT_NAME + "height" ).c_str() )
+	{
+		persistent_map< key_type, value_type > map;
+
+		// Sorted insertions degenerate an unbalanced tree into a list.
+		for ( key_type key = 0; key < static_cast< key_type >( ITERATIONS ); ++key )
+		{
+			map = map.insert( key, key );
+		}
+
+		REQUIRE( valid( map ) );
+		REQUIRE( map.height() < 2 * std::log2( ITERATIONS + 1 ) );
+
+		for ( key_type key = 0; key < static_cast< key_type >( ITERATIONS ); key += 2 )
+		{
+			map = map.erase( key );
+		}
+
+		REQUIRE( valid( map ) );
+		REQUIRE( map.size() == ITERATIONS / 2 );
+		REQUIRE( map.height() < 2 * std::log2( ITERATIONS / 2 + 1 ) );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "equality_operator" ).c_str() )
+	{
+		persistent_map< key_type, value_type > ascending;
+		persistent_map< key_type, value_type > descending;
+
+		for ( key_type key = 0; key < 100; ++key )
+		{
+			ascending = ascending.insert( key, key );
+			descending = descending.insert( 99 - key, 99 - key );
+		}
+
+		REQUIRE( ascending == descending );
+		REQUIRE( ascending == ascending.insert( 0, 1 ) );
+		REQUIRE( ascending != ascending.insert_or_assign( 0, 1 ) );
+		REQUIRE( ascending != ascending.erase( 50 ) );
+		REQUIRE( ascending == ascending.erase( 50 ).insert( 50, 50 ) );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "structural_sharing" ).c_str() )
+	{
+		persistent_map< key_type, std::string > map;
+
+		for ( key_type key = 0; key < 100; ++key )
+		{
+			map = map.insert( key, std::to_string( key ) );
+		}
+
+		const auto updated = map.insert_or_assign( 0, "zero" );
+
+		REQUIRE( *map.find( 0 ) == "0" );
+		REQUIRE( *updated.find( 0 ) == "zero" );
+
+		// The last key is off the path to the first one.
+		REQUIRE( map.find( 99 ) == updated.find( 99 ) );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "snapshot_reads" ).c_str() )
+	{
+		// The writer keeps the map the keys [first, last) mapped to themselves, which every snapshot must be as well.
+		std::mutex mutex;
+		persistent_map< key_type, value_type > published;
+
+		std::atomic< bool > done { false };
+		std::atomic< std::size_t > failures { 0 };
+
+		std::vector< std::thread > readers;
+
+		for ( std::size_t reader = 0; reader < THREADS; ++reader )
+		{
+			readers.emplace_back( [&]
+			{
+				while ( !done.load() )
+				{
+					persistent_map< key_type, value_type > snapshot;
+
+					{
+						std::lock_guard< std::mutex > lock( mutex );
+						snapshot = published;
+					}
+
+					auto previous = key_type();
+					auto first = true;
+
+					snapshot.inorder( [&]( const node_type& node )
+					{
+						if ( ( node->key != node->value ) || ( !first && ( node->key != previous + 1 ) ) )
+						{
+							++failures;
+						}
+
+						previous = node->key;
+						first = false;
+					} );
+				}
+			} );
+		}
+
+		auto map = published;
+
+		for ( key_type key = 0; key < static_cast< key_type >( ITERATIONS ); ++key )
+		{
+			map = map.insert( key, key );
+
+			if ( key % 3 == 0 )
+			{
+				map = map.erase( key / 3 );
+			}
+
+			std::lock_guard< std::mutex > lock( mutex );
+			published = map;
+		}
+
+		done = true;
+
+		for ( auto& reader : readers )
+		{
+			reader.join();
+		}
+
+		REQUIRE( failures == 0 );
+	}
+}
\ No newline at end of file
@@ -0,0 +1,456 @@
+/**
+ * Daniel Sebastian Iliescu, http://dansil.net
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ *
+ * Segmented Deque Unit Tests.
+ */
+
+#include "lists/doubly_linked_list.hpp"
+#include "lists/segmented_deque.hpp"
+#include "lists/unrolled_list.hpp"
+
+#include "utilities/generator.hpp"
+
+#include <catch.hpp>
+
+#include <algorithm>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+	const std::string UNIT_NAME = "segmented_deque_";
+
+	using value_type = std::int32_t;
+	constexpr auto ITERATIONS = 1000U;
+
+	// A small block size so that every test crosses many block boundaries.
+	constexpr std::size_t BLOCK_SIZE = 7;
+
+	template < typename T >
+	using deque_type = dsa::segmented_deque< T, BLOCK_SIZE >;
+
+	// Only uses the modifiers shared with doubly_linked_list.
+	template < typename Container >
+	std::vector< value_type >
+	exercise_modifiers()
+	{
+		Container container;
+
+		for ( value_type item = 0; item < 20; ++item )
+		{
+			container.push_back( item );
+			container.emplace_front( -item );
+		}
+
+		container.pop_front();
+		container.pop_back();
+
+		auto position = container.insert( std::next( container.cbegin(), 5 ), 100 );
+		position = container.erase( position );
+		container.emplace( position, 200 );
+		container.erase( std::next( container.cbegin(), 10 ), std::next( container.cbegin(), 15 ) );
+
+		Container other;
+		other.push_back( 300 );
+		other.push_back( 400 );
+
+		container.splice( container.cbegin(), other );
+		container.splice( container.cend(), container, container.cbegin() );
+
+		const std::vector< value_type > values { 500, 600, 700, 800, 900, 1000, 1100, 1200, 1300 };
+		container.insert( std::next( container.cbegin(), 3 ), std::cbegin( values ), std::cend( values ) );
+
+		other.insert( other.cend(), std::cbegin( values ), std::cend( values ) );
+		container.splice( std::next( container.cbegin(), 7 ), other, std::next( other.cbegin(), 2 ), std::next( other.cbegin(), 6 ) );
+		container.splice( std::next( container.cbegin(), 2 ), container, std::next( container.cbegin(), 20 ), std::next( container.cbegin(), 25 ) );
+
+		container.front() += 1;
+		container.emplace_back( 2000 ) += 1;
+
+		Container sorted( std::cbegin( values ), std::cend( values ) );
+		other.push_back( 1400 );
+		sorted.merge( other );
+
+		std::vector< value_type > result( container.cbegin(), container.cend() );
+		result.insert( std::end( result ), sorted.cbegin(), sorted.cend() );
+		result.push_back( static_cast< value_type >( other.size() ) );
+
+		return result;
+	}
+}
+
+namespace dsa
+{
+	TEST_CASE( ( UNIT_NAME + "default_constructor" ).c_str() )
+	{
+		deque_type< value_type > deque;
+
+		REQUIRE( deque.empty() );
+		REQUIRE( deque.begin() == deque.end() );
+		REQUIRE( deque.cbegin() == deque.cend() );
+		REQUIRE( deque.end() - deque.begin() == 0 );
+		REQUIRE( value_type() == deque.pop_front() );
+		REQUIRE( value_type() == deque.pop_back() );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "copy_move_assignment" ).c_str() )
+	{
+		deque_type< std::string > deque;
+
+		for ( std::size_t item = 0; item < ITERATIONS; ++item )
+		{
+			deque.push_back( std::to_string( item ) );
+		}
+
+		auto copy( deque );
+
+		REQUIRE( copy == deque );
+
+		const auto moved( std::move( copy ) );
+
+		REQUIRE( copy.empty() );
+		REQUIRE( moved == deque );
+
+		copy = moved;
+		copy.pop_back();
+
+		REQUIRE( copy != moved );
+
+		deque = std::move( copy );
+
+		REQUIRE( ITERATIONS - 1 == deque.size() );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "equality_operator" ).c_str() )
+	{
+		std::vector< value_type > values( ITERATIONS );
+
+		generator< value_type > generator;
+		generator.fill_buffer( std::begin( values ), std::end( values ) );
+
+		// The same elements, starting at a different offset within their first block.
+		deque_type< value_type > deque( std::cbegin( values ), std::cend( values ) );
+		deque_type< value_type > other;
+
+		for ( auto it = std::crbegin( values ); it != std::crend( values ); ++it )
+		{
+			other.push_front( *it );
+		}
+
+		REQUIRE( deque == other );
+
+		other.back() = values.back() + 1;
+
+		REQUIRE( deque != other );
+
+		other.pop_back();
+
+		REQUIRE( deque != other );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "push_pop_both_ends" ).c_str() )
+	{
+		generator< value_type > values;
+		generator< std::size_t, std::uniform_int_distribution< std::size_t > > operations( values.seed(), std::uniform_int_distribution< std::size_t >( 0, 4 ) );
+
+		deque_type< value_type > deque;
+		std::deque< value_type > expected;
+
+		for ( std::size_t iteration = 0; iteration < 20 * ITERATIONS; ++iteration )
+		{
+			// Biased towards pushing at the front, so that the map has to grow in both directions.
+			switch ( operations() )
+			{
+			case 0:
+			case 1:
+				deque.push_front( expected.emplace_front( values() ) );
+				break;
+			case 2:
+				deque.push_back( expected.emplace_back( values() ) );
+				break;
+			case 3:
+				REQUIRE( deque.pop_front() == ( expected.empty() ? value_type() : expected.front() ) );
+
+				if ( !expected.empty() )
+				{
+					expected.pop_front();
+				}
+
+				break;
+			default:
+				REQUIRE( deque.pop_back() == ( expected.empty() ? value_type() : expected.back() ) );
+
+				if ( !expected.empty() )
+				{
+					expected.pop_back();
+				}
+
+				break;
+			}
+
+			REQUIRE( expected.size() == deque.size() );
+		}
+
+		for ( std::size_t index = 0; index < expected.size(); ++index )
+		{
+			REQUIRE( expected[ index ] == deque[ index ] );
+		}
+
+		REQUIRE( std::equal( std::cbegin( expected ), std::cend( expected ), std::cbegin( deque ), std::cend( deque ) ) );
+		REQUIRE( std::equal( std::crbegin( expected ), std::crend( expected ), std::crbegin( deque ), std::crend( deque ) ) );
+
+		deque.clear();
+
+		REQUIRE( deque.empty() );
+		REQUIRE( deque.begin() == deque.end() );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "stable_references" ).c_str() )
+	{
+		deque_type< value_type > deque;
+
+		deque.push_back( 0 );
+
+		const auto first = &deque.front();
+		std::vector< value_type* > addresses;
+
+		// Enough pushes on both ends to reallocate the map several times.
+		for ( value_type item = 1; item <= static_cast< value_type >( ITERATIONS ); ++item )
+		{
+			addresses.push_back( &deque.emplace_back( item ) );
+			addresses.push_back( &deque.emplace_front( -item ) );
+		}
+
+		REQUIRE( first == &deque[ ITERATIONS ] );
+		REQUIRE( *first == 0 );
+
+		for ( std::size_t index = 0; index < addresses.size(); ++index )
+		{
+			const auto item = static_cast< value_type >( index / 2 + 1 );
+
+			REQUIRE( *addresses[ index ] == ( ( index % 2 == 0 ) ? item : -item ) );
+		}
+
+		for ( std::size_t item = 0; item < ITERATIONS; ++item )
+		{
+			deque.pop_front();
+		}
+
+		REQUIRE( first == &deque.front() );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "random_access_iterators" ).c_str() )
+	{
+		std::vector< value_type > values( ITERATIONS );
+
+		generator< value_type > generator;
+		generator.fill_buffer( std::begin( values ), std::end( values ) );
+
+		deque_type< value_type > deque;
+
+		// Start the elements in the middle of a block.
+		for ( auto it = std::crbegin( values ); it != std::crend( values ); ++it )
+		{
+			deque.push_front( *it );
+		}
+
+		REQUIRE( static_cast< std::ptrdiff_t >( ITERATIONS ) == deque.end() - deque.begin() );
+
+		for ( std::ptrdiff_t offset = 0; offset < static_cast< std::ptrdiff_t >( ITERATIONS ); offset += 13 )
+		{
+			const auto it = deque.cbegin() + offset;
+
+			REQUIRE( *it == values[ offset ] );
+			REQUIRE( it[ 3 ] == deque[ offset + 3 ] );
+			REQUIRE( ( deque.cend() - ( static_cast< std::ptrdiff_t >( ITERATIONS ) - offset ) ) == it );
+			REQUIRE( it - deque.cbegin() == offset );
+			REQUIRE( deque.cbegin() <= it );
+			REQUIRE( it < deque.cend() );
+		}
+
+		std::sort( deque.begin(), deque.end() );
+		std::sort( std::begin( values ), std::end( values ) );
+
+		REQUIRE( std::equal( std::cbegin( values ), std::cend( values ), std::cbegin( deque ), std::cend( deque ) ) );
+		REQUIRE( std::binary_search( deque.cbegin(), deque.cend(), values[ ITERATIONS / 2 ] ) );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "insert_erase" ).c_str() )
+	{
+		std::vector< value_type > values( ITERATIONS );
+
+		generator< value_type > generator;
+		generator.fill_buffer(
+			std::begin( values ),
+			std::end( values ) );
+
+		std::deque< value_type > expected( std::cbegin( values ), std::cend( values ) );
+		deque_type< value_type > deque( std::cbegin( values ), std::cend( values ) );
+
+		// Insert a range in the middle, single elements near either end, then erase every third element.
+		expected.insert( std::begin( expected ) + ITERATIONS / 2, std::cbegin( values ), std::cend( values ) );
+		const auto inserted = deque.insert( deque.cbegin() + ITERATIONS / 2, std::cbegin( values ), std::cend( values ) );
+
+		REQUIRE( *inserted == values.front() );
+
+		expected.insert( std::begin( expected ) + 3, 42 );
+		REQUIRE( *deque.insert( deque.cbegin() + 3, 42 ) == 42 );
+
+		expected.insert( std::end( expected ) - 3, 43 );
+		REQUIRE( *deque.emplace( deque.cend() - 3, 43 ) == 43 );
+
+		auto expected_it = std::begin( expected );
+		auto it = deque.begin();
+
+		for ( std::size_t index = 0; it != deque.end(); ++index )
+		{
+			if ( index % 3 == 0 )
+			{
+				expected_it = expected.erase( expected_it );
+				it = deque.erase( it );
+			}
+			else
+			{
+				++expected_it;
+				++it;
+			}
+		}
+
+		// Ranges near the front and near the back.
+		expected.erase( std::begin( expected ) + 10, std::begin( expected ) + 30 );
+		deque.erase( deque.cbegin() + 10, deque.cbegin() + 30 );
+
+		expected.erase( std::end( expected ) - 30, std::end( expected ) - 10 );
+		deque.erase( deque.cend() - 30, deque.cend() - 10 );
+
+		REQUIRE( expected.size() == deque.size() );
+		REQUIRE(
+			std::equal(
+				std::cbegin( expected ),
+				std::cend( expected ),
+				std::cbegin( deque ),
+				std::cend( deque ) ) );
+
+		const auto erased = deque.erase( deque.cbegin(), deque.cend() );
+
+		REQUIRE( deque.empty() );
+		REQUIRE( erased == deque.end() );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "splice" ).c_str() )
+	{
+		const std::vector< value_type > values { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+
+		deque_type< value_type > deque( std::cbegin( values ), std::cbegin( values ) + 5 );
+		deque_type< value_type > other( std::cbegin( values ) + 5, std::cend( values ) );
+
+		// Whole deque.
+		deque.splice( deque.cend(), other );
+
+		REQUIRE( other.empty() );
+		REQUIRE( std::equal( std::cbegin( values ), std::cend( values ), std::cbegin( deque ), std::cend( deque ) ) );
+
+		// Range into another deque: 3, 4, 5.
+		other.splice( other.cend(), deque, deque.cbegin() + 2, deque.cbegin() + 5 );
+
+		REQUIRE( 7 == deque.size() );
+		REQUIRE( 3 == other.size() );
+		REQUIRE( other.front() == 3 );
+		REQUIRE( other.back() == 5 );
+
+		// Single element to the front: 6.
+		other.splice( other.cbegin(), deque, deque.cbegin() + 2 );
+
+		REQUIRE( 6 == deque.size() );
+		REQUIRE( other.front() == 6 );
+
+		// Range within the same deque: move 1, 2 to the back, then 10 to the front.
+		deque.splice( deque.cend(), deque, deque.cbegin(), deque.cbegin() + 2 );
+		deque.splice( deque.cbegin(), deque, deque.cend() - 3 );
+
+		const std::vector< value_type > expected { 10, 7, 8, 9, 1, 2 };
+
+		REQUIRE( std::equal( std::cbegin( expected ), std::cend( expected ), std::cbegin( deque ), std::cend( deque ) ) );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "self_splice" ).c_str() )
+	{
+		const std::vector< value_type > values { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+
+		deque_type< value_type > deque( std::cbegin( values ), std::cend( values ) );
+
+		// An element or a range spliced before itself or right after itself stays in place.
+		deque.splice( deque.cbegin() + 3, deque, deque.cbegin() + 3 );
+		deque.splice( deque.cbegin() + 4, deque, deque.cbegin() + 3 );
+		deque.splice( deque.cbegin() + 3, deque, deque.cbegin() + 3, deque.cbegin() + 6 );
+		deque.splice( deque.cbegin() + 6, deque, deque.cbegin() + 3, deque.cbegin() + 6 );
+		deque.splice( deque.cbegin(), deque, deque.cbegin(), deque.cend() );
+
+		REQUIRE( std::equal( std::cbegin( values ), std::cend( values ), std::cbegin( deque ), std::cend( deque ) ) );
+
+		// Spliced one position further, the element swaps with its successor.
+		deque.splice( deque.cbegin() + 5, deque, deque.cbegin() + 3 );
+
+		const std::vector< value_type > expected { 0, 1, 2, 4, 3, 5, 6, 7, 8, 9 };
+
+		REQUIRE( std::equal( std::cbegin( expected ), std::cend( expected ), std::cbegin( deque ), std::cend( deque ) ) );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "merge" ).c_str() )
+	{
+		std::vector< value_type > first_values( ITERATIONS );
+		std::vector< value_type > second_values( ITERATIONS / 3 );
+
+		generator< value_type > generator;
+		generator.fill_buffer( std::begin( first_values ), std::end( first_values ) );
+		generator.fill_buffer( std::begin( second_values ), std::end( second_values ) );
+
+		std::sort( std::begin( first_values ), std::end( first_values ) );
+		std::sort( std::begin( second_values ), std::end( second_values ) );
+
+		deque_type< value_type > deque( std::cbegin( first_values ), std::cend( first_values ) );
+		deque_type< value_type > other( std::cbegin( second_values ), std::cend( second_values ) );
+
+		deque.merge( other );
+
+		std::vector< value_type > expected;
+		std::merge(
+			std::cbegin( first_values ),
+			std::cend( first_values ),
+			std::cbegin( second_values ),
+			std::cend( second_values ),
+			std::back_inserter( expected ) );
+
+		REQUIRE( other.empty() );
+		REQUIRE( std::equal( std::cbegin( expected ), std::cend( expected ), std::cbegin( deque ), std::cend( deque ) ) );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "move_only" ).c_str() )
+	{
+		deque_type< std::unique_ptr< value_type > > deque;
+
+		for ( value_type item = 0; item < 10; ++item )
+		{
+			deque.push_back( std::make_unique< value_type >( item ) );
+			deque.push_front( std::make_unique< value_type >( -item ) );
+		}
+
+		deque.insert( deque.cbegin() + 5, std::make_unique< value_type >( 100 ) );
+		deque.erase( deque.cbegin() + 15 );
+
+		REQUIRE( *deque[ 5 ] == 100 );
+		REQUIRE( *deque.pop_front() == -9 );
+		REQUIRE( *deque.pop_back() == 9 );
+		REQUIRE( 18 == deque.size() );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "doubly_linked_list_interface" ).c_str() )
+	{
+		REQUIRE( ( exercise_modifiers< deque_type< value_type > >() == exercise_modifiers< doubly_linked_list< value_type > >() ) );
+		REQUIRE( ( exercise_modifiers< segmented_deque< value_type > >() == exercise_modifiers< doubly_linked_list< value_type > >() ) );
+		REQUIRE( ( exercise_modifiers< unrolled_list< value_type, BLOCK_SIZE > >() == exercise_modifiers< doubly_linked_list< value_type > >() ) );
+	}
+}
\ No newline at end of file
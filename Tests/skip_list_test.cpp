@@ -0,0 +1,161 @@
+/**
+ * Daniel Sebastian Iliescu, http://dansil.net
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ *
+ * Skip List Unit Tests.
+ */
+
+#include "lists/skip_list.hpp"
+
+#include "utilities/generator.hpp"
+
+#include <catch.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	const std::string UNIT_NAME = "skip_list_";
+
+	using value_type = std::int32_t;
+	constexpr auto ITERATIONS = 10000U;
+	constexpr std::size_t THREADS = 4;
+}
+
+namespace dsa
+{
+	TEST_CASE( ( UNIT_NAME + "default_constructor" ).c_str() )
+	{
+		skip_list< value_type, std::string > list;
+
+		REQUIRE( list.empty() );
+		REQUIRE( list.begin() == list.end() );
+		REQUIRE( list.find( 0 ) == list.end() );
+		REQUIRE( !list.erase( 0 ) );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "matches_map" ).c_str() )
+	{
+		generator< value_type > keys( generators::random_seed(), std::uniform_int_distribution< value_type >( 0, ITERATIONS / 2 ) );
+
+		skip_list< value_type, value_type > list;
+		std::map< value_type, value_type > expected;
+
+		for ( value_type iteration = 0; iteration < static_cast< value_type >( ITERATIONS ); ++iteration )
+		{
+			const auto key = keys();
+
+			if ( iteration % 3 == 2 )
+			{
+				REQUIRE( list.erase( key ) == ( expected.erase( key ) == 1 ) );
+			}
+			else
+			{
+				const auto result = list.try_emplace( key, iteration );
+
+				REQUIRE( result.second == expected.try_emplace( key, iteration ).second );
+				REQUIRE( result.first->first == key );
+			}
+		}
+
+		REQUIRE( list.size() == expected.size() );
+		REQUIRE(
+			std::equal(
+				std::cbegin( expected ),
+				std::cend( expected ),
+				std::cbegin( list ),
+				std::cend( list ) ) );
+
+		for ( value_type key = -1; key <= static_cast< value_type >( ITERATIONS / 2 ) + 1; ++key )
+		{
+			const auto bound = list.lower_bound( key );
+			const auto expected_bound = expected.lower_bound( key );
+
+			REQUIRE( ( bound == list.end() ) == ( expected_bound == std::end( expected ) ) );
+
+			if ( bound != list.end() )
+			{
+				REQUIRE( bound->first == expected_bound->first );
+			}
+
+			REQUIRE( list.contains( key ) == ( expected.count( key ) == 1 ) );
+		}
+
+		list.clear();
+
+		REQUIRE( list.empty() );
+		REQUIRE( list.size() == 0 );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "values" ).c_str() )
+	{
+		skip_list< std::string, std::string, std::greater< std::string > > list;
+
+		list.insert( { "b", "second" } );
+		list.insert( { "a", "third" } );
+		list.try_emplace( "c", 5, 'x' );
+
+		REQUIRE( !list.insert( { "a", "ignored" } ).second );
+		REQUIRE( list.find( "a" )->second == "third" );
+		REQUIRE( list.begin()->second == "xxxxx" );
+
+		list.find( "b" )->second = "modified";
+
+		REQUIRE( list.find( "b" )->second == "modified" );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "concurrent_insert_find" ).c_str() )
+	{
+		concurrent_skip_list< value_type, value_type > list;
+
+		// Every thread inserts every key, in a different order, while looking up earlier ones.
+		std::atomic< std::size_t > inserted { 0 };
+		std::atomic< std::size_t > missing { 0 };
+		std::vector< std::thread > threads;
+
+		for ( std::size_t thread = 0; thread < THREADS; ++thread )
+		{
+			threads.emplace_back( [&list, &inserted, &missing, thread]()
+			{
+				for ( std::size_t iteration = 0; iteration < ITERATIONS; ++iteration )
+				{
+					const auto key = static_cast< value_type >( ( iteration * ( 2 * thread + 1 ) ) % ITERATIONS );
+
+					if ( list.try_emplace( key, 2 * key ).second )
+					{
+						++inserted;
+					}
+
+					// A key inserted by this thread (or an earlier one) is always found afterwards.
+					const auto found = list.find( key );
+
+					if ( ( found == list.end() ) || ( found->second != 2 * key ) )
+					{
+						++missing;
+					}
+				}
+			} );
+		}
+
+		for ( auto& thread : threads )
+		{
+			thread.join();
+		}
+
+		REQUIRE( inserted == ITERATIONS );
+		REQUIRE( missing == 0 );
+		REQUIRE( list.size() == ITERATIONS );
+
+		value_type expected = 0;
+
+		for ( const auto& item : list )
+		{
+			REQUIRE( item.first == expected++ );
+		}
+	}
+}
\ No newline at end of file
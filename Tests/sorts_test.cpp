@@ -10,12 +10,17 @@
 #include "sorts/insertion_sort.hpp"
 #include "sorts/merge_sort.hpp"
 #include "sorts/quick_sort.hpp"
+#include "sorts/heap_sort.hpp"
+#include "sorts/sample_sort.hpp"
+#include "sorts/normalized_sort.hpp"
 
 #include "utilities/generator.hpp"
 
 #include <catch.hpp>
 
 #include <array>
+#include <string>
+#include <tuple>
 
 namespace
 {
@@ -37,6 +42,11 @@ namespace dsa
 			std::begin( container ),
 			std::end( container ) );
 
+		auto expected = container;
+		std::sort(
+			std::begin( expected ),
+			std::end( expected ) );
+
 		SortImplementation::sort(
 			std::begin( container ),
 			std::end( container ) );
@@ -45,8 +55,25 @@ namespace dsa
 			std::is_sorted(
 				std::cbegin( container ),
 				std::cend( container ) ) );
+		REQUIRE( container == expected );
 	}
 
+#if defined( __cpp_lib_constexpr_algorithms )
+	template< typename SortImplementation >
+	constexpr bool constexpr_sort_tester()
+	{
+		std::array< std::int32_t, 10 > container { 7, -3, 9, 0, 7, 2, -8, 5, 1, 4 };
+
+		SortImplementation::sort(
+			std::begin( container ),
+			std::end( container ) );
+
+		return std::is_sorted(
+			std::cbegin( container ),
+			std::cend( container ) );
+	}
+#endif
+
 	TEST_CASE( ( UNIT_NAME + "bubble sort" ).c_str() )
 	{
 		sort_tester< bubble >();
@@ -92,4 +119,341 @@ namespace dsa
 		sort_tester< quick::custom_implementation >();
 	}
 
+	TEST_CASE( ( UNIT_NAME + "heap sort (std implementation)" ).c_str() )
+	{
+		sort_tester< heap::std_implementation >();
+	}
+
+	TEST_CASE( ( UNIT_NAME + "heap sort (custom implementation)" ).c_str() )
+	{
+		sort_tester< heap::custom_implementation >();
+	}
+
+	TEST_CASE( ( UNIT_NAME + "sample sort" ).c_str() )
+	{
+		sort_tester< sample >();
+	}
+
+	TEST_CASE( ( UNIT_NAME + "sample sort (sharded range)" ).c_str() )
+	{
+		using value_type = std::int32_t;
+		constexpr std::size_t SHARDS = 4;
+		constexpr auto ITERATIONS = 4 * SAMPLE_THRESHOLD;
+
+		generator< value_type > generator;
+
+		std::vector< value_type > unique;
+		generator.fill_buffer_n( std::back_inserter( unique ), ITERATIONS );
+
+		// Few distinct keys, so that whole buckets of equal keys end up in one shard.
+		std::vector< value_type > duplicates;
+		std::transform(
+			std::cbegin( unique ),
+			std::cend( unique ),
+			std::back_inserter( duplicates ),
+			[]( const value_type value )
+			{
+				return value % 3;
+			} );
+
+		const std::vector< value_type > equal( ITERATIONS, 7 );
+
+		for ( auto container : { unique, duplicates, equal } )
+		{
+			auto expected = container;
+			std::sort( std::begin( expected ), std::end( expected ) );
+
+			auto sharded = container;
+			sample::sort( std::begin( sharded ), std::end( sharded ), SHARDS );
+
+			REQUIRE( sharded == expected );
+
+			// Shards by hardware thread, above the threshold below which it sorts locally.
+			sample::sort( std::begin( container ), std::end( container ) );
+
+			REQUIRE( container == expected );
+		}
+	}
+
+	TEST_CASE( ( UNIT_NAME + "sample sort (shards)" ).c_str() )
+	{
+		using value_type = std::int32_t;
+		constexpr std::size_t SHARDS = 5;
+		constexpr auto ITERATIONS = 10000U;
+
+		generator< value_type > generator;
+
+		std::vector< std::vector< value_type > > shards( SHARDS );
+		std::vector< value_type > expected;
+
+		for ( std::size_t shard = 0; shard < SHARDS; ++shard )
+		{
+			// Uneven shard sizes, including an empty shard.
+			generator.fill_buffer_n( std::back_inserter( shards[ shard ] ), ( ITERATIONS * shard ) / SHARDS );
+			expected.insert( std::end( expected ), std::cbegin( shards[ shard ] ), std::cend( shards[ shard ] ) );
+		}
+
+		sample::sort< merge::std_implementation >( shards );
+
+		std::vector< value_type > sorted;
+		for ( const auto& shard : shards )
+		{
+			REQUIRE( std::is_sorted( std::cbegin( shard ), std::cend( shard ) ) );
+
+			sorted.insert( std::end( sorted ), std::cbegin( shard ), std::cend( shard ) );
+		}
+
+		std::sort( std::begin( expected ), std::end( expected ) );
+
+		REQUIRE( sorted == expected );
+	}
+
+	template< typename PartitionImplementation >
+	void partition_tester()
+	{
+		using value_type = std::int32_t;
+		constexpr auto ITERATIONS = 1001U;
+
+		std::vector< value_type > container( ITERATIONS );
+
+		// Low-cardinality keys so that the equal region is large.
+		generator< value_type > generator;
+		for ( auto& item : container )
+		{
+			item = generator() % 5;
+		}
+
+		const value_type pivot = container[ ITERATIONS / 2 ];
+
+		const auto bounds = PartitionImplementation::partition(
+			std::begin( container ),
+			std::end( container ),
+			pivot );
+
+		REQUIRE( std::all_of( std::begin( container ), bounds.first, [pivot]( const auto item ) { return ( item < pivot ); } ) );
+		REQUIRE( std::all_of( bounds.first, bounds.second, [pivot]( const auto item ) { return ( item == pivot ); } ) );
+		REQUIRE( std::all_of( bounds.second, std::end( container ), [pivot]( const auto item ) { return ( item > pivot ); } ) );
+		REQUIRE( bounds.first != bounds.second );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "three way partition (generic implementation)" ).c_str() )
+	{
+		partition_tester< three_way_partition::generic_implementation >();
+	}
+
+	TEST_CASE( ( UNIT_NAME + "three way partition (branchless implementation)" ).c_str() )
+	{
+		partition_tester< three_way_partition::branchless_implementation >();
+	}
+
+#if defined( __AVX2__ )
+	TEST_CASE( ( UNIT_NAME + "three way partition (vectorized implementation)" ).c_str() )
+	{
+		std::vector< float > container { 2.0f, -0.0f, 1.0f, 0.0f, 3.0f, -1.0f, 0.0f, 5.0f, -2.0f, 0.0f, 7.0f };
+
+		const auto bounds = three_way_partition::vectorized_implementation::partition(
+			container.data(),
+			container.data() + container.size(),
+			0.0f );
+
+		REQUIRE( ( bounds.first - container.data() ) == 2 );
+		REQUIRE( ( bounds.second - container.data() ) == 6 );
+		REQUIRE( std::is_permutation(
+			container.data(),
+			bounds.first,
+			std::vector< float > { -1.0f, -2.0f }.data() ) );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "three way partition (vectorized implementation, large)" ).c_str() )
+	{
+		generator< std::int32_t > generator;
+
+		// Large enough for the vector loop, with every remainder modulo the vector width.
+		for ( std::size_t size = 4096; size < 4096 + 8; ++size )
+		{
+			std::vector< std::int32_t > integers( size );
+			for ( auto& item : integers )
+			{
+				item = generator() % 5;
+			}
+
+			std::vector< float > floats( std::cbegin( integers ), std::cend( integers ) );
+
+			const auto check = []( auto& container, const auto pivot )
+			{
+				const auto original = container;
+
+				const auto bounds = three_way_partition::vectorized_implementation::partition(
+					container.data(),
+					container.data() + container.size(),
+					pivot );
+
+				REQUIRE( std::all_of( container.data(), bounds.first, [pivot]( const auto item ) { return ( item < pivot ); } ) );
+				REQUIRE( std::all_of( bounds.first, bounds.second, [pivot]( const auto item ) { return ( item == pivot ); } ) );
+				REQUIRE( std::all_of( bounds.second, container.data() + container.size(), [pivot]( const auto item ) { return ( item > pivot ); } ) );
+				REQUIRE( bounds.first != bounds.second );
+				REQUIRE( std::is_permutation( std::cbegin( container ), std::cend( container ), std::cbegin( original ) ) );
+			};
+
+			check( integers, integers[ size / 2 ] );
+			check( floats, floats[ size / 3 ] );
+		}
+	}
+#endif
+
+	TEST_CASE( ( UNIT_NAME + "three way partition" ).c_str() )
+	{
+		partition_tester< three_way_partition >();
+	}
+
+	TEST_CASE( ( UNIT_NAME + "normalized key order" ).c_str() )
+	{
+		const auto encode = []( const auto value, const sort_order order = sort_order::ascending )
+		{
+			normalized_key key;
+			key.append( value, order );
+
+			return key;
+		};
+
+		REQUIRE( encode( -5 ) < encode( -1 ) );
+		REQUIRE( encode( -1 ) < encode( 0 ) );
+		REQUIRE( encode( 0 ) < encode( 7 ) );
+		REQUIRE( encode( 7U ) < encode( 4000000000U ) );
+		REQUIRE( encode( -2.5 ) < encode( -0.5 ) );
+		REQUIRE( encode( -0.0 ) == encode( 0.0 ) );
+		REQUIRE( encode( 0.5f ) < encode( 1.5f ) );
+		REQUIRE( encode( 3, sort_order::descending ) < encode( 2, sort_order::descending ) );
+		REQUIRE( encode( std::string_view( "ab" ) ) < encode( std::string_view( "abc" ) ) );
+		REQUIRE( encode( std::string_view( "ab" ) ) < encode( std::string_view( "b" ) ) );
+		REQUIRE( encode( std::string_view( "a" ) ) < encode( std::string_view( "a\0", 2 ) ) );
+
+		normalized_key truncated;
+		truncated.append( std::string_view( "abcdef" ), sort_order::ascending, 3 ).append( 1 );
+
+		REQUIRE( !truncated.complete() );
+		REQUIRE( truncated.size() == 4 );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "normalized sort (truncated strings)" ).c_str() )
+	{
+		const auto string_compare = []( const std::string& lhs, const std::string& rhs )
+		{
+			return ( lhs < rhs );
+		};
+
+		for ( const auto order : { sort_order::ascending, sort_order::descending } )
+		{
+			const auto encoder = [order]( const std::string& item, normalized_key& key )
+			{
+				key.append( std::string_view( item ), order, 3 );
+			};
+
+			const auto full_compare = [order, &string_compare]( const std::string& lhs, const std::string& rhs )
+			{
+				return ( order == sort_order::ascending ) ? string_compare( lhs, rhs ) : string_compare( rhs, lhs );
+			};
+
+			std::vector< std::string > strings = { "abcdef", "abc", "abd", "ab", "abcd", std::string( "ab\0", 3 ), "" };
+
+			auto expected = strings;
+			std::stable_sort( std::begin( expected ), std::end( expected ), full_compare );
+
+			normalized::sort( std::begin( strings ), std::end( strings ), encoder, full_compare );
+
+			REQUIRE( strings == expected );
+
+			// Strings shorter and longer than the limit, sharing many prefixes.
+			generator< std::uint32_t > generator;
+
+			strings.clear();
+			for ( std::size_t iteration = 0; iteration < 1000; ++iteration )
+			{
+				std::string item( generator() % 6, 'a' );
+
+				for ( auto& character : item )
+				{
+					character = static_cast< char >( 'a' + generator() % 3 );
+				}
+
+				strings.push_back( std::move( item ) );
+			}
+
+			expected = strings;
+			std::stable_sort( std::begin( expected ), std::end( expected ), full_compare );
+
+			normalized::sort( std::begin( strings ), std::end( strings ), encoder, full_compare );
+
+			REQUIRE( strings == expected );
+		}
+	}
+
+	TEST_CASE( ( UNIT_NAME + "normalized sort (records)" ).c_str() )
+	{
+		using record = std::tuple< std::int32_t, std::string, double >;
+		constexpr auto ITERATIONS = 1000U;
+
+		generator< std::int32_t > generator;
+
+		std::vector< record > records;
+		for ( std::size_t iteration = 0; iteration < ITERATIONS; ++iteration )
+		{
+			// Narrow ranges so that the later columns decide many comparisons.
+			records.emplace_back(
+				generator() % 4,
+				"key_" + std::to_string( generator() % 8 ) + std::string( 10, 'x' ) + std::to_string( generator() % 4 ),
+				static_cast< double >( generator() % 16 ) / 4.0 - 2.0 );
+		}
+
+		const auto column_compare = []( const record& lhs, const record& rhs )
+		{
+			return
+				std::make_tuple( std::get< 0 >( lhs ), std::get< 1 >( lhs ), std::get< 2 >( rhs ) ) <
+				std::make_tuple( std::get< 0 >( rhs ), std::get< 1 >( rhs ), std::get< 2 >( lhs ) );
+		};
+
+		auto expected = records;
+		std::stable_sort( std::begin( expected ), std::end( expected ), column_compare );
+
+		auto exact = records;
+		normalized::sort(
+			std::begin( exact ),
+			std::end( exact ),
+			[]( const record& item, normalized_key& key )
+			{
+				key.append( std::get< 0 >( item ) )
+					.append( std::string_view( std::get< 1 >( item ) ) )
+					.append( std::get< 2 >( item ), sort_order::descending );
+			} );
+
+		REQUIRE( exact == expected );
+
+		auto truncated = records;
+		normalized::sort(
+			std::begin( truncated ),
+			std::end( truncated ),
+			[]( const record& item, normalized_key& key )
+			{
+				key.append( std::get< 0 >( item ) )
+					.append( std::string_view( std::get< 1 >( item ) ), sort_order::ascending, 6 );
+			},
+			column_compare );
+
+		REQUIRE( truncated == expected );
+	}
+
+#if defined( __cpp_lib_constexpr_algorithms )
+	TEST_CASE( ( UNIT_NAME + "constexpr sorts" ).c_str() )
+	{
+		static_assert( constexpr_sort_tester< selection::std_implementation >(), "" );
+		static_assert( constexpr_sort_tester< selection::custom_implementation >(), "" );
+		static_assert( constexpr_sort_tester< insertion::std_implementation >(), "" );
+		static_assert( constexpr_sort_tester< insertion::custom_implementation >(), "" );
+		static_assert( constexpr_sort_tester< heap::std_implementation >(), "" );
+		static_assert( constexpr_sort_tester< heap::custom_implementation >(), "" );
+
+		REQUIRE( constexpr_sort_tester< heap::custom_implementation >() );
+	}
+#endif
+
 }
@@ -0,0 +1,208 @@
+/**
+ * Daniel Sebastian Iliescu, http://dansil.net
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ *
+ * SPSC Ring Unit Tests.
+ */
+
+#include "lists/spsc_ring.hpp"
+
+#include <catch.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	const std::string UNIT_NAME = "spsc_ring_";
+
+	using value_type = std::uint64_t;
+	constexpr std::size_t ITERATIONS = 200000;
+	constexpr std::size_t BATCH = 13;
+
+	// Counts the live items, and throws when built from a negative value.
+	struct counted_item
+	{
+		counted_item( const int input_value ) :
+			value( input_value )
+		{
+			if ( input_value < 0 )
+			{
+				throw std::invalid_argument( "negative" );
+			}
+
+			++live;
+		}
+
+		counted_item( const counted_item& other ) noexcept :
+			value( other.value )
+		{
+			++live;
+		}
+
+		counted_item& operator=( const counted_item& ) noexcept = default;
+
+		~counted_item() noexcept
+		{
+			--live;
+		}
+
+		int value;
+
+		static inline int live = 0;
+	};
+}
+
+namespace dsa
+{
+	TEST_CASE( ( UNIT_NAME + "fifo" ).c_str() )
+	{
+		spsc_ring< std::string, 8 > ring;
+
+		REQUIRE( ring.empty() );
+		REQUIRE( ring.capacity() == 8 );
+
+		for ( std::size_t item = 0; item < ring.capacity(); ++item )
+		{
+			REQUIRE( ring.push_back( std::to_string( item ) ) );
+		}
+
+		REQUIRE( !ring.push_back( "full" ) );
+		REQUIRE( ring.size() == ring.capacity() );
+
+		std::string item;
+		for ( std::size_t expected = 0; expected < ring.capacity() / 2; ++expected )
+		{
+			REQUIRE( ring.pop_front( item ) );
+			REQUIRE( item == std::to_string( expected ) );
+		}
+
+		// Wrap around the ring; the remaining items are destroyed with it.
+		REQUIRE( ring.push_back( "wrapped" ) );
+		REQUIRE( ring.size() == ring.capacity() / 2 + 1 );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "move_only" ).c_str() )
+	{
+		spsc_ring< std::unique_ptr< std::string >, 2 > ring;
+
+		REQUIRE( ring.push_back( std::make_unique< std::string >( "first" ) ) );
+		REQUIRE( ring.emplace_back( new std::string( "second" ) ) );
+
+		std::unique_ptr< std::string > item;
+
+		REQUIRE( ring.pop_front( item ) );
+		REQUIRE( *item == "first" );
+		REQUIRE( ring.pop_front( item ) );
+		REQUIRE( *item == "second" );
+		REQUIRE( !ring.pop_front( item ) );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "batch" ).c_str() )
+	{
+		spsc_ring< value_type, 16 > ring;
+
+		const std::vector< value_type > input { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11 };
+
+		REQUIRE( ring.push_n( std::cbegin( input ), input.size() ) == input.size() );
+
+		std::array< value_type, 8 > output {};
+
+		REQUIRE( ring.pop_n( std::begin( output ), output.size() ) == output.size() );
+		REQUIRE( std::equal( std::cbegin( output ), std::cend( output ), std::cbegin( input ) ) );
+
+		// Only the free slots are filled, across the end of the buffer.
+		REQUIRE( ring.push_n( std::cbegin( input ), input.size() ) == input.size() );
+		REQUIRE( ring.push_n( std::cbegin( input ), input.size() ) == 0 );
+		REQUIRE( ring.size() == 16 );
+
+		std::vector< value_type > rest;
+
+		REQUIRE( ring.pop_n( std::back_inserter( rest ), 32 ) == 16 );
+		REQUIRE( rest.front() == 8 );
+		REQUIRE( rest[ 4 ] == 0 );
+		REQUIRE( rest.back() == 11 );
+		REQUIRE( ring.empty() );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "batch_throwing_construction" ).c_str() )
+	{
+		{
+			spsc_ring< counted_item, 8 > ring;
+
+			const std::vector< int > input { 0, 1, 2, -1, 4 };
+
+			REQUIRE_THROWS_AS( ring.push_n( std::cbegin( input ), input.size() ), const std::invalid_argument& );
+
+			// The items constructed before the failure are destroyed, not pushed.
+			REQUIRE( ring.empty() );
+			REQUIRE( counted_item::live == 0 );
+
+			REQUIRE( ring.push_n( std::cbegin( input ), 3 ) == 3 );
+			REQUIRE( counted_item::live == 3 );
+		}
+
+		REQUIRE( counted_item::live == 0 );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "producer_consumer" ).c_str() )
+	{
+		spsc_ring< value_type, 64 > ring;
+
+		std::thread producer( [&ring]()
+		{
+			std::array< value_type, BATCH > batch;
+			value_type next = 0;
+
+			while ( next < ITERATIONS )
+			{
+				// Alternate between single and batched pushes.
+				if ( next % 2 == 0 )
+				{
+					next += ring.push_back( next ) ? 1 : 0;
+				}
+				else
+				{
+					const auto count = std::min< std::size_t >( BATCH, ITERATIONS - next );
+
+					for ( std::size_t offset = 0; offset < count; ++offset )
+					{
+						batch[ offset ] = next + offset;
+					}
+
+					next += ring.push_n( std::cbegin( batch ), count );
+				}
+			}
+		} );
+
+		std::array< value_type, BATCH > batch;
+		value_type expected = 0;
+		value_type item;
+
+		while ( expected < ITERATIONS )
+		{
+			if ( ring.pop_front( item ) )
+			{
+				REQUIRE( item == expected++ );
+			}
+
+			const auto count = ring.pop_n( std::begin( batch ), BATCH );
+
+			for ( std::size_t offset = 0; offset < count; ++offset )
+			{
+				REQUIRE( batch[ offset ] == expected++ );
+			}
+		}
+
+		producer.join();
+
+		REQUIRE( ring.empty() );
+	}
+}
\ No newline at end of file
@@ -0,0 +1,348 @@
+/**
+ * Daniel Sebastian Iliescu, http://dansil.net
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ *
+ * Unrolled List Unit Tests.
+ */
+
+#include "lists/unrolled_list.hpp"
+#include "memory/node_pool.hpp"
+
+#include "utilities/generator.hpp"
+
+#include <catch.hpp>
+
+#include <algorithm>
+#include <array>
+#include <deque>
+#include <list>
+#include <string>
+#include <vector>
+
+namespace
+{
+	const std::string UNIT_NAME = "unrolled_list_";
+
+	using value_type = std::int32_t;
+	constexpr auto ITERATIONS = 1000U;
+
+	// A small node capacity so that every test crosses many node boundaries.
+	constexpr std::size_t NODE_CAPACITY = 7;
+
+	template < typename T >
+	using list_type = dsa::unrolled_list< T, NODE_CAPACITY >;
+}
+
+namespace dsa
+{
+	TEST_CASE( ( UNIT_NAME + "default_constructor" ).c_str() )
+	{
+		list_type< value_type > list;
+
+		REQUIRE( list.empty() );
+		REQUIRE( list.begin() == list.end() );
+		REQUIRE( value_type() == list.front() );
+		REQUIRE( value_type() == list.pop_back() );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "default_capacity" ).c_str() )
+	{
+		REQUIRE( unrolled_list< std::int32_t >::node_capacity > 1 );
+		REQUIRE( sizeof( unrolled_list< std::int32_t >::unrolled_node ) <= 128 );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "copy_constructor" ).c_str() )
+	{
+		list_type< value_type > list;
+
+		generator< value_type > generator;
+		generator.fill_buffer_n( std::front_inserter( list ), ITERATIONS );
+		generator.fill_buffer_n( std::back_inserter( list ), ITERATIONS );
+
+		const auto list_copy( list );
+
+		REQUIRE( list == list_copy );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "move_constructor" ).c_str() )
+	{
+		list_type< value_type > list;
+
+		generator< value_type > generator;
+		generator.fill_buffer_n( std::back_inserter( list ), ITERATIONS );
+
+		const auto list_copy( list );
+		const auto list_move( std::move( list ) );
+
+		REQUIRE( list.empty() );
+		REQUIRE( list_move == list_copy );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "assignment" ).c_str() )
+	{
+		list_type< value_type > list;
+		list_type< value_type > other;
+
+		generator< value_type > generator;
+		generator.fill_buffer_n( std::back_inserter( list ), ITERATIONS );
+		generator.fill_buffer_n( std::back_inserter( other ), ITERATIONS / 2 );
+
+		other = list;
+
+		REQUIRE( other == list );
+
+		list_type< value_type > moved;
+		moved = std::move( other );
+
+		REQUIRE( moved == list );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "equality_operator" ).c_str() )
+	{
+		std::vector< value_type > values( ITERATIONS );
+
+		generator< value_type > generator;
+		generator.fill_buffer( std::begin( values ), std::end( values ) );
+
+		// The same elements, split differently across nodes.
+		list_type< value_type > list;
+		list_type< value_type > other;
+
+		for ( const auto item : values )
+		{
+			list.push_back( item );
+		}
+
+		for ( auto it = std::crbegin( values ); it != std::crend( values ); ++it )
+		{
+			other.push_front( *it );
+		}
+
+		REQUIRE( list == other );
+
+		other.pop_front();
+		other.push_front( values.front() + 1 );
+
+		REQUIRE( list != other );
+
+		other.pop_front();
+
+		REQUIRE( list != other );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "push_pop_both_ends" ).c_str() )
+	{
+		std::deque< value_type > expected;
+		list_type< value_type > list;
+
+		generator< value_type > generator;
+
+		for ( std::size_t iteration = 0; iteration < 10 * ITERATIONS; ++iteration )
+		{
+			const auto value = generator();
+
+			switch ( static_cast< std::uint32_t >( value ) % 4 )
+			{
+			case 0:
+				expected.push_front( value );
+				list.push_front( value );
+				break;
+			case 1:
+				expected.push_back( value );
+				list.push_back( value );
+				break;
+			case 2:
+				REQUIRE( ( expected.empty() ? value_type() : expected.front() ) == list.pop_front() );
+				if ( !expected.empty() )
+				{
+					expected.pop_front();
+				}
+				break;
+			default:
+				REQUIRE( ( expected.empty() ? value_type() : expected.back() ) == list.pop_back() );
+				if ( !expected.empty() )
+				{
+					expected.pop_back();
+				}
+				break;
+			}
+
+			REQUIRE( expected.size() == list.size() );
+		}
+
+		REQUIRE( std::equal( std::cbegin( expected ), std::cend( expected ), std::cbegin( list ), std::cend( list ) ) );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "insert_erase_positions" ).c_str() )
+	{
+		std::list< std::string > expected;
+		list_type< std::string > list;
+
+		generator< value_type > generator;
+
+		for ( std::size_t iteration = 0; iteration < 4 * ITERATIONS; ++iteration )
+		{
+			const auto value = static_cast< std::uint32_t >( generator() );
+			const auto offset = expected.empty() ? 0 : value % ( expected.size() + 1 );
+
+			// Inserting more often than erasing, so that full nodes get split.
+			if ( ( value % 3 != 0 ) || ( offset == expected.size() ) )
+			{
+				const auto item = std::to_string( value ) + std::string( 16, 'x' );
+
+				const auto inserted = list.emplace( std::next( list.cbegin(), offset ), item );
+				expected.insert( std::next( expected.cbegin(), offset ), item );
+
+				REQUIRE( *inserted == item );
+			}
+			else
+			{
+				const auto following = list.erase( std::next( list.cbegin(), offset ) );
+				const auto expected_following = expected.erase( std::next( expected.cbegin(), offset ) );
+
+				REQUIRE( std::distance( list.begin(), following ) == std::distance( expected.begin(), expected_following ) );
+			}
+
+			REQUIRE( expected.size() == list.size() );
+		}
+
+		REQUIRE( std::equal( std::cbegin( expected ), std::cend( expected ), std::cbegin( list ), std::cend( list ) ) );
+		REQUIRE( std::equal( std::crbegin( expected ), std::crend( expected ), std::crbegin( list ), std::crend( list ) ) );
+
+		list.erase( std::next( list.cbegin(), 10 ), std::prev( list.cend(), 10 ) );
+		expected.erase( std::next( expected.cbegin(), 10 ), std::prev( expected.cend(), 10 ) );
+
+		REQUIRE( std::equal( std::cbegin( expected ), std::cend( expected ), std::cbegin( list ), std::cend( list ) ) );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "splice_merge" ).c_str() )
+	{
+		std::array< value_type, ITERATIONS > values;
+
+		generator< value_type > generator;
+		generator.fill_buffer(
+			std::begin( values ),
+			std::end( values ) );
+
+		const auto middle = std::next( std::cbegin( values ), ITERATIONS / 3 );
+
+		std::list< value_type > expected( std::cbegin( values ), middle );
+		std::list< value_type > expected_other( middle, std::cend( values ) );
+
+		list_type< value_type > list( std::cbegin( values ), middle );
+		list_type< value_type > other( middle, std::cend( values ) );
+
+		// Splicing into the middle of a node splits it.
+		list.splice( std::next( list.cbegin(), NODE_CAPACITY / 2 ), other );
+		expected.splice( std::next( expected.cbegin(), NODE_CAPACITY / 2 ), expected_other );
+
+		REQUIRE( other.empty() );
+		REQUIRE( std::equal( std::cbegin( expected ), std::cend( expected ), std::cbegin( list ), std::cend( list ) ) );
+
+		other.splice( other.cend(), list, std::next( list.cbegin(), 3 ), std::next( list.cbegin(), 3 + ITERATIONS / 2 ) );
+		expected_other.splice( expected_other.cend(), expected, std::next( expected.cbegin(), 3 ), std::next( expected.cbegin(), 3 + ITERATIONS / 2 ) );
+
+		list.splice( std::next( list.cbegin(), 5 ), list, std::prev( list.cend(), 20 ), list.cend() );
+		expected.splice( std::next( expected.cbegin(), 5 ), expected, std::prev( expected.cend(), 20 ), expected.cend() );
+
+		REQUIRE( std::equal( std::cbegin( expected ), std::cend( expected ), std::cbegin( list ), std::cend( list ) ) );
+		REQUIRE( std::equal( std::cbegin( expected_other ), std::cend( expected_other ), std::cbegin( other ), std::cend( other ) ) );
+
+		// Sorted halves of different lengths, merged back together.
+		std::sort( std::begin( values ), std::end( values ) );
+
+		list_type< value_type > evens;
+		list_type< value_type > odds;
+
+		for ( std::size_t index = 0; index < ITERATIONS; ++index )
+		{
+			( ( values[ index ] % 2 == 0 ) ? evens : odds ).push_back( values[ index ] );
+		}
+
+		evens.merge( odds );
+
+		REQUIRE( odds.empty() );
+		REQUIRE( std::equal( std::cbegin( values ), std::cend( values ), std::cbegin( evens ), std::cend( evens ) ) );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "iterator_begin_end" ).c_str() )
+	{
+		std::array< value_type, ITERATIONS > values;
+
+		generator< value_type > generator;
+		generator.fill_buffer(
+			std::begin( values ),
+			std::end( values ) );
+
+		list_type< value_type > list;
+		std::copy(
+			std::cbegin( values ),
+			std::cend( values ),
+			std::front_inserter( list ) );
+
+		REQUIRE(
+			std::equal(
+				std::crbegin( values ),
+				std::crend( values ),
+				std::begin( list ),
+				std::end( list ) ) );
+
+		REQUIRE(
+			std::equal(
+				std::cbegin( values ),
+				std::cend( values ),
+				std::crbegin( list ),
+				std::crend( list ) ) );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "iterator_mutation" ).c_str() )
+	{
+		list_type< value_type > list;
+
+		for ( value_type value = 0; value < static_cast< value_type >( ITERATIONS ); ++value )
+		{
+			list.push_back( value );
+		}
+
+		for ( auto& item : list )
+		{
+			item *= 2;
+		}
+
+		value_type expected = 0;
+		for ( auto it = list.cbegin(); it != list.cend(); ++it, expected += 2 )
+		{
+			REQUIRE( *it == expected );
+		}
+	}
+
+	TEST_CASE( ( UNIT_NAME + "non_trivial_elements" ).c_str() )
+	{
+		list_type< std::string > list;
+
+		for ( std::size_t iteration = 0; iteration < ITERATIONS; ++iteration )
+		{
+			list.push_back( std::to_string( iteration ) + std::string( 32, 'x' ) );
+			list.push_front( std::to_string( iteration ) );
+		}
+
+		REQUIRE( list.front() == std::to_string( ITERATIONS - 1 ) );
+		REQUIRE( list.pop_back() == std::to_string( ITERATIONS - 1 ) + std::string( 32, 'x' ) );
+
+		list.clear();
+
+		REQUIRE( list.empty() );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "node_pool" ).c_str() )
+	{
+		unrolled_list< value_type, NODE_CAPACITY, node_pool< value_type > > list;
+
+		generator< value_type > generator;
+		generator.fill_buffer_n( std::back_inserter( list ), ITERATIONS );
+
+		const auto list_copy( list );
+
+		REQUIRE( list == list_copy );
+	}
+}
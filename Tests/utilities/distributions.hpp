@@ -0,0 +1,131 @@
+/**
+ * Daniel Sebastian Iliescu, http://dansil.net
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ *
+ * Random number distributions which are not provided by the standard library.
+ *
+ * They follow the standard distribution interface so that they can be used
+ * with any standard engine and with the generator utility.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+
+/**
+ * Zipfian distribution over the ranks [1, n]: rank k is drawn with a
+ * probability proportional to 1 / k^s.
+ *
+ * Sampling uses rejection-inversion (Hörmann and Derflinger, 1996), which
+ * takes constant expected time and memory regardless of n.
+ */
+template < typename IntType = std::uint64_t >
+class zipf_distribution
+{
+public:
+	using result_type = IntType;
+
+	explicit zipf_distribution(
+		const result_type input_elements = 1,
+		const double input_exponent = 1.0 ) :
+		elements( input_elements ),
+		exponent( input_exponent ),
+		integral_first( this->integral( 1.5 ) - 1.0 ),
+		integral_elements( this->integral( static_cast< double >( input_elements ) + 0.5 ) ),
+		threshold( 2.0 - this->integral_inverse( this->integral( 2.5 ) - this->density( 2.0 ) ) )
+	{
+	}
+
+	void
+	reset() noexcept
+	{
+	}
+
+	result_type
+	min() const noexcept
+	{
+		return 1;
+	}
+
+	result_type
+	max() const noexcept
+	{
+		return this->elements;
+	}
+
+	template < typename Engine >
+	result_type
+	operator()( Engine& engine )
+	{
+		std::uniform_real_distribution< double > uniform;
+
+		while ( true )
+		{
+			const auto u = this->integral_elements + uniform( engine ) * ( this->integral_first - this->integral_elements );
+			const auto x = this->integral_inverse( u );
+
+			const auto k = std::min(
+				std::max( std::floor( x + 0.5 ), 1.0 ),
+				static_cast< double >( this->elements ) );
+
+			if ( ( ( k - x ) <= this->threshold ) ||
+				 ( u >= ( this->integral( k + 0.5 ) - this->density( k ) ) ) )
+			{
+				return static_cast< result_type >( k );
+			}
+		}
+	}
+
+private:
+	// h( x ) = 1 / x^s
+	double
+	density( const double x ) const
+	{
+		return std::exp( -this->exponent * std::log( x ) );
+	}
+
+	// H( x ) = ( x^( 1 - s ) - 1 ) / ( 1 - s ), continuous at s = 1.
+	double
+	integral( const double x ) const
+	{
+		const auto log_x = std::log( x );
+
+		return expm1_ratio( ( 1.0 - this->exponent ) * log_x ) * log_x;
+	}
+
+	double
+	integral_inverse( const double x ) const
+	{
+		const auto t = std::max( x * ( 1.0 - this->exponent ), -1.0 );
+
+		return std::exp( log1p_ratio( t ) * x );
+	}
+
+	// log( 1 + x ) / x, accurate near 0.
+	static double
+	log1p_ratio( const double x )
+	{
+		return ( std::abs( x ) > 1e-8 ) ?
+			std::log1p( x ) / x :
+			1.0 - x * ( 0.5 - x * ( 1.0 / 3.0 - 0.25 * x ) );
+	}
+
+	// ( exp( x ) - 1 ) / x, accurate near 0.
+	static double
+	expm1_ratio( const double x )
+	{
+		return ( std::abs( x ) > 1e-8 ) ?
+			std::expm1( x ) / x :
+			1.0 + x * 0.5 * ( 1.0 + x * ( 1.0 / 3.0 ) * ( 1.0 + 0.25 * x ) );
+	}
+
+	result_type elements;
+	double exponent;
+
+	double integral_first;
+	double integral_elements;
+	double threshold;
+};
@@ -2,32 +2,122 @@
  * Daniel Sebastian Iliescu, http://dansil.net
  * MIT License (MIT), http://opensource.org/licenses/MIT
  *
- * Utility class for generating random value from a distribution.
+ * Utility classes for generating random values from a distribution.
+ *
+ * Every generator owns a std::mt19937_64 engine, whose output is fully
+ * specified by the standard. Given the same seed, a generator produces the
+ * same sequence on every run (distributions from the standard library are
+ * implementation-defined, so the guarantee holds for a given standard
+ * library). Default constructed generators draw their seed from
+ * std::random_device; it can be read back with seed() to replay a run.
+ *
+ * Large buffers are filled in parallel in fixed-size chunks, each generated
+ * from a seed derived from the generator seed and the chunk index, so the
+ * result does not depend on the number of threads used.
  */
 
 #pragma once
 
+#include "distributions.hpp"
+
 #include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <iterator>
 #include <random>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <vector>
 
-template < typename T >
+namespace generators
+{
+	using seed_type = std::uint64_t;
+
+	// Elements generated per chunk by the parallel fill.
+	static constexpr std::size_t PARALLEL_CHUNK = 1U << 16;
+
+	template < typename T >
+	using default_distribution =
+		typename std::conditional<
+			std::is_floating_point< T >::value,
+			std::uniform_real_distribution< T >,
+			std::uniform_int_distribution< T > >::type;
+
+	inline seed_type
+	random_seed()
+	{
+		std::random_device entropy;
+
+		return ( static_cast< seed_type >( entropy() ) << 32 ) ^ entropy();
+	}
+
+	// SplitMix64 finalizer, used to derive independent seeds from one seed.
+	inline seed_type
+	derive_seed(
+		const seed_type seed,
+		const seed_type stream ) noexcept
+	{
+		auto z = seed + ( stream + 1 ) * 0x9E3779B97F4A7C15ULL;
+
+		z = ( z ^ ( z >> 30 ) ) * 0xBF58476D1CE4E5B9ULL;
+		z = ( z ^ ( z >> 27 ) ) * 0x94D049BB133111EBULL;
+
+		return z ^ ( z >> 31 );
+	}
+}
+
+template <
+	typename T,
+	typename Distribution = generators::default_distribution< T > >
 class generator
 {
 public:
+	using result_type = T;
+	using distribution_type = Distribution;
+
+	generator() :
+		generator( generators::random_seed() )
+	{
+	}
+
+	explicit generator(
+		const generators::seed_type input_seed,
+		Distribution input_distribution = Distribution() ) :
+		initial_seed( input_seed ),
+		engine( input_seed ),
+		distribution( std::move( input_distribution ) )
+	{
+	}
 
-	generator() = default;
 	~generator() noexcept = default;
 
-	generator( const generator& ) = delete;
-	generator( generator&& ) noexcept = delete;
+	generator( const generator& ) = default;
+	generator( generator&& ) noexcept = default;
 
-	generator& operator=( const generator& ) = delete;
-	generator& operator=( generator&& ) noexcept = delete;
+	generator& operator=( const generator& ) = default;
+	generator& operator=( generator&& ) noexcept = default;
 
 	T
 	operator()()
 	{
-		return this->distribution( this->engine );
+		return static_cast< T >( this->distribution( this->engine ) );
+	}
+
+	generators::seed_type
+	seed() const noexcept
+	{
+		return this->initial_seed;
+	}
+
+	void
+	reseed( const generators::seed_type input_seed )
+	{
+		this->initial_seed = input_seed;
+		this->engine.seed( input_seed );
+		this->distribution.reset();
 	}
 
 	template < typename Iterator >
@@ -39,7 +129,7 @@ public:
 		std::generate(
 			begin,
 			end,
-			[=]()
+			[this]()
 			{
 				return this->operator()();
 			} );
@@ -54,14 +144,217 @@ public:
 		std::generate_n(
 			begin,
 			iterations,
-			[=]()
+			[this]()
 			{
 				return this->operator()();
 			} );
 	}
 
+	/**
+	 * Fills [begin, end) using up to the given number of threads. The values
+	 * only depend on the seed and the buffer size, not on the thread count,
+	 * but differ from the sequence produced by fill_buffer.
+	 */
+	template < typename RandomAccessIterator >
+	void
+	fill_buffer_parallel(
+		RandomAccessIterator begin,
+		RandomAccessIterator end,
+		std::size_t threads = std::thread::hardware_concurrency() ) const
+	{
+		const auto size = static_cast< std::size_t >( end - begin );
+		const auto chunks = ( size + generators::PARALLEL_CHUNK - 1 ) / generators::PARALLEL_CHUNK;
+
+		threads = std::max< std::size_t >( 1, std::min( threads, chunks ) );
+
+		const auto fill_chunks = [this, begin, size, chunks, threads]( const std::size_t first_chunk )
+		{
+			auto chunk_generator = *this;
+
+			for ( auto chunk = first_chunk; chunk < chunks; chunk += threads )
+			{
+				const auto chunk_begin = chunk * generators::PARALLEL_CHUNK;
+				const auto chunk_end = std::min( size, chunk_begin + generators::PARALLEL_CHUNK );
+
+				chunk_generator.reseed( generators::derive_seed( this->initial_seed, chunk ) );
+				chunk_generator.fill_buffer( begin + chunk_begin, begin + chunk_end );
+			}
+		};
+
+		std::vector< std::future< void > > tasks;
+		tasks.reserve( threads );
+
+		for ( std::size_t thread = 1; thread < threads; ++thread )
+		{
+			tasks.push_back( std::async( std::launch::async, fill_chunks, thread ) );
+		}
+
+		fill_chunks( 0 );
+
+		for ( auto& task : tasks )
+		{
+			task.get();
+		}
+	}
+
+	/**
+	 * Fills [begin, end) with sorted values, then applies the given number
+	 * of swaps between random neighbours. The result has at most that many
+	 * inversions (exactly that many when the values are distinct and no
+	 * two swaps touch the same pair).
+	 */
+	template < typename RandomAccessIterator >
+	void
+	fill_buffer_sorted(
+		RandomAccessIterator begin,
+		RandomAccessIterator end,
+		const std::size_t inversions = 0 )
+	{
+		using std::swap;
+
+		this->fill_buffer( begin, end );
+
+		std::sort( begin, end );
+
+		const auto size = static_cast< std::size_t >( end - begin );
+
+		if ( size < 2 )
+		{
+			return;
+		}
+
+		std::uniform_int_distribution< std::size_t > position( 0, size - 2 );
+
+		for ( std::size_t inversion = 0; inversion < inversions; ++inversion )
+		{
+			const auto first = begin + position( this->engine );
+
+			swap( *first, *std::next( first ) );
+		}
+	}
+
 private:
-	std::random_device entropy;
-	std::default_random_engine engine { entropy() };
-	std::uniform_int_distribution< T > distribution;
+	generators::seed_type initial_seed;
+	std::mt19937_64 engine;
+	Distribution distribution;
 };
+
+template < typename T >
+using zipf_generator = generator< T, zipf_distribution< T > >;
+
+template < typename T >
+using normal_generator = generator< T, std::normal_distribution< T > >;
+
+/**
+ * Generates strings with a uniformly distributed length in
+ * [min_length, max_length] over the given alphabet.
+ */
+class string_generator
+{
+public:
+	using result_type = std::string;
+
+	string_generator() :
+		string_generator( generators::random_seed() )
+	{
+	}
+
+	explicit string_generator(
+		const generators::seed_type seed,
+		const std::size_t min_length = 0,
+		const std::size_t max_length = 16,
+		std::string input_alphabet = "abcdefghijklmnopqrstuvwxyz" ) :
+		alphabet( std::move( input_alphabet ) ),
+		length( seed, std::uniform_int_distribution< std::size_t >( min_length, max_length ) ),
+		character( generators::derive_seed( seed, 0 ), std::uniform_int_distribution< std::size_t >( 0, this->alphabet.size() - 1 ) )
+	{
+	}
+
+	std::string
+	operator()()
+	{
+		std::string item( this->length(), '\0' );
+
+		for ( auto& letter : item )
+		{
+			letter = this->alphabet[ this->character() ];
+		}
+
+		return item;
+	}
+
+	template < typename Iterator >
+	void
+	fill_buffer_n(
+		Iterator begin,
+		const std::size_t iterations )
+	{
+		std::generate_n(
+			begin,
+			iterations,
+			[this]()
+			{
+				return this->operator()();
+			} );
+	}
+
+private:
+	std::string alphabet;
+
+	generator< std::size_t, std::uniform_int_distribution< std::size_t > > length;
+	generator< std::size_t, std::uniform_int_distribution< std::size_t > > character;
+};
+
+/**
+ * Generates records (tuples) whose fields come from one generator each.
+ */
+template < typename... FieldGenerators >
+class record_generator
+{
+public:
+	using result_type = std::tuple< typename FieldGenerators::result_type... >;
+
+	explicit record_generator( FieldGenerators... input_fields ) :
+		fields( std::move( input_fields )... )
+	{
+	}
+
+	result_type
+	operator()()
+	{
+		return this->generate( std::index_sequence_for< FieldGenerators... >() );
+	}
+
+	template < typename Iterator >
+	void
+	fill_buffer_n(
+		Iterator begin,
+		const std::size_t iterations )
+	{
+		std::generate_n(
+			begin,
+			iterations,
+			[this]()
+			{
+				return this->operator()();
+			} );
+	}
+
+private:
+	template < std::size_t... Fields >
+	result_type
+	generate( std::index_sequence< Fields... > )
+	{
+		// Braced initialization guarantees that the fields are generated in order.
+		return result_type { std::get< Fields >( this->fields )()... };
+	}
+
+	std::tuple< FieldGenerators... > fields;
+};
+
+template < typename... FieldGenerators >
+record_generator< FieldGenerators... >
+make_record_generator( FieldGenerators... fields )
+{
+	return record_generator< FieldGenerators... >( std::move( fields )... );
+}
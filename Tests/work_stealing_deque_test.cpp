@@ -0,0 +1,135 @@
+/**
+ * Daniel Sebastian Iliescu, http://dansil.net
+ * MIT License (MIT), http://opensource.org/licenses/MIT
+ *
+ * Work Stealing Deque Unit Tests.
+ */
+
+#include "lists/work_stealing_deque.hpp"
+
+#include <catch.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	const std::string UNIT_NAME = "work_stealing_deque_";
+
+	using value_type = std::uint64_t;
+	constexpr std::size_t ITERATIONS = 100000;
+	constexpr std::size_t THIEVES = 3;
+}
+
+namespace dsa
+{
+	TEST_CASE( ( UNIT_NAME + "owner_and_thief_ends" ).c_str() )
+	{
+		work_stealing_deque< value_type > deque( 4 );
+
+		REQUIRE( deque.empty() );
+		REQUIRE( deque.capacity() == 4 );
+
+		// Grows twice.
+		for ( value_type item = 0; item < 10; ++item )
+		{
+			deque.push_back( item );
+		}
+
+		REQUIRE( deque.size() == 10 );
+		REQUIRE( deque.capacity() == 16 );
+
+		value_type item;
+
+		REQUIRE( deque.steal_front( item ) );
+		REQUIRE( item == 0 );
+		REQUIRE( deque.steal_front( item ) );
+		REQUIRE( item == 1 );
+
+		for ( value_type expected = 9; expected > 1; --expected )
+		{
+			REQUIRE( deque.pop_back( item ) );
+			REQUIRE( item == expected );
+		}
+
+		REQUIRE( !deque.pop_back( item ) );
+		REQUIRE( !deque.steal_front( item ) );
+		REQUIRE( deque.empty() );
+	}
+
+	TEST_CASE( ( UNIT_NAME + "owner_and_thieves" ).c_str() )
+	{
+		work_stealing_deque< value_type > deque( 2 );
+
+		std::atomic< bool > done { false };
+		std::vector< std::vector< value_type > > stolen( THIEVES );
+		std::vector< std::thread > thieves;
+
+		for ( std::size_t thief = 0; thief < THIEVES; ++thief )
+		{
+			thieves.emplace_back( [&deque, &done, &items = stolen[ thief ]]()
+			{
+				value_type item;
+
+				while ( !done.load() || !deque.empty() )
+				{
+					if ( deque.steal_front( item ) )
+					{
+						items.push_back( item );
+					}
+					else
+					{
+						std::this_thread::yield();
+					}
+				}
+			} );
+		}
+
+		// The owner pops one item for every three it pushes.
+		std::vector< value_type > all;
+		value_type item;
+
+		for ( value_type next = 0; next < ITERATIONS; ++next )
+		{
+			deque.push_back( next );
+
+			if ( ( next % 3 == 0 ) && deque.pop_back( item ) )
+			{
+				all.push_back( item );
+			}
+		}
+
+		while ( deque.pop_back( item ) )
+		{
+			all.push_back( item );
+		}
+
+		done.store( true );
+
+		for ( auto& thief : thieves )
+		{
+			thief.join();
+		}
+
+		for ( const auto& items : stolen )
+		{
+			// Each thief steals in push order.
+			REQUIRE( std::is_sorted( std::cbegin( items ), std::cend( items ) ) );
+
+			all.insert( std::end( all ), std::cbegin( items ), std::cend( items ) );
+		}
+
+		std::sort( std::begin( all ), std::end( all ) );
+
+		REQUIRE( all.size() == ITERATIONS );
+
+		for ( std::size_t expected = 0; expected < all.size(); ++expected )
+		{
+			REQUIRE( all[ expected ] == expected );
+		}
+	}
+}
\ No newline at end of file